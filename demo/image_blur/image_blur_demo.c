@@ -238,7 +238,7 @@ static int load_bmp_image(const char* filename, neurax_tensor_t** tensor) {
         
         for (int x = 0; x < width; x++) {
             for (int c = 0; c < channels; c++) {
-                int tensor_idx = (y * width + x) * channels + c;
+                size_t tensor_idx = ((size_t)y * width + x) * channels + c;
                 int bmp_idx;
                 
                 if (channels == 4) {
@@ -319,7 +319,7 @@ static int save_bmp_image(const char* filename, neurax_tensor_t* tensor) {
         for (int x = 0; x < width; x++) {
             // Only save RGB channels (0, 1, 2), ignore alpha if present
             for (int c = 0; c < bytes_per_pixel; c++) {
-                int tensor_idx = (y * width + x) * channels + c;
+                size_t tensor_idx = ((size_t)y * width + x) * channels + c;
                 int bmp_idx = x * bytes_per_pixel + (bytes_per_pixel - 1 - c); // RGB to BGR
                 
                 float value = tensor_data[tensor_idx];
@@ -383,68 +383,48 @@ static int apply_blur_filter(neurax_device_t* device, neurax_tensor_t* input,
         return -1;
     }
     
-    // Apply blur to each channel separately
+    // Configure convolution
+    neurax_conv_config_t conv_config = {
+        .kernel_width = kernel_size,
+        .kernel_height = kernel_size,
+        .stride_x = 1,
+        .stride_y = 1,
+        .padding_x = padding,
+        .padding_y = padding,
+        .input_channels = 1,
+        .output_channels = 1,
+        .use_bias = false,
+        .activation = NEURAX_ACTIVATION_LINEAR
+    };
+    
+    // Apply blur to each channel separately, reading and writing channel views in place
     for (int c = 0; c < input->channels; c++) {
-        // Create single-channel tensors
         neurax_tensor_t* input_channel = NULL;
         neurax_tensor_t* output_channel = NULL;
         
-        error = neurax_tensor_create(input->width, input->height, 1, 1,
-                                   NEURAX_DATA_FLOAT32, &input_channel);
+        error = neurax_tensor_channel_slice(input, c, 1, &input_channel);
         if (error != NEURAX_SUCCESS) {
             neurax_tensor_destroy(*output);
             return -1;
         }
         
-        error = neurax_tensor_create(out_width, out_height, 1, 1,
-                                   NEURAX_DATA_FLOAT32, &output_channel);
+        error = neurax_tensor_channel_slice(*output, c, 1, &output_channel);
         if (error != NEURAX_SUCCESS) {
             neurax_tensor_destroy(input_channel);
             neurax_tensor_destroy(*output);
             return -1;
         }
         
-        // Copy channel data
-        float* input_data = (float*)input->data;
-        float* channel_data = (float*)input_channel->data;
-        
-        for (int i = 0; i < input->width * input->height; i++) {
-            channel_data[i] = input_data[i * input->channels + c];
-        }
-        
-        // Configure convolution
-        neurax_conv_config_t conv_config = {
-            .kernel_width = kernel_size,
-            .kernel_height = kernel_size,
-            .stride_x = 1,
-            .stride_y = 1,
-            .padding_x = padding,
-            .padding_y = padding,
-            .input_channels = 1,
-            .output_channels = 1,
-            .use_bias = false,
-            .activation = NEURAX_ACTIVATION_LINEAR
-        };
-        
         // Apply convolution
         error = neurax_conv2d(device, input_channel, kernel, NULL, &conv_config, output_channel);
+        
+        neurax_tensor_destroy(input_channel);
+        neurax_tensor_destroy(output_channel);
+        
         if (error != NEURAX_SUCCESS) {
-            neurax_tensor_destroy(input_channel);
-            neurax_tensor_destroy(output_channel);
             neurax_tensor_destroy(*output);
             return -1;
         }
-        
-        // Copy result back to output tensor
-        float* output_data = (float*)(*output)->data;
-        float* result_data = (float*)output_channel->data;
-        
-        for (int i = 0; i < out_width * out_height; i++) {
-            output_data[i * out_channels + c] = result_data[i];
-        }
-        
-        neurax_tensor_destroy(input_channel);
-        neurax_tensor_destroy(output_channel);
     }
     
     return 0;
@@ -469,7 +449,7 @@ static void create_sample_image(const char* filename) {
     // Create a pattern with circles and gradients
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
-            int idx = (y * width + x) * channels;
+            size_t idx = ((size_t)y * width + x) * channels;
             
             // Create circular patterns
             float cx = width / 2.0f;
@@ -18,7 +18,7 @@ extern "C" {
 #endif
 
 // Version information
-#define NEURAX_VERSION_MAJOR 1
+#define NEURAX_VERSION_MAJOR 2
 #define NEURAX_VERSION_MINOR 0
 #define NEURAX_VERSION_PATCH 0
 
@@ -32,7 +32,8 @@ typedef enum {
     NEURAX_ERROR_HARDWARE_FAILURE = -5,
     NEURAX_ERROR_TIMEOUT = -6,
     NEURAX_ERROR_INVALID_MODEL = -7,
-    NEURAX_ERROR_BUFFER_OVERFLOW = -8
+    NEURAX_ERROR_BUFFER_OVERFLOW = -8,
+    NEURAX_ERROR_IO = -9
 } neurax_error_t;
 
 // Data types
@@ -41,7 +42,9 @@ typedef enum {
     NEURAX_DATA_INT8 = 1,
     NEURAX_DATA_UINT16 = 2,
     NEURAX_DATA_INT16 = 3,
-    NEURAX_DATA_FLOAT32 = 4
+    NEURAX_DATA_FLOAT32 = 4,
+    NEURAX_DATA_FLOAT16 = 5,        // IEEE 754 half precision (storage only, computed in fp32)
+    NEURAX_DATA_BFLOAT16 = 6        // bfloat16 (storage only, computed in fp32)
 } neurax_data_type_t;
 
 // Activation functions
@@ -66,6 +69,15 @@ typedef struct {
     uint32_t max_kernel_size;       // Maximum supported kernel size
     uint32_t num_multipliers;       // Number of parallel multipliers
     neurax_data_type_t data_type;   // Default data type
+    bool use_tensor_pool;           // Recycle tensor buffers through the process-wide pool
+    size_t tensor_pool_limit;       // Idle bytes the pool may retain (0 = 256 MiB)
+    size_t memory_budget;           // Tracked bytes the device may hold (0 = unlimited)
+    const char* dma_device;         // u-dma-buf device node for DMA buffers (NULL = /dev/udmabuf0)
+    size_t dma_region_size;         // Anonymous DMA region when the node is missing (0 = 64 MiB)
+    bool use_simulator;             // Drive the register-level simulator instead of a device node
+    uint32_t timeout_ms;            // Hardware operation timeout (0 = 5000 ms)
+    uint32_t clock_mhz;             // Accelerator clock for performance estimates (0 = 100 MHz)
+    uint32_t dma_bandwidth_mbps;    // DMA bandwidth in MB/s for performance estimates (0 = 800)
 } neurax_config_t;
 
 // Layer configuration structures
@@ -90,6 +102,104 @@ typedef struct {
     neurax_pool_type_t pool_type;
 } neurax_pool_config_t;
 
+typedef struct {
+    uint32_t input_features;
+    uint32_t output_features;
+    bool use_bias;
+    neurax_activation_t activation;
+} neurax_dense_config_t;
+
+// Elementwise binary operations
+typedef enum {
+    NEURAX_ELTWISE_ADD = 0,         // a + b
+    NEURAX_ELTWISE_MUL = 1,         // a * b
+    NEURAX_ELTWISE_ADD_RELU = 2     // max(a + b, 0), residual connection with fused ReLU
+} neurax_eltwise_op_t;
+
+// Resize interpolation modes (half-pixel centers)
+typedef enum {
+    NEURAX_RESIZE_NEAREST = 0,
+    NEURAX_RESIZE_BILINEAR = 1
+} neurax_resize_mode_t;
+
+// Calibration methods for activation range estimation
+typedef enum {
+    NEURAX_CALIB_MINMAX = 0,        // Observed minimum and maximum
+    NEURAX_CALIB_PERCENTILE = 1,    // Percentile of absolute values
+    NEURAX_CALIB_KL_DIVERGENCE = 2  // Threshold minimizing KL divergence (entropy)
+} neurax_calib_method_t;
+
+// Tensor creation flags for neurax_tensor_create_ex
+typedef enum {
+    NEURAX_TENSOR_DEFAULT = 0,
+    NEURAX_TENSOR_NO_INIT = 1 << 0,  // Leave the data uninitialized (for outputs written in full)
+    NEURAX_TENSOR_HUGEPAGE = 1 << 1, // Back large tensors with transparent huge pages
+    NEURAX_TENSOR_UNTRACKED = 1 << 2 // Leave the data out of device memory accounting
+} neurax_tensor_flags_t;
+
+// Ownership of buffers passed to neurax_tensor_wrap
+typedef enum {
+    NEURAX_WRAP_BORROW = 0,         // Caller keeps ownership; destroy leaves the buffer alone
+    NEURAX_WRAP_TAKE_OWNERSHIP = 1  // Destroy releases the buffer with the deleter (free() if NULL)
+} neurax_wrap_flags_t;
+
+// Access requested by neurax_tensor_map
+typedef enum {
+    NEURAX_MAP_READ = 1,
+    NEURAX_MAP_WRITE = 2,
+    NEURAX_MAP_READ_WRITE = 3
+} neurax_map_access_t;
+
+// Memory accounting categories
+typedef enum {
+    NEURAX_MEMORY_WEIGHTS = 0,      // Model parameters
+    NEURAX_MEMORY_ACTIVATIONS = 1,  // Layer inputs and outputs
+    NEURAX_MEMORY_SCRATCH = 2,      // Workspace arena and kernel scratch buffers
+    NEURAX_MEMORY_DMA = 3,          // Buffers shared with the accelerator
+    NEURAX_MEMORY_CATEGORY_COUNT = 4
+} neurax_memory_category_t;
+
+// Releases a wrapped buffer owned by a tensor
+typedef void (*neurax_tensor_deleter_t)(void* data, void* user_data);
+
+// Tensor dimensions, used to index neurax_tensor_t strides
+typedef enum {
+    NEURAX_DIM_CHANNEL = 0,
+    NEURAX_DIM_WIDTH = 1,
+    NEURAX_DIM_HEIGHT = 2,
+    NEURAX_DIM_BATCH = 3
+} neurax_dim_t;
+
+// Memory layouts
+typedef enum {
+    NEURAX_LAYOUT_NHWC = 0,         // Interleaved channels (default for activations)
+    NEURAX_LAYOUT_NCHW = 1,         // Planar channels
+    NEURAX_LAYOUT_NCHW8C = 2,       // Channel blocks of 8, interleaved within a block
+    NEURAX_LAYOUT_NCHW16C = 3,      // Channel blocks of 16, interleaved within a block
+    NEURAX_LAYOUT_OIHW = 4          // Weights: batch = output channels, channels = input channels
+} neurax_layout_t;
+
+// Layer types, used to query kernel preferences
+typedef enum {
+    NEURAX_LAYER_CONV2D = 0,
+    NEURAX_LAYER_POOLING = 1,
+    NEURAX_LAYER_ACTIVATION = 2,
+    NEURAX_LAYER_DENSE = 3,
+    NEURAX_LAYER_BATCH_NORM = 4,
+    NEURAX_LAYER_ELTWISE = 5,
+    NEURAX_LAYER_CONCAT = 6,
+    NEURAX_LAYER_RESIZE = 7,
+    NEURAX_LAYER_SOFTMAX = 8
+} neurax_layer_type_t;
+
+// Quantization parameters: real_value = scale * (quantized_value - zero_point)
+typedef struct {
+    float scale;                    // Per-tensor scale (0 = not quantized)
+    int32_t zero_point;             // Per-tensor zero point
+    float* channel_scales;          // Per-output-channel scales, owned by the tensor (NULL = per-tensor)
+    uint32_t num_channels;          // Number of per-channel scales
+} neurax_quant_params_t;
+
 // Tensor structure
 typedef struct {
     void* data;                     // Pointer to data
@@ -99,8 +209,156 @@ typedef struct {
     uint32_t batch_size;            // Batch size
     neurax_data_type_t data_type;   // Data type
     size_t data_size;               // Size of data in bytes
+    neurax_quant_params_t quant;    // Quantization parameters for integer data
+    size_t strides[4];              // Byte strides indexed by neurax_dim_t (all 0 = dense NHWC)
+    neurax_layout_t layout;         // Memory layout of the data
+    struct neurax_tensor_state* state; // Library bookkeeping (NULL for caller-built tensors)
 } neurax_tensor_t;
 
+// Calibration state handle
+typedef struct neurax_calibrator neurax_calibrator_t;
+
+// Batch normalization parameters (per-channel tensors, FLOAT32 or any supported type)
+typedef struct {
+    const neurax_tensor_t* gamma;     // Scale (NULL = 1)
+    const neurax_tensor_t* beta;      // Shift (NULL = 0)
+    const neurax_tensor_t* mean;      // Running mean
+    const neurax_tensor_t* variance;  // Running variance
+    float epsilon;                    // Added to variance for stability
+} neurax_batch_norm_params_t;
+
+// Device workspace usage
+typedef struct {
+    size_t size;                // Reserved bytes, scratch arenas included
+    size_t used;                // Bytes currently allocated
+    size_t peak;                // Largest number of bytes allocated at once
+    size_t high_water;          // Largest demand, including requests that did not fit
+    uint64_t fallback_allocs;   // Kernel scratch requests served from the heap
+} neurax_workspace_stats_t;
+
+// Tensor pool statistics
+typedef struct {
+    bool enabled;               // At least one device enabled the pool
+    uint64_t hits;              // Allocations served from recycled buffers
+    uint64_t misses;            // Allocations that needed a new buffer
+    float hit_rate;             // hits / (hits + misses)
+    size_t bytes_retained;      // Idle bytes held for reuse
+    size_t bytes_in_use;        // Bytes of pooled buffers owned by live tensors
+    size_t bytes_limit;         // Largest number of idle bytes retained
+} neurax_tensor_pool_stats_t;
+
+// Source of a device's DMA memory
+typedef enum {
+    NEURAX_DMA_NONE = 0,            // Not set up yet (no DMA buffer allocated)
+    NEURAX_DMA_UDMABUF = 1,         // Physically contiguous u-dma-buf region
+    NEURAX_DMA_ANONYMOUS = 2        // Page-aligned anonymous memory with synthetic bus addresses
+} neurax_dma_backend_t;
+
+// DMA region state
+typedef struct {
+    neurax_dma_backend_t backend;
+    uint64_t bus_address;       // Address of the region as seen by the accelerator
+    size_t size;                // Region size in bytes
+    size_t used;                // Bytes allocated
+    size_t peak;                // Largest number of bytes allocated at once
+    uint32_t num_buffers;       // Live allocations
+} neurax_dma_info_t;
+
+// Faults the simulated accelerator can be told to produce
+typedef enum {
+    NEURAX_SIM_FAULT_NONE = 0,
+    NEURAX_SIM_FAULT_ERROR = 1,     // Set the status error bit instead of computing
+    NEURAX_SIM_FAULT_HANG = 2       // Stay busy until reset, so the wait times out
+} neurax_sim_fault_t;
+
+// Accelerator layer for performance estimation
+typedef struct {
+    neurax_layer_type_t type;       // NEURAX_LAYER_CONV2D, _POOLING or _ACTIVATION
+    uint32_t width;                 // Input width
+    uint32_t height;                // Input height
+    uint32_t channels;              // Input channels
+    uint32_t batch_size;
+    neurax_data_type_t data_type;
+    neurax_conv_config_t conv;      // Convolution parameters (NEURAX_LAYER_CONV2D)
+    neurax_pool_config_t pool;      // Pooling parameters (NEURAX_LAYER_POOLING)
+    neurax_activation_t activation; // Activation function (NEURAX_LAYER_ACTIVATION)
+} neurax_perf_layer_t;
+
+// What limits a layer on the accelerator
+typedef enum {
+    NEURAX_BOUND_NONE = 0,          // Not run on the accelerator
+    NEURAX_BOUND_COMPUTE = 1,       // Multiplier array
+    NEURAX_BOUND_TRANSFER = 2       // DMA bandwidth
+} neurax_perf_bound_t;
+
+// Predicted (or simulated) accelerator cost
+typedef struct {
+    uint64_t cycles;                // Total cycles, compute and transfer overlapped
+    uint64_t compute_cycles;        // Cycles the multiplier array is busy
+    uint64_t transfer_cycles;       // Cycles the DMA engine is busy
+    uint64_t dma_bytes;             // Bytes read and written over DMA
+    uint64_t operations;            // Multiply-accumulates, window elements or activations
+    uint32_t runs;                  // Accelerator starts
+    double time_ms;                 // Cycles at the configured clock
+    neurax_perf_bound_t bottleneck;
+} neurax_perf_estimate_t;
+
+// Tracked memory of one category, or of all of them
+typedef struct {
+    size_t live_bytes;          // Bytes currently held
+    size_t peak_bytes;          // Largest number of bytes held at once
+    uint64_t allocations;       // Allocations charged
+    uint64_t frees;             // Allocations released
+} neurax_memory_usage_t;
+
+// Device memory accounting
+typedef struct {
+    neurax_memory_usage_t categories[NEURAX_MEMORY_CATEGORY_COUNT]; // Indexed by neurax_memory_category_t
+    neurax_memory_usage_t total;
+    size_t budget;              // Limit on total live bytes (0 = unlimited)
+    uint64_t failed_allocs;     // Allocations refused by the budget
+} neurax_memory_stats_t;
+
+// Layer as seen by the memory planner: the activation tensors it reads and writes
+typedef struct {
+    const uint32_t* inputs;     // Ids of the tensors the layer reads
+    uint32_t num_inputs;
+    uint32_t output;            // Id of the tensor the layer writes
+    bool in_place;              // Output may overwrite inputs[0] (activation, eltwise, batch norm)
+} neurax_plan_layer_t;
+
+// Memory plan summary
+typedef struct {
+    size_t peak_bytes;          // Size of the block holding every planned tensor
+    size_t naive_bytes;         // Sum of all tensor sizes without reuse
+    uint32_t num_tensors;
+    uint32_t num_buffers;       // Distinct storage regions after in-place sharing
+    uint32_t in_place_tensors;  // Tensors computed in their input's storage
+} neurax_memory_plan_stats_t;
+
+// Static activation memory plan
+typedef struct neurax_memory_plan neurax_memory_plan_t;
+
+// Completion of an asynchronously submitted operation
+typedef struct neurax_fence neurax_fence_t;
+
+// Called on the device's queue thread when an asynchronous operation finishes,
+// before its fence is signalled. The next operation waits for the callback
+// to return. A callback may submit more work and poll or destroy fences, but
+// must not wait for its own device: neurax_finish, neurax_cleanup and
+// neurax_fence_wait on a pending fence of that device return
+// NEURAX_ERROR_INVALID_PARAM there instead of deadlocking.
+typedef void (*neurax_completion_fn)(neurax_error_t result, void* user_data);
+
+// Recorded chain of accelerator operations
+typedef struct neurax_command_buffer neurax_command_buffer_t;
+
+// Memory-mapped .nxt tensor file
+typedef struct neurax_tensor_file neurax_tensor_file_t;
+
+// Longest tensor name stored in a .nxt file, including the terminator
+#define NEURAX_TENSOR_NAME_MAX 64
+
 // Neural network model structure
 typedef struct neurax_model neurax_model_t;
 
@@ -119,6 +377,8 @@ neurax_error_t neurax_init(const neurax_config_t* config, neurax_device_t** devi
 
 /**
  * Cleanup and close NEURAX device
+ * Queued asynchronous operations finish first; refused from the device's
+ * own completion callbacks.
  * @param device Device handle
  * @return Error code
  */
@@ -154,8 +414,116 @@ neurax_error_t neurax_tensor_create(uint32_t width, uint32_t height,
                                    neurax_data_type_t data_type,
                                    neurax_tensor_t** tensor);
 
+/**
+ * Create a new tensor with an explicit memory layout
+ * Blocked layouts pad the channels to a multiple of the block size; the
+ * padding lanes are zero-filled. OIHW labels a weight tensor and is stored
+ * like the tensors neurax_tensor_create returns.
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param layout Memory layout
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_create_layout(uint32_t width, uint32_t height,
+                                          uint32_t channels, uint32_t batch_size,
+                                          neurax_data_type_t data_type,
+                                          neurax_layout_t layout,
+                                          neurax_tensor_t** tensor);
+
+/**
+ * Create a new tensor with explicit layout, allocation flags and alignment
+ * Data is aligned to 64 bytes by default. NEURAX_TENSOR_HUGEPAGE aligns
+ * tensors of at least 2 MiB to a huge page and advises the kernel to back
+ * them with huge pages.
+ * Like every neurax_tensor_create* call, the data is charged to the most
+ * recently initialized device that is still open: OIHW tensors as
+ * NEURAX_MEMORY_WEIGHTS, others as NEURAX_MEMORY_ACTIVATIONS. The charge
+ * fails with NEURAX_ERROR_MEMORY_ALLOCATION past the device's budget.
+ * NEURAX_TENSOR_UNTRACKED opts out; with no device open nothing is charged.
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param layout Memory layout
+ * @param flags Bitwise OR of neurax_tensor_flags_t
+ * @param alignment Data alignment in bytes: a power of two up to the page size (0 = default)
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_create_ex(uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_layout_t layout,
+                                      uint32_t flags, size_t alignment,
+                                      neurax_tensor_t** tensor);
+
+/**
+ * Create a tensor around a caller-owned buffer without copying it
+ * Image loaders, camera frames and DMA buffers can be used in place instead
+ * of going through neurax_tensor_set_data / neurax_tensor_get_data.
+ * @param data Buffer holding the tensor data in the given layout
+ * @param size Size of the buffer in bytes (at least the tensor's data size)
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param layout Memory layout of the buffer
+ * @param flags Ownership of the buffer
+ * @param deleter Called on destroy for owned buffers (NULL = free())
+ * @param user_data Passed to the deleter
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_wrap(void* data, size_t size,
+                                 uint32_t width, uint32_t height,
+                                 uint32_t channels, uint32_t batch_size,
+                                 neurax_data_type_t data_type,
+                                 neurax_layout_t layout,
+                                 neurax_wrap_flags_t flags,
+                                 neurax_tensor_deleter_t deleter,
+                                 void* user_data,
+                                 neurax_tensor_t** tensor);
+
+/**
+ * Map a tensor's storage for direct access
+ * The pointer is the tensor's own storage (views keep their strides) and
+ * stays valid until the matching neurax_tensor_unmap.
+ * @param tensor Tensor to map
+ * @param access Intended access
+ * @param data Output pointer to the storage
+ * @param size Output size of the storage in bytes (may be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_map(neurax_tensor_t* tensor, neurax_map_access_t access,
+                                void** data, size_t* size);
+
+/**
+ * Release a mapping obtained with neurax_tensor_map
+ * @param tensor Mapped tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_unmap(neurax_tensor_t* tensor);
+
+/**
+ * Copy a tensor into another tensor of the same shape and type but a different layout
+ * Uses cache-blocked transposes; NHWC views are accepted on either side.
+ * OIHW is treated as NCHW, so weights can be transposed from OHWI as well.
+ * @param src Source tensor
+ * @param dst Destination tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_convert_layout(const neurax_tensor_t* src, neurax_tensor_t* dst);
+
 /**
  * Destroy a tensor and free memory
+ * Tensors the caller built without the library (state NULL) must have
+ * malloc'd header and data; both are released with free().
  * @param tensor Tensor to destroy
  * @return Error code
  */
@@ -186,10 +554,503 @@ neurax_error_t neurax_tensor_get_data(const neurax_tensor_t* tensor, void* data,
  */
 size_t neurax_tensor_total_elements(const neurax_tensor_t* tensor);
 
+/**
+ * Create a view of a sub-block of a tensor (ROI crop, channel range, batch split)
+ * The view shares the parent's memory and strides; no data is copied and
+ * destroying the view does not free the parent's data. Views are accepted by
+ * all layer functions.
+ * @param parent Parent tensor (may itself be a view)
+ * @param x First column
+ * @param y First row
+ * @param c First channel
+ * @param n First batch item
+ * @param width Width of the view
+ * @param height Height of the view
+ * @param channels Channels of the view
+ * @param batch_size Batch size of the view
+ * @param view Output view tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_view(neurax_tensor_t* parent,
+                                 uint32_t x, uint32_t y, uint32_t c, uint32_t n,
+                                 uint32_t width, uint32_t height,
+                                 uint32_t channels, uint32_t batch_size,
+                                 neurax_tensor_t** view);
+
+/**
+ * Create a view with explicit byte strides into a tensor's memory
+ * Allows reinterpretations a sub-block can't express, such as every other
+ * channel or a planar (NCHW) buffer seen as NHWC. The view must lie within
+ * the parent's data and every stride must be a multiple of the element size.
+ * @param parent Parent tensor providing the memory and data type
+ * @param byte_offset Offset of the view's first element from parent->data
+ * @param width Width of the view
+ * @param height Height of the view
+ * @param channels Channels of the view
+ * @param batch_size Batch size of the view
+ * @param strides Byte strides indexed by neurax_dim_t
+ * @param view Output view tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_view_strided(neurax_tensor_t* parent, size_t byte_offset,
+                                         uint32_t width, uint32_t height,
+                                         uint32_t channels, uint32_t batch_size,
+                                         const size_t strides[4],
+                                         neurax_tensor_t** view);
+
+/**
+ * Create a view of a channel range of a tensor
+ * Layers writing into channel views of one preallocated tensor build a
+ * channel concatenation without copies. Same as neurax_tensor_view over
+ * the full width, height and batch.
+ * @param parent Parent tensor
+ * @param channel_offset First channel of the view
+ * @param channels Number of channels in the view
+ * @param view Output view tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_channel_slice(neurax_tensor_t* parent, uint32_t channel_offset,
+                                          uint32_t channels, neurax_tensor_t** view);
+
+/**
+ * Attach quantization parameters to a tensor
+ * @param tensor Target tensor
+ * @param scale Per-tensor scale
+ * @param zero_point Per-tensor zero point
+ * @param channel_scales Per-output-channel scales (copied, can be NULL)
+ * @param num_channels Number of entries in channel_scales (must equal batch_size)
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_set_quant_params(neurax_tensor_t* tensor, float scale,
+                                             int32_t zero_point,
+                                             const float* channel_scales,
+                                             uint32_t num_channels);
+
+// Tensor pool functions
+
+/**
+ * Release idle tensor pool buffers
+ * Buffers cached by every thread, not only the caller, are included.
+ * @param max_retained Idle bytes to keep (0 = release everything)
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_pool_trim(size_t max_retained);
+
+/**
+ * Get tensor pool statistics
+ * The pool is enabled by neurax_config_t.use_tensor_pool and serves
+ * neurax_tensor_create and neurax_tensor_destroy transparently.
+ * @param stats Output statistics
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_pool_get_stats(neurax_tensor_pool_stats_t* stats);
+
+// Workspace functions
+
+/**
+ * Reserve device workspace memory up front
+ * neurax_workspace_alloc and neurax_workspace_tensor take their memory from
+ * the workspace, which grows to the largest demand seen on each reset. CPU
+ * kernels take scratch buffers from an arena per operation in flight, so
+ * operations on one device from different threads do not wait for each
+ * other; each arena grows to the largest demand of one operation, so
+ * repeated inferences of the same network stop allocating after the first
+ * run, and requests that do not fit fall back to the heap. Reserving also
+ * sizes those arenas to at least `size`.
+ * @param device Device handle
+ * @param size Minimum workspace size in bytes
+ * @return Error code
+ */
+neurax_error_t neurax_workspace_reserve(neurax_device_t* device, size_t size);
+
+/**
+ * Allocate memory from the device workspace
+ * The memory is 64-byte aligned and stays valid until neurax_workspace_reset.
+ * @param device Device handle
+ * @param size Size in bytes
+ * @param ptr Output pointer
+ * @return Error code (NEURAX_ERROR_MEMORY_ALLOCATION when the workspace is full)
+ */
+neurax_error_t neurax_workspace_alloc(neurax_device_t* device, size_t size, void** ptr);
+
+/**
+ * Create an uninitialized NHWC tensor in the device workspace
+ * Header and data are released by neurax_workspace_reset; neurax_tensor_destroy
+ * is optional for these tensors.
+ * @param device Device handle
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_workspace_tensor(neurax_device_t* device,
+                                      uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_tensor_t** tensor);
+
+/**
+ * Release every workspace allocation, typically once per inference
+ * @param device Device handle
+ * @return Error code
+ */
+neurax_error_t neurax_workspace_reset(neurax_device_t* device);
+
+/**
+ * Get workspace usage statistics
+ * @param device Device handle
+ * @param stats Output statistics
+ * @return Error code
+ */
+neurax_error_t neurax_workspace_get_stats(neurax_device_t* device, neurax_workspace_stats_t* stats);
+
+// Memory accounting functions
+
+/**
+ * Create a tensor whose data is charged to a given device and category
+ * Fails with NEURAX_ERROR_MEMORY_ALLOCATION before allocating when the
+ * device's memory budget would be exceeded. The tensor may outlive the
+ * device; its charge is then released into the retired accounting.
+ * @param device Device handle
+ * @param category Accounting category
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param layout Memory layout
+ * @param flags Bitwise OR of neurax_tensor_flags_t
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_create_tracked(neurax_device_t* device,
+                                           neurax_memory_category_t category,
+                                           uint32_t width, uint32_t height,
+                                           uint32_t channels, uint32_t batch_size,
+                                           neurax_data_type_t data_type,
+                                           neurax_layout_t layout,
+                                           uint32_t flags,
+                                           neurax_tensor_t** tensor);
+
+/**
+ * Charge an existing tensor's data to a device
+ * Use for tensors the library does not charge itself, such as wrapped
+ * buffers or weights loaded from a tensor file, or to move a tensor's charge
+ * to another device or category. Views and workspace tensors cannot be
+ * tracked; destroying the tensor releases the charge.
+ * @param device Device handle
+ * @param tensor Tensor to track
+ * @param category Accounting category
+ * @return Error code (NEURAX_ERROR_MEMORY_ALLOCATION when over budget)
+ */
+neurax_error_t neurax_tensor_track(neurax_device_t* device, neurax_tensor_t* tensor,
+                                  neurax_memory_category_t category);
+
+/**
+ * Set the limit on tracked memory held by a device
+ * Memory already held is kept; allocations that would exceed the limit fail.
+ * @param device Device handle
+ * @param budget Limit in bytes (0 = unlimited)
+ * @return Error code
+ */
+neurax_error_t neurax_memory_set_budget(neurax_device_t* device, size_t budget);
+
+/**
+ * Get tracked memory usage by category
+ * @param device Device handle
+ * @param stats Output statistics
+ * @return Error code
+ */
+neurax_error_t neurax_memory_get_stats(neurax_device_t* device, neurax_memory_stats_t* stats);
+
+/**
+ * Restart peak tracking from the bytes currently held
+ * @param device Device handle
+ * @return Error code
+ */
+neurax_error_t neurax_memory_reset_peak(neurax_device_t* device);
+
+// DMA memory functions
+
+/**
+ * Allocate a buffer the accelerator can access
+ * Buffers come from the u-dma-buf region named by neurax_config_t.dma_device.
+ * Without that node, a page-aligned anonymous region stands in, with the
+ * same alignment and bus addressing, so the hardware path can be exercised
+ * on machines without the driver. Buffers are page-aligned, zero-filled and
+ * charged to NEURAX_MEMORY_DMA.
+ * @param device Device handle
+ * @param size Size in bytes
+ * @param ptr Output CPU pointer
+ * @param bus_address Output accelerator address (may be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_dma_alloc(neurax_device_t* device, size_t size, void** ptr,
+                               uint64_t* bus_address);
+
+/**
+ * Free a buffer from neurax_dma_alloc
+ * @param device Device handle
+ * @param ptr Buffer pointer
+ * @return Error code
+ */
+neurax_error_t neurax_dma_free(neurax_device_t* device, void* ptr);
+
+/**
+ * Translate a CPU pointer into DMA memory to its accelerator address
+ * Any address inside a DMA buffer is accepted, so views of DMA tensors
+ * translate as well.
+ * @param device Device handle
+ * @param ptr Pointer into DMA memory
+ * @param bus_address Output accelerator address
+ * @return Error code (NEURAX_ERROR_INVALID_PARAM when ptr is not DMA memory)
+ */
+neurax_error_t neurax_dma_get_address(neurax_device_t* device, const void* ptr,
+                                     uint64_t* bus_address);
+
+/**
+ * Create a tensor whose data lives in DMA memory
+ * The hardware path uses such tensors in place, without staging copies.
+ * @param device Device handle
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param layout Memory layout
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_create_dma(neurax_device_t* device,
+                                       uint32_t width, uint32_t height,
+                                       uint32_t channels, uint32_t batch_size,
+                                       neurax_data_type_t data_type,
+                                       neurax_layout_t layout,
+                                       neurax_tensor_t** tensor);
+
+/**
+ * Get the state of the device's DMA region
+ * @param device Device handle
+ * @param info Output region state
+ * @return Error code
+ */
+neurax_error_t neurax_dma_get_info(neurax_device_t* device, neurax_dma_info_t* info);
+
+// Simulator functions
+
+/**
+ * Make the next accelerator operation on a simulated device fail
+ * The simulator replaces the device node when neurax_config_t.use_simulator
+ * is set or the NEURAX_SIMULATOR environment variable is non-empty and not
+ * "0". It models the register file, the CTRL/STAT handshake and the
+ * convolution, activation and pooling units over DMA memory, so the
+ * hardware path runs on machines without the FPGA. An injected fault
+ * applies to one operation: NEURAX_SIM_FAULT_ERROR raises the status error
+ * bit, NEURAX_SIM_FAULT_HANG leaves the unit busy until the wait times out.
+ * @param device Device handle
+ * @param fault Fault to inject (NEURAX_SIM_FAULT_NONE clears a pending one)
+ * @return Error code (NEURAX_ERROR_DEVICE_NOT_FOUND when the device is not simulated)
+ */
+neurax_error_t neurax_simulator_inject_fault(neurax_device_t* device, neurax_sim_fault_t fault);
+
+/**
+ * Get the cost of the operations a simulated device has run
+ * Every operation is charged with the model behind neurax_perf_estimate, so
+ * the totals equal the estimate for the same layers; the cycles of the
+ * last operation are also readable from its cycle count register.
+ * @param device Device handle
+ * @param stats Output accumulated cost
+ * @return Error code (NEURAX_ERROR_DEVICE_NOT_FOUND when the device is not simulated)
+ */
+neurax_error_t neurax_simulator_get_stats(neurax_device_t* device, neurax_perf_estimate_t* stats);
+
+/**
+ * Clear the accumulated cost of a simulated device
+ * @param device Device handle
+ * @return Error code
+ */
+neurax_error_t neurax_simulator_reset_stats(neurax_device_t* device);
+
+// Performance estimation functions
+
+/**
+ * Predict accelerator cycles, DMA traffic and bottleneck for a layer sequence
+ * Each layer is encoded the way the hardware path programs the accelerator.
+ * One run takes the larger of its compute cycles (operations spread over
+ * num_multipliers) and transfer cycles (DMA bytes at dma_bandwidth_mbps
+ * against clock_mhz), plus a fixed setup cost. Convolution and pooling run
+ * once per image, activation once per layer. Layers the accelerator doesn't
+ * handle get a zero estimate with NEURAX_BOUND_NONE; they run on the CPU.
+ * @param device Device handle (its configuration supplies the parameters)
+ * @param layers Layers in execution order
+ * @param num_layers Number of layers
+ * @param estimates Output per-layer estimates (num_layers entries, may be NULL)
+ * @param total Output sum over all layers (may be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_perf_estimate(neurax_device_t* device, const neurax_perf_layer_t* layers,
+                                   uint32_t num_layers, neurax_perf_estimate_t* estimates,
+                                   neurax_perf_estimate_t* total);
+
+// Tensor file functions
+
+/**
+ * Save tensors to a .nxt tensor file
+ * Shape, data type, layout and quantization parameters are stored with each
+ * tensor; payloads are page-aligned so the file can be mapped directly. The
+ * file is little-endian and can only be written and read on little-endian
+ * hosts. A partly written file is removed when writing fails.
+ * @param filename Output file path
+ * @param tensors Tensors to save (dense tensors or contiguous views)
+ * @param names Tensor names, shorter than NEURAX_TENSOR_NAME_MAX (NULL or NULL entries = unnamed)
+ * @param count Number of tensors
+ * @return Error code (NEURAX_ERROR_IO when the file cannot be created or written)
+ */
+neurax_error_t neurax_tensor_file_save(const char* filename,
+                                      const neurax_tensor_t* const* tensors,
+                                      const char* const* names,
+                                      uint32_t count);
+
+/**
+ * Open a .nxt tensor file through a read-only mapping
+ * Processes loading the same file share its pages.
+ * @param filename File path
+ * @param file Output file handle
+ * @return Error code (NEURAX_ERROR_IO when the file cannot be opened,
+ *         NEURAX_ERROR_INVALID_MODEL for malformed files)
+ */
+neurax_error_t neurax_tensor_file_open(const char* filename, neurax_tensor_file_t** file);
+
+/**
+ * Close a tensor file handle
+ * The mapping is released once every tensor loaded from it is destroyed.
+ * @param file File handle
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_file_close(neurax_tensor_file_t* file);
+
+/**
+ * Get the number of tensors in a file
+ * @param file File handle
+ * @param count Output tensor count
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_file_get_count(const neurax_tensor_file_t* file, uint32_t* count);
+
+/**
+ * Get the name of a tensor in a file
+ * @param file File handle
+ * @param index Tensor index
+ * @param name Output name, valid while the file is open
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_file_get_name(const neurax_tensor_file_t* file, uint32_t index,
+                                          const char** name);
+
+/**
+ * Load a tensor without copying its data
+ * The tensor and its views are read-only: they point into the file
+ * mapping, and operations that would write them (mapping for write,
+ * neurax_tensor_set_data, op outputs, neurax_fold_batch_norm) fail with
+ * NEURAX_ERROR_INVALID_PARAM. Convert into a new tensor with
+ * neurax_tensor_convert_layout to get a writable copy.
+ * @param file File handle
+ * @param index Tensor index
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_file_load(neurax_tensor_file_t* file, uint32_t index,
+                                      neurax_tensor_t** tensor);
+
+/**
+ * Load a tensor by name without copying its data
+ * @param file File handle
+ * @param name Tensor name
+ * @param tensor Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_tensor_file_find(neurax_tensor_file_t* file, const char* name,
+                                      neurax_tensor_t** tensor);
+
+// Memory planning functions
+
+/**
+ * Plan activation memory for a sequence of layers
+ * Tensors are live from the layer that writes them (graph inputs: the first
+ * layer) to the last layer that reads them (graph outputs: the end). Tensors
+ * whose lifetimes don't overlap share storage; offsets are 64-byte aligned
+ * and assigned largest first into the best-fitting gap.
+ * @param tensor_sizes Size in bytes of each tensor, indexed by tensor id
+ * @param num_tensors Number of tensors
+ * @param layers Layers in execution order
+ * @param num_layers Number of layers
+ * @param plan Output plan
+ * @return Error code
+ */
+neurax_error_t neurax_memory_plan_create(const size_t* tensor_sizes, uint32_t num_tensors,
+                                        const neurax_plan_layer_t* layers, uint32_t num_layers,
+                                        neurax_memory_plan_t** plan);
+
+/**
+ * Destroy a memory plan
+ * @param plan Plan to destroy
+ * @return Error code
+ */
+neurax_error_t neurax_memory_plan_destroy(neurax_memory_plan_t* plan);
+
+/**
+ * Get the planned peak and naive memory of a plan
+ * @param plan Memory plan
+ * @param stats Output statistics
+ * @return Error code
+ */
+neurax_error_t neurax_memory_plan_get_stats(const neurax_memory_plan_t* plan,
+                                           neurax_memory_plan_stats_t* stats);
+
+/**
+ * Get the offset of a tensor inside the planned block
+ * @param plan Memory plan
+ * @param tensor Tensor id
+ * @param offset Output byte offset
+ * @return Error code
+ */
+neurax_error_t neurax_memory_plan_get_offset(const neurax_memory_plan_t* plan, uint32_t tensor,
+                                            size_t* offset);
+
+/**
+ * Create an NHWC tensor over a planned tensor's storage
+ * The block must hold at least peak_bytes, 64-byte aligned (for example from
+ * neurax_workspace_alloc); the tensor borrows it.
+ * @param plan Memory plan
+ * @param block Planned memory block
+ * @param tensor Tensor id
+ * @param width Width dimension
+ * @param height Height dimension
+ * @param channels Number of channels
+ * @param batch_size Batch size
+ * @param data_type Data type
+ * @param output Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_memory_plan_bind(const neurax_memory_plan_t* plan, void* block,
+                                      uint32_t tensor,
+                                      uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_tensor_t** output);
+
 // Layer execution functions
 
 /**
  * Execute 2D convolution
+ *
+ * Quantized operands are dequantized with their parameters (per output channel
+ * for weights with channel scales) and quantized INT8/UINT8 outputs are
+ * requantized with the output tensor's parameters. The bias holds real values.
+ * Convolutions of quantized tensors run on the CPU.
  * @param device Device handle
  * @param input Input tensor
  * @param weights Weight tensor
@@ -231,6 +1092,357 @@ neurax_error_t neurax_activation(neurax_device_t* device,
                                 neurax_activation_t activation,
                                 neurax_tensor_t* output);
 
+/**
+ * Execute dense (fully-connected) layer with fused bias and activation.
+ * Input is [batch, input_features] (any width x height x channels product),
+ * weights are [output_features, input_features] with output features in the
+ * batch dimension, output is [batch, output_features]. FLOAT32, FLOAT16,
+ * BFLOAT16 and quantized INT8 weights are supported.
+ * @param device Device handle
+ * @param input Input tensor
+ * @param weights Weight tensor
+ * @param bias Bias tensor (can be NULL)
+ * @param config Dense configuration
+ * @param output Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_dense(neurax_device_t* device,
+                           const neurax_tensor_t* input,
+                           const neurax_tensor_t* weights,
+                           const neurax_tensor_t* bias,
+                           const neurax_dense_config_t* config,
+                           neurax_tensor_t* output);
+
+/**
+ * Execute elementwise binary operation with broadcasting
+ * Each dimension of a and b must match the output or be 1.
+ * @param device Device handle
+ * @param a First operand
+ * @param b Second operand
+ * @param op Operation
+ * @param output Output tensor (can be the same as a or b)
+ * @return Error code
+ */
+neurax_error_t neurax_eltwise(neurax_device_t* device,
+                             const neurax_tensor_t* a,
+                             const neurax_tensor_t* b,
+                             neurax_eltwise_op_t op,
+                             neurax_tensor_t* output);
+
+/**
+ * Execute per-channel scale and bias: y = x * scale[c] + bias[c]
+ * Scale and bias hold one value per channel or a single value for all channels.
+ * @param device Device handle
+ * @param input Input tensor
+ * @param scale Scale tensor (can be NULL for 1)
+ * @param bias Bias tensor (can be NULL for 0)
+ * @param output Output tensor (can be the same as input)
+ * @return Error code
+ */
+neurax_error_t neurax_scale_bias(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                const neurax_tensor_t* scale,
+                                const neurax_tensor_t* bias,
+                                neurax_tensor_t* output);
+
+/**
+ * Concatenate tensors along the channel dimension
+ * Inputs that are already channel slices of output at their position
+ * (see neurax_tensor_channel_slice) are skipped; others are copied.
+ * @param device Device handle
+ * @param inputs Input tensors in channel order
+ * @param num_inputs Number of inputs
+ * @param output Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_concat(neurax_device_t* device,
+                            const neurax_tensor_t* const* inputs,
+                            uint32_t num_inputs,
+                            neurax_tensor_t* output);
+
+/**
+ * Resize the spatial dimensions of a tensor
+ * The output tensor's width and height select the scale. UINT8 to UINT8
+ * bilinear resizing uses fixed-point arithmetic; exact 2x upsampling and
+ * 0.5x downsampling take dedicated paths.
+ * @param device Device handle
+ * @param input Input tensor
+ * @param mode Interpolation mode
+ * @param output Output tensor (same channels and batch size as input)
+ * @return Error code
+ */
+neurax_error_t neurax_resize(neurax_device_t* device,
+                            const neurax_tensor_t* input,
+                            neurax_resize_mode_t mode,
+                            neurax_tensor_t* output);
+
+/**
+ * Execute softmax over the channels of each pixel
+ * Uses max subtraction for numerical stability. Quantized inputs are
+ * dequantized first; quantized outputs use the output tensor's parameters.
+ * A NaN score makes every probability of its pixel NaN; integer outputs
+ * can't represent that, so the pixel is zeroed and NEURAX_ERROR_INVALID_PARAM
+ * returned. When scores are +inf, those channels share the probability
+ * equally and the rest get zero.
+ * @param device Device handle
+ * @param input Input tensor (class scores in the channel dimension)
+ * @param output Output tensor with the same shape
+ * @return Error code
+ */
+neurax_error_t neurax_softmax(neurax_device_t* device,
+                             const neurax_tensor_t* input,
+                             neurax_tensor_t* output);
+
+/**
+ * Find the highest-scoring channel of each pixel
+ * Ties resolve to the lowest channel index.
+ * @param device Device handle
+ * @param input Input tensor (class scores in the channel dimension)
+ * @param indices Output array of width * height * batch_size indices
+ * @param values Output array of the same length for the scores (can be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_argmax(neurax_device_t* device,
+                            const neurax_tensor_t* input,
+                            uint32_t* indices,
+                            float* values);
+
+/**
+ * Find the k highest-scoring channels of each pixel, best first
+ * Uses a size-k heap instead of sorting all classes.
+ * @param device Device handle
+ * @param input Input tensor (class scores in the channel dimension)
+ * @param k Number of results per pixel (1 to channels)
+ * @param indices Output array of k entries per pixel
+ * @param values Output array of k scores per pixel (can be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_topk(neurax_device_t* device,
+                          const neurax_tensor_t* input,
+                          uint32_t k,
+                          uint32_t* indices,
+                          float* values);
+
+/**
+ * Execute batch normalization: y = gamma * (x - mean) / sqrt(variance + epsilon) + beta
+ * Parameters are reduced to one scale and shift per channel and applied over
+ * the NHWC tensor. Inference graphs should fold batch norm into the preceding
+ * layer with neurax_fold_batch_norm instead.
+ * @param device Device handle
+ * @param input Input tensor
+ * @param params Batch normalization parameters
+ * @param output Output tensor (can be the same as input)
+ * @return Error code
+ */
+neurax_error_t neurax_batch_norm(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                const neurax_batch_norm_params_t* params,
+                                neurax_tensor_t* output);
+
+/**
+ * Fold batch normalization into the preceding convolution or dense layer
+ * Weights are scaled in place per output channel (batch dimension) and the
+ * bias is rewritten. If *bias is NULL a FLOAT32 bias tensor is created and
+ * returned; the layer must then run with use_bias enabled. Weights must be
+ * floating point, so fold before quantizing.
+ * @param weights Weight tensor (OIHW or [output_features, input_features])
+ * @param bias Pointer to bias tensor, may point to NULL
+ * @param params Batch normalization parameters
+ * @return Error code
+ */
+neurax_error_t neurax_fold_batch_norm(neurax_tensor_t* weights,
+                                     neurax_tensor_t** bias,
+                                     const neurax_batch_norm_params_t* params);
+
+// Asynchronous execution functions
+
+/**
+ * Queue a 2D convolution on the device's submission queue
+ * Operations run one at a time in submission order on a per-device worker
+ * thread, so the caller can prepare the next input while the accelerator
+ * works. Tensors are borrowed until the operation completes and must not be
+ * modified or destroyed before then; the configuration is copied.
+ * @param device Device handle
+ * @param input Input tensor
+ * @param weights Weight tensor
+ * @param bias Bias tensor (can be NULL)
+ * @param config Convolution configuration
+ * @param output Output tensor
+ * @param callback Called on the queue thread with the result (can be NULL)
+ * @param user_data Passed to the callback
+ * @param fence Output fence, released with neurax_fence_destroy (can be NULL)
+ * @return Error code (submission only; the operation's result goes to the fence)
+ */
+neurax_error_t neurax_conv2d_async(neurax_device_t* device,
+                                  const neurax_tensor_t* input,
+                                  const neurax_tensor_t* weights,
+                                  const neurax_tensor_t* bias,
+                                  const neurax_conv_config_t* config,
+                                  neurax_tensor_t* output,
+                                  neurax_completion_fn callback,
+                                  void* user_data,
+                                  neurax_fence_t** fence);
+
+/**
+ * Queue a pooling operation on the device's submission queue
+ * @param device Device handle
+ * @param input Input tensor
+ * @param config Pooling configuration
+ * @param output Output tensor
+ * @param callback Called on the queue thread with the result (can be NULL)
+ * @param user_data Passed to the callback
+ * @param fence Output fence (can be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_pooling_async(neurax_device_t* device,
+                                   const neurax_tensor_t* input,
+                                   const neurax_pool_config_t* config,
+                                   neurax_tensor_t* output,
+                                   neurax_completion_fn callback,
+                                   void* user_data,
+                                   neurax_fence_t** fence);
+
+/**
+ * Queue an activation function on the device's submission queue
+ * @param device Device handle
+ * @param input Input tensor
+ * @param activation Activation function type
+ * @param output Output tensor
+ * @param callback Called on the queue thread with the result (can be NULL)
+ * @param user_data Passed to the callback
+ * @param fence Output fence (can be NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_activation_async(neurax_device_t* device,
+                                      const neurax_tensor_t* input,
+                                      neurax_activation_t activation,
+                                      neurax_tensor_t* output,
+                                      neurax_completion_fn callback,
+                                      void* user_data,
+                                      neurax_fence_t** fence);
+
+/**
+ * Block until a fence's operation has completed
+ * The operation's callback has returned by the time this does. Fails with
+ * NEURAX_ERROR_INVALID_PARAM, rather than waiting forever, when called from
+ * a completion callback of the same device while the fence is still pending.
+ * @param fence Fence from an asynchronous submission
+ * @return The operation's error code
+ */
+neurax_error_t neurax_fence_wait(neurax_fence_t* fence);
+
+/**
+ * Check whether a fence's operation has completed, without blocking
+ * @param fence Fence from an asynchronous submission
+ * @param signaled Output completion state
+ * @return Error code
+ */
+neurax_error_t neurax_fence_poll(neurax_fence_t* fence, bool* signaled);
+
+/**
+ * Release a fence
+ * The operation still runs if it hasn't completed yet.
+ * @param fence Fence to release
+ * @return Error code
+ */
+neurax_error_t neurax_fence_destroy(neurax_fence_t* fence);
+
+/**
+ * Block until every operation submitted to the device has completed
+ * Fails with NEURAX_ERROR_INVALID_PARAM when called from one of the
+ * device's completion callbacks, which the queue is waiting on.
+ * neurax_cleanup also finishes queued work before releasing the device.
+ * @param device Device handle
+ * @return Error code
+ */
+neurax_error_t neurax_finish(neurax_device_t* device);
+
+// Command buffer functions
+
+/**
+ * Create a command buffer
+ * Operations recorded into it are encoded as descriptors in DMA memory and
+ * run as one chain: a single doorbell starts them and a single completion
+ * ends them, without register programming between operations. Convolution
+ * and pooling take one descriptor per image, activation one per operation.
+ * @param device Device handle
+ * @param capacity Maximum number of descriptors
+ * @param cmd Output command buffer
+ * @return Error code
+ */
+neurax_error_t neurax_command_buffer_create(neurax_device_t* device, uint32_t capacity,
+                                           neurax_command_buffer_t** cmd);
+
+/**
+ * Destroy a command buffer
+ * @param cmd Command buffer to destroy
+ * @return Error code
+ */
+neurax_error_t neurax_command_buffer_destroy(neurax_command_buffer_t* cmd);
+
+/**
+ * Record a 2D convolution
+ * All tensors must live in DMA memory (neurax_tensor_create_dma) and the
+ * shape must be one the accelerator handles; there is no per-operation CPU
+ * fallback inside a chain. Tensors are borrowed until the buffer is
+ * destroyed or reset.
+ * @param cmd Command buffer
+ * @param input Input tensor
+ * @param weights Weight tensor
+ * @param bias Bias tensor (can be NULL)
+ * @param config Convolution configuration
+ * @param output Output tensor
+ * @return Error code (NEURAX_ERROR_BUFFER_OVERFLOW when the buffer is full)
+ */
+neurax_error_t neurax_command_buffer_conv2d(neurax_command_buffer_t* cmd,
+                                           const neurax_tensor_t* input,
+                                           const neurax_tensor_t* weights,
+                                           const neurax_tensor_t* bias,
+                                           const neurax_conv_config_t* config,
+                                           neurax_tensor_t* output);
+
+/**
+ * Record a pooling operation
+ * @param cmd Command buffer
+ * @param input Input tensor
+ * @param config Pooling configuration
+ * @param output Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_command_buffer_pooling(neurax_command_buffer_t* cmd,
+                                            const neurax_tensor_t* input,
+                                            const neurax_pool_config_t* config,
+                                            neurax_tensor_t* output);
+
+/**
+ * Record an activation function
+ * @param cmd Command buffer
+ * @param input Input tensor
+ * @param activation Activation function type
+ * @param output Output tensor
+ * @return Error code
+ */
+neurax_error_t neurax_command_buffer_activation(neurax_command_buffer_t* cmd,
+                                               const neurax_tensor_t* input,
+                                               neurax_activation_t activation,
+                                               neurax_tensor_t* output);
+
+/**
+ * Forget the recorded operations
+ * @param cmd Command buffer
+ * @return Error code
+ */
+neurax_error_t neurax_command_buffer_reset(neurax_command_buffer_t* cmd);
+
+/**
+ * Run the recorded operations in order and wait for them
+ * A buffer can be submitted any number of times. Without the accelerator
+ * the operations run one by one on the CPU.
+ * @param cmd Command buffer
+ * @return Error code (the first failure stops the chain)
+ */
+neurax_error_t neurax_command_buffer_submit(neurax_command_buffer_t* cmd);
+
 // Model management functions
 
 /**
@@ -262,6 +1474,90 @@ neurax_error_t neurax_model_inference(neurax_model_t* model,
                                      const neurax_tensor_t* input,
                                      neurax_tensor_t* output);
 
+// Quantization functions
+
+/**
+ * Create a calibrator that collects activation statistics in a streaming fashion
+ * @param num_tensors Number of tensors (e.g. layer outputs) to track
+ * @param method Range estimation method
+ * @param calibrator Output calibrator handle
+ * @return Error code
+ */
+neurax_error_t neurax_calibrator_create(uint32_t num_tensors,
+                                       neurax_calib_method_t method,
+                                       neurax_calibrator_t** calibrator);
+
+/**
+ * Set the percentile used by NEURAX_CALIB_PERCENTILE (default 99.99)
+ * @param calibrator Calibrator handle
+ * @param percentile Percentile in (0, 100]
+ * @return Error code
+ */
+neurax_error_t neurax_calibrator_set_percentile(neurax_calibrator_t* calibrator, float percentile);
+
+/**
+ * Accumulate statistics for one calibration batch of a tracked tensor.
+ * Run each representative input through the layer sequence and call this on
+ * every layer output; batches are not retained.
+ * @param calibrator Calibrator handle
+ * @param tensor_index Index of the tracked tensor
+ * @param tensor Observed values
+ * @return Error code
+ */
+neurax_error_t neurax_calibrator_observe(neurax_calibrator_t* calibrator,
+                                        uint32_t tensor_index,
+                                        const neurax_tensor_t* tensor);
+
+/**
+ * Compute per-tensor quantization parameters from the collected statistics
+ * @param calibrator Calibrator handle
+ * @param tensor_index Index of the tracked tensor
+ * @param quant_type NEURAX_DATA_INT8 (symmetric) or NEURAX_DATA_UINT8 (asymmetric)
+ * @param params Output quantization parameters (channel_scales is left NULL)
+ * @return Error code
+ */
+neurax_error_t neurax_calibrator_compute(const neurax_calibrator_t* calibrator,
+                                        uint32_t tensor_index,
+                                        neurax_data_type_t quant_type,
+                                        neurax_quant_params_t* params);
+
+/**
+ * Destroy calibrator and free its statistics
+ * @param calibrator Calibrator handle
+ * @return Error code
+ */
+neurax_error_t neurax_calibrator_destroy(neurax_calibrator_t* calibrator);
+
+/**
+ * Quantize weights to symmetric INT8.
+ * Output channels are the batch dimension ([output_channels, input_channels, kh, kw]).
+ * @param weights Weight tensor of any non-integer type
+ * @param per_channel True for one scale per output channel, false for one per tensor
+ * @param quantized Output INT8 tensor with quant parameters attached
+ * @return Error code
+ */
+neurax_error_t neurax_quantize_weights(const neurax_tensor_t* weights, bool per_channel,
+                                      neurax_tensor_t** quantized);
+
+/**
+ * Quantize a tensor with the given parameters (round to nearest, saturate)
+ * @param input Input tensor
+ * @param params Quantization parameters
+ * @param output INT8 or UINT8 output tensor of the same shape
+ * @return Error code
+ */
+neurax_error_t neurax_quantize_tensor(const neurax_tensor_t* input,
+                                     const neurax_quant_params_t* params,
+                                     neurax_tensor_t* output);
+
+/**
+ * Dequantize a tensor using its attached quantization parameters
+ * @param input Quantized input tensor
+ * @param output Output tensor of the same shape (typically FLOAT32)
+ * @return Error code
+ */
+neurax_error_t neurax_dequantize_tensor(const neurax_tensor_t* input, neurax_tensor_t* output);
+
 // Utility functions
 
 /**
@@ -272,6 +1568,19 @@ neurax_error_t neurax_model_inference(neurax_model_t* model,
  */
 neurax_error_t neurax_get_optimal_config(neurax_device_t* device, neurax_config_t* config);
 
+/**
+ * Get the activation layout a layer's kernels run fastest on
+ * Callers convert once at the boundaries of runs of layers that share a
+ * preferred layout instead of around every layer. Weights are always OIHW.
+ * @param device Device handle
+ * @param layer Layer type
+ * @param layout Output preferred activation layout
+ * @return Error code
+ */
+neurax_error_t neurax_get_preferred_layout(neurax_device_t* device,
+                                          neurax_layer_type_t layer,
+                                          neurax_layout_t* layout);
+
 /**
  * Benchmark layer performance
  * @param device Device handle
@@ -285,6 +1594,36 @@ neurax_error_t neurax_benchmark_layer(neurax_device_t* device,
                                      uint32_t iterations,
                                      double* time_ms);
 
+/**
+ * Convert elements between data types, saturating to the destination range
+ * @param src Source buffer
+ * @param src_type Source data type
+ * @param dst Destination buffer
+ * @param dst_type Destination data type
+ * @param num_elements Number of elements to convert
+ * @return Error code
+ */
+neurax_error_t neurax_convert_data_type(const void* src, neurax_data_type_t src_type,
+                                       void* dst, neurax_data_type_t dst_type,
+                                       size_t num_elements);
+
+/**
+ * Convert elements between data types as dst = src * scale + offset
+ * (e.g. scale = 1/255 to normalize uint8 camera frames to [0, 1])
+ * @param src Source buffer
+ * @param src_type Source data type
+ * @param dst Destination buffer
+ * @param dst_type Destination data type
+ * @param num_elements Number of elements to convert
+ * @param scale Multiplier applied to each source element
+ * @param offset Value added after scaling
+ * @return Error code
+ */
+neurax_error_t neurax_convert_data_type_scaled(const void* src, neurax_data_type_t src_type,
+                                              void* dst, neurax_data_type_t dst_type,
+                                              size_t num_elements,
+                                              float scale, float offset);
+
 /**
  * Print device information
  * @param device Device handle
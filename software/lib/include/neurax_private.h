@@ -11,6 +11,9 @@
 #include "neurax.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <math.h>
 
 // Register addresses (relative to base)
 #define NEURAX_REG_CONTROL      0x00
@@ -21,6 +24,16 @@
 #define NEURAX_REG_DIM_CONFIG   0x14
 #define NEURAX_REG_WEIGHT_ADDR  0x18
 #define NEURAX_REG_BIAS_ADDR    0x1C
+#define NEURAX_REG_INPUT_ADDR   0x20
+#define NEURAX_REG_OUTPUT_ADDR  0x24
+#define NEURAX_REG_CHAN_CONFIG  0x28
+#define NEURAX_REG_CYCLE_COUNT  0x2C    // Cycles taken by the last operation (read-only)
+#define NEURAX_REG_DESC_ADDR    0x30    // Bus address of the first command descriptor
+#define NEURAX_REG_DESC_COUNT   0x34    // Descriptors in the chain
+#define NEURAX_REG_DESC_DONE    0x38    // Descriptors completed by the last chain (read-only)
+
+// Register window, in 32-bit words
+#define NEURAX_NUM_REGS         16
 
 // Control register bits
 #define CTRL_START      (1 << 0)
@@ -29,12 +42,96 @@
 #define CTRL_POOL_EN    (1 << 3)
 #define CTRL_ACT_EN     (1 << 4)
 #define CTRL_DATA_WIDTH (1 << 5)
+#define CTRL_SIGNED     (1 << 6)
+#define CTRL_IRQ_EN     (1 << 7)
+#define CTRL_DESC_EN    (1 << 8)    // START runs the descriptor chain instead of the registers
 
 // Status register bits
 #define STAT_BUSY       (1 << 0)
 #define STAT_DONE       (1 << 1)
 #define STAT_ERROR      (1 << 2)
 
+// Kernel scratch arena of one operation. The thread that takes the first mark owns it;
+// the parallel workers running that operation's jobs bump-allocate from it as well.
+typedef struct neurax_scratch_arena {
+    uint8_t* base;              // Arena storage
+    size_t size;                // Arena capacity in bytes
+    size_t used;                // Bump offset (atomic: workers allocate concurrently)
+    size_t demand;              // Bytes requested since taken, including overflow (atomic)
+    uint32_t depth;             // Nested marks held by the owner
+    bool busy;                  // Taken by an operation
+    pthread_t owner;            // Thread holding the marks
+    neurax_device_t* device;
+    struct neurax_scratch_arena* outer; // Owner's arena for the operation it is nested in
+    struct neurax_scratch_arena* next;  // Next arena of the device
+} neurax_scratch_arena_t;
+
+// Per-device workspace: a bump arena for user allocations, and one scratch arena per
+// operation in flight so operations from different threads never wait for each other
+typedef struct {
+    uint8_t* base;              // User arena storage
+    size_t size;                // User arena capacity in bytes
+    size_t used;                // User bump offset
+    size_t demand;              // User bytes requested since the last reset, including failures
+    size_t high_water;          // Largest user demand; the user arena regrows to this on reset
+    size_t peak;                // Largest number of bytes allocated at once, user and scratch
+    neurax_scratch_arena_t* arenas; // Every scratch arena of the device, busy or idle
+    size_t scratch_high_water;  // Largest scratch demand of one operation; arenas grow to it
+    uint64_t fallback_allocs;   // Scratch requests that overflowed to the heap (atomic)
+    pthread_mutex_t lock;       // Protects the user arena and the arena list
+} neurax_workspace_t;
+
+// Per-device memory accounting, indexed by neurax_memory_category_t. Reference counted:
+// tensors charged to it keep it alive after the device is cleaned up.
+typedef struct neurax_memory {
+    size_t live[NEURAX_MEMORY_CATEGORY_COUNT];
+    size_t peak[NEURAX_MEMORY_CATEGORY_COUNT];
+    uint64_t allocations[NEURAX_MEMORY_CATEGORY_COUNT];
+    uint64_t frees[NEURAX_MEMORY_CATEGORY_COUNT];
+    size_t total_live;
+    size_t total_peak;
+    size_t budget;              // Limit on total_live (0 = unlimited)
+    uint64_t failed_allocs;     // Charges refused by the budget
+    uint32_t refs;              // Device plus each charged tensor
+    struct neurax_memory* next; // Older open device (default accounting list)
+    pthread_mutex_t lock;
+} neurax_memory_t;
+
+// Allocation inside the DMA region, kept in a list sorted by offset
+typedef struct neurax_dma_block {
+    size_t offset;
+    size_t size;
+    struct neurax_dma_block* next;
+} neurax_dma_block_t;
+
+// Per-device DMA region, set up on first use
+typedef struct {
+    neurax_dma_backend_t backend;
+    uint8_t* base;              // CPU mapping of the region
+    size_t size;
+    uint64_t bus_address;       // Accelerator address of base
+    int fd;                     // u-dma-buf node (-1 for anonymous memory)
+    size_t used;
+    size_t peak;
+    uint32_t num_buffers;
+    neurax_dma_block_t* blocks; // Live allocations
+    pthread_mutex_t lock;
+} neurax_dma_t;
+
+// Completion waiting: interrupt node and the spin budget calibration
+typedef struct {
+    int irq_fd;                 // UIO node delivering the completion interrupt (-1 = poll)
+    double ns_per_cycle;        // Observed run time per modelled cycle (0 = not measured yet)
+    uint64_t spin_completions;  // Runs that finished during the busy-spin
+    uint64_t block_completions; // Runs that needed a blocking wait
+} neurax_wait_t;
+
+// Register-level accelerator model (neurax_sim.c)
+typedef struct neurax_sim neurax_sim_t;
+
+// Per-device submission queue for asynchronous operations (neurax_queue.c)
+typedef struct neurax_queue neurax_queue_t;
+
 // Device structure (private)
 struct neurax_device {
     neurax_config_t config;
@@ -44,12 +141,48 @@ struct neurax_device {
     size_t mapped_size;         // Size of mapped memory
     uint32_t* register_base;    // Register base address
     bool hardware_available;    // Hardware availability flag
+    neurax_workspace_t workspace; // Scratch arena for CPU kernels
+    neurax_memory_t* memory;    // Tracked memory and budget
+    neurax_dma_t dma;           // Accelerator-visible buffers
+    neurax_sim_t* sim;          // Simulated accelerator behind the registers (NULL = none)
+    uint32_t registers[NEURAX_NUM_REGS]; // Last value written to each register
+    neurax_wait_t wait;         // Completion interrupt and spin calibration
+    pthread_mutex_t hw_lock;    // Held while programming the accelerator and waiting for it
+    neurax_queue_t* queue;      // Asynchronous submissions
 };
 
 // Internal configuration constants
 #define NEURAX_MAX_TENSOR_DIMS 4
 #define NEURAX_MAX_LAYERS 256
 #define NEURAX_DEFAULT_TIMEOUT_MS 5000
+#define NEURAX_MAX_THREADS 8
+#define NEURAX_TENSOR_ALIGNMENT 64      // Cache line and AVX-512 vector
+#define NEURAX_HUGEPAGE_SIZE (2u << 20) // Transparent huge page size on x86-64 and arm64
+
+// Tensor bookkeeping (private), reached through neurax_tensor_t.state
+struct neurax_tensor_state {
+    bool is_view;                   // Data borrowed from another tensor
+    bool owns_data;                 // Data released on destroy
+    neurax_tensor_deleter_t deleter; // Releases owned data (NULL = library allocator)
+    void* deleter_data;             // User data passed to the deleter
+    uint32_t map_count;             // Outstanding neurax_tensor_map calls
+    bool in_workspace;              // Header and data live in a device workspace
+    uint32_t pool_class;            // Tensor pool size class of the data (0 = not pooled)
+    bool read_only;                 // Data lives in a read-only mapping (tensor files)
+    neurax_memory_t* memory;        // Accounting charged for the data (NULL = untracked)
+    neurax_memory_category_t memory_category; // Accounting category when tracked
+};
+
+// Library-created tensors keep header and state in one allocation
+typedef struct {
+    neurax_tensor_t tensor;
+    struct neurax_tensor_state state;
+} neurax_tensor_block_t;
+
+// Tensors without state (built by the caller) own nothing and are never views
+static inline bool neurax_tensor_is_view(const neurax_tensor_t* tensor) {
+    return tensor->state && tensor->state->is_view;
+}
 
 // Model structure (private)
 struct neurax_model {
@@ -63,15 +196,6 @@ struct neurax_model {
     bool loaded;                // Model load status
 };
 
-// Layer type enumeration
-typedef enum {
-    NEURAX_LAYER_CONV2D = 0,
-    NEURAX_LAYER_POOLING = 1,
-    NEURAX_LAYER_ACTIVATION = 2,
-    NEURAX_LAYER_DENSE = 3,
-    NEURAX_LAYER_BATCH_NORM = 4
-} neurax_layer_type_t;
-
 // Generic layer configuration (for future model-based API)
 // NOTE: Currently unused - planned for future model loading functionality
 typedef struct {
@@ -102,12 +226,20 @@ neurax_error_t neurax_hw_activation(neurax_device_t* device,
                                    neurax_tensor_t* output);
 
 // CPU emulation functions
-neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
+neurax_error_t neurax_cpu_conv2d(neurax_device_t* device,
+                                const neurax_tensor_t* input,
                                 const neurax_tensor_t* weights,
                                 const neurax_tensor_t* bias,
                                 const neurax_conv_config_t* config,
                                 neurax_tensor_t* output);
 
+// Channel block the CPU conv kernel vectorizes across: one vector register of fp32
+#if defined(__AVX512F__)
+#define NEURAX_CONV_PREFERRED_LAYOUT NEURAX_LAYOUT_NCHW16C
+#else
+#define NEURAX_CONV_PREFERRED_LAYOUT NEURAX_LAYOUT_NCHW8C
+#endif
+
 neurax_error_t neurax_cpu_pooling(const neurax_tensor_t* input,
                                  const neurax_pool_config_t* config,
                                  neurax_tensor_t* output);
@@ -116,19 +248,125 @@ neurax_error_t neurax_cpu_activation(const neurax_tensor_t* input,
                                     neurax_activation_t activation,
                                     neurax_tensor_t* output);
 
+neurax_error_t neurax_cpu_dense(neurax_device_t* device,
+                               const neurax_tensor_t* input,
+                               const neurax_tensor_t* weights,
+                               const neurax_tensor_t* bias,
+                               const neurax_dense_config_t* config,
+                               neurax_tensor_t* output);
+
+neurax_error_t neurax_cpu_channel_affine(const neurax_tensor_t* input,
+                                        const float* scale,
+                                        const float* shift,
+                                        neurax_tensor_t* output);
+
+neurax_error_t neurax_cpu_eltwise(const neurax_tensor_t* a,
+                                 const neurax_tensor_t* b,
+                                 neurax_eltwise_op_t op,
+                                 neurax_tensor_t* output);
+
+neurax_error_t neurax_cpu_resize(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                neurax_resize_mode_t mode,
+                                neurax_tensor_t* output);
+
+neurax_error_t neurax_cpu_batch_norm(neurax_device_t* device,
+                                    const neurax_tensor_t* input,
+                                    const neurax_batch_norm_params_t* params,
+                                    neurax_tensor_t* output);
+
 // Utility functions
 neurax_error_t neurax_validate_tensor(const neurax_tensor_t* tensor);
+neurax_error_t neurax_validate_output(const neurax_tensor_t* tensor);
 neurax_error_t neurax_validate_conv_config(const neurax_conv_config_t* config);
 neurax_error_t neurax_validate_pool_config(const neurax_pool_config_t* config);
+neurax_error_t neurax_validate_dense_config(const neurax_dense_config_t* config);
+neurax_error_t neurax_validate_contiguous(const neurax_tensor_t* tensor);
+neurax_error_t neurax_validate_layout(const neurax_tensor_t* tensor, bool allow_blocked);
+
+// Strided channel access: convert `count` channels starting at a byte offset to or from fp32
+void neurax_load_channels(const neurax_tensor_t* tensor, size_t byte_offset,
+                          uint32_t count, float* dst);
+void neurax_store_channels(neurax_tensor_t* tensor, size_t byte_offset,
+                           uint32_t count, const float* src);
 
 // Memory management functions
 neurax_error_t neurax_alloc_aligned(size_t size, size_t alignment, void** ptr);
 neurax_error_t neurax_free_aligned(void* ptr);
-
-// Data conversion functions
-neurax_error_t neurax_convert_data_type(const void* src, neurax_data_type_t src_type,
-                                       void* dst, neurax_data_type_t dst_type,
-                                       size_t num_elements);
+neurax_error_t neurax_alloc_tensor_data(size_t size, size_t alignment, uint32_t flags, void** ptr);
+neurax_tensor_t* neurax_tensor_alloc_block(void);
+neurax_error_t neurax_tensor_compute_size(uint32_t width, uint32_t height,
+                                          uint32_t channels, uint32_t batch_size,
+                                          neurax_data_type_t data_type,
+                                          neurax_layout_t layout,
+                                          size_t* size);
+
+// Tensor pool: pooled buffers are tagged with their size class (0 = not served)
+void* neurax_pool_alloc(size_t size, uint32_t* pool_class);
+void neurax_pool_release(void* ptr, uint32_t pool_class);
+void neurax_pool_attach(const neurax_config_t* config);
+void neurax_pool_detach(void);
+
+// Device workspace and kernel scratch. An operation takes a mark, allocates scratch
+// (from its own thread or the parallel workers it runs) and releases back to the mark
+// when done; device may be NULL. The outermost mark of a thread takes a scratch arena
+// of its own, so operations on one device may run concurrently from several threads.
+// Scratch must be freed before the operation's release. neurax_parallel_for passes the
+// caller's scratch context to the workers running its ranges.
+neurax_error_t neurax_workspace_init(neurax_workspace_t* ws);
+void neurax_workspace_destroy(neurax_device_t* device);
+void* neurax_scratch_alloc(neurax_device_t* device, size_t size);
+void neurax_scratch_free(neurax_device_t* device, void* ptr);
+size_t neurax_scratch_mark(neurax_device_t* device);
+void neurax_scratch_release(neurax_device_t* device, size_t mark);
+void* neurax_scratch_context(void);
+void neurax_scratch_set_context(void* context);
+
+// Memory accounting: charge before allocating, uncharge after freeing. Charging fails
+// with NEURAX_ERROR_MEMORY_ALLOCATION when it would exceed the budget; device or
+// memory may be NULL. A new accounting becomes the default for tensors created
+// without a device until its device is cleaned up (retired).
+neurax_memory_t* neurax_memory_create(size_t budget);
+void neurax_memory_retire(neurax_memory_t* memory);
+neurax_memory_t* neurax_memory_retain(neurax_memory_t* memory);
+void neurax_memory_release(neurax_memory_t* memory);
+neurax_memory_t* neurax_memory_default(void);
+neurax_error_t neurax_memory_charge_to(neurax_memory_t* memory, neurax_memory_category_t category,
+                                       size_t size);
+void neurax_memory_uncharge_from(neurax_memory_t* memory, neurax_memory_category_t category,
+                                 size_t size);
+neurax_error_t neurax_memory_charge(neurax_device_t* device, neurax_memory_category_t category,
+                                    size_t size);
+void neurax_memory_uncharge(neurax_device_t* device, neurax_memory_category_t category,
+                            size_t size);
+
+// Tensor creation charged to `memory` under `category` (memory NULL = untracked)
+neurax_error_t neurax_tensor_create_charged(uint32_t width, uint32_t height,
+                                            uint32_t channels, uint32_t batch_size,
+                                            neurax_data_type_t data_type,
+                                            neurax_layout_t layout,
+                                            uint32_t flags, size_t alignment,
+                                            neurax_memory_t* memory,
+                                            neurax_memory_category_t category,
+                                            neurax_tensor_t** tensor);
+
+// Weights the library derives (quantized copies, folded biases), charged by default
+neurax_error_t neurax_tensor_create_weights(uint32_t width, uint32_t height,
+                                            uint32_t channels, uint32_t batch_size,
+                                            neurax_data_type_t data_type,
+                                            neurax_layout_t layout,
+                                            neurax_tensor_t** tensor);
+
+// DMA region lifetime, and lookup of the CPU pointer behind a bus address range
+neurax_error_t neurax_dma_init(neurax_dma_t* dma);
+void neurax_dma_destroy(neurax_dma_t* dma);
+void* neurax_dma_resolve(neurax_device_t* device, uint64_t bus_address, size_t size);
+
+// Parallel execution helpers
+typedef void (*neurax_parallel_fn)(void* ctx, size_t begin, size_t end);
+uint32_t neurax_get_num_threads(void);
+void neurax_parallel_for(size_t count, size_t grain, size_t min_per_thread,
+                         neurax_parallel_fn fn, void* ctx);
 
 // Helper functions for tensor operations
 float neurax_get_tensor_value(const neurax_tensor_t* tensor, uint32_t batch, uint32_t y, uint32_t x, uint32_t c);
@@ -138,11 +376,77 @@ void neurax_set_tensor_value(neurax_tensor_t* tensor, uint32_t batch, uint32_t y
 float neurax_get_tensor_element(const neurax_tensor_t* tensor, size_t index);
 void neurax_set_tensor_element(neurax_tensor_t* tensor, size_t index, float value);
 float neurax_apply_activation(float value, neurax_activation_t activation);
+void neurax_apply_activation_block(float* values, size_t count, neurax_activation_t activation);
 
 // Hardware register access
 void neurax_write_reg(neurax_device_t* device, uint32_t offset, uint32_t value);
 uint32_t neurax_read_reg(neurax_device_t* device, uint32_t offset);
-neurax_error_t neurax_wait_for_completion(neurax_device_t* device, uint32_t timeout_ms);
+neurax_error_t neurax_wait_for_completion(neurax_device_t* device, uint64_t spin_ns,
+                                          uint32_t timeout_ms);
+void neurax_irq_arm(neurax_device_t* device);
+uint64_t neurax_time_ns(void);
+
+// Hardware transfer engine. The accelerator reads and writes dense NHWC buffers of 8 or
+// 16-bit integers in DMA memory; tensors elsewhere are staged through DMA buffers.
+typedef struct {
+    uint8_t* data;              // CPU view of the DMA buffer
+    uint64_t bus_address;       // Accelerator address of the buffer
+    size_t size;
+    bool staged;                // Temporary copy of a tensor outside DMA memory
+} neurax_hw_buffer_t;
+
+bool neurax_hw_supports_tensor(const neurax_tensor_t* tensor, neurax_data_type_t data_type);
+neurax_error_t neurax_hw_buffer_acquire(neurax_device_t* device, const neurax_tensor_t* tensor,
+                                        bool copy_in, neurax_hw_buffer_t* buffer);
+void neurax_hw_buffer_release(neurax_device_t* device, neurax_hw_buffer_t* buffer,
+                              neurax_tensor_t* copy_out);
+neurax_error_t neurax_hw_run(neurax_device_t* device, uint32_t control);
+neurax_error_t neurax_hw_execute(neurax_device_t* device, uint32_t control,
+                                 uint64_t predicted_cycles);
+
+// Registers that program one accelerator run
+typedef struct {
+    uint32_t control;
+    uint32_t conv_config;
+    uint32_t pool_config;
+    uint32_t act_config;
+    uint32_t dim_config;
+    uint32_t chan_config;
+} neurax_hw_program_t;
+
+// Command descriptor: the registers of one run, fetched by the accelerator from DMA memory.
+// A chain of them runs in order after one START with CTRL_DESC_EN and completes once.
+typedef struct {
+    neurax_hw_program_t program; // Unit enables, data width and configuration (START ignored)
+    uint32_t input_addr;
+    uint32_t output_addr;
+    uint32_t weight_addr;
+    uint32_t bias_addr;
+    uint32_t reserved[6];       // Pads the descriptor to 64 bytes
+} neurax_hw_descriptor_t;
+
+// Cycle-approximate cost of one run, shared by neurax_perf_estimate and the simulator.
+// Returns NEURAX_ERROR_INVALID_PARAM when the registers don't describe a valid operation.
+neurax_error_t neurax_perf_model_run(const neurax_config_t* config,
+                                     const neurax_hw_program_t* program,
+                                     neurax_perf_estimate_t* estimate);
+void neurax_perf_accumulate(const neurax_config_t* config, neurax_perf_estimate_t* total,
+                            const neurax_perf_estimate_t* estimate, uint32_t count);
+double neurax_perf_cycle_ns(const neurax_config_t* config);
+bool neurax_hw_encode_layer(const neurax_config_t* config, const neurax_perf_layer_t* layer,
+                            neurax_hw_program_t* program, uint32_t* runs);
+
+// Submission queue lifetime; destroying it finishes the queued operations
+neurax_queue_t* neurax_queue_create(neurax_device_t* device);
+void neurax_queue_destroy(neurax_queue_t* queue);
+bool neurax_queue_on_worker(neurax_queue_t* queue);
+
+// Simulated accelerator: register reads and writes are routed here when device->sim is set
+bool neurax_sim_requested(const neurax_config_t* config);
+neurax_sim_t* neurax_sim_create(neurax_device_t* device);
+void neurax_sim_destroy(neurax_sim_t* sim);
+void neurax_sim_write(neurax_sim_t* sim, uint32_t offset, uint32_t value);
+uint32_t neurax_sim_read(neurax_sim_t* sim, uint32_t offset);
 
 // Performance profiling
 typedef struct {
@@ -192,6 +496,14 @@ typedef union {
     } bits;
 } neurax_dim_config_reg_t;
 
+typedef union {
+    uint32_t raw;
+    struct {
+        uint32_t input_channels  : 16; // Bits 15:0  - Channels per input pixel
+        uint32_t output_channels : 16; // Bits 31:16 - Channels per output pixel
+    } bits;
+} neurax_chan_config_reg_t;
+
 typedef union {
     uint32_t raw;
     struct {
@@ -209,7 +521,10 @@ typedef union {
         uint32_t pool_en        : 1;  // Bit 3      - Pooling enable
         uint32_t act_en         : 1;  // Bit 4      - Activation enable
         uint32_t data_width     : 1;  // Bit 5      - Data width (0=8bit, 1=16bit)
-        uint32_t reserved       : 26; // Bits 31:6  - Reserved
+        uint32_t is_signed      : 1;  // Bit 6      - Signed elements
+        uint32_t irq_en         : 1;  // Bit 7      - Interrupt on completion
+        uint32_t desc_en        : 1;  // Bit 8      - Run the descriptor chain
+        uint32_t reserved       : 23; // Bits 31:9  - Reserved
     } bits;
 } neurax_control_reg_t;
 
@@ -221,6 +536,8 @@ static inline size_t neurax_get_element_size(neurax_data_type_t type) {
             return 1;
         case NEURAX_DATA_UINT16:
         case NEURAX_DATA_INT16:
+        case NEURAX_DATA_FLOAT16:
+        case NEURAX_DATA_BFLOAT16:
             return 2;
         case NEURAX_DATA_FLOAT32:
             return 4;
@@ -233,6 +550,241 @@ static inline bool neurax_is_signed_type(neurax_data_type_t type) {
     return (type == NEURAX_DATA_INT8 || type == NEURAX_DATA_INT16);
 }
 
+// Channels per block of a blocked layout (0 for unblocked layouts)
+static inline uint32_t neurax_layout_block_size(neurax_layout_t layout) {
+    switch (layout) {
+        case NEURAX_LAYOUT_NCHW8C: return 8;
+        case NEURAX_LAYOUT_NCHW16C: return 16;
+        default: return 0;
+    }
+}
+
+// Byte strides of a tensor, filling in dense NHWC when none are set
+static inline void neurax_tensor_get_strides(const neurax_tensor_t* tensor, size_t strides[4]) {
+    if (tensor->strides[NEURAX_DIM_CHANNEL] != 0) {
+        for (int d = 0; d < 4; d++) {
+            strides[d] = tensor->strides[d];
+        }
+        return;
+    }
+
+    strides[NEURAX_DIM_CHANNEL] = neurax_get_element_size(tensor->data_type);
+    strides[NEURAX_DIM_WIDTH] = strides[NEURAX_DIM_CHANNEL] * tensor->channels;
+    strides[NEURAX_DIM_HEIGHT] = strides[NEURAX_DIM_WIDTH] * tensor->width;
+    strides[NEURAX_DIM_BATCH] = strides[NEURAX_DIM_HEIGHT] * tensor->height;
+}
+
+// Dense NHWC storage, so the tensor can be addressed as a flat array
+static inline bool neurax_tensor_is_contiguous(const neurax_tensor_t* tensor) {
+    if (neurax_layout_block_size(tensor->layout) != 0) {
+        return false;
+    }
+    if (tensor->strides[NEURAX_DIM_CHANNEL] == 0) {
+        return true;
+    }
+
+    // Strides of size-1 dimensions never matter
+    size_t expected = neurax_get_element_size(tensor->data_type);
+    const uint32_t dims[4] = {tensor->channels, tensor->width, tensor->height, tensor->batch_size};
+    for (int d = 0; d < 4; d++) {
+        if (dims[d] > 1 && tensor->strides[d] != expected) {
+            return false;
+        }
+        expected *= dims[d];
+    }
+    return true;
+}
+
+// Channels of each pixel are adjacent in memory
+static inline bool neurax_tensor_channels_packed(const neurax_tensor_t* tensor) {
+    if (neurax_layout_block_size(tensor->layout) != 0) {
+        return tensor->channels == 1;
+    }
+    return tensor->strides[NEURAX_DIM_CHANNEL] == 0 || tensor->channels == 1 ||
+           tensor->strides[NEURAX_DIM_CHANNEL] == neurax_get_element_size(tensor->data_type);
+}
+
+// a * b in size_t; false when the product does not fit
+static inline bool neurax_size_mul(size_t a, size_t b, size_t* result) {
+    if (b != 0 && a > SIZE_MAX / b) {
+        return false;
+    }
+    *result = a * b;
+    return true;
+}
+
+static inline size_t neurax_tensor_pixel_count(const neurax_tensor_t* tensor) {
+    return (size_t)tensor->width * tensor->height * tensor->batch_size;
+}
+
+// Byte offset of element (n, y, x, c) from tensor->data
+static inline size_t neurax_tensor_byte_offset(const neurax_tensor_t* tensor, uint32_t n,
+                                               uint32_t y, uint32_t x, uint32_t c) {
+    if (tensor->strides[NEURAX_DIM_CHANNEL] == 0) {
+        uint32_t block = neurax_layout_block_size(tensor->layout);
+        if (block != 0) {
+            size_t blocks = (tensor->channels + block - 1) / block;
+            return (((((size_t)n * blocks + c / block) * tensor->height + y) * tensor->width + x) *
+                    block + c % block) * neurax_get_element_size(tensor->data_type);
+        }
+        return ((((size_t)n * tensor->height + y) * tensor->width + x) * tensor->channels + c) *
+               neurax_get_element_size(tensor->data_type);
+    }
+
+    return n * tensor->strides[NEURAX_DIM_BATCH] + y * tensor->strides[NEURAX_DIM_HEIGHT] +
+           x * tensor->strides[NEURAX_DIM_WIDTH] + c * tensor->strides[NEURAX_DIM_CHANNEL];
+}
+
+// Byte offset of the first channel of pixel number `pixel` in (n, y, x) order
+static inline size_t neurax_tensor_pixel_offset(const neurax_tensor_t* tensor, size_t pixel) {
+    if (tensor->strides[NEURAX_DIM_CHANNEL] == 0) {
+        return pixel * tensor->channels * neurax_get_element_size(tensor->data_type);
+    }
+
+    size_t x = pixel % tensor->width;
+    size_t row = pixel / tensor->width;
+    return (row / tensor->height) * tensor->strides[NEURAX_DIM_BATCH] +
+           (row % tensor->height) * tensor->strides[NEURAX_DIM_HEIGHT] +
+           x * tensor->strides[NEURAX_DIM_WIDTH];
+}
+
+static inline bool neurax_is_half_type(neurax_data_type_t type) {
+    return (type == NEURAX_DATA_FLOAT16 || type == NEURAX_DATA_BFLOAT16);
+}
+
+// Half precision conversion (software, round-to-nearest-even)
+typedef union {
+    float f;
+    uint32_t u;
+} neurax_fp32_bits_t;
+
+static inline float neurax_fp16_to_fp32(uint16_t half) {
+    const uint32_t w = (uint32_t)half << 16;
+    const uint32_t sign = w & 0x80000000u;
+    const uint32_t two_w = w + w;
+    neurax_fp32_bits_t normalized, denormalized, result;
+
+    // Normal, inf and NaN: rebias the exponent by scaling with 2^-112
+    normalized.u = (two_w >> 4) + (0xE0u << 23);
+    normalized.f *= 0x1.0p-112f;
+
+    // Subnormal: build 0.5 + m * 2^-24 with a magic exponent and subtract 0.5
+    denormalized.u = (two_w >> 17) | (126u << 23);
+    denormalized.f -= 0.5f;
+
+    result.u = sign | (two_w < (1u << 27) ? denormalized.u : normalized.u);
+    return result.f;
+}
+
+static inline uint16_t neurax_fp32_to_fp16(float value) {
+    neurax_fp32_bits_t in, base, bias_bits;
+    in.f = value;
+    const uint32_t shl1_w = in.u + in.u;
+    const uint32_t sign = in.u & 0x80000000u;
+
+    // Scale up then down so the FPU performs the round-to-nearest-even for us
+    base.u = in.u & 0x7FFFFFFFu;
+    base.f = (base.f * 0x1.0p+112f) * 0x1.0p-110f;
+
+    uint32_t bias = shl1_w & 0xFF000000u;
+    if (bias < 0x71000000u) {
+        bias = 0x71000000u;
+    }
+    bias_bits.u = (bias >> 1) + 0x07800000u;
+    base.f = bias_bits.f + base.f;
+
+    const uint32_t exp_bits = (base.u >> 13) & 0x00007C00u;
+    const uint32_t mantissa_bits = base.u & 0x00000FFFu;
+    const uint32_t nonsign = exp_bits + mantissa_bits;
+    return (uint16_t)((sign >> 16) | (shl1_w > 0xFF000000u ? 0x7E00u : nonsign));
+}
+
+static inline float neurax_bf16_to_fp32(uint16_t half) {
+    neurax_fp32_bits_t bits;
+    bits.u = (uint32_t)half << 16;
+    return bits.f;
+}
+
+static inline uint16_t neurax_fp32_to_bf16(float value) {
+    neurax_fp32_bits_t bits;
+    bits.f = value;
+    if ((bits.u & 0x7FFFFFFFu) > 0x7F800000u) {
+        return (uint16_t)((bits.u >> 16) | 0x0040u); // Keep NaN quiet
+    }
+    if ((bits.u & 0x7F800000u) == 0) {
+        return (uint16_t)((bits.u >> 16) & 0x8000u); // Denormals flush to zero, as in AVX-512 BF16
+    }
+    return (uint16_t)((bits.u + 0x7FFFu + ((bits.u >> 16) & 1u)) >> 16);
+}
+
+// Read one element of any data type as float
+static inline float neurax_load_element(const void* data, neurax_data_type_t type, size_t index) {
+    switch (type) {
+        case NEURAX_DATA_UINT8:
+            return (float)((const uint8_t*)data)[index];
+        case NEURAX_DATA_INT8:
+            return (float)((const int8_t*)data)[index];
+        case NEURAX_DATA_UINT16:
+            return (float)((const uint16_t*)data)[index];
+        case NEURAX_DATA_INT16:
+            return (float)((const int16_t*)data)[index];
+        case NEURAX_DATA_FLOAT32:
+            return ((const float*)data)[index];
+        case NEURAX_DATA_FLOAT16:
+            return neurax_fp16_to_fp32(((const uint16_t*)data)[index]);
+        case NEURAX_DATA_BFLOAT16:
+            return neurax_bf16_to_fp32(((const uint16_t*)data)[index]);
+        default:
+            return 0.0f;
+    }
+}
+
+// Write one float element into any data type, saturating integer types
+// (NaN saturates to the maximum, as the original fmax/fmin clamp did)
+static inline void neurax_store_element(void* data, neurax_data_type_t type, size_t index, float value) {
+    switch (type) {
+        case NEURAX_DATA_UINT8:
+            value = value < 255.0f ? value : 255.0f;
+            ((uint8_t*)data)[index] = (uint8_t)(value > 0.0f ? value : 0.0f);
+            break;
+        case NEURAX_DATA_INT8:
+            value = value < 127.0f ? value : 127.0f;
+            ((int8_t*)data)[index] = (int8_t)(value > -128.0f ? value : -128.0f);
+            break;
+        case NEURAX_DATA_UINT16:
+            value = value < 65535.0f ? value : 65535.0f;
+            ((uint16_t*)data)[index] = (uint16_t)(value > 0.0f ? value : 0.0f);
+            break;
+        case NEURAX_DATA_INT16:
+            value = value < 32767.0f ? value : 32767.0f;
+            ((int16_t*)data)[index] = (int16_t)(value > -32768.0f ? value : -32768.0f);
+            break;
+        case NEURAX_DATA_FLOAT32:
+            ((float*)data)[index] = value;
+            break;
+        case NEURAX_DATA_FLOAT16:
+            ((uint16_t*)data)[index] = neurax_fp32_to_fp16(value);
+            break;
+        case NEURAX_DATA_BFLOAT16:
+            ((uint16_t*)data)[index] = neurax_fp32_to_bf16(value);
+            break;
+        default:
+            break;
+    }
+}
+
+// Tensors with quantization parameters attached (see neurax_quant_params_t)
+static inline bool neurax_tensor_is_quantized(const neurax_tensor_t* tensor) {
+    return tensor->quant.scale > 0.0f || tensor->quant.channel_scales != NULL;
+}
+
+// Quantize one real value: round(value / scale) + zero_point, before saturation.
+// Rounding comes first so values whose sign differs from value + zero_point
+// still round to the nearest step.
+static inline float neurax_quantize_value(float value, float inv_scale, int32_t zero_point) {
+    return roundf(value * inv_scale) + (float)zero_point;
+}
+
 // Hardware register helper functions
 static inline void neurax_write_conv_config(neurax_device_t* device, const neurax_conv_config_reg_t* config) {
     NEURAX_WRITE_REG(device, NEURAX_REG_CONV_CONFIG, config->raw);
@@ -0,0 +1,206 @@
+/*
+ * NEURAX Batch Normalization Implementation
+ * Per-channel scale/shift kernel and folding into preceding layer weights
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Validate one per-channel parameter tensor (NULL allowed for optional ones)
+static neurax_error_t neurax_validate_bn_param(const neurax_tensor_t* param, uint32_t channels,
+                                               bool required) {
+    if (!param) {
+        return required ? NEURAX_ERROR_INVALID_PARAM : NEURAX_SUCCESS;
+    }
+
+    neurax_error_t error = neurax_validate_tensor(param);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (neurax_tensor_total_elements(param) < channels) {
+        NEURAX_LOG_ERROR("Batch norm parameter has fewer than %u channels", channels);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    return NEURAX_SUCCESS;
+}
+
+static neurax_error_t neurax_validate_bn_params(const neurax_batch_norm_params_t* params,
+                                               uint32_t channels) {
+    if (!params || !(params->epsilon >= 0.0f)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_validate_bn_param(params->mean, channels, true);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_bn_param(params->variance, channels, true);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_bn_param(params->gamma, channels, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    return neurax_validate_bn_param(params->beta, channels, false);
+}
+
+// Reduce BN to y = x * scale[c] + shift[c]
+static void neurax_batch_norm_coefficients(const neurax_batch_norm_params_t* params,
+                                           uint32_t channels, float* scale, float* shift) {
+    for (uint32_t c = 0; c < channels; c++) {
+        float gamma = params->gamma ? neurax_get_bias_value(params->gamma, c) : 1.0f;
+        float beta = params->beta ? neurax_get_bias_value(params->beta, c) : 0.0f;
+        float mean = neurax_get_bias_value(params->mean, c);
+        float variance = neurax_get_bias_value(params->variance, c);
+
+        scale[c] = gamma / sqrtf(variance + params->epsilon);
+        shift[c] = beta - mean * scale[c];
+    }
+}
+
+// Execute batch normalization
+neurax_error_t neurax_batch_norm(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                const neurax_batch_norm_params_t* params,
+                                neurax_tensor_t* output) {
+
+    if (!device || !input || !params || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Validate inputs
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(input, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_bn_params(params, input->channels);
+    if (error != NEURAX_SUCCESS) return error;
+
+    // Check tensor compatibility
+    if (input->width != output->width || input->height != output->height ||
+        input->channels != output->channels || input->batch_size != output->batch_size) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing batch norm: %u channels", input->channels);
+
+    // The accelerator has no normalization block, so batch norm always runs on the CPU
+    return neurax_cpu_batch_norm(device, input, params, output);
+}
+
+// CPU implementation
+neurax_error_t neurax_cpu_batch_norm(neurax_device_t* device,
+                                    const neurax_tensor_t* input,
+                                    const neurax_batch_norm_params_t* params,
+                                    neurax_tensor_t* output) {
+
+    NEURAX_LOG_DEBUG("Using CPU implementation for batch norm");
+
+    uint32_t channels = input->channels;
+    size_t mark = neurax_scratch_mark(device);
+    float* coefficients = neurax_scratch_alloc(device, sizeof(float) * 2 * channels);
+    if (!coefficients) {
+        neurax_scratch_release(device, mark);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    float* scale = coefficients;
+    float* shift = coefficients + channels;
+    neurax_batch_norm_coefficients(params, channels, scale, shift);
+
+    neurax_error_t error = neurax_cpu_channel_affine(input, scale, shift, output);
+
+    neurax_scratch_free(device, coefficients);
+    neurax_scratch_release(device, mark);
+    return error;
+}
+
+// Fold batch norm into the weights and bias of the preceding conv or dense layer
+neurax_error_t neurax_fold_batch_norm(neurax_tensor_t* weights,
+                                     neurax_tensor_t** bias,
+                                     const neurax_batch_norm_params_t* params) {
+    if (!bias) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_validate_output(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    // Integer weights would need requantization; fold before quantizing instead
+    if (weights->data_type != NEURAX_DATA_FLOAT32 && !neurax_is_half_type(weights->data_type)) {
+        NEURAX_LOG_ERROR("Batch norm folding requires floating-point weights");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Output channels are the batch dimension of the weight tensor
+    uint32_t out_channels = weights->batch_size;
+    error = neurax_validate_bn_params(params, out_channels);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (*bias) {
+        error = neurax_validate_bn_param(*bias, out_channels, true);
+        if (error != NEURAX_SUCCESS) return error;
+
+        error = neurax_validate_output(*bias);
+        if (error != NEURAX_SUCCESS) return error;
+    }
+
+    float* coefficients = malloc(sizeof(float) * 2 * out_channels);
+    if (!coefficients) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    float* scale = coefficients;
+    float* shift = coefficients + out_channels;
+    neurax_batch_norm_coefficients(params, out_channels, scale, shift);
+
+    neurax_tensor_t* new_bias = NULL;
+    if (!*bias) {
+        error = neurax_tensor_create_weights(out_channels, 1, 1, 1, NEURAX_DATA_FLOAT32,
+                                             NEURAX_LAYOUT_NHWC, &new_bias);
+        if (error != NEURAX_SUCCESS) {
+            free(coefficients);
+            return error;
+        }
+    }
+
+    // w'[o] = w[o] * scale[o]
+    size_t channel_elements = neurax_tensor_total_elements(weights) / out_channels;
+    size_t element_size = neurax_get_element_size(weights->data_type);
+    for (uint32_t o = 0; o < out_channels; o++) {
+        uint8_t* channel = (uint8_t*)weights->data + o * channel_elements * element_size;
+        neurax_convert_data_type_scaled(channel, weights->data_type, channel, weights->data_type,
+                                        channel_elements, scale[o], 0.0f);
+    }
+
+    // b'[o] = b[o] * scale[o] + shift[o]
+    neurax_tensor_t* target = new_bias ? new_bias : *bias;
+    for (uint32_t o = 0; o < out_channels; o++) {
+        float b = new_bias ? 0.0f : neurax_get_bias_value(*bias, o);
+        neurax_set_tensor_element(target, o, b * scale[o] + shift[o]);
+    }
+
+    if (new_bias) {
+        *bias = new_bias;
+    }
+
+    free(coefficients);
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,363 @@
+/*
+ * NEURAX Command Buffers
+ * Layer chains recorded as descriptors in DMA memory and run with one doorbell
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Recorded operation, replayed through the layer functions when there is no accelerator
+typedef struct {
+    neurax_layer_type_t type;
+    const neurax_tensor_t* input;
+    const neurax_tensor_t* weights;
+    const neurax_tensor_t* bias;
+    neurax_tensor_t* output;
+    union {
+        neurax_conv_config_t conv;
+        neurax_pool_config_t pool;
+        neurax_activation_t activation;
+    } params;
+} neurax_command_t;
+
+struct neurax_command_buffer {
+    neurax_device_t* device;
+    neurax_hw_descriptor_t* descriptors; // Descriptor chain in DMA memory
+    uint64_t bus_address;       // Accelerator address of the chain
+    uint32_t capacity;          // Descriptors (and commands) the buffer holds
+    uint32_t num_descriptors;
+    neurax_command_t* commands;
+    uint32_t num_commands;
+    uint64_t predicted_cycles;  // Modelled cycles of the whole chain
+};
+
+// Accelerator address of a tensor, which must lie in DMA memory below 4 GiB
+static neurax_error_t neurax_command_address(neurax_device_t* device,
+                                             const neurax_tensor_t* tensor,
+                                             uint32_t* address) {
+    size_t size = neurax_tensor_total_elements(tensor) * neurax_get_element_size(tensor->data_type);
+    uint64_t bus;
+
+    if (neurax_dma_get_address(device, tensor->data, &bus) != NEURAX_SUCCESS ||
+        !neurax_dma_resolve(device, bus, size)) {
+        NEURAX_LOG_ERROR("Command buffer tensors must live in DMA memory");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (bus + size > (1ull << 32)) {
+        NEURAX_LOG_ERROR("Tensor at 0x%llx is beyond the 32-bit address registers",
+                         (unsigned long long)bus);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *address = (uint32_t)bus;
+    return NEURAX_SUCCESS;
+}
+
+// Encode a validated command into one descriptor per run
+static neurax_error_t neurax_command_append(neurax_command_buffer_t* cmd,
+                                            const neurax_command_t* command,
+                                            const neurax_perf_layer_t* layer) {
+    neurax_device_t* device = cmd->device;
+    neurax_hw_program_t program;
+    neurax_perf_estimate_t estimate;
+    uint32_t runs;
+
+    if (!neurax_hw_encode_layer(&device->config, layer, &program, &runs) ||
+        neurax_perf_model_run(&device->config, &program, &estimate) != NEURAX_SUCCESS) {
+        NEURAX_LOG_ERROR("Operation not supported by the accelerator");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (cmd->num_commands >= cmd->capacity || runs > cmd->capacity - cmd->num_descriptors) {
+        NEURAX_LOG_ERROR("Command buffer full (%u descriptors)", cmd->capacity);
+        return NEURAX_ERROR_BUFFER_OVERFLOW;
+    }
+
+    uint32_t input_addr, output_addr, weight_addr = 0, bias_addr = 0;
+    neurax_error_t error = neurax_command_address(device, command->input, &input_addr);
+    if (error == NEURAX_SUCCESS) {
+        error = neurax_command_address(device, command->output, &output_addr);
+    }
+    if (error == NEURAX_SUCCESS && command->weights) {
+        error = neurax_command_address(device, command->weights, &weight_addr);
+    }
+    if (error == NEURAX_SUCCESS && command->bias) {
+        error = neurax_command_address(device, command->bias, &bias_addr);
+    }
+    if (error != NEURAX_SUCCESS) return error;
+
+    // Per-image runs step through the batch; a single run covers it whole
+    size_t in_stride = neurax_tensor_total_elements(command->input) *
+                       neurax_get_element_size(command->input->data_type) / runs;
+    size_t out_stride = neurax_tensor_total_elements(command->output) *
+                        neurax_get_element_size(command->output->data_type) / runs;
+    for (uint32_t n = 0; n < runs; n++) {
+        neurax_hw_descriptor_t* desc = &cmd->descriptors[cmd->num_descriptors++];
+        memset(desc, 0, sizeof(*desc));
+        desc->program = program;
+        desc->input_addr = input_addr + (uint32_t)(n * in_stride);
+        desc->output_addr = output_addr + (uint32_t)(n * out_stride);
+        desc->weight_addr = weight_addr;
+        desc->bias_addr = bias_addr;
+    }
+
+    cmd->commands[cmd->num_commands++] = *command;
+    cmd->predicted_cycles += estimate.cycles * runs;
+    return NEURAX_SUCCESS;
+}
+
+// Public API
+
+neurax_error_t neurax_command_buffer_create(neurax_device_t* device, uint32_t capacity,
+                                           neurax_command_buffer_t** cmd) {
+    if (!cmd || capacity == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_command_buffer_t* c = calloc(1, sizeof(neurax_command_buffer_t));
+    if (!c) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    c->commands = calloc(capacity, sizeof(neurax_command_t));
+    if (!c->commands) {
+        free(c);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    void* descriptors = NULL;
+    neurax_error_t error = neurax_dma_alloc(device, (size_t)capacity * sizeof(neurax_hw_descriptor_t),
+                                            &descriptors, &c->bus_address);
+    if (error == NEURAX_SUCCESS &&
+        c->bus_address + (size_t)capacity * sizeof(neurax_hw_descriptor_t) > (1ull << 32)) {
+        NEURAX_LOG_ERROR("Descriptor ring is beyond the 32-bit address registers");
+        neurax_dma_free(device, descriptors);
+        error = NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (error != NEURAX_SUCCESS) {
+        free(c->commands);
+        free(c);
+        return error;
+    }
+
+    c->device = device;
+    c->descriptors = (neurax_hw_descriptor_t*)descriptors;
+    c->capacity = capacity;
+    *cmd = c;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_command_buffer_destroy(neurax_command_buffer_t* cmd) {
+    if (!cmd) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_dma_free(cmd->device, cmd->descriptors);
+    free(cmd->commands);
+    free(cmd);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_command_buffer_conv2d(neurax_command_buffer_t* cmd,
+                                           const neurax_tensor_t* input,
+                                           const neurax_tensor_t* weights,
+                                           const neurax_tensor_t* bias,
+                                           const neurax_conv_config_t* config,
+                                           neurax_tensor_t* output) {
+    if (!cmd || !input || !weights || !config || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_data_type_t type = input->data_type;
+    bool use_bias = config->use_bias && bias;
+    if (!neurax_hw_supports_tensor(input, type) || !neurax_hw_supports_tensor(weights, type) ||
+        !neurax_hw_supports_tensor(output, type) ||
+        (use_bias && !neurax_hw_supports_tensor(bias, type))) {
+        NEURAX_LOG_ERROR("Command buffer convolution needs dense 8 or 16-bit tensors of one type");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (neurax_tensor_is_quantized(input) || neurax_tensor_is_quantized(weights) ||
+        neurax_tensor_is_quantized(output)) {
+        NEURAX_LOG_ERROR("The accelerator can't requantize convolutions of quantized tensors");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (config->stride_x == 0 || config->stride_y == 0 ||
+        input->width + 2 * config->padding_x < config->kernel_width ||
+        input->height + 2 * config->padding_y < config->kernel_height) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    uint32_t out_height = (input->height + 2 * config->padding_y - config->kernel_height) / config->stride_y + 1;
+    uint32_t out_width = (input->width + 2 * config->padding_x - config->kernel_width) / config->stride_x + 1;
+    if (output->height != out_height || output->width != out_width ||
+        config->output_channels != output->channels || input->batch_size != output->batch_size ||
+        neurax_tensor_total_elements(weights) < (size_t)config->output_channels *
+            config->input_channels * config->kernel_width * config->kernel_height ||
+        (use_bias && neurax_tensor_total_elements(bias) < config->output_channels)) {
+        NEURAX_LOG_ERROR("Convolution tensors don't match the configuration");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_command_t command = {
+        .type = NEURAX_LAYER_CONV2D,
+        .input = input,
+        .weights = weights,
+        .bias = use_bias ? bias : NULL,
+        .output = output,
+    };
+    command.params.conv = *config;
+    command.params.conv.use_bias = use_bias;
+
+    neurax_perf_layer_t layer = {
+        .type = NEURAX_LAYER_CONV2D,
+        .width = input->width,
+        .height = input->height,
+        .channels = input->channels,
+        .batch_size = input->batch_size,
+        .data_type = type,
+        .conv = command.params.conv,
+    };
+    return neurax_command_append(cmd, &command, &layer);
+}
+
+neurax_error_t neurax_command_buffer_pooling(neurax_command_buffer_t* cmd,
+                                            const neurax_tensor_t* input,
+                                            const neurax_pool_config_t* config,
+                                            neurax_tensor_t* output) {
+    if (!cmd || !input || !config || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!neurax_hw_supports_tensor(input, input->data_type) ||
+        !neurax_hw_supports_tensor(output, input->data_type)) {
+        NEURAX_LOG_ERROR("Command buffer pooling needs dense 8 or 16-bit tensors of one type");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (config->stride_x == 0 || config->stride_y == 0 ||
+        input->height < config->pool_height || input->width < config->pool_width) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    uint32_t out_height = (input->height - config->pool_height) / config->stride_y + 1;
+    uint32_t out_width = (input->width - config->pool_width) / config->stride_x + 1;
+    if (output->height != out_height || output->width != out_width ||
+        input->channels != output->channels || input->batch_size != output->batch_size) {
+        NEURAX_LOG_ERROR("Output tensor dimensions don't match calculated dimensions");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_command_t command = {
+        .type = NEURAX_LAYER_POOLING,
+        .input = input,
+        .output = output,
+    };
+    command.params.pool = *config;
+
+    neurax_perf_layer_t layer = {
+        .type = NEURAX_LAYER_POOLING,
+        .width = input->width,
+        .height = input->height,
+        .channels = input->channels,
+        .batch_size = input->batch_size,
+        .data_type = input->data_type,
+        .pool = *config,
+    };
+    return neurax_command_append(cmd, &command, &layer);
+}
+
+neurax_error_t neurax_command_buffer_activation(neurax_command_buffer_t* cmd,
+                                               const neurax_tensor_t* input,
+                                               neurax_activation_t activation,
+                                               neurax_tensor_t* output) {
+    if (!cmd || !input || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!neurax_hw_supports_tensor(input, input->data_type) ||
+        !neurax_hw_supports_tensor(output, input->data_type) ||
+        input->width != output->width || input->height != output->height ||
+        input->channels != output->channels || input->batch_size != output->batch_size) {
+        NEURAX_LOG_ERROR("Command buffer activation needs matching dense 8 or 16-bit tensors");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_command_t command = {
+        .type = NEURAX_LAYER_ACTIVATION,
+        .input = input,
+        .output = output,
+    };
+    command.params.activation = activation;
+
+    neurax_perf_layer_t layer = {
+        .type = NEURAX_LAYER_ACTIVATION,
+        .width = input->width,
+        .height = input->height,
+        .channels = input->channels,
+        .batch_size = input->batch_size,
+        .data_type = input->data_type,
+        .activation = activation,
+    };
+    return neurax_command_append(cmd, &command, &layer);
+}
+
+neurax_error_t neurax_command_buffer_reset(neurax_command_buffer_t* cmd) {
+    if (!cmd) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    cmd->num_descriptors = 0;
+    cmd->num_commands = 0;
+    cmd->predicted_cycles = 0;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_command_buffer_submit(neurax_command_buffer_t* cmd) {
+    if (!cmd) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_device_t* device = cmd->device;
+    if (cmd->num_commands == 0) {
+        return NEURAX_SUCCESS;
+    }
+
+    // Without the accelerator, replay the recorded operations
+    if (!(device->hardware_available && device->config.use_hardware)) {
+        for (uint32_t i = 0; i < cmd->num_commands; i++) {
+            const neurax_command_t* command = &cmd->commands[i];
+            neurax_error_t error;
+
+            if (command->type == NEURAX_LAYER_CONV2D) {
+                error = neurax_conv2d(device, command->input, command->weights, command->bias,
+                                      &command->params.conv, command->output);
+            } else if (command->type == NEURAX_LAYER_POOLING) {
+                error = neurax_pooling(device, command->input, &command->params.pool,
+                                       command->output);
+            } else {
+                error = neurax_activation(device, command->input, command->params.activation,
+                                          command->output);
+            }
+            if (error != NEURAX_SUCCESS) return error;
+        }
+        return NEURAX_SUCCESS;
+    }
+
+    // One doorbell for the whole chain
+    pthread_mutex_lock(&device->hw_lock);
+    NEURAX_WRITE_REG(device, NEURAX_REG_DESC_ADDR, (uint32_t)cmd->bus_address);
+    NEURAX_WRITE_REG(device, NEURAX_REG_DESC_COUNT, cmd->num_descriptors);
+
+    neurax_error_t error = neurax_hw_execute(device, CTRL_DESC_EN, cmd->predicted_cycles);
+    if (error != NEURAX_SUCCESS) {
+        NEURAX_LOG_ERROR("Command chain stopped after %u of %u descriptors",
+                         NEURAX_READ_REG(device, NEURAX_REG_DESC_DONE), cmd->num_descriptors);
+    }
+    pthread_mutex_unlock(&device->hw_lock);
+
+    return error;
+}
@@ -7,6 +7,7 @@
 
 #include "neurax.h"
 #include "neurax_private.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
@@ -31,10 +32,20 @@ neurax_error_t neurax_conv2d(neurax_device_t* device,
     neurax_error_t error = neurax_validate_tensor(input);
     if (error != NEURAX_SUCCESS) return error;
     
+    error = neurax_validate_layout(input, true);
+    if (error != NEURAX_SUCCESS) return error;
+    
     error = neurax_validate_tensor(weights);
     if (error != NEURAX_SUCCESS) return error;
     
-    error = neurax_validate_tensor(output);
+    // Activations may be strided views; weights are addressed as a flat OIHW array
+    error = neurax_validate_contiguous(weights);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_layout(output, true);
     if (error != NEURAX_SUCCESS) return error;
     
     error = neurax_validate_conv_config(config);
@@ -54,8 +65,43 @@ neurax_error_t neurax_conv2d(neurax_device_t* device,
     if (device->hardware_available && device->config.use_hardware) {
         return neurax_hw_conv2d(device, input, weights, bias, config, output);
     } else {
-        return neurax_cpu_conv2d(input, weights, bias, config, output);
+        return neurax_cpu_conv2d(device, input, weights, bias, config, output);
+    }
+}
+
+// Shapes and types the accelerator's convolution unit handles
+static bool neurax_hw_conv_supported(neurax_device_t* device,
+                                     const neurax_tensor_t* input,
+                                     const neurax_tensor_t* weights,
+                                     const neurax_tensor_t* bias,
+                                     const neurax_conv_config_t* config,
+                                     const neurax_tensor_t* output) {
+    neurax_data_type_t type = input->data_type;
+    
+    if (!neurax_hw_supports_tensor(input, type) || !neurax_hw_supports_tensor(weights, type) ||
+        !neurax_hw_supports_tensor(output, type) ||
+        (config->use_bias && bias && !neurax_hw_supports_tensor(bias, type))) {
+        return false;
+    }
+    
+    // The unit saturates raw integer sums and has no requantization stage
+    if (neurax_tensor_is_quantized(input) || neurax_tensor_is_quantized(weights) ||
+        neurax_tensor_is_quantized(output)) {
+        return false;
     }
+    
+    // Square kernels with symmetric stride and padding, up to 8 input channels
+    uint32_t max_kernel = device->config.max_kernel_size ? device->config.max_kernel_size : 16;
+    return config->kernel_width == config->kernel_height && config->kernel_width <= max_kernel &&
+           config->kernel_width <= 16 && config->stride_x == config->stride_y &&
+           config->stride_x <= 8 &&
+           config->padding_x == config->padding_y && config->padding_x <= 3 &&
+           config->input_channels == input->channels && config->input_channels <= 8 &&
+           config->output_channels == output->channels &&
+           input->batch_size == output->batch_size &&
+           neurax_tensor_total_elements(weights) >= (size_t)config->output_channels *
+               config->input_channels * config->kernel_width * config->kernel_height &&
+           (!config->use_bias || !bias || neurax_tensor_total_elements(bias) >= config->output_channels);
 }
 
 // Hardware implementation
@@ -66,50 +112,290 @@ neurax_error_t neurax_hw_conv2d(neurax_device_t* device,
                                const neurax_conv_config_t* config,
                                neurax_tensor_t* output) {
     
+    if (!neurax_hw_conv_supported(device, input, weights, bias, config, output)) {
+        NEURAX_LOG_DEBUG("Convolution not supported by the accelerator, using CPU");
+        return neurax_cpu_conv2d(device, input, weights, bias, config, output);
+    }
+    
+    uint32_t out_height = (input->height + 2 * config->padding_y - config->kernel_height) / config->stride_y + 1;
+    uint32_t out_width = (input->width + 2 * config->padding_x - config->kernel_width) / config->stride_x + 1;
+    if (output->height != out_height || output->width != out_width) {
+        NEURAX_LOG_ERROR("Output tensor dimensions don't match calculated dimensions");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
     NEURAX_LOG_DEBUG("Using hardware acceleration for convolution");
     
-    // Configure hardware registers using bit fields
-    neurax_conv_config_reg_t conv_config = {.raw = 0};
-    conv_config.bits.kernel_size = config->kernel_width - 1;     // Bits 3:0
-    conv_config.bits.stride = config->stride_x - 1;              // Bits 6:4
-    conv_config.bits.padding = config->padding_x;                // Bits 8:7
-    conv_config.bits.use_bias = config->use_bias ? 1 : 0;        // Bit 9
-    conv_config.bits.input_channels = config->input_channels - 1; // Bits 12:10
-    
-    NEURAX_WRITE_REG(device, NEURAX_REG_CONV_CONFIG, conv_config.raw);
-    
-    // Set dimension configuration
-    neurax_dim_config_reg_t dim_config = {.raw = 0};
-    dim_config.bits.width = input->width;
-    dim_config.bits.height = input->height;
-    NEURAX_WRITE_REG(device, NEURAX_REG_DIM_CONFIG, dim_config.raw);
-    
-    // Set activation configuration
-    neurax_act_config_reg_t act_config = {.raw = 0};
-    act_config.bits.activation = config->activation;
-    NEURAX_WRITE_REG(device, NEURAX_REG_ACT_CONFIG, act_config.raw);
-    
-    // Configure control register
-    neurax_control_reg_t control = {.raw = 0};
-    if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
-        control.bits.data_width = 1;
+    bool use_bias = config->use_bias && bias;
+    
+    // Operands in DMA memory: inputs copied in unless they already live there
+    neurax_hw_buffer_t in_buf = {0}, weight_buf = {0}, bias_buf = {0}, out_buf = {0};
+    neurax_error_t error = neurax_hw_buffer_acquire(device, input, true, &in_buf);
+    if (error == NEURAX_SUCCESS) {
+        error = neurax_hw_buffer_acquire(device, weights, true, &weight_buf);
     }
-    control.bits.conv_en = 1;
-    if (config->activation != NEURAX_ACTIVATION_LINEAR) {
-        control.bits.act_en = 1;
+    if (error == NEURAX_SUCCESS && use_bias) {
+        error = neurax_hw_buffer_acquire(device, bias, true, &bias_buf);
+    }
+    if (error == NEURAX_SUCCESS) {
+        error = neurax_hw_buffer_acquire(device, output, false, &out_buf);
     }
     
-    NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, control.raw);
+    if (error == NEURAX_SUCCESS) {
+        pthread_mutex_lock(&device->hw_lock);
+        
+        // Configure hardware registers using bit fields
+        neurax_conv_config_reg_t conv_config = {.raw = 0};
+        conv_config.bits.kernel_size = config->kernel_width - 1;     // Bits 3:0
+        conv_config.bits.stride = config->stride_x - 1;              // Bits 6:4
+        conv_config.bits.padding = config->padding_x;                // Bits 8:7
+        conv_config.bits.use_bias = use_bias ? 1 : 0;                // Bit 9
+        conv_config.bits.input_channels = config->input_channels - 1; // Bits 12:10
+        
+        NEURAX_WRITE_REG(device, NEURAX_REG_CONV_CONFIG, conv_config.raw);
+        
+        // Set dimension configuration
+        neurax_dim_config_reg_t dim_config = {.raw = 0};
+        dim_config.bits.width = input->width;
+        dim_config.bits.height = input->height;
+        NEURAX_WRITE_REG(device, NEURAX_REG_DIM_CONFIG, dim_config.raw);
+        
+        neurax_chan_config_reg_t chan_config = {.raw = 0};
+        chan_config.bits.input_channels = input->channels;
+        chan_config.bits.output_channels = output->channels;
+        NEURAX_WRITE_REG(device, NEURAX_REG_CHAN_CONFIG, chan_config.raw);
+        
+        // Set activation configuration
+        neurax_act_config_reg_t act_config = {.raw = 0};
+        act_config.bits.activation = config->activation;
+        NEURAX_WRITE_REG(device, NEURAX_REG_ACT_CONFIG, act_config.raw);
+        
+        NEURAX_WRITE_REG(device, NEURAX_REG_WEIGHT_ADDR, (uint32_t)weight_buf.bus_address);
+        NEURAX_WRITE_REG(device, NEURAX_REG_BIAS_ADDR, (uint32_t)bias_buf.bus_address);
+        
+        // Configure control register
+        neurax_control_reg_t control = {.raw = 0};
+        if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
+            control.bits.data_width = 1;
+        }
+        if (input->data_type == NEURAX_DATA_INT8 || input->data_type == NEURAX_DATA_INT16) {
+            control.bits.is_signed = 1;
+        }
+        control.bits.conv_en = 1;
+        if (config->activation != NEURAX_ACTIVATION_LINEAR) {
+            control.bits.act_en = 1;
+        }
+        
+        // One image per run; the weights stay in place across the batch
+        size_t in_stride = in_buf.size / input->batch_size;
+        size_t out_stride = out_buf.size / output->batch_size;
+        for (uint32_t n = 0; n < input->batch_size && error == NEURAX_SUCCESS; n++) {
+            NEURAX_WRITE_REG(device, NEURAX_REG_INPUT_ADDR, (uint32_t)(in_buf.bus_address + n * in_stride));
+            NEURAX_WRITE_REG(device, NEURAX_REG_OUTPUT_ADDR, (uint32_t)(out_buf.bus_address + n * out_stride));
+            error = neurax_hw_run(device, control.raw);
+        }
+        
+        pthread_mutex_unlock(&device->hw_lock);
+        
+        if (error != NEURAX_SUCCESS) {
+            NEURAX_LOG_ERROR("Hardware convolution timeout or error");
+        }
+    }
     
-    // TODO: Implement DMA data transfer
-    // For now, we'll fall back to CPU implementation
-    NEURAX_LOG_DEBUG("DMA transfer not implemented, falling back to CPU");
+    neurax_hw_buffer_release(device, &in_buf, NULL);
+    neurax_hw_buffer_release(device, &weight_buf, NULL);
+    neurax_hw_buffer_release(device, &bias_buf, NULL);
+    neurax_hw_buffer_release(device, &out_buf, error == NEURAX_SUCCESS ? output : NULL);
     
-    return neurax_cpu_conv2d(input, weights, bias, config, output);
+    return error;
+}
+
+// Quantized convolution: accumulate (input - input_zp) * (weight - weight_zp), scale
+// the sum by in_scale * w_scale (per output channel where set) to get the real value,
+// and requantize it with the output parameters. Tensors without quantization
+// parameters use scale 1 and zero point 0, which leaves float math unchanged.
+typedef struct {
+    float input_scale;
+    float input_zero_point;
+    float weight_scale;
+    float weight_zero_point;
+    const float* channel_scales;    // Per-output-channel weight scales, or NULL
+    bool quantize_output;
+    float output_inv_scale;
+    int32_t output_zero_point;
+} neurax_conv_quant_t;
+
+static void neurax_conv_quant_init(const neurax_tensor_t* input, const neurax_tensor_t* weights,
+                                   const neurax_tensor_t* output, neurax_conv_quant_t* quant) {
+    bool input_quantized = input->quant.scale > 0.0f;
+    bool weights_quantized = weights->quant.scale > 0.0f;
+    
+    quant->input_scale = input_quantized ? input->quant.scale : 1.0f;
+    quant->input_zero_point = input_quantized ? (float)input->quant.zero_point : 0.0f;
+    quant->weight_scale = weights_quantized ? weights->quant.scale : 1.0f;
+    quant->weight_zero_point = weights_quantized ? (float)weights->quant.zero_point : 0.0f;
+    quant->channel_scales = weights->quant.channel_scales;
+    quant->quantize_output = output->quant.scale > 0.0f &&
+                             (output->data_type == NEURAX_DATA_INT8 ||
+                              output->data_type == NEURAX_DATA_UINT8);
+    quant->output_inv_scale = quant->quantize_output ? 1.0f / output->quant.scale : 1.0f;
+    quant->output_zero_point = quant->quantize_output ? output->quant.zero_point : 0;
+}
+
+// Real-valued multiplier of one output channel's accumulator
+static float neurax_conv_channel_scale(const neurax_conv_quant_t* quant, uint32_t out_ch) {
+    return quant->input_scale * (quant->channel_scales ? quant->channel_scales[out_ch]
+                                                        : quant->weight_scale);
+}
+
+// Output elements computed per thread before the blocked kernel is split
+#define NEURAX_CONV_PARALLEL_MIN (1 << 16)
+
+// Shared state for blocked conv worker threads
+typedef struct {
+    const neurax_tensor_t* input;
+    const neurax_conv_config_t* config;
+    neurax_tensor_t* output;
+    const float* weights;           // Packed [out block][in][kh][kw][lane], zero past the last channel
+    const float* bias;              // [out block][lane]
+} neurax_conv_blocked_job_t;
+
+// Rows [begin, end) of (image, output block, output row). Always inlined into one
+// wrapper per block size so the lane loops have a constant trip count and vectorize.
+static inline __attribute__((always_inline))
+void neurax_conv2d_blocked_rows(const neurax_conv_blocked_job_t* job, size_t begin, size_t end,
+                                const uint32_t B) {
+    const neurax_tensor_t* input = job->input;
+    const neurax_conv_config_t* config = job->config;
+    neurax_tensor_t* output = job->output;
+    const uint32_t IC = config->input_channels;
+    const uint32_t KH = config->kernel_height;
+    const uint32_t KW = config->kernel_width;
+    const size_t in_blocks = (input->channels + B - 1) / B;
+    const size_t out_blocks = (output->channels + B - 1) / B;
+    const float* in = (const float*)input->data;
+    float* out = (float*)output->data;
+    
+    for (size_t r = begin; r < end; r++) {
+        size_t n = r / (out_blocks * output->height);
+        size_t ob = (r / output->height) % out_blocks;
+        uint32_t oy = (uint32_t)(r % output->height);
+        uint32_t lanes = output->channels - ob * B < B ? output->channels - ob * B : B;
+        float* dst = out + ((n * out_blocks + ob) * output->height + oy) * output->width * B;
+        
+        for (uint32_t ox = 0; ox < output->width; ox++) {
+            float acc[16] = {0.0f};
+            
+            // Each input channel broadcasts against a block of output channels
+            for (uint32_t ic = 0; ic < IC; ic++) {
+                const float* plane = in + ((n * in_blocks + ic / B) * input->height) *
+                                          input->width * B + ic % B;
+                const float* w_ic = job->weights + ((ob * IC + ic) * KH) * KW * B;
+                
+                for (uint32_t ky = 0; ky < KH; ky++) {
+                    int32_t iy = oy * config->stride_y + ky - config->padding_y;
+                    if (iy < 0 || iy >= (int32_t)input->height) continue;
+                    
+                    for (uint32_t kx = 0; kx < KW; kx++) {
+                        int32_t ix = ox * config->stride_x + kx - config->padding_x;
+                        if (ix < 0 || ix >= (int32_t)input->width) continue;
+                        
+                        const float v = plane[((size_t)iy * input->width + ix) * B];
+                        const float* w = w_ic + (ky * KW + kx) * B;
+                        for (uint32_t b = 0; b < B; b++) {
+                            acc[b] += v * w[b];
+                        }
+                    }
+                }
+            }
+            
+            float* o = dst + (size_t)ox * B;
+            for (uint32_t b = 0; b < lanes; b++) {
+                float value = job->bias ? acc[b] + job->bias[ob * B + b] : acc[b];
+                o[b] = neurax_apply_activation(value, config->activation);
+            }
+            // Padding lanes of the last block stay zero
+            for (uint32_t b = lanes; b < B; b++) {
+                o[b] = 0.0f;
+            }
+        }
+    }
+}
+
+static void neurax_conv2d_blocked8(void* ctx, size_t begin, size_t end) {
+    neurax_conv2d_blocked_rows((const neurax_conv_blocked_job_t*)ctx, begin, end, 8);
+}
+
+static void neurax_conv2d_blocked16(void* ctx, size_t begin, size_t end) {
+    neurax_conv2d_blocked_rows((const neurax_conv_blocked_job_t*)ctx, begin, end, 16);
+}
+
+// fp32 NCHWc activations: pack the weights per output block and vectorize across lanes
+static neurax_error_t neurax_cpu_conv2d_blocked(neurax_device_t* device,
+                                               const neurax_tensor_t* input,
+                                               const neurax_tensor_t* weights,
+                                               const neurax_tensor_t* bias,
+                                               const neurax_conv_config_t* config,
+                                               neurax_tensor_t* output) {
+    const uint32_t B = neurax_layout_block_size(output->layout);
+    const uint32_t IC = config->input_channels;
+    const uint32_t OC = config->output_channels;
+    const size_t out_blocks = (output->channels + B - 1) / B;
+    const size_t taps = (size_t)config->kernel_height * config->kernel_width;
+    
+    size_t mark = neurax_scratch_mark(device);
+    float* packed = neurax_scratch_alloc(device, sizeof(float) * out_blocks * B * (IC * taps + 1));
+    if (!packed) {
+        neurax_scratch_release(device, mark);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    float* packed_bias = packed + out_blocks * B * IC * taps;
+    
+    // fp32 activations are never quantized; quantized weights are dequantized while packing
+    neurax_conv_quant_t quant;
+    neurax_conv_quant_init(input, weights, output, &quant);
+    
+    for (size_t ob = 0; ob < out_blocks; ob++) {
+        for (uint32_t ic = 0; ic < IC; ic++) {
+            for (uint32_t ky = 0; ky < config->kernel_height; ky++) {
+                for (uint32_t kx = 0; kx < config->kernel_width; kx++) {
+                    float* w = packed + (((ob * IC + ic) * config->kernel_height + ky) *
+                                         config->kernel_width + kx) * B;
+                    for (uint32_t b = 0; b < B; b++) {
+                        uint32_t oc = (uint32_t)(ob * B + b);
+                        w[b] = oc < OC ? (neurax_get_weight_value(weights, oc, ic, ky, kx) -
+                                          quant.weight_zero_point) *
+                                         neurax_conv_channel_scale(&quant, oc) : 0.0f;
+                    }
+                }
+            }
+        }
+        for (uint32_t b = 0; b < B; b++) {
+            uint32_t oc = (uint32_t)(ob * B + b);
+            packed_bias[ob * B + b] = oc < OC && bias ? neurax_get_bias_value(bias, oc) : 0.0f;
+        }
+    }
+    
+    neurax_conv_blocked_job_t job;
+    job.input = input;
+    job.config = config;
+    job.output = output;
+    job.weights = packed;
+    job.bias = config->use_bias && bias ? packed_bias : NULL;
+    
+    size_t rows = (size_t)output->batch_size * out_blocks * output->height;
+    size_t row_work = (size_t)output->width * B * IC * taps;
+    neurax_parallel_for(rows, 1, NEURAX_CONV_PARALLEL_MIN / row_work + 1,
+                        B == 16 ? neurax_conv2d_blocked16 : neurax_conv2d_blocked8, &job);
+    
+    neurax_scratch_free(device, packed);
+    neurax_scratch_release(device, mark);
+    return NEURAX_SUCCESS;
 }
 
 // CPU implementation
-neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
+neurax_error_t neurax_cpu_conv2d(neurax_device_t* device,
+                                const neurax_tensor_t* input,
                                 const neurax_tensor_t* weights,
                                 const neurax_tensor_t* bias,
                                 const neurax_conv_config_t* config,
@@ -126,8 +412,24 @@ neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    // Clear output tensor
-    memset(output->data, 0, output->data_size);
+    // Every output element is written below, so outputs need no clearing
+    if (config->input_channels > input->channels || output->channels != config->output_channels ||
+        output->batch_size != input->batch_size) {
+        NEURAX_LOG_ERROR("Convolution of %u -> %u channels doesn't match tensors of %u -> %u",
+                         config->input_channels, config->output_channels,
+                         input->channels, output->channels);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    // Blocked fp32 activations in and out take the vectorized kernel
+    if (neurax_layout_block_size(input->layout) != 0 && input->layout == output->layout &&
+        input->data_type == NEURAX_DATA_FLOAT32 && output->data_type == NEURAX_DATA_FLOAT32 &&
+        !neurax_tensor_is_quantized(input) && !neurax_tensor_is_quantized(output)) {
+        return neurax_cpu_conv2d_blocked(device, input, weights, bias, config, output);
+    }
+    
+    neurax_conv_quant_t quant;
+    neurax_conv_quant_init(input, weights, output, &quant);
     
     // Perform convolution for each batch
     for (uint32_t batch = 0; batch < input->batch_size; batch++) {
@@ -158,12 +460,15 @@ neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
                                     float input_val = neurax_get_tensor_value(input, batch, in_y, in_x, in_ch);
                                     float weight_val = neurax_get_weight_value(weights, out_ch, in_ch, ky, kx);
                                     
-                                    accumulator += input_val * weight_val;
+                                    accumulator += (input_val - quant.input_zero_point) *
+                                                   (weight_val - quant.weight_zero_point);
                                 }
                             }
                         }
                     }
                     
+                    accumulator *= neurax_conv_channel_scale(&quant, out_ch);
+                    
                     // Add bias if enabled
                     if (config->use_bias && bias) {
                         float bias_val = neurax_get_bias_value(bias, out_ch);
@@ -172,6 +477,10 @@ neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
                     
                     // Apply activation function
                     float result = neurax_apply_activation(accumulator, config->activation);
+                    if (quant.quantize_output) {
+                        result = neurax_quantize_value(result, quant.output_inv_scale,
+                                                       quant.output_zero_point);
+                    }
                     
                     // Store result
                     neurax_set_tensor_value(output, batch, out_y, out_x, out_ch, result);
@@ -185,124 +494,26 @@ neurax_error_t neurax_cpu_conv2d(const neurax_tensor_t* input,
 
 // Helper function to get tensor value
 float neurax_get_tensor_value(const neurax_tensor_t* tensor, uint32_t batch, uint32_t y, uint32_t x, uint32_t c) {
-    size_t index = ((batch * tensor->height + y) * tensor->width + x) * tensor->channels + c;
-    
-    switch (tensor->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)tensor->data;
-            return data[index];
-        }
-        default:
-            return 0.0f;
-    }
+    const uint8_t* data = (const uint8_t*)tensor->data + neurax_tensor_byte_offset(tensor, batch, y, x, c);
+    return neurax_load_element(data, tensor->data_type, 0);
 }
 
 // Helper function to get weight value
 float neurax_get_weight_value(const neurax_tensor_t* weights, uint32_t out_ch, uint32_t in_ch, uint32_t ky, uint32_t kx) {
     // Weights are stored as [output_channels, input_channels, kernel_height, kernel_width]
-    size_t index = ((out_ch * weights->channels + in_ch) * weights->height + ky) * weights->width + kx;
-    
-    switch (weights->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)weights->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)weights->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)weights->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)weights->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)weights->data;
-            return data[index];
-        }
-        default:
-            return 0.0f;
-    }
+    size_t index = (((size_t)out_ch * weights->channels + in_ch) * weights->height + ky) * weights->width + kx;
+    return neurax_load_element(weights->data, weights->data_type, index);
 }
 
 // Helper function to get bias value
 float neurax_get_bias_value(const neurax_tensor_t* bias, uint32_t channel) {
-    switch (bias->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)bias->data;
-            return (float)data[channel];
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)bias->data;
-            return (float)data[channel];
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)bias->data;
-            return (float)data[channel];
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)bias->data;
-            return (float)data[channel];
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)bias->data;
-            return data[channel];
-        }
-        default:
-            return 0.0f;
-    }
+    return neurax_load_element(bias->data, bias->data_type, channel);
 }
 
 // Helper function to set tensor value
 void neurax_set_tensor_value(neurax_tensor_t* tensor, uint32_t batch, uint32_t y, uint32_t x, uint32_t c, float value) {
-    size_t index = ((batch * tensor->height + y) * tensor->width + x) * tensor->channels + c;
-    
-    switch (tensor->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)tensor->data;
-            data[index] = (uint8_t)fmax(0, fmin(255, value));
-            break;
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)tensor->data;
-            data[index] = (int8_t)fmax(-128, fmin(127, value));
-            break;
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)tensor->data;
-            data[index] = (uint16_t)fmax(0, fmin(65535, value));
-            break;
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)tensor->data;
-            data[index] = (int16_t)fmax(-32768, fmin(32767, value));
-            break;
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)tensor->data;
-            data[index] = value;
-            break;
-        }
-    }
+    uint8_t* data = (uint8_t*)tensor->data + neurax_tensor_byte_offset(tensor, batch, y, x, c);
+    neurax_store_element(data, tensor->data_type, 0, value);
 }
 
 // Helper function to apply activation
@@ -320,6 +531,30 @@ float neurax_apply_activation(float value, neurax_activation_t activation) {
     }
 }
 
+// Apply activation to a block of fp32 values in place
+void neurax_apply_activation_block(float* values, size_t count, neurax_activation_t activation) {
+    switch (activation) {
+        case NEURAX_ACTIVATION_RELU:
+            for (size_t i = 0; i < count; i++) {
+                values[i] = values[i] > 0.0f ? values[i] : 0.0f;
+            }
+            break;
+        case NEURAX_ACTIVATION_TANH:
+            for (size_t i = 0; i < count; i++) {
+                values[i] = tanhf(values[i]);
+            }
+            break;
+        case NEURAX_ACTIVATION_SIGMOID:
+            for (size_t i = 0; i < count; i++) {
+                values[i] = 1.0f / (1.0f + expf(-values[i]));
+            }
+            break;
+        case NEURAX_ACTIVATION_LINEAR:
+        default:
+            break;
+    }
+}
+
 // Forward declarations for helper functions used in the file
 float neurax_get_tensor_value(const neurax_tensor_t* tensor, uint32_t batch, uint32_t y, uint32_t x, uint32_t c);
 float neurax_get_weight_value(const neurax_tensor_t* weights, uint32_t out_ch, uint32_t in_ch, uint32_t ky, uint32_t kx);
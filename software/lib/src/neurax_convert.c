@@ -0,0 +1,597 @@
+/*
+ * NEURAX Data Type Conversion
+ * Specialized conversion loops for every (source, destination) type pair
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NEURAX_HAVE_X86_DISPATCH 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NEURAX_HAVE_NEON 1
+#endif
+
+// Buffers smaller than this are converted on the calling thread
+#define NEURAX_CONVERT_PARALLEL_MIN (256 * 1024)
+// Elements per range boundary, so no two threads write the same cache line
+#define NEURAX_CONVERT_GRAIN 64
+
+// Per-type storage and saturation limits
+#define NX_TYPE_U8   uint8_t
+#define NX_TYPE_I8   int8_t
+#define NX_TYPE_U16  uint16_t
+#define NX_TYPE_I16  int16_t
+#define NX_TYPE_F32  float
+#define NX_TYPE_F16  uint16_t
+#define NX_TYPE_BF16 uint16_t
+
+// Per-type load to float and store from float (half types only)
+#define NX_LOAD_U8(x)    ((float)(x))
+#define NX_LOAD_I8(x)    ((float)(x))
+#define NX_LOAD_U16(x)   ((float)(x))
+#define NX_LOAD_I16(x)   ((float)(x))
+#define NX_LOAD_F32(x)   (x)
+#define NX_LOAD_F16(x)   neurax_fp16_to_fp32(x)
+#define NX_LOAD_BF16(x)  neurax_bf16_to_fp32(x)
+
+#define NX_STORE_F16(x)  neurax_fp32_to_fp16(x)
+#define NX_STORE_BF16(x) neurax_fp32_to_bf16(x)
+
+#define NX_MIN_U8    0
+#define NX_MAX_U8    255
+#define NX_MIN_I8    (-128)
+#define NX_MAX_I8    127
+#define NX_MIN_U16   0
+#define NX_MAX_U16   65535
+#define NX_MIN_I16   (-32768)
+#define NX_MAX_I16   32767
+
+// Conversion loop signature: dst[i] = saturate(src[i] * scale + offset)
+typedef void (*neurax_convert_fn)(const void* src, void* dst, size_t count,
+                                  float scale, float offset);
+
+// Integer to integer: saturate in 32-bit integer arithmetic
+#define NX_CONVERT_INT_INT(S, D)                                                    \
+static void convert_##S##_##D(const void* src, void* dst, size_t count,           \
+                              float scale, float offset) {                        \
+    (void)scale; (void)offset;                                                    \
+    const NX_TYPE_##S* s = (const NX_TYPE_##S*)src;                               \
+    NX_TYPE_##D* d = (NX_TYPE_##D*)dst;                                           \
+    for (size_t i = 0; i < count; i++) {                                          \
+        int32_t v = s[i];                                                         \
+        v = v < NX_MIN_##D ? NX_MIN_##D : v;                                      \
+        v = v > NX_MAX_##D ? NX_MAX_##D : v;                                      \
+        d[i] = (NX_TYPE_##D)v;                                                    \
+    }                                                                             \
+}
+
+// Integer to float: plain widening
+#define NX_CONVERT_INT_F32(S)                                                       \
+static void convert_##S##_F32(const void* src, void* dst, size_t count,           \
+                              float scale, float offset) {                        \
+    (void)scale; (void)offset;                                                    \
+    const NX_TYPE_##S* s = (const NX_TYPE_##S*)src;                               \
+    float* d = (float*)dst;                                                       \
+    for (size_t i = 0; i < count; i++) {                                          \
+        d[i] = (float)s[i];                                                       \
+    }                                                                             \
+}
+
+// Float to integer: clamp in float, then truncate (NaN maps to the maximum)
+#define NX_CONVERT_F32_INT(D)                                                       \
+static void convert_F32_##D(const void* src, void* dst, size_t count,             \
+                            float scale, float offset) {                          \
+    (void)scale; (void)offset;                                                    \
+    const float* s = (const float*)src;                                           \
+    NX_TYPE_##D* d = (NX_TYPE_##D*)dst;                                           \
+    for (size_t i = 0; i < count; i++) {                                          \
+        float v = s[i];                                                           \
+        v = v < (float)NX_MAX_##D ? v : (float)NX_MAX_##D;                        \
+        v = v > (float)NX_MIN_##D ? v : (float)NX_MIN_##D;                        \
+        d[i] = (NX_TYPE_##D)(int32_t)v;                                           \
+    }                                                                             \
+}
+
+// Any type to integer with scale/offset applied in float
+#define NX_AFFINE_INT(S, D)                                                         \
+static void affine_##S##_##D(const void* src, void* dst, size_t count,            \
+                             float scale, float offset) {                         \
+    const NX_TYPE_##S* s = (const NX_TYPE_##S*)src;                               \
+    NX_TYPE_##D* d = (NX_TYPE_##D*)dst;                                           \
+    for (size_t i = 0; i < count; i++) {                                          \
+        float v = NX_LOAD_##S(s[i]) * scale + offset;                             \
+        v = v < (float)NX_MAX_##D ? v : (float)NX_MAX_##D;                        \
+        v = v > (float)NX_MIN_##D ? v : (float)NX_MIN_##D;                        \
+        d[i] = (NX_TYPE_##D)(int32_t)v;                                           \
+    }                                                                             \
+}
+
+// Any type to float with scale/offset
+#define NX_AFFINE_F32(S)                                                            \
+static void affine_##S##_F32(const void* src, void* dst, size_t count,            \
+                             float scale, float offset) {                         \
+    const NX_TYPE_##S* s = (const NX_TYPE_##S*)src;                               \
+    float* d = (float*)dst;                                                       \
+    for (size_t i = 0; i < count; i++) {                                          \
+        d[i] = NX_LOAD_##S(s[i]) * scale + offset;                                \
+    }                                                                             \
+}
+
+// Any type to a half precision type with scale/offset
+#define NX_AFFINE_HALF(S, D)                                                        \
+static void affine_##S##_##D(const void* src, void* dst, size_t count,            \
+                             float scale, float offset) {                         \
+    const NX_TYPE_##S* s = (const NX_TYPE_##S*)src;                               \
+    NX_TYPE_##D* d = (NX_TYPE_##D*)dst;                                           \
+    for (size_t i = 0; i < count; i++) {                                          \
+        d[i] = NX_STORE_##D(NX_LOAD_##S(s[i]) * scale + offset);                  \
+    }                                                                             \
+}
+
+NX_CONVERT_INT_INT(U8, I8)
+NX_CONVERT_INT_INT(U8, U16)
+NX_CONVERT_INT_INT(U8, I16)
+NX_CONVERT_INT_INT(I8, U8)
+NX_CONVERT_INT_INT(I8, U16)
+NX_CONVERT_INT_INT(I8, I16)
+NX_CONVERT_INT_INT(U16, U8)
+NX_CONVERT_INT_INT(U16, I8)
+NX_CONVERT_INT_INT(U16, I16)
+NX_CONVERT_INT_INT(I16, U8)
+NX_CONVERT_INT_INT(I16, I8)
+NX_CONVERT_INT_INT(I16, U16)
+
+NX_CONVERT_INT_F32(I8)
+NX_CONVERT_INT_F32(U16)
+NX_CONVERT_INT_F32(I16)
+
+NX_CONVERT_F32_INT(I8)
+NX_CONVERT_F32_INT(U16)
+NX_CONVERT_F32_INT(I16)
+
+#define NX_AFFINE_ALL_SOURCES(D) \
+    NX_AFFINE_##D(U8)            \
+    NX_AFFINE_##D(I8)            \
+    NX_AFFINE_##D(U16)           \
+    NX_AFFINE_##D(I16)           \
+    NX_AFFINE_##D(F32)           \
+    NX_AFFINE_##D(F16)           \
+    NX_AFFINE_##D(BF16)
+
+#define NX_AFFINE_I8(S)   NX_AFFINE_INT(S, I8)
+#define NX_AFFINE_U16(S)  NX_AFFINE_INT(S, U16)
+#define NX_AFFINE_I16(S)  NX_AFFINE_INT(S, I16)
+#define NX_AFFINE_F16(S)  NX_AFFINE_HALF(S, F16)
+#define NX_AFFINE_BF16(S) NX_AFFINE_HALF(S, BF16)
+
+NX_AFFINE_ALL_SOURCES(I8)
+NX_AFFINE_ALL_SOURCES(U16)
+NX_AFFINE_ALL_SOURCES(I16)
+NX_AFFINE_ALL_SOURCES(F16)
+NX_AFFINE_ALL_SOURCES(BF16)
+
+NX_AFFINE_INT(U8, U8)
+NX_AFFINE_INT(I8, U8)
+NX_AFFINE_INT(U16, U8)
+NX_AFFINE_INT(I16, U8)
+NX_AFFINE_INT(F16, U8)
+NX_AFFINE_INT(BF16, U8)
+
+NX_AFFINE_F32(I8)
+NX_AFFINE_F32(U16)
+NX_AFFINE_F32(I16)
+NX_AFFINE_F32(F32)
+NX_AFFINE_F32(F16)
+NX_AFFINE_F32(BF16)
+
+// uint8 <-> float32 are the camera frame paths, so they get explicit SIMD loops
+
+static void affine_U8_F32(const void* src, void* dst, size_t count,
+                          float scale, float offset) {
+    const uint8_t* s = (const uint8_t*)src;
+    float* d = (float*)dst;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+        __m128 f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero));
+        __m128 f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero));
+        __m128 f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero));
+        __m128 f3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero));
+        _mm_storeu_ps(d + i,      _mm_add_ps(_mm_mul_ps(f0, vscale), voffset));
+        _mm_storeu_ps(d + i + 4,  _mm_add_ps(_mm_mul_ps(f1, vscale), voffset));
+        _mm_storeu_ps(d + i + 8,  _mm_add_ps(_mm_mul_ps(f2, vscale), voffset));
+        _mm_storeu_ps(d + i + 12, _mm_add_ps(_mm_mul_ps(f3, vscale), voffset));
+    }
+#elif defined(NEURAX_HAVE_NEON)
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    const float32x4_t voffset = vdupq_n_f32(offset);
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t bytes = vld1q_u8(s + i);
+        uint16x8_t lo16 = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t hi16 = vmovl_u8(vget_high_u8(bytes));
+        float32x4_t f0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16)));
+        float32x4_t f1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16)));
+        float32x4_t f2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16)));
+        float32x4_t f3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16)));
+        vst1q_f32(d + i,      vmlaq_f32(voffset, f0, vscale));
+        vst1q_f32(d + i + 4,  vmlaq_f32(voffset, f1, vscale));
+        vst1q_f32(d + i + 8,  vmlaq_f32(voffset, f2, vscale));
+        vst1q_f32(d + i + 12, vmlaq_f32(voffset, f3, vscale));
+    }
+#endif
+
+    for (; i < count; i++) {
+        d[i] = (float)s[i] * scale + offset;
+    }
+}
+
+static void convert_U8_F32(const void* src, void* dst, size_t count,
+                           float scale, float offset) {
+    (void)scale; (void)offset;
+    affine_U8_F32(src, dst, count, 1.0f, 0.0f);
+}
+
+#if defined(NEURAX_HAVE_NEON)
+// vcvtq_u32_f32 truncates and saturates but maps NaN to 0, so NaN lanes
+// become 255 first to match the scalar path
+static inline uint32x4_t neurax_neon_f32_to_u32(float32x4_t f) {
+    return vcvtq_u32_f32(vbslq_f32(vceqq_f32(f, f), f, vdupq_n_f32(255.0f)));
+}
+#endif
+
+static void affine_F32_U8(const void* src, void* dst, size_t count,
+                          float scale, float offset) {
+    const float* s = (const float*)src;
+    uint8_t* d = (uint8_t*)dst;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // cvttps truncates like the scalar path; packs/packus saturate to [0, 255].
+    // The pre-clamp keeps NaN and out-of-range values away from the 0x80000000
+    // conversion result; minps returns its second operand for NaN, so NaN
+    // saturates to 255 like the scalar path.
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    const __m128 vmin = _mm_set1_ps(0.0f);
+    const __m128 vmax = _mm_set1_ps(255.0f);
+    for (; i + 16 <= count; i += 16) {
+        __m128 f0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(s + i),      vscale), voffset);
+        __m128 f1 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(s + i + 4),  vscale), voffset);
+        __m128 f2 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(s + i + 8),  vscale), voffset);
+        __m128 f3 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(s + i + 12), vscale), voffset);
+        f0 = _mm_max_ps(_mm_min_ps(f0, vmax), vmin);
+        f1 = _mm_max_ps(_mm_min_ps(f1, vmax), vmin);
+        f2 = _mm_max_ps(_mm_min_ps(f2, vmax), vmin);
+        f3 = _mm_max_ps(_mm_min_ps(f3, vmax), vmin);
+        __m128i w0 = _mm_packs_epi32(_mm_cvttps_epi32(f0), _mm_cvttps_epi32(f1));
+        __m128i w1 = _mm_packs_epi32(_mm_cvttps_epi32(f2), _mm_cvttps_epi32(f3));
+        _mm_storeu_si128((__m128i*)(d + i), _mm_packus_epi16(w0, w1));
+    }
+#elif defined(NEURAX_HAVE_NEON)
+    // vqmovn narrows with saturation
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    const float32x4_t voffset = vdupq_n_f32(offset);
+    for (; i + 16 <= count; i += 16) {
+        uint32x4_t u0 = neurax_neon_f32_to_u32(vmlaq_f32(voffset, vld1q_f32(s + i),      vscale));
+        uint32x4_t u1 = neurax_neon_f32_to_u32(vmlaq_f32(voffset, vld1q_f32(s + i + 4),  vscale));
+        uint32x4_t u2 = neurax_neon_f32_to_u32(vmlaq_f32(voffset, vld1q_f32(s + i + 8),  vscale));
+        uint32x4_t u3 = neurax_neon_f32_to_u32(vmlaq_f32(voffset, vld1q_f32(s + i + 12), vscale));
+        uint16x8_t lo = vcombine_u16(vqmovn_u32(u0), vqmovn_u32(u1));
+        uint16x8_t hi = vcombine_u16(vqmovn_u32(u2), vqmovn_u32(u3));
+        vst1q_u8(d + i, vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        float v = s[i] * scale + offset;
+        v = v < 255.0f ? v : 255.0f;
+        v = v > 0.0f ? v : 0.0f;
+        d[i] = (uint8_t)(int32_t)v;
+    }
+}
+
+static void convert_F32_U8(const void* src, void* dst, size_t count,
+                           float scale, float offset) {
+    (void)scale; (void)offset;
+    affine_F32_U8(src, dst, count, 1.0f, 0.0f);
+}
+
+// Half precision <-> float32 use hardware conversion instructions when the CPU has them
+
+#if defined(NEURAX_HAVE_X86_DISPATCH)
+__attribute__((target("avx,f16c")))
+static void convert_F16_F32_f16c(const uint16_t* s, float* d, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(s + i));
+        _mm256_storeu_ps(d + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < count; i++) {
+        d[i] = neurax_fp16_to_fp32(s[i]);
+    }
+}
+
+__attribute__((target("avx,f16c")))
+static void convert_F32_F16_f16c(const float* s, uint16_t* d, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(s + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(d + i), h);
+    }
+    for (; i < count; i++) {
+        d[i] = neurax_fp32_to_fp16(s[i]);
+    }
+}
+
+// Same results as neurax_fp32_to_bf16, which flushes denormals like VCVTNEPS2BF16
+__attribute__((target("avx512f,avx512bf16")))
+static void convert_F32_BF16_avx512(const float* s, uint16_t* d, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(s + i));
+        _mm256_storeu_si256((__m256i*)(d + i), (__m256i)h);
+    }
+    for (; i < count; i++) {
+        d[i] = neurax_fp32_to_bf16(s[i]);
+    }
+}
+
+static bool neurax_cpu_has_f16c(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+    }
+    return supported != 0;
+}
+
+static bool neurax_cpu_has_avx512bf16(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512f");
+    }
+    return supported != 0;
+}
+#endif
+
+#if defined(NEURAX_HAVE_NEON) && defined(__ARM_FP) && (__ARM_FP & 2)
+#define NEURAX_HAVE_NEON_FP16 1
+#endif
+
+static void convert_F16_F32(const void* src, void* dst, size_t count,
+                            float scale, float offset) {
+    (void)scale; (void)offset;
+    const uint16_t* s = (const uint16_t*)src;
+    float* d = (float*)dst;
+    size_t i = 0;
+
+#if defined(NEURAX_HAVE_X86_DISPATCH)
+    if (neurax_cpu_has_f16c()) {
+        convert_F16_F32_f16c(s, d, count);
+        return;
+    }
+#elif defined(NEURAX_HAVE_NEON_FP16)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(d + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(s + i))));
+    }
+#endif
+
+    for (; i < count; i++) {
+        d[i] = neurax_fp16_to_fp32(s[i]);
+    }
+}
+
+static void convert_F32_F16(const void* src, void* dst, size_t count,
+                            float scale, float offset) {
+    (void)scale; (void)offset;
+    const float* s = (const float*)src;
+    uint16_t* d = (uint16_t*)dst;
+    size_t i = 0;
+
+#if defined(NEURAX_HAVE_X86_DISPATCH)
+    if (neurax_cpu_has_f16c()) {
+        convert_F32_F16_f16c(s, d, count);
+        return;
+    }
+#elif defined(NEURAX_HAVE_NEON_FP16)
+    for (; i + 4 <= count; i += 4) {
+        vst1_u16(d + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(s + i))));
+    }
+#endif
+
+    for (; i < count; i++) {
+        d[i] = neurax_fp32_to_fp16(s[i]);
+    }
+}
+
+static void convert_BF16_F32(const void* src, void* dst, size_t count,
+                             float scale, float offset) {
+    (void)scale; (void)offset;
+    const uint16_t* s = (const uint16_t*)src;
+    uint32_t* d = (uint32_t*)dst;
+    for (size_t i = 0; i < count; i++) {
+        d[i] = (uint32_t)s[i] << 16;
+    }
+}
+
+static void convert_F32_BF16(const void* src, void* dst, size_t count,
+                             float scale, float offset) {
+    (void)scale; (void)offset;
+    const float* s = (const float*)src;
+    uint16_t* d = (uint16_t*)dst;
+
+#if defined(NEURAX_HAVE_X86_DISPATCH)
+    if (neurax_cpu_has_avx512bf16()) {
+        convert_F32_BF16_avx512(s, d, count);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i++) {
+        d[i] = neurax_fp32_to_bf16(s[i]);
+    }
+}
+
+#define NEURAX_NUM_DATA_TYPES (NEURAX_DATA_BFLOAT16 + 1)
+
+// Plain conversions, indexed [src_type][dst_type]; same-type entries are memcpy.
+// Pairs with a half type and no dedicated loop reuse the scaled loop with
+// scale 1 and offset 0.
+static const neurax_convert_fn convert_table[NEURAX_NUM_DATA_TYPES][NEURAX_NUM_DATA_TYPES] = {
+
+    [NEURAX_DATA_UINT8] = {
+        [NEURAX_DATA_INT8] = convert_U8_I8,   [NEURAX_DATA_UINT16] = convert_U8_U16,
+        [NEURAX_DATA_INT16] = convert_U8_I16, [NEURAX_DATA_FLOAT32] = convert_U8_F32,
+        [NEURAX_DATA_FLOAT16] = affine_U8_F16, [NEURAX_DATA_BFLOAT16] = affine_U8_BF16,
+    },
+    [NEURAX_DATA_INT8] = {
+        [NEURAX_DATA_UINT8] = convert_I8_U8,  [NEURAX_DATA_UINT16] = convert_I8_U16,
+        [NEURAX_DATA_INT16] = convert_I8_I16, [NEURAX_DATA_FLOAT32] = convert_I8_F32,
+        [NEURAX_DATA_FLOAT16] = affine_I8_F16, [NEURAX_DATA_BFLOAT16] = affine_I8_BF16,
+    },
+    [NEURAX_DATA_UINT16] = {
+        [NEURAX_DATA_UINT8] = convert_U16_U8, [NEURAX_DATA_INT8] = convert_U16_I8,
+        [NEURAX_DATA_INT16] = convert_U16_I16, [NEURAX_DATA_FLOAT32] = convert_U16_F32,
+        [NEURAX_DATA_FLOAT16] = affine_U16_F16, [NEURAX_DATA_BFLOAT16] = affine_U16_BF16,
+    },
+    [NEURAX_DATA_INT16] = {
+        [NEURAX_DATA_UINT8] = convert_I16_U8, [NEURAX_DATA_INT8] = convert_I16_I8,
+        [NEURAX_DATA_UINT16] = convert_I16_U16, [NEURAX_DATA_FLOAT32] = convert_I16_F32,
+        [NEURAX_DATA_FLOAT16] = affine_I16_F16, [NEURAX_DATA_BFLOAT16] = affine_I16_BF16,
+    },
+    [NEURAX_DATA_FLOAT32] = {
+        [NEURAX_DATA_UINT8] = convert_F32_U8, [NEURAX_DATA_INT8] = convert_F32_I8,
+        [NEURAX_DATA_UINT16] = convert_F32_U16, [NEURAX_DATA_INT16] = convert_F32_I16,
+        [NEURAX_DATA_FLOAT16] = convert_F32_F16, [NEURAX_DATA_BFLOAT16] = convert_F32_BF16,
+    },
+    [NEURAX_DATA_FLOAT16] = {
+        [NEURAX_DATA_UINT8] = affine_F16_U8, [NEURAX_DATA_INT8] = affine_F16_I8,
+        [NEURAX_DATA_UINT16] = affine_F16_U16, [NEURAX_DATA_INT16] = affine_F16_I16,
+        [NEURAX_DATA_FLOAT32] = convert_F16_F32, [NEURAX_DATA_BFLOAT16] = affine_F16_BF16,
+    },
+    [NEURAX_DATA_BFLOAT16] = {
+        [NEURAX_DATA_UINT8] = affine_BF16_U8, [NEURAX_DATA_INT8] = affine_BF16_I8,
+        [NEURAX_DATA_UINT16] = affine_BF16_U16, [NEURAX_DATA_INT16] = affine_BF16_I16,
+        [NEURAX_DATA_FLOAT32] = convert_BF16_F32, [NEURAX_DATA_FLOAT16] = affine_BF16_F16,
+    },
+};
+
+// Scaled conversions, indexed [src_type][dst_type]
+static const neurax_convert_fn affine_table[NEURAX_NUM_DATA_TYPES][NEURAX_NUM_DATA_TYPES] = {
+    [NEURAX_DATA_UINT8] = {
+        affine_U8_U8, affine_U8_I8, affine_U8_U16, affine_U8_I16, affine_U8_F32,
+        affine_U8_F16, affine_U8_BF16
+    },
+    [NEURAX_DATA_INT8] = {
+        affine_I8_U8, affine_I8_I8, affine_I8_U16, affine_I8_I16, affine_I8_F32,
+        affine_I8_F16, affine_I8_BF16
+    },
+    [NEURAX_DATA_UINT16] = {
+        affine_U16_U8, affine_U16_I8, affine_U16_U16, affine_U16_I16, affine_U16_F32,
+        affine_U16_F16, affine_U16_BF16
+    },
+    [NEURAX_DATA_INT16] = {
+        affine_I16_U8, affine_I16_I8, affine_I16_U16, affine_I16_I16, affine_I16_F32,
+        affine_I16_F16, affine_I16_BF16
+    },
+    [NEURAX_DATA_FLOAT32] = {
+        affine_F32_U8, affine_F32_I8, affine_F32_U16, affine_F32_I16, affine_F32_F32,
+        affine_F32_F16, affine_F32_BF16
+    },
+    [NEURAX_DATA_FLOAT16] = {
+        affine_F16_U8, affine_F16_I8, affine_F16_U16, affine_F16_I16, affine_F16_F32,
+        affine_F16_F16, affine_F16_BF16
+    },
+    [NEURAX_DATA_BFLOAT16] = {
+        affine_BF16_U8, affine_BF16_I8, affine_BF16_U16, affine_BF16_I16, affine_BF16_F32,
+        affine_BF16_F16, affine_BF16_BF16
+    },
+};
+
+// Work description shared by all conversion threads
+typedef struct {
+    neurax_convert_fn fn;
+    const uint8_t* src;
+    uint8_t* dst;
+    size_t src_element_size;
+    size_t dst_element_size;
+    float scale;
+    float offset;
+} neurax_convert_job_t;
+
+static void neurax_convert_range(void* ctx, size_t begin, size_t end) {
+    const neurax_convert_job_t* job = (const neurax_convert_job_t*)ctx;
+    job->fn(job->src + begin * job->src_element_size,
+            job->dst + begin * job->dst_element_size,
+            end - begin, job->scale, job->offset);
+}
+
+static neurax_error_t neurax_convert_dispatch(const void* src, neurax_data_type_t src_type,
+                                              void* dst, neurax_data_type_t dst_type,
+                                              size_t num_elements, bool affine,
+                                              float scale, float offset) {
+    if (!src || !dst || num_elements == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if ((unsigned)src_type >= NEURAX_NUM_DATA_TYPES || (unsigned)dst_type >= NEURAX_NUM_DATA_TYPES) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_convert_job_t job;
+    job.fn = affine ? affine_table[src_type][dst_type] : convert_table[src_type][dst_type];
+    job.src = (const uint8_t*)src;
+    job.dst = (uint8_t*)dst;
+    job.src_element_size = neurax_get_element_size(src_type);
+    job.dst_element_size = neurax_get_element_size(dst_type);
+    job.scale = scale;
+    job.offset = offset;
+
+    // If types are the same and no scaling is requested, just copy
+    if (!job.fn) {
+        memcpy(dst, src, num_elements * job.src_element_size);
+        return NEURAX_SUCCESS;
+    }
+
+    neurax_parallel_for(num_elements, NEURAX_CONVERT_GRAIN, NEURAX_CONVERT_PARALLEL_MIN,
+                        neurax_convert_range, &job);
+    return NEURAX_SUCCESS;
+}
+
+// Data type conversion
+neurax_error_t neurax_convert_data_type(const void* src, neurax_data_type_t src_type,
+                                       void* dst, neurax_data_type_t dst_type,
+                                       size_t num_elements) {
+    return neurax_convert_dispatch(src, src_type, dst, dst_type, num_elements,
+                                   false, 1.0f, 0.0f);
+}
+
+// Data type conversion with normalization
+neurax_error_t neurax_convert_data_type_scaled(const void* src, neurax_data_type_t src_type,
+                                              void* dst, neurax_data_type_t dst_type,
+                                              size_t num_elements,
+                                              float scale, float offset) {
+    bool affine = (scale != 1.0f || offset != 0.0f);
+    return neurax_convert_dispatch(src, src_type, dst, dst_type, num_elements,
+                                   affine, scale, offset);
+}
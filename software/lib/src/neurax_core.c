@@ -15,9 +15,11 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
 
 // Version string
-static const char* version_string = "NEURAX v1.0.0";
+static const char* version_string = "NEURAX v2.0.0";
 
 // Error strings
 static const char* error_strings[] = {
@@ -29,13 +31,17 @@ static const char* error_strings[] = {
     "Hardware failure",
     "Timeout",
     "Invalid model",
-    "Buffer overflow"
+    "Buffer overflow",
+    "I/O error"
 };
 
 // Device paths
 #define NEURAX_DEVICE_PATH "/dev/neurax0"
 #define NEURAX_UIO_PATH "/dev/uio0"
 
+// Status polling interval when no completion interrupt is available
+#define NEURAX_POLL_INTERVAL_US 100
+
 // Forward declarations
 static neurax_error_t neurax_device_open(neurax_device_t* device);
 static neurax_error_t neurax_device_close(neurax_device_t* device);
@@ -59,19 +65,61 @@ neurax_error_t neurax_init(const neurax_config_t* config, neurax_device_t** devi
     dev->device_fd = -1;
     dev->mapped_memory = NULL;
     dev->register_base = NULL;
+    dev->wait.irq_fd = -1;
+    
+    dev->memory = neurax_memory_create(config->memory_budget);
+    if (!dev->memory) {
+        free(dev);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    neurax_error_t error = neurax_workspace_init(&dev->workspace);
+    if (error != NEURAX_SUCCESS) {
+        neurax_memory_retire(dev->memory);
+        free(dev);
+        return error;
+    }
+    
+    error = neurax_dma_init(&dev->dma);
+    if (error != NEURAX_SUCCESS) {
+        neurax_workspace_destroy(dev);
+        neurax_memory_retire(dev->memory);
+        free(dev);
+        return error;
+    }
     
     // Open device
-    neurax_error_t error = neurax_device_open(dev);
+    error = neurax_device_open(dev);
     if (error != NEURAX_SUCCESS) {
+        neurax_dma_destroy(&dev->dma);
+        neurax_workspace_destroy(dev);
+        neurax_memory_retire(dev->memory);
         free(dev);
         return error;
     }
     
+    // Submission queue; its worker thread starts with the first asynchronous operation
+    pthread_mutex_init(&dev->hw_lock, NULL);
+    dev->queue = neurax_queue_create(dev);
+    if (!dev->queue) {
+        pthread_mutex_destroy(&dev->hw_lock);
+        neurax_device_close(dev);
+        neurax_dma_destroy(&dev->dma);
+        neurax_workspace_destroy(dev);
+        neurax_memory_retire(dev->memory);
+        free(dev);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    
     // Reset hardware
     NEURAX_WRITE_REG(dev, NEURAX_REG_CONTROL, CTRL_RESET);
     usleep(1000); // Wait 1ms
     NEURAX_WRITE_REG(dev, NEURAX_REG_CONTROL, 0);
     
+    if (dev->config.use_tensor_pool) {
+        neurax_pool_attach(&dev->config);
+    }
+    
     dev->initialized = true;
     *device = dev;
     
@@ -88,15 +136,32 @@ neurax_error_t neurax_cleanup(neurax_device_t* device) {
     }
     
     if (device->initialized) {
+        // The queue cannot be joined from its own worker
+        if (neurax_queue_on_worker(device->queue)) {
+            NEURAX_LOG_ERROR("neurax_cleanup called from a completion callback of the same device");
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+
+        // Let queued operations finish while the device is still usable
+        neurax_queue_destroy(device->queue);
+        device->queue = NULL;
+        
         // Reset hardware
         if (device->hardware_available) {
             NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, CTRL_RESET);
         }
         
         neurax_device_close(device);
+        if (device->config.use_tensor_pool) {
+            neurax_pool_detach();
+        }
         device->initialized = false;
     }
     
+    neurax_dma_destroy(&device->dma);
+    neurax_workspace_destroy(device);
+    neurax_memory_retire(device->memory);
+    pthread_mutex_destroy(&device->hw_lock);
     free(device);
     return NEURAX_SUCCESS;
 }
@@ -119,11 +184,71 @@ neurax_error_t neurax_tensor_create(uint32_t width, uint32_t height,
                                    uint32_t channels, uint32_t batch_size,
                                    neurax_data_type_t data_type,
                                    neurax_tensor_t** tensor) {
-    if (!tensor || width == 0 || height == 0 || channels == 0 || batch_size == 0) {
+    return neurax_tensor_create_layout(width, height, channels, batch_size, data_type,
+                                       NEURAX_LAYOUT_NHWC, tensor);
+}
+
+// Byte size of a dense tensor of the given shape, type and layout
+neurax_error_t neurax_tensor_compute_size(uint32_t width, uint32_t height,
+                                          uint32_t channels, uint32_t batch_size,
+                                          neurax_data_type_t data_type,
+                                          neurax_layout_t layout,
+                                          size_t* size) {
+    if (width == 0 || height == 0 || channels == 0 || batch_size == 0 ||
+        layout > NEURAX_LAYOUT_OIHW) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    // Calculate data size based on type
+    size_t element_size = neurax_get_element_size(data_type);
+    if (element_size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    // Blocked layouts round channels up to whole blocks
+    uint32_t block = neurax_layout_block_size(layout);
+    size_t stored_channels = block ? ((size_t)channels + block - 1) / block * block : channels;
+    
+    // Sizes are computed in size_t; shapes whose byte size does not fit are rejected
+    if (!neurax_size_mul((size_t)width, height, size) ||
+        !neurax_size_mul(*size, stored_channels, size) ||
+        !neurax_size_mul(*size, batch_size, size) ||
+        !neurax_size_mul(*size, element_size, size)) {
+        NEURAX_LOG_ERROR("Tensor %ux%ux%ux%u overflows the address space",
+                         width, height, channels, batch_size);
+        return NEURAX_ERROR_BUFFER_OVERFLOW;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+// Zeroed header with its bookkeeping state in the same block; free() releases both
+neurax_tensor_t* neurax_tensor_alloc_block(void) {
+    neurax_tensor_block_t* block = calloc(1, sizeof(neurax_tensor_block_t));
+    if (!block) {
+        return NULL;
+    }
+    block->tensor.state = &block->state;
+    return &block->tensor;
+}
+
+// Allocate a tensor header and derive its size and strides; data is left to the caller
+static neurax_error_t neurax_tensor_alloc_header(uint32_t width, uint32_t height,
+                                                uint32_t channels, uint32_t batch_size,
+                                                neurax_data_type_t data_type,
+                                                neurax_layout_t layout,
+                                                neurax_tensor_t** tensor) {
+    if (!tensor) {
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    neurax_tensor_t* t = calloc(1, sizeof(neurax_tensor_t));
+    size_t data_size;
+    neurax_error_t error = neurax_tensor_compute_size(width, height, channels, batch_size,
+                                                      data_type, layout, &data_size);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    size_t element_size = neurax_get_element_size(data_type);
+    neurax_tensor_t* t = neurax_tensor_alloc_block();
     if (!t) {
         return NEURAX_ERROR_MEMORY_ALLOCATION;
     }
@@ -133,33 +258,139 @@ neurax_error_t neurax_tensor_create(uint32_t width, uint32_t height,
     t->channels = channels;
     t->batch_size = batch_size;
     t->data_type = data_type;
+    t->layout = layout;
+    t->data_size = data_size;
+    
+    // Planar storage is NHWC with channel-major strides, so strided kernels accept it as is
+    if (layout == NEURAX_LAYOUT_NCHW) {
+        t->strides[NEURAX_DIM_WIDTH] = element_size;
+        t->strides[NEURAX_DIM_HEIGHT] = element_size * width;
+        t->strides[NEURAX_DIM_CHANNEL] = element_size * width * height;
+        t->strides[NEURAX_DIM_BATCH] = element_size * width * height * channels;
+    }
     
-    // Calculate data size based on type
-    size_t element_size;
-    switch (data_type) {
-        case NEURAX_DATA_UINT8:
-        case NEURAX_DATA_INT8:
-            element_size = 1;
-            break;
-        case NEURAX_DATA_UINT16:
-        case NEURAX_DATA_INT16:
-            element_size = 2;
-            break;
-        case NEURAX_DATA_FLOAT32:
-            element_size = 4;
-            break;
-        default:
+    *tensor = t;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_create_layout(uint32_t width, uint32_t height,
+                                          uint32_t channels, uint32_t batch_size,
+                                          neurax_data_type_t data_type,
+                                          neurax_layout_t layout,
+                                          neurax_tensor_t** tensor) {
+    return neurax_tensor_create_ex(width, height, channels, batch_size, data_type, layout,
+                                   NEURAX_TENSOR_DEFAULT, 0, tensor);
+}
+
+neurax_error_t neurax_tensor_create_ex(uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_layout_t layout,
+                                      uint32_t flags, size_t alignment,
+                                      neurax_tensor_t** tensor) {
+    // Charged to the default device: OIHW tensors are weights, the rest activations
+    neurax_memory_t* memory = (flags & NEURAX_TENSOR_UNTRACKED) ? NULL : neurax_memory_default();
+    neurax_memory_category_t category = layout == NEURAX_LAYOUT_OIHW ? NEURAX_MEMORY_WEIGHTS
+                                                                      : NEURAX_MEMORY_ACTIVATIONS;
+    neurax_error_t error = neurax_tensor_create_charged(width, height, channels, batch_size,
+                                                        data_type, layout, flags, alignment,
+                                                        memory, category, tensor);
+    neurax_memory_release(memory);
+    return error;
+}
+
+neurax_error_t neurax_tensor_create_weights(uint32_t width, uint32_t height,
+                                            uint32_t channels, uint32_t batch_size,
+                                            neurax_data_type_t data_type,
+                                            neurax_layout_t layout,
+                                            neurax_tensor_t** tensor) {
+    neurax_memory_t* memory = neurax_memory_default();
+    neurax_error_t error = neurax_tensor_create_charged(width, height, channels, batch_size,
+                                                        data_type, layout, NEURAX_TENSOR_DEFAULT,
+                                                        0, memory, NEURAX_MEMORY_WEIGHTS, tensor);
+    neurax_memory_release(memory);
+    return error;
+}
+
+neurax_error_t neurax_tensor_create_charged(uint32_t width, uint32_t height,
+                                            uint32_t channels, uint32_t batch_size,
+                                            neurax_data_type_t data_type,
+                                            neurax_layout_t layout,
+                                            uint32_t flags, size_t alignment,
+                                            neurax_memory_t* memory,
+                                            neurax_memory_category_t category,
+                                            neurax_tensor_t** tensor) {
+    if (flags & ~(uint32_t)(NEURAX_TENSOR_NO_INIT | NEURAX_TENSOR_HUGEPAGE |
+                            NEURAX_TENSOR_UNTRACKED)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    neurax_tensor_t* t = NULL;
+    neurax_error_t error = neurax_tensor_alloc_header(width, height, channels, batch_size,
+                                                      data_type, layout, &t);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    // Charge first so an over-budget request fails before touching the allocator
+    error = neurax_memory_charge_to(memory, category, t->data_size);
+    if (error != NEURAX_SUCCESS) {
+        free(t);
+        return error;
+    }
+    
+    // The pool hands out 64-byte aligned buffers of regular pages
+    bool poolable = !(flags & NEURAX_TENSOR_HUGEPAGE) && alignment <= NEURAX_TENSOR_ALIGNMENT &&
+                    (alignment & (alignment - 1)) == 0;
+    t->data = poolable ? neurax_pool_alloc(t->data_size, &t->state->pool_class) : NULL;
+    if (t->data) {
+        if (!(flags & NEURAX_TENSOR_NO_INIT)) {
+            memset(t->data, 0, t->data_size);
+        }
+    } else {
+        error = neurax_alloc_tensor_data(t->data_size, alignment, flags, &t->data);
+        if (error != NEURAX_SUCCESS) {
+            neurax_memory_uncharge_from(memory, category, t->data_size);
             free(t);
-            return NEURAX_ERROR_INVALID_PARAM;
+            return error;
+        }
     }
+    t->state->owns_data = true;
+    t->state->memory = neurax_memory_retain(memory);
+    t->state->memory_category = category;
     
-    t->data_size = width * height * channels * batch_size * element_size;
-    t->data = calloc(1, t->data_size);
-    if (!t->data) {
+    *tensor = t;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_wrap(void* data, size_t size,
+                                 uint32_t width, uint32_t height,
+                                 uint32_t channels, uint32_t batch_size,
+                                 neurax_data_type_t data_type,
+                                 neurax_layout_t layout,
+                                 neurax_wrap_flags_t flags,
+                                 neurax_tensor_deleter_t deleter,
+                                 void* user_data,
+                                 neurax_tensor_t** tensor) {
+    if (!data || flags > NEURAX_WRAP_TAKE_OWNERSHIP) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    neurax_tensor_t* t = NULL;
+    neurax_error_t error = neurax_tensor_alloc_header(width, height, channels, batch_size,
+                                                      data_type, layout, &t);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    if (size < t->data_size) {
+        NEURAX_LOG_ERROR("Wrapped buffer of %zu bytes is smaller than the %zu-byte tensor",
+                         size, t->data_size);
         free(t);
-        return NEURAX_ERROR_MEMORY_ALLOCATION;
+        return NEURAX_ERROR_BUFFER_OVERFLOW;
     }
     
+    t->data = data;
+    t->state->owns_data = flags == NEURAX_WRAP_TAKE_OWNERSHIP;
+    t->state->deleter = deleter;
+    t->state->deleter_data = user_data;
+    
     *tensor = t;
     return NEURAX_SUCCESS;
 }
@@ -169,19 +400,199 @@ neurax_error_t neurax_tensor_destroy(neurax_tensor_t* tensor) {
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    if (tensor->data) {
+    struct neurax_tensor_state* state = tensor->state;
+    
+    if (state && state->map_count != 0) {
+        NEURAX_LOG_ERROR("Destroying tensor with %u outstanding mappings", state->map_count);
+    }
+    
+    // Workspace tensors are released with their workspace
+    if (state && state->in_workspace) {
+        free(tensor->quant.channel_scales);
+        tensor->quant.channel_scales = NULL;
+        return NEURAX_SUCCESS;
+    }
+    
+    if (state && state->memory) {
+        neurax_memory_uncharge_from(state->memory, state->memory_category, tensor->data_size);
+        neurax_memory_release(state->memory);
+    }
+    
+    // Caller-built headers keep the original contract: data and header are free()d
+    if (!state) {
         free(tensor->data);
+    } else if (tensor->data && state->owns_data) {
+        if (state->deleter) {
+            state->deleter(tensor->data, state->deleter_data);
+        } else if (state->pool_class != 0) {
+            neurax_pool_release(tensor->data, state->pool_class);
+        } else {
+            neurax_free_aligned(tensor->data);
+        }
     }
+    free(tensor->quant.channel_scales);
     free(tensor);
     
     return NEURAX_SUCCESS;
 }
 
+neurax_error_t neurax_tensor_map(neurax_tensor_t* tensor, neurax_map_access_t access,
+                                void** data, size_t* size) {
+    if (!data || access < NEURAX_MAP_READ || access > NEURAX_MAP_READ_WRITE) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    neurax_error_t error = access == NEURAX_MAP_READ ? neurax_validate_tensor(tensor)
+                                                     : neurax_validate_output(tensor);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    // Only library-created tensors count their mappings
+    if (tensor->state) {
+        tensor->state->map_count++;
+    }
+    *data = tensor->data;
+    if (size) {
+        *size = tensor->data_size;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_unmap(neurax_tensor_t* tensor) {
+    if (!tensor) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    if (!tensor->state) {
+        return NEURAX_SUCCESS;
+    }
+    
+    if (tensor->state->map_count == 0) {
+        NEURAX_LOG_ERROR("Tensor is not mapped");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    tensor->state->map_count--;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_view_strided(neurax_tensor_t* parent, size_t byte_offset,
+                                         uint32_t width, uint32_t height,
+                                         uint32_t channels, uint32_t batch_size,
+                                         const size_t strides[4],
+                                         neurax_tensor_t** view) {
+    if (!view || !strides || width == 0 || height == 0 || channels == 0 || batch_size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    neurax_error_t error = neurax_validate_tensor(parent);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_layout(parent, false);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    neurax_tensor_t* v = neurax_tensor_alloc_block();
+    if (!v) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    size_t element_size = neurax_get_element_size(parent->data_type);
+    
+    v->width = width;
+    v->height = height;
+    v->channels = channels;
+    v->batch_size = batch_size;
+    v->data_type = parent->data_type;
+    v->data = (uint8_t*)parent->data + byte_offset;
+    v->state->is_view = true;
+    v->state->read_only = parent->state && parent->state->read_only;
+    
+    // A zero channel stride marks dense storage, so give single-channel views a real one
+    for (int d = 0; d < 4; d++) {
+        v->strides[d] = strides[d];
+    }
+    if (v->strides[NEURAX_DIM_CHANNEL] == 0) {
+        v->strides[NEURAX_DIM_CHANNEL] = element_size;
+    }
+    
+    // Span from the first to the last element of the view
+    const uint32_t dims[4] = {channels, width, height, batch_size};
+    v->data_size = element_size;
+    for (int d = 0; d < 4; d++) {
+        v->data_size += (size_t)(dims[d] - 1) * v->strides[d];
+    }
+    
+    error = neurax_validate_tensor(v);
+    if (error == NEURAX_SUCCESS &&
+        (byte_offset > parent->data_size || v->data_size > parent->data_size - byte_offset)) {
+        NEURAX_LOG_ERROR("View of %zu bytes at offset %zu exceeds parent of %zu bytes",
+                         v->data_size, byte_offset, parent->data_size);
+        error = NEURAX_ERROR_BUFFER_OVERFLOW;
+    }
+    if (error != NEURAX_SUCCESS) {
+        free(v);
+        return error;
+    }
+    
+    // Per-tensor quantization carries over; per-channel scales belong to the parent
+    v->quant.scale = parent->quant.scale;
+    v->quant.zero_point = parent->quant.zero_point;
+    
+    *view = v;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_view(neurax_tensor_t* parent,
+                                 uint32_t x, uint32_t y, uint32_t c, uint32_t n,
+                                 uint32_t width, uint32_t height,
+                                 uint32_t channels, uint32_t batch_size,
+                                 neurax_tensor_t** view) {
+    neurax_error_t error = neurax_validate_tensor(parent);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    if (x >= parent->width || width > parent->width - x ||
+        y >= parent->height || height > parent->height - y ||
+        c >= parent->channels || channels > parent->channels - c ||
+        n >= parent->batch_size || batch_size > parent->batch_size - n) {
+        NEURAX_LOG_ERROR("View [%u,%u,%u,%u] + %ux%ux%ux%u out of range for %ux%ux%ux%u tensor",
+                         x, y, c, n, width, height, channels, batch_size,
+                         parent->width, parent->height, parent->channels, parent->batch_size);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    size_t strides[4];
+    neurax_tensor_get_strides(parent, strides);
+    
+    return neurax_tensor_view_strided(parent, neurax_tensor_byte_offset(parent, n, y, x, c),
+                                      width, height, channels, batch_size, strides, view);
+}
+
+neurax_error_t neurax_tensor_channel_slice(neurax_tensor_t* parent, uint32_t channel_offset,
+                                          uint32_t channels, neurax_tensor_t** view) {
+    if (!parent) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    return neurax_tensor_view(parent, 0, 0, channel_offset, 0,
+                              parent->width, parent->height, channels, parent->batch_size, view);
+}
+
 neurax_error_t neurax_tensor_set_data(neurax_tensor_t* tensor, const void* data, size_t size) {
     if (!tensor || !data) {
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
+    if (tensor->state && tensor->state->read_only) {
+        NEURAX_LOG_ERROR("Tensor is read-only; write to a copy instead");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    // Raw copies need one dense block: any non-view tensor, in its own layout
+    if (neurax_tensor_is_view(tensor)) {
+        neurax_error_t error = neurax_validate_contiguous(tensor);
+        if (error != NEURAX_SUCCESS) return error;
+    }
+    
     if (size > tensor->data_size) {
         return NEURAX_ERROR_BUFFER_OVERFLOW;
     }
@@ -195,6 +606,12 @@ neurax_error_t neurax_tensor_get_data(const neurax_tensor_t* tensor, void* data,
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
+    // Raw copies need one dense block: any non-view tensor, in its own layout
+    if (neurax_tensor_is_view(tensor)) {
+        neurax_error_t error = neurax_validate_contiguous(tensor);
+        if (error != NEURAX_SUCCESS) return error;
+    }
+    
     if (size > tensor->data_size) {
         return NEURAX_ERROR_BUFFER_OVERFLOW;
     }
@@ -206,6 +623,17 @@ neurax_error_t neurax_tensor_get_data(const neurax_tensor_t* tensor, void* data,
 // Private helper functions
 
 neurax_error_t neurax_device_open(neurax_device_t* device) {
+    // The simulator stands in for the device nodes when requested
+    if (neurax_sim_requested(&device->config)) {
+        device->sim = neurax_sim_create(device);
+        if (!device->sim) {
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        printf("NEURAX: Using the simulated accelerator\n");
+        device->hardware_available = true;
+        return NEURAX_SUCCESS;
+    }
+    
     // Try to open hardware device first
     device->device_fd = open(NEURAX_DEVICE_PATH, O_RDWR);
     if (device->device_fd < 0) {
@@ -216,6 +644,9 @@ neurax_error_t neurax_device_open(neurax_device_t* device) {
             device->hardware_available = false;
             return NEURAX_SUCCESS;
         }
+        
+        // Reads on a UIO node block until the next interrupt
+        device->wait.irq_fd = device->device_fd;
     }
     
     // Map device memory
@@ -247,55 +678,118 @@ static neurax_error_t neurax_device_close(neurax_device_t* device) {
         munmap(device->mapped_memory, device->mapped_size);
         device->mapped_memory = NULL;
     }
+    device->register_base = NULL;
+    device->wait.irq_fd = -1;
     
     if (device->device_fd >= 0) {
         close(device->device_fd);
         device->device_fd = -1;
     }
     
+    neurax_sim_destroy(device->sim);
+    device->sim = NULL;
+    
     device->hardware_available = false;
     return NEURAX_SUCCESS;
 }
 
 void neurax_write_reg(neurax_device_t* device, uint32_t offset, uint32_t value) {
-    if (device->hardware_available && device->register_base) {
+    if (offset / 4 < NEURAX_NUM_REGS) {
+        device->registers[offset / 4] = value;
+    }
+    
+    if (device->sim) {
+        neurax_sim_write(device->sim, offset, value);
+    } else if (device->hardware_available && device->register_base) {
         device->register_base[offset / 4] = value;
     }
-    // For CPU emulation, we would implement register emulation here
 }
 
 uint32_t neurax_read_reg(neurax_device_t* device, uint32_t offset) {
+    if (device->sim) {
+        return neurax_sim_read(device->sim, offset);
+    }
     if (device->hardware_available && device->register_base) {
         return device->register_base[offset / 4];
     }
-    // For CPU emulation, we would implement register emulation here
     return 0;
 }
 
-neurax_error_t neurax_wait_for_completion(neurax_device_t* device, uint32_t timeout_ms) {
+uint64_t neurax_time_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+// Unmask the UIO interrupt; the generic UIO driver masks it again after each delivery
+void neurax_irq_arm(neurax_device_t* device) {
+    uint32_t enable = 1;
+    
+    if (device->wait.irq_fd >= 0 &&
+        write(device->wait.irq_fd, &enable, sizeof(enable)) != sizeof(enable)) {
+        NEURAX_LOG_ERROR("Cannot enable the completion interrupt (%s), polling instead",
+                         strerror(errno));
+        device->wait.irq_fd = -1;
+    }
+}
+
+// Block until the interrupt fires or the deadline passes; the caller rechecks the status
+static void neurax_irq_wait(neurax_device_t* device, uint64_t remaining_ns) {
+    struct pollfd pfd = {.fd = device->wait.irq_fd, .events = POLLIN};
+    int timeout = (int)((remaining_ns + 999999) / 1000000);
+    
+    int ready = poll(&pfd, 1, timeout);
+    if (ready > 0) {
+        uint32_t count;
+        if (read(device->wait.irq_fd, &count, sizeof(count)) == sizeof(count)) {
+            neurax_irq_arm(device);
+        }
+    } else if (ready < 0 && errno != EINTR) {
+        NEURAX_LOG_ERROR("Waiting for the completion interrupt failed (%s), polling instead",
+                         strerror(errno));
+        device->wait.irq_fd = -1;
+    }
+}
+
+// Wait for DONE or ERROR: busy-spin for up to spin_ns, then block on the interrupt (or
+// sleep between status reads) until timeout_ms has passed on the monotonic clock
+neurax_error_t neurax_wait_for_completion(neurax_device_t* device, uint64_t spin_ns,
+                                          uint32_t timeout_ms) {
     if (!device->hardware_available) {
         return NEURAX_SUCCESS; // CPU emulation is assumed to complete immediately
     }
     
-    uint32_t elapsed = 0;
-    const uint32_t poll_interval_us = 100; // 100 microseconds
+    uint64_t start = neurax_time_ns();
+    uint64_t spin_end = start + spin_ns;
+    uint64_t deadline = start + (uint64_t)timeout_ms * 1000000ull;
     
-    while (elapsed < timeout_ms * 1000) {
+    for (;;) {
         uint32_t status = neurax_read_reg(device, NEURAX_REG_STATUS);
+        uint64_t now = neurax_time_ns();
         
-        if (status & STAT_ERROR) {
-            return NEURAX_ERROR_HARDWARE_FAILURE;
+        if (status & (STAT_ERROR | STAT_DONE)) {
+            if (now <= spin_end) {
+                device->wait.spin_completions++;
+            } else {
+                device->wait.block_completions++;
+            }
+            return (status & STAT_ERROR) ? NEURAX_ERROR_HARDWARE_FAILURE : NEURAX_SUCCESS;
         }
         
-        if (status & STAT_DONE) {
-            return NEURAX_SUCCESS;
+        if (now >= deadline) {
+            return NEURAX_ERROR_TIMEOUT;
+        }
+        
+        if (now < spin_end) {
+            continue;
         }
         
-        usleep(poll_interval_us);
-        elapsed += poll_interval_us;
+        if (device->wait.irq_fd >= 0) {
+            neurax_irq_wait(device, deadline - now);
+        } else {
+            usleep(NEURAX_POLL_INTERVAL_US);
+        }
     }
-    
-    return NEURAX_ERROR_TIMEOUT;
 }
 
 neurax_error_t neurax_print_device_info(neurax_device_t* device) {
@@ -306,7 +800,8 @@ neurax_error_t neurax_print_device_info(neurax_device_t* device) {
     printf("NEURAX Device Information:\n");
     printf("==========================\n");
     printf("Version: %s\n", neurax_get_version());
-    printf("Hardware acceleration: %s\n", device->hardware_available ? "Yes" : "No (CPU emulation)");
+    printf("Hardware acceleration: %s\n", device->sim ? "Yes (simulated)" :
+           device->hardware_available ? "Yes" : "No (CPU emulation)");
     printf("Base address: 0x%08X\n", device->config.base_address);
     printf("Memory size: %u bytes\n", device->config.memory_size);
     printf("Max kernel size: %u\n", device->config.max_kernel_size);
@@ -319,6 +814,10 @@ neurax_error_t neurax_print_device_info(neurax_device_t* device) {
         printf("  Busy: %s\n", (status & STAT_BUSY) ? "Yes" : "No");
         printf("  Done: %s\n", (status & STAT_DONE) ? "Yes" : "No");
         printf("  Error: %s\n", (status & STAT_ERROR) ? "Yes" : "No");
+        printf("Completion: %s (%llu spun, %llu blocked)\n",
+               device->wait.irq_fd >= 0 ? "interrupt" : "polling",
+               (unsigned long long)device->wait.spin_completions,
+               (unsigned long long)device->wait.block_completions);
     }
     
     return NEURAX_SUCCESS;
@@ -0,0 +1,312 @@
+/*
+ * NEURAX Dense (Fully-Connected) Layer Implementation
+ * GEMV kernel for single inputs and a packed, blocked GEMM kernel for batches
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Blocking parameters: K block, output columns per packed panel, batch rows per micro-tile
+#define NEURAX_DENSE_KC 256
+#define NEURAX_DENSE_NR 8
+#define NEURAX_DENSE_MR 4
+
+// Minimum multiply-accumulates per thread before splitting the work
+#define NEURAX_DENSE_PARALLEL_MACS (128 * 1024)
+
+// Shared state for dense worker threads
+typedef struct {
+    const float* x;                 // [batch][K] fp32 input
+    const neurax_tensor_t* weights; // [N][K] weights of any type
+    float weight_offset;            // -zero_point for quantized weights
+    bool weights_fp32;              // Weights can be read in place
+    float* acc;                     // [batch][N] fp32 accumulators
+    uint32_t batch;
+    uint32_t K;
+    uint32_t N;
+} neurax_dense_job_t;
+
+// Fetch weights[row][k0 .. k0+count) as fp32, converting into buf when needed
+static const float* neurax_dense_weight_block(const neurax_dense_job_t* job, uint32_t row,
+                                              uint32_t k0, uint32_t count, float* buf) {
+    size_t offset = (size_t)row * job->K + k0;
+
+    if (job->weights_fp32) {
+        return (const float*)job->weights->data + offset;
+    }
+
+    size_t element_size = neurax_get_element_size(job->weights->data_type);
+    neurax_convert_data_type_scaled((const uint8_t*)job->weights->data + offset * element_size,
+                                    job->weights->data_type, buf, NEURAX_DATA_FLOAT32, count,
+                                    1.0f, job->weight_offset);
+    return buf;
+}
+
+// Dot product with independent partial sums so the compiler can vectorize it
+static inline float neurax_dense_dot(const float* a, const float* b, uint32_t count) {
+    float partial[8] = {0.0f};
+    uint32_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        for (uint32_t j = 0; j < 8; j++) {
+            partial[j] += a[i + j] * b[i + j];
+        }
+    }
+
+    float sum = ((partial[0] + partial[4]) + (partial[1] + partial[5])) +
+                ((partial[2] + partial[6]) + (partial[3] + partial[7]));
+    for (; i < count; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// GEMV: one weight row per output feature, streamed once
+static void neurax_dense_gemv_rows(void* ctx, size_t begin, size_t end) {
+    const neurax_dense_job_t* job = (const neurax_dense_job_t*)ctx;
+    float buf[NEURAX_DENSE_KC];
+
+    for (size_t row = begin; row < end; row++) {
+        float sum = 0.0f;
+        for (uint32_t k0 = 0; k0 < job->K; k0 += NEURAX_DENSE_KC) {
+            uint32_t kc = job->K - k0 < NEURAX_DENSE_KC ? job->K - k0 : NEURAX_DENSE_KC;
+            const float* w = neurax_dense_weight_block(job, (uint32_t)row, k0, kc, buf);
+            sum += neurax_dense_dot(w, job->x + k0, kc);
+        }
+        job->acc[row] = sum;
+    }
+}
+
+// GEMM: pack an NR-wide weight panel as [k][NR] fp32, then run MR x NR micro-tiles over it
+static void neurax_dense_gemm_panels(void* ctx, size_t begin, size_t end) {
+    const neurax_dense_job_t* job = (const neurax_dense_job_t*)ctx;
+    float packed[NEURAX_DENSE_KC * NEURAX_DENSE_NR];
+    float buf[NEURAX_DENSE_KC];
+    const uint32_t K = job->K;
+    const uint32_t N = job->N;
+
+    for (size_t panel = begin; panel < end; panel++) {
+        uint32_t n0 = (uint32_t)panel * NEURAX_DENSE_NR;
+        uint32_t nr = N - n0 < NEURAX_DENSE_NR ? N - n0 : NEURAX_DENSE_NR;
+
+        for (uint32_t k0 = 0; k0 < K; k0 += NEURAX_DENSE_KC) {
+            uint32_t kc = K - k0 < NEURAX_DENSE_KC ? K - k0 : NEURAX_DENSE_KC;
+
+            // Pack (and widen) the weight panel; missing columns are zero
+            for (uint32_t j = 0; j < NEURAX_DENSE_NR; j++) {
+                if (j < nr) {
+                    const float* w = neurax_dense_weight_block(job, n0 + j, k0, kc, buf);
+                    for (uint32_t k = 0; k < kc; k++) {
+                        packed[k * NEURAX_DENSE_NR + j] = w[k];
+                    }
+                } else {
+                    for (uint32_t k = 0; k < kc; k++) {
+                        packed[k * NEURAX_DENSE_NR + j] = 0.0f;
+                    }
+                }
+            }
+
+            uint32_t b0 = 0;
+            for (; b0 + NEURAX_DENSE_MR <= job->batch; b0 += NEURAX_DENSE_MR) {
+                float tile[NEURAX_DENSE_MR][NEURAX_DENSE_NR] = {{0.0f}};
+                const float* x0 = job->x + (size_t)b0 * K + k0;
+
+                for (uint32_t k = 0; k < kc; k++) {
+                    const float* p = &packed[k * NEURAX_DENSE_NR];
+                    for (uint32_t i = 0; i < NEURAX_DENSE_MR; i++) {
+                        float xv = x0[(size_t)i * K + k];
+                        for (uint32_t j = 0; j < NEURAX_DENSE_NR; j++) {
+                            tile[i][j] += xv * p[j];
+                        }
+                    }
+                }
+
+                for (uint32_t i = 0; i < NEURAX_DENSE_MR; i++) {
+                    float* c = job->acc + (size_t)(b0 + i) * N + n0;
+                    for (uint32_t j = 0; j < nr; j++) {
+                        c[j] += tile[i][j];
+                    }
+                }
+            }
+
+            // Remaining batch rows one at a time
+            for (; b0 < job->batch; b0++) {
+                float tile[NEURAX_DENSE_NR] = {0.0f};
+                const float* x0 = job->x + (size_t)b0 * K + k0;
+
+                for (uint32_t k = 0; k < kc; k++) {
+                    const float* p = &packed[k * NEURAX_DENSE_NR];
+                    for (uint32_t j = 0; j < NEURAX_DENSE_NR; j++) {
+                        tile[j] += x0[k] * p[j];
+                    }
+                }
+
+                float* c = job->acc + (size_t)b0 * N + n0;
+                for (uint32_t j = 0; j < nr; j++) {
+                    c[j] += tile[j];
+                }
+            }
+        }
+    }
+}
+
+// Execute dense layer
+neurax_error_t neurax_dense(neurax_device_t* device,
+                           const neurax_tensor_t* input,
+                           const neurax_tensor_t* weights,
+                           const neurax_tensor_t* bias,
+                           const neurax_dense_config_t* config,
+                           neurax_tensor_t* output) {
+
+    if (!device || !input || !weights || !config || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Validate inputs
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_tensor(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_dense_config(config);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (bias && config->use_bias) {
+        error = neurax_validate_tensor(bias);
+        if (error != NEURAX_SUCCESS) return error;
+
+        if (neurax_tensor_total_elements(bias) < config->output_features) {
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+    }
+
+    // Dense addresses input and output as flat [batch][features] arrays
+    error = neurax_validate_contiguous(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    NEURAX_LOG_INFO("Executing dense: %u -> %u features, batch %u",
+                    config->input_features, config->output_features, input->batch_size);
+
+    // The accelerator has no fully-connected block, so dense always runs on the CPU
+    return neurax_cpu_dense(device, input, weights, bias, config, output);
+}
+
+// CPU implementation
+neurax_error_t neurax_cpu_dense(neurax_device_t* device,
+                               const neurax_tensor_t* input,
+                               const neurax_tensor_t* weights,
+                               const neurax_tensor_t* bias,
+                               const neurax_dense_config_t* config,
+                               neurax_tensor_t* output) {
+
+    NEURAX_LOG_DEBUG("Using CPU implementation for dense");
+
+    const uint32_t batch = input->batch_size;
+    const uint32_t K = config->input_features;
+    const uint32_t N = config->output_features;
+
+    // Input is [batch][K], weights [N][K] (output features in the batch dimension), output [batch][N]
+    if (neurax_tensor_total_elements(input) != (size_t)batch * K ||
+        weights->batch_size != N || neurax_tensor_total_elements(weights) != (size_t)N * K ||
+        output->batch_size != batch || neurax_tensor_total_elements(output) != (size_t)batch * N) {
+        NEURAX_LOG_ERROR("Dense tensor shapes don't match %u -> %u features", K, N);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_dense_job_t job;
+    job.weights = weights;
+    job.weights_fp32 = weights->data_type == NEURAX_DATA_FLOAT32;
+    job.weight_offset = weights->quant.scale > 0.0f ? -(float)weights->quant.zero_point : 0.0f;
+    job.batch = batch;
+    job.K = K;
+    job.N = N;
+
+    // Widen (and dequantize) the input once unless it is already fp32
+    size_t mark = neurax_scratch_mark(device);
+    float* x_buffer = NULL;
+    if (input->data_type == NEURAX_DATA_FLOAT32) {
+        job.x = (const float*)input->data;
+    } else {
+        x_buffer = neurax_scratch_alloc(device, sizeof(float) * batch * K);
+        if (!x_buffer) {
+            neurax_scratch_release(device, mark);
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        float in_scale = input->quant.scale > 0.0f ? input->quant.scale : 1.0f;
+        neurax_convert_data_type_scaled(input->data, input->data_type, x_buffer,
+                                        NEURAX_DATA_FLOAT32, (size_t)batch * K,
+                                        in_scale, -in_scale * input->quant.zero_point);
+        job.x = x_buffer;
+    }
+
+    job.acc = neurax_scratch_alloc(device, sizeof(float) * batch * N);
+    if (!job.acc) {
+        neurax_scratch_free(device, x_buffer);
+        neurax_scratch_release(device, mark);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    memset(job.acc, 0, sizeof(float) * batch * N);
+
+    if (batch == 1) {
+        size_t min_rows = NEURAX_DENSE_PARALLEL_MACS / K + 1;
+        neurax_parallel_for(N, 1, min_rows, neurax_dense_gemv_rows, &job);
+    } else {
+        size_t panels = (N + NEURAX_DENSE_NR - 1) / NEURAX_DENSE_NR;
+        size_t min_panels = NEURAX_DENSE_PARALLEL_MACS / ((size_t)batch * K * NEURAX_DENSE_NR) + 1;
+        neurax_parallel_for(panels, 1, min_panels, neurax_dense_gemm_panels, &job);
+    }
+
+    // Epilogue: dequantization scale, bias, activation and output quantization
+    const float* channel_scales = weights->quant.channel_scales;
+    const float weight_scale = weights->quant.scale > 0.0f ? weights->quant.scale : 1.0f;
+    const bool quantize_output = output->quant.scale > 0.0f &&
+                                 (output->data_type == NEURAX_DATA_INT8 ||
+                                  output->data_type == NEURAX_DATA_UINT8);
+    const float out_inv_scale = quantize_output ? 1.0f / output->quant.scale : 1.0f;
+
+    for (uint32_t b = 0; b < batch; b++) {
+        float* row = job.acc + (size_t)b * N;
+
+        for (uint32_t o = 0; o < N; o++) {
+            float value = row[o] * (channel_scales ? channel_scales[o] : weight_scale);
+            if (config->use_bias && bias) {
+                value += neurax_get_bias_value(bias, o);
+            }
+            row[o] = value;
+        }
+
+        neurax_apply_activation_block(row, N, config->activation);
+
+        if (quantize_output) {
+            for (uint32_t o = 0; o < N; o++) {
+                row[o] = neurax_quantize_value(row[o], out_inv_scale, output->quant.zero_point);
+            }
+        }
+    }
+
+    neurax_convert_data_type(job.acc, NEURAX_DATA_FLOAT32, output->data, output->data_type,
+                             (size_t)batch * N);
+
+    neurax_scratch_free(device, job.acc);
+    neurax_scratch_free(device, x_buffer);
+    neurax_scratch_release(device, mark);
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,343 @@
+/*
+ * NEURAX DMA Memory
+ * Accelerator-visible buffers carved from a u-dma-buf region, or from anonymous
+ * memory with synthetic bus addresses when the driver is not loaded
+ *
+ * Author: NEURAX Team
+ */
+
+#define _GNU_SOURCE
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define NEURAX_DMA_DEFAULT_DEVICE "/dev/udmabuf0"
+#define NEURAX_DMA_DEFAULT_REGION ((size_t)64 << 20)
+
+// Bus address of the anonymous region; low enough for the 32-bit address registers
+#define NEURAX_DMA_ANONYMOUS_BUS_BASE 0x40000000ull
+
+// Read a numeric u-dma-buf attribute (sysfs class name differs between driver versions)
+static bool neurax_dma_read_attr(const char* name, const char* attr, uint64_t* value) {
+    static const char* classes[] = {"u-dma-buf", "udmabuf"};
+    char path[256];
+    char text[64];
+
+    for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+        snprintf(path, sizeof(path), "/sys/class/%s/%s/%s", classes[i], name, attr);
+        FILE* fp = fopen(path, "r");
+        if (!fp) continue;
+
+        bool ok = fgets(text, sizeof(text), fp) != NULL;
+        fclose(fp);
+        if (ok) {
+            *value = strtoull(text, NULL, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Map the u-dma-buf node. Opened with O_SYNC so the mapping is coherent with the
+// accelerator without cache maintenance.
+static bool neurax_dma_open_udmabuf(neurax_dma_t* dma, const char* path) {
+    int fd = open(path, O_RDWR | O_SYNC);
+    if (fd < 0) {
+        return false;
+    }
+
+    const char* name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    uint64_t size = 0;
+    uint64_t phys_addr = 0;
+    if (!neurax_dma_read_attr(name, "size", &size) || size == 0 ||
+        !neurax_dma_read_attr(name, "phys_addr", &phys_addr)) {
+        NEURAX_LOG_ERROR("Cannot read size and phys_addr of %s", path);
+        close(fd);
+        return false;
+    }
+
+    void* base = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        NEURAX_LOG_ERROR("Cannot map %s", path);
+        close(fd);
+        return false;
+    }
+
+    dma->backend = NEURAX_DMA_UDMABUF;
+    dma->base = (uint8_t*)base;
+    dma->size = (size_t)size;
+    dma->bus_address = phys_addr;
+    dma->fd = fd;
+    return true;
+}
+
+// Stand-in region with the same page alignment; pages are committed on first touch
+static neurax_error_t neurax_dma_open_anonymous(neurax_dma_t* dma, size_t size) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    size = (size + (size_t)page_size - 1) & ~((size_t)page_size - 1);
+
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    dma->backend = NEURAX_DMA_ANONYMOUS;
+    dma->base = (uint8_t*)base;
+    dma->size = size;
+    dma->bus_address = NEURAX_DMA_ANONYMOUS_BUS_BASE;
+    dma->fd = -1;
+    return NEURAX_SUCCESS;
+}
+
+// Set up the region on first use. Caller holds the lock.
+static neurax_error_t neurax_dma_setup(neurax_device_t* device) {
+    neurax_dma_t* dma = &device->dma;
+    if (dma->backend != NEURAX_DMA_NONE) {
+        return NEURAX_SUCCESS;
+    }
+
+    const char* path = device->config.dma_device ? device->config.dma_device : NEURAX_DMA_DEFAULT_DEVICE;
+    if (neurax_dma_open_udmabuf(dma, path)) {
+        NEURAX_LOG_INFO("DMA region: %s, %zu bytes at 0x%llx", path, dma->size,
+                        (unsigned long long)dma->bus_address);
+        return NEURAX_SUCCESS;
+    }
+
+    size_t size = device->config.dma_region_size ? device->config.dma_region_size : NEURAX_DMA_DEFAULT_REGION;
+    neurax_error_t error = neurax_dma_open_anonymous(dma, size);
+    if (error != NEURAX_SUCCESS) {
+        NEURAX_LOG_ERROR("Cannot reserve a %zu-byte DMA region", size);
+        return error;
+    }
+    NEURAX_LOG_INFO("DMA region: %s not available, using %zu bytes of anonymous memory",
+                    path, dma->size);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_dma_init(neurax_dma_t* dma) {
+    memset(dma, 0, sizeof(*dma));
+    dma->fd = -1;
+    if (pthread_mutex_init(&dma->lock, NULL) != 0) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    return NEURAX_SUCCESS;
+}
+
+void neurax_dma_destroy(neurax_dma_t* dma) {
+    if (dma->num_buffers != 0) {
+        NEURAX_LOG_ERROR("Device released with %u DMA buffers still allocated", dma->num_buffers);
+    }
+
+    neurax_dma_block_t* block = dma->blocks;
+    while (block) {
+        neurax_dma_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+    if (dma->base) {
+        munmap(dma->base, dma->size);
+    }
+    if (dma->fd >= 0) {
+        close(dma->fd);
+    }
+    pthread_mutex_destroy(&dma->lock);
+    memset(dma, 0, sizeof(*dma));
+    dma->fd = -1;
+}
+
+// CPU pointer for a bus address range, or NULL when it is not inside the region
+void* neurax_dma_resolve(neurax_device_t* device, uint64_t bus_address, size_t size) {
+    neurax_dma_t* dma = &device->dma;
+    if (!dma->base || bus_address < dma->bus_address) {
+        return NULL;
+    }
+
+    uint64_t offset = bus_address - dma->bus_address;
+    if (offset > dma->size || size > dma->size - offset) {
+        return NULL;
+    }
+    return dma->base + offset;
+}
+
+// Public API
+
+neurax_error_t neurax_dma_alloc(neurax_device_t* device, size_t size, void** ptr,
+                               uint64_t* bus_address) {
+    if (!ptr || size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Whole pages, so the accelerator never shares a page with another buffer
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    if (size > SIZE_MAX - page_size) {
+        return NEURAX_ERROR_BUFFER_OVERFLOW;
+    }
+    size = (size + page_size - 1) & ~(page_size - 1);
+
+    neurax_error_t error = neurax_memory_charge(device, NEURAX_MEMORY_DMA, size);
+    if (error != NEURAX_SUCCESS) return error;
+
+    neurax_dma_block_t* block = malloc(sizeof(neurax_dma_block_t));
+    if (!block) {
+        neurax_memory_uncharge(device, NEURAX_MEMORY_DMA, size);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    neurax_dma_t* dma = &device->dma;
+    pthread_mutex_lock(&dma->lock);
+    error = neurax_dma_setup(device);
+
+    // First fit between the live allocations, which are sorted by offset
+    neurax_dma_block_t** link = &dma->blocks;
+    size_t cursor = 0;
+    while (error == NEURAX_SUCCESS && *link && (*link)->offset - cursor < size) {
+        cursor = (*link)->offset + (*link)->size;
+        link = &(*link)->next;
+    }
+    if (error == NEURAX_SUCCESS && (cursor > dma->size || size > dma->size - cursor)) {
+        NEURAX_LOG_ERROR("DMA region exhausted: %zu bytes requested, %zu of %zu in use",
+                         size, dma->used, dma->size);
+        error = NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    if (error == NEURAX_SUCCESS) {
+        block->offset = cursor;
+        block->size = size;
+        block->next = *link;
+        *link = block;
+        dma->used += size;
+        if (dma->used > dma->peak) {
+            dma->peak = dma->used;
+        }
+        dma->num_buffers++;
+    }
+    pthread_mutex_unlock(&dma->lock);
+
+    if (error != NEURAX_SUCCESS) {
+        free(block);
+        neurax_memory_uncharge(device, NEURAX_MEMORY_DMA, size);
+        return error;
+    }
+
+    *ptr = dma->base + block->offset;
+    memset(*ptr, 0, size);
+    if (bus_address) {
+        *bus_address = dma->bus_address + block->offset;
+    }
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_dma_free(neurax_device_t* device, void* ptr) {
+    if (!ptr) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_dma_t* dma = &device->dma;
+    pthread_mutex_lock(&dma->lock);
+    neurax_dma_block_t** link = &dma->blocks;
+    while (*link && dma->base + (*link)->offset != (uint8_t*)ptr) {
+        link = &(*link)->next;
+    }
+
+    neurax_dma_block_t* block = *link;
+    if (block) {
+        *link = block->next;
+        dma->used -= block->size;
+        dma->num_buffers--;
+    }
+    pthread_mutex_unlock(&dma->lock);
+
+    if (!block) {
+        NEURAX_LOG_ERROR("Pointer %p is not a DMA buffer", ptr);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_memory_uncharge(device, NEURAX_MEMORY_DMA, block->size);
+    free(block);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_dma_get_address(neurax_device_t* device, const void* ptr,
+                                     uint64_t* bus_address) {
+    if (!ptr || !bus_address) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_dma_t* dma = &device->dma;
+    const uint8_t* p = (const uint8_t*)ptr;
+    if (!dma->base || p < dma->base || p >= dma->base + dma->size) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *bus_address = dma->bus_address + (uint64_t)(p - dma->base);
+    return NEURAX_SUCCESS;
+}
+
+static void neurax_dma_tensor_deleter(void* data, void* user_data) {
+    neurax_dma_free((neurax_device_t*)user_data, data);
+}
+
+neurax_error_t neurax_tensor_create_dma(neurax_device_t* device,
+                                       uint32_t width, uint32_t height,
+                                       uint32_t channels, uint32_t batch_size,
+                                       neurax_data_type_t data_type,
+                                       neurax_layout_t layout,
+                                       neurax_tensor_t** tensor) {
+    if (!tensor) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    size_t size;
+    neurax_error_t error = neurax_tensor_compute_size(width, height, channels, batch_size,
+                                                      data_type, layout, &size);
+    if (error != NEURAX_SUCCESS) return error;
+
+    void* data = NULL;
+    error = neurax_dma_alloc(device, size, &data, NULL);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_tensor_wrap(data, size, width, height, channels, batch_size, data_type, layout,
+                               NEURAX_WRAP_TAKE_OWNERSHIP, neurax_dma_tensor_deleter, device,
+                               tensor);
+    if (error != NEURAX_SUCCESS) {
+        neurax_dma_free(device, data);
+    }
+    return error;
+}
+
+neurax_error_t neurax_dma_get_info(neurax_device_t* device, neurax_dma_info_t* info) {
+    if (!info) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_dma_t* dma = &device->dma;
+    pthread_mutex_lock(&dma->lock);
+    info->backend = dma->backend;
+    info->bus_address = dma->bus_address;
+    info->size = dma->size;
+    info->used = dma->used;
+    info->peak = dma->peak;
+    info->num_buffers = dma->num_buffers;
+    pthread_mutex_unlock(&dma->lock);
+
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,515 @@
+/*
+ * NEURAX Elementwise and Concatenation Implementation
+ * Broadcast binary ops, per-channel scale/shift and channel concatenation
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Elements converted per fp32 block for non-fp32 tensors
+#define NEURAX_ELTWISE_BLOCK 1024
+
+// Elements per thread before a kernel is split across threads
+#define NEURAX_ELTWISE_PARALLEL_MIN (64 * 1024)
+// Elements per range boundary of the flat pass, so no two threads write the same cache line
+#define NEURAX_ELTWISE_GRAIN 64
+
+// Shared state for per-channel affine worker threads
+typedef struct {
+    const neurax_tensor_t* input;
+    neurax_tensor_t* output;
+    const float* scale;
+    const float* shift;
+} neurax_affine_job_t;
+
+// Shared state for elementwise worker threads
+typedef struct {
+    const neurax_tensor_t* a;
+    const neurax_tensor_t* b;
+    neurax_tensor_t* output;
+    neurax_eltwise_op_t op;
+} neurax_eltwise_job_t;
+
+// Inner loop for one op; a_scalar / b_scalar broadcast a single channel value
+#define NX_ELTWISE_LOOP(expr)                                   \
+    if (a_scalar && b_scalar) {                                 \
+        const float x = a[0];                                   \
+        const float y = b[0];                                   \
+        const float value = (expr);                             \
+        for (size_t i = 0; i < count; i++) {                    \
+            out[i] = value;                                     \
+        }                                                       \
+    } else if (a_scalar) {                                      \
+        const float x = a[0];                                   \
+        for (size_t i = 0; i < count; i++) {                    \
+            const float y = b[i];                               \
+            out[i] = (expr);                                    \
+        }                                                       \
+    } else if (b_scalar) {                                      \
+        const float y = b[0];                                   \
+        for (size_t i = 0; i < count; i++) {                    \
+            const float x = a[i];                               \
+            out[i] = (expr);                                    \
+        }                                                       \
+    } else {                                                    \
+        for (size_t i = 0; i < count; i++) {                    \
+            const float x = a[i];                               \
+            const float y = b[i];                               \
+            out[i] = (expr);                                    \
+        }                                                       \
+    }
+
+static void neurax_eltwise_span(neurax_eltwise_op_t op,
+                                const float* a, bool a_scalar,
+                                const float* b, bool b_scalar,
+                                float* out, size_t count) {
+    switch (op) {
+        case NEURAX_ELTWISE_ADD:
+            NX_ELTWISE_LOOP(x + y)
+            break;
+        case NEURAX_ELTWISE_MUL:
+            NX_ELTWISE_LOOP(x * y)
+            break;
+        case NEURAX_ELTWISE_ADD_RELU:
+            NX_ELTWISE_LOOP(x + y > 0.0f ? x + y : 0.0f)
+            break;
+    }
+}
+
+// Byte offset of pixel (n, y, x) in a tensor that may be broadcast along any dimension
+static inline size_t neurax_eltwise_pixel(const neurax_tensor_t* tensor,
+                                          uint32_t n, uint32_t y, uint32_t x) {
+    n = tensor->batch_size == 1 ? 0 : n;
+    y = tensor->height == 1 ? 0 : y;
+    x = tensor->width == 1 ? 0 : x;
+    return neurax_tensor_byte_offset(tensor, n, y, x, 0);
+}
+
+// Same-shape contiguous operands: one flat pass
+static void neurax_eltwise_flat(void* ctx, size_t begin, size_t end) {
+    const neurax_eltwise_job_t* job = (const neurax_eltwise_job_t*)ctx;
+    const neurax_tensor_t* a = job->a;
+    const neurax_tensor_t* b = job->b;
+    neurax_tensor_t* output = job->output;
+
+    if (a->data_type == NEURAX_DATA_FLOAT32 && b->data_type == NEURAX_DATA_FLOAT32 &&
+        output->data_type == NEURAX_DATA_FLOAT32) {
+        neurax_eltwise_span(job->op, (const float*)a->data + begin, false,
+                            (const float*)b->data + begin, false,
+                            (float*)output->data + begin, end - begin);
+        return;
+    }
+
+    float a_block[NEURAX_ELTWISE_BLOCK];
+    float b_block[NEURAX_ELTWISE_BLOCK];
+    const size_t a_size = neurax_get_element_size(a->data_type);
+    const size_t b_size = neurax_get_element_size(b->data_type);
+    const size_t out_size = neurax_get_element_size(output->data_type);
+
+    for (size_t start = begin; start < end; start += NEURAX_ELTWISE_BLOCK) {
+        size_t count = end - start < NEURAX_ELTWISE_BLOCK ? end - start : NEURAX_ELTWISE_BLOCK;
+
+        neurax_convert_data_type((const uint8_t*)a->data + start * a_size, a->data_type,
+                                 a_block, NEURAX_DATA_FLOAT32, count);
+        neurax_convert_data_type((const uint8_t*)b->data + start * b_size, b->data_type,
+                                 b_block, NEURAX_DATA_FLOAT32, count);
+        neurax_eltwise_span(job->op, a_block, false, b_block, false, a_block, count);
+        neurax_convert_data_type(a_block, NEURAX_DATA_FLOAT32,
+                                 (uint8_t*)output->data + start * out_size,
+                                 output->data_type, count);
+    }
+}
+
+// Broadcast or strided operands: walk output rows, one channel run per pixel
+static void neurax_eltwise_rows(void* ctx, size_t begin, size_t end) {
+    const neurax_eltwise_job_t* job = (const neurax_eltwise_job_t*)ctx;
+    const neurax_tensor_t* a = job->a;
+    const neurax_tensor_t* b = job->b;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = output->channels;
+    const bool a_scalar = a->channels == 1 && C > 1;
+    const bool b_scalar = b->channels == 1 && C > 1;
+    const bool all_fp32 = a->data_type == NEURAX_DATA_FLOAT32 &&
+                          b->data_type == NEURAX_DATA_FLOAT32 &&
+                          output->data_type == NEURAX_DATA_FLOAT32 &&
+                          neurax_tensor_channels_packed(a) &&
+                          neurax_tensor_channels_packed(b) &&
+                          neurax_tensor_channels_packed(output);
+    size_t a_strides[4], b_strides[4], out_strides[4];
+    neurax_tensor_get_strides(a, a_strides);
+    neurax_tensor_get_strides(b, b_strides);
+    neurax_tensor_get_strides(output, out_strides);
+    float a_block[NEURAX_ELTWISE_BLOCK];
+    float b_block[NEURAX_ELTWISE_BLOCK];
+
+    for (size_t row = begin; row < end; row++) {
+        uint32_t n = (uint32_t)(row / output->height);
+        uint32_t y = (uint32_t)(row % output->height);
+
+        for (uint32_t x = 0; x < output->width; x++) {
+            size_t ai = neurax_eltwise_pixel(a, n, y, x);
+            size_t bi = neurax_eltwise_pixel(b, n, y, x);
+            size_t oi = neurax_eltwise_pixel(output, n, y, x);
+
+            if (all_fp32) {
+                neurax_eltwise_span(job->op,
+                                    (const float*)((const uint8_t*)a->data + ai), a_scalar,
+                                    (const float*)((const uint8_t*)b->data + bi), b_scalar,
+                                    (float*)((uint8_t*)output->data + oi), C);
+                continue;
+            }
+
+            for (uint32_t c0 = 0; c0 < C; c0 += NEURAX_ELTWISE_BLOCK) {
+                uint32_t count = C - c0 < NEURAX_ELTWISE_BLOCK ? C - c0 : NEURAX_ELTWISE_BLOCK;
+
+                neurax_load_channels(a, ai + (a_scalar ? 0 : c0 * a_strides[NEURAX_DIM_CHANNEL]),
+                                     a_scalar ? 1 : count, a_block);
+                neurax_load_channels(b, bi + (b_scalar ? 0 : c0 * b_strides[NEURAX_DIM_CHANNEL]),
+                                     b_scalar ? 1 : count, b_block);
+
+                // Write into whichever block is not a broadcast scalar
+                float* result = a_scalar ? b_block : a_block;
+                neurax_eltwise_span(job->op, a_block, a_scalar, b_block, b_scalar, result, count);
+                neurax_store_channels(output, oi + c0 * out_strides[NEURAX_DIM_CHANNEL],
+                                      count, result);
+            }
+        }
+    }
+}
+
+static void neurax_channel_affine_pixels(void* ctx, size_t begin, size_t end) {
+    const neurax_affine_job_t* job = (const neurax_affine_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = input->channels;
+    const float* scale = job->scale;
+    const float* shift = job->shift;
+
+    // fp32 in and out with packed channels: one vectorizable pass over channels per pixel
+    if (input->data_type == NEURAX_DATA_FLOAT32 && output->data_type == NEURAX_DATA_FLOAT32 &&
+        neurax_tensor_channels_packed(input) && neurax_tensor_channels_packed(output)) {
+        const uint8_t* in = (const uint8_t*)input->data;
+        uint8_t* out = (uint8_t*)output->data;
+        for (size_t p = begin; p < end; p++) {
+            const float* src = (const float*)(in + neurax_tensor_pixel_offset(input, p));
+            float* dst = (float*)(out + neurax_tensor_pixel_offset(output, p));
+            for (uint32_t c = 0; c < C; c++) {
+                dst[c] = src[c] * scale[c] + shift[c];
+            }
+        }
+        return;
+    }
+
+    // Other types: widen a block of whole pixels (or a channel run of one pixel) to fp32
+    float block[NEURAX_ELTWISE_BLOCK];
+    const bool contiguous = neurax_tensor_is_contiguous(input) &&
+                            neurax_tensor_is_contiguous(output);
+    const size_t pixels_per_block = contiguous && C <= NEURAX_ELTWISE_BLOCK ?
+                                    NEURAX_ELTWISE_BLOCK / C : 1;
+    const uint32_t channels_per_block = C <= NEURAX_ELTWISE_BLOCK ? C : NEURAX_ELTWISE_BLOCK;
+    size_t in_strides[4], out_strides[4];
+    neurax_tensor_get_strides(input, in_strides);
+    neurax_tensor_get_strides(output, out_strides);
+
+    for (size_t p0 = begin; p0 < end; p0 += pixels_per_block) {
+        size_t pixels = end - p0 < pixels_per_block ? end - p0 : pixels_per_block;
+        size_t in_offset = neurax_tensor_pixel_offset(input, p0);
+        size_t out_offset = neurax_tensor_pixel_offset(output, p0);
+
+        for (uint32_t c0 = 0; c0 < C; c0 += channels_per_block) {
+            uint32_t nc = C - c0 < channels_per_block ? C - c0 : channels_per_block;
+            uint32_t count = (uint32_t)(pixels * nc);
+
+            // Whole-pixel blocks only occur for contiguous tensors, where channels are packed
+            neurax_load_channels(input, in_offset + c0 * in_strides[NEURAX_DIM_CHANNEL],
+                                 count, block);
+            for (size_t q = 0; q < count; q += nc) {
+                for (uint32_t c = 0; c < nc; c++) {
+                    block[q + c] = block[q + c] * scale[c0 + c] + shift[c0 + c];
+                }
+            }
+            neurax_store_channels(output, out_offset + c0 * out_strides[NEURAX_DIM_CHANNEL],
+                                  count, block);
+        }
+    }
+}
+
+// CPU per-channel y = x * scale[c] + shift[c], shared by scale/bias and batch norm
+neurax_error_t neurax_cpu_channel_affine(const neurax_tensor_t* input,
+                                        const float* scale,
+                                        const float* shift,
+                                        neurax_tensor_t* output) {
+    neurax_affine_job_t job;
+    job.input = input;
+    job.output = output;
+    job.scale = scale;
+    job.shift = shift;
+
+    size_t min_pixels = NEURAX_ELTWISE_PARALLEL_MIN / input->channels + 1;
+    neurax_parallel_for(neurax_tensor_pixel_count(input), 1, min_pixels,
+                        neurax_channel_affine_pixels, &job);
+
+    return NEURAX_SUCCESS;
+}
+
+// Check that a tensor can be broadcast to the output shape
+static bool neurax_eltwise_broadcastable(const neurax_tensor_t* tensor,
+                                         const neurax_tensor_t* output) {
+    return (tensor->width == output->width || tensor->width == 1) &&
+           (tensor->height == output->height || tensor->height == 1) &&
+           (tensor->channels == output->channels || tensor->channels == 1) &&
+           (tensor->batch_size == output->batch_size || tensor->batch_size == 1);
+}
+
+static bool neurax_eltwise_same_shape(const neurax_tensor_t* tensor,
+                                      const neurax_tensor_t* output) {
+    return tensor->width == output->width && tensor->height == output->height &&
+           tensor->channels == output->channels && tensor->batch_size == output->batch_size;
+}
+
+// Execute elementwise operation
+neurax_error_t neurax_eltwise(neurax_device_t* device,
+                             const neurax_tensor_t* a,
+                             const neurax_tensor_t* b,
+                             neurax_eltwise_op_t op,
+                             neurax_tensor_t* output) {
+
+    if (!device || !a || !b || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Validate inputs
+    neurax_error_t error = neurax_validate_tensor(a);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(a, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_tensor(b);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(b, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (op > NEURAX_ELTWISE_ADD_RELU) {
+        NEURAX_LOG_ERROR("Invalid elementwise operation");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!neurax_eltwise_broadcastable(a, output) || !neurax_eltwise_broadcastable(b, output)) {
+        NEURAX_LOG_ERROR("Elementwise operands can't be broadcast to %ux%ux%ux%u",
+                         output->width, output->height, output->channels, output->batch_size);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing elementwise op %d: %ux%ux%u", op,
+                    output->width, output->height, output->channels);
+
+    // The accelerator has no elementwise block, so these ops always run on the CPU
+    return neurax_cpu_eltwise(a, b, op, output);
+}
+
+// CPU implementation
+neurax_error_t neurax_cpu_eltwise(const neurax_tensor_t* a,
+                                 const neurax_tensor_t* b,
+                                 neurax_eltwise_op_t op,
+                                 neurax_tensor_t* output) {
+
+    NEURAX_LOG_DEBUG("Using CPU implementation for elementwise op");
+
+    neurax_eltwise_job_t job;
+    job.a = a;
+    job.b = b;
+    job.output = output;
+    job.op = op;
+
+    if (neurax_eltwise_same_shape(a, output) && neurax_eltwise_same_shape(b, output) &&
+        neurax_tensor_is_contiguous(a) && neurax_tensor_is_contiguous(b) &&
+        neurax_tensor_is_contiguous(output)) {
+        neurax_parallel_for(neurax_tensor_total_elements(output), NEURAX_ELTWISE_GRAIN,
+                            NEURAX_ELTWISE_PARALLEL_MIN, neurax_eltwise_flat, &job);
+    } else {
+        size_t rows = (size_t)output->batch_size * output->height;
+        size_t row_elements = (size_t)output->width * output->channels;
+        neurax_parallel_for(rows, 1, NEURAX_ELTWISE_PARALLEL_MIN / row_elements + 1,
+                            neurax_eltwise_rows, &job);
+    }
+
+    return NEURAX_SUCCESS;
+}
+
+// Execute per-channel scale and bias
+neurax_error_t neurax_scale_bias(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                const neurax_tensor_t* scale,
+                                const neurax_tensor_t* bias,
+                                neurax_tensor_t* output) {
+
+    if (!device || !input || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Validate inputs
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(input, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (!neurax_eltwise_same_shape(input, output)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Scale and bias hold one value per channel or one value for all channels
+    const neurax_tensor_t* params[2] = {scale, bias};
+    for (int i = 0; i < 2; i++) {
+        if (!params[i]) continue;
+
+        error = neurax_validate_tensor(params[i]);
+        if (error != NEURAX_SUCCESS) return error;
+
+        size_t count = neurax_tensor_total_elements(params[i]);
+        if (count != 1 && count < input->channels) {
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+    }
+
+    NEURAX_LOG_INFO("Executing scale/bias: %u channels", input->channels);
+
+    uint32_t channels = input->channels;
+    size_t mark = neurax_scratch_mark(device);
+    float* coefficients = neurax_scratch_alloc(device, sizeof(float) * 2 * channels);
+    if (!coefficients) {
+        neurax_scratch_release(device, mark);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    bool scale_per_channel = scale && neurax_tensor_total_elements(scale) > 1;
+    bool bias_per_channel = bias && neurax_tensor_total_elements(bias) > 1;
+    for (uint32_t c = 0; c < channels; c++) {
+        coefficients[c] = scale ? neurax_get_bias_value(scale, scale_per_channel ? c : 0) : 1.0f;
+        coefficients[channels + c] = bias ?
+                                     neurax_get_bias_value(bias, bias_per_channel ? c : 0) : 0.0f;
+    }
+
+    error = neurax_cpu_channel_affine(input, coefficients, coefficients + channels, output);
+
+    neurax_scratch_free(device, coefficients);
+    neurax_scratch_release(device, mark);
+    return error;
+}
+
+// Execute channel concatenation
+neurax_error_t neurax_concat(neurax_device_t* device,
+                            const neurax_tensor_t* const* inputs,
+                            uint32_t num_inputs,
+                            neurax_tensor_t* output) {
+
+    if (!device || !inputs || num_inputs == 0 || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_error_t error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    // Check that the inputs tile the output's channels exactly
+    uint32_t total_channels = 0;
+    for (uint32_t i = 0; i < num_inputs; i++) {
+        error = neurax_validate_tensor(inputs[i]);
+        if (error != NEURAX_SUCCESS) return error;
+
+        error = neurax_validate_layout(inputs[i], false);
+        if (error != NEURAX_SUCCESS) return error;
+
+        if (inputs[i]->width != output->width || inputs[i]->height != output->height ||
+            inputs[i]->batch_size != output->batch_size) {
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        total_channels += inputs[i]->channels;
+    }
+
+    if (total_channels != output->channels) {
+        NEURAX_LOG_ERROR("Concat inputs have %u channels, output has %u",
+                         total_channels, output->channels);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing concat: %u inputs -> %u channels", num_inputs, output->channels);
+
+    const size_t pixels = neurax_tensor_pixel_count(output);
+    const bool out_packed = neurax_tensor_channels_packed(output);
+    size_t out_strides[4];
+    neurax_tensor_get_strides(output, out_strides);
+    float block[NEURAX_ELTWISE_BLOCK];
+    uint32_t channel_offset = 0;
+
+    for (uint32_t i = 0; i < num_inputs; i++) {
+        const neurax_tensor_t* input = inputs[i];
+        size_t dst_offset = channel_offset * out_strides[NEURAX_DIM_CHANNEL];
+        uint8_t* dst = (uint8_t*)output->data + dst_offset;
+        channel_offset += input->channels;
+
+        // Producer already wrote into this slice of the output
+        size_t in_strides[4];
+        neurax_tensor_get_strides(input, in_strides);
+        if (input->data == dst && input->data_type == output->data_type &&
+            memcmp(in_strides, out_strides, sizeof(in_strides)) == 0) {
+            continue;
+        }
+
+        const bool packed = out_packed && neurax_tensor_channels_packed(input);
+        for (size_t p = 0; p < pixels; p++) {
+            size_t in_offset = neurax_tensor_pixel_offset(input, p);
+            size_t out_offset = dst_offset + neurax_tensor_pixel_offset(output, p);
+
+            if (packed) {
+                neurax_convert_data_type((const uint8_t*)input->data + in_offset, input->data_type,
+                                         (uint8_t*)output->data + out_offset, output->data_type,
+                                         input->channels);
+                continue;
+            }
+
+            for (uint32_t c0 = 0; c0 < input->channels; c0 += NEURAX_ELTWISE_BLOCK) {
+                uint32_t count = input->channels - c0 < NEURAX_ELTWISE_BLOCK ?
+                                 input->channels - c0 : NEURAX_ELTWISE_BLOCK;
+                neurax_load_channels(input, in_offset + c0 * in_strides[NEURAX_DIM_CHANNEL],
+                                     count, block);
+                neurax_store_channels(output, out_offset + c0 * out_strides[NEURAX_DIM_CHANNEL],
+                                      count, block);
+            }
+        }
+    }
+
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*
+ * NEURAX Hardware Transfer Engine
+ * DMA buffers for accelerator operands, operation start, completion and readback
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <string.h>
+
+// Largest dimension the 16-bit dimension and channel fields hold
+#define NEURAX_HW_MAX_DIM 0xFFFFu
+
+// The address registers are 32 bits wide
+#define NEURAX_HW_ADDRESS_LIMIT (1ull << 32)
+
+// Runs predicted to finish within this are busy-waited rather than slept on, since a
+// blocking wait costs a scheduler wakeup of about the same order
+#define NEURAX_HW_SPIN_MAX_NS 50000
+
+// Weight of the newest run in the ns-per-cycle calibration
+#define NEURAX_HW_CALIBRATION_WEIGHT 0.125
+
+// Tensors the accelerator can stream: dense NHWC with the requested 8 or 16-bit element type
+bool neurax_hw_supports_tensor(const neurax_tensor_t* tensor, neurax_data_type_t data_type) {
+    if (tensor->data_type != data_type || neurax_get_element_size(data_type) > 2 ||
+        neurax_is_half_type(data_type)) {
+        return false;
+    }
+    if (tensor->layout != NEURAX_LAYOUT_NHWC && tensor->layout != NEURAX_LAYOUT_OIHW) {
+        return false;
+    }
+    return neurax_tensor_is_contiguous(tensor) &&
+           tensor->width <= NEURAX_HW_MAX_DIM && tensor->height <= NEURAX_HW_MAX_DIM &&
+           tensor->channels <= NEURAX_HW_MAX_DIM;
+}
+
+// Describe a tensor to the accelerator: DMA tensors are used in place, anything else is
+// copied into a temporary DMA buffer (only when the accelerator reads it)
+neurax_error_t neurax_hw_buffer_acquire(neurax_device_t* device, const neurax_tensor_t* tensor,
+                                        bool copy_in, neurax_hw_buffer_t* buffer) {
+    size_t size = neurax_tensor_total_elements(tensor) * neurax_get_element_size(tensor->data_type);
+
+    memset(buffer, 0, sizeof(*buffer));
+    if (neurax_dma_get_address(device, tensor->data, &buffer->bus_address) == NEURAX_SUCCESS &&
+        neurax_dma_resolve(device, buffer->bus_address, size) != NULL) {
+        buffer->data = (uint8_t*)tensor->data;
+    } else {
+        void* data = NULL;
+        neurax_error_t error = neurax_dma_alloc(device, size, &data, &buffer->bus_address);
+        if (error != NEURAX_SUCCESS) return error;
+
+        buffer->data = (uint8_t*)data;
+        buffer->staged = true;
+        if (copy_in) {
+            memcpy(buffer->data, tensor->data, size);
+        }
+    }
+    buffer->size = size;
+
+    if (buffer->bus_address + size > NEURAX_HW_ADDRESS_LIMIT) {
+        NEURAX_LOG_ERROR("DMA buffer at 0x%llx is beyond the 32-bit address registers",
+                         (unsigned long long)buffer->bus_address);
+        neurax_hw_buffer_release(device, buffer, NULL);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    return NEURAX_SUCCESS;
+}
+
+// Read a staged result back into its tensor (when copy_out is set) and free the staging buffer
+void neurax_hw_buffer_release(neurax_device_t* device, neurax_hw_buffer_t* buffer,
+                              neurax_tensor_t* copy_out) {
+    if (!buffer->data) {
+        return;
+    }
+
+    if (buffer->staged) {
+        if (copy_out) {
+            memcpy(copy_out->data, buffer->data, buffer->size);
+        }
+        neurax_dma_free(device, buffer->data);
+    }
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+// Start the operation programmed in the registers and wait for it
+neurax_error_t neurax_hw_run(neurax_device_t* device, uint32_t control) {
+    neurax_hw_program_t program = {
+        .control = control,
+        .conv_config = device->registers[NEURAX_REG_CONV_CONFIG / 4],
+        .pool_config = device->registers[NEURAX_REG_POOL_CONFIG / 4],
+        .act_config = device->registers[NEURAX_REG_ACT_CONFIG / 4],
+        .dim_config = device->registers[NEURAX_REG_DIM_CONFIG / 4],
+        .chan_config = device->registers[NEURAX_REG_CHAN_CONFIG / 4],
+    };
+    neurax_perf_estimate_t estimate;
+
+    if (neurax_perf_model_run(&device->config, &program, &estimate) != NEURAX_SUCCESS) {
+        estimate.cycles = 0;
+    }
+    return neurax_hw_execute(device, control, estimate.cycles);
+}
+
+// Start the accelerator and wait for it; starting clears the done flag. The predicted
+// cycles, scaled by what past runs actually took, decide the wait: short runs are spun on,
+// longer ones (or unknown ones, predicted_cycles = 0) block on the interrupt.
+// A unit that never finishes is reset so the next operation can start.
+neurax_error_t neurax_hw_execute(neurax_device_t* device, uint32_t control,
+                                 uint64_t predicted_cycles) {
+    uint32_t timeout_ms = device->config.timeout_ms ? device->config.timeout_ms
+                                                    : NEURAX_DEFAULT_TIMEOUT_MS;
+    uint64_t spin_ns = 0;
+
+    if (predicted_cycles > 0) {
+        double ns_per_cycle = device->wait.ns_per_cycle;
+        if (ns_per_cycle == 0.0) {
+            ns_per_cycle = neurax_perf_cycle_ns(&device->config);
+        }
+
+        // Spin a little past the prediction to absorb jitter
+        uint64_t predicted_ns = (uint64_t)(predicted_cycles * ns_per_cycle);
+        if (predicted_ns <= NEURAX_HW_SPIN_MAX_NS) {
+            spin_ns = predicted_ns + predicted_ns / 2;
+            if (spin_ns > NEURAX_HW_SPIN_MAX_NS) {
+                spin_ns = NEURAX_HW_SPIN_MAX_NS;
+            }
+        }
+    }
+
+    if (device->wait.irq_fd >= 0) {
+        neurax_irq_arm(device);
+        control |= CTRL_IRQ_EN;
+    }
+
+    uint64_t start = neurax_time_ns();
+    NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, control | CTRL_START);
+
+    neurax_error_t error = neurax_wait_for_completion(device, spin_ns, timeout_ms);
+    if (error == NEURAX_SUCCESS && predicted_cycles > 0) {
+        double observed = (double)(neurax_time_ns() - start) / predicted_cycles;
+        device->wait.ns_per_cycle = device->wait.ns_per_cycle == 0.0 ? observed :
+            device->wait.ns_per_cycle + NEURAX_HW_CALIBRATION_WEIGHT *
+                                        (observed - device->wait.ns_per_cycle);
+    }
+    if (error == NEURAX_ERROR_TIMEOUT) {
+        NEURAX_LOG_ERROR("Accelerator still busy after %u ms, resetting", timeout_ms);
+        NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, CTRL_RESET);
+    }
+    NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, control);
+    return error;
+}
@@ -10,6 +10,9 @@
 #include <math.h>
 #include <float.h>
 
+// Elements processed per fp32 block by the CPU activation kernel
+#define NEURAX_ACTIVATION_BLOCK 1024
+
 // Activation function implementation
 neurax_error_t neurax_activation(neurax_device_t* device,
                                 const neurax_tensor_t* input,
@@ -28,7 +31,13 @@ neurax_error_t neurax_activation(neurax_device_t* device,
     neurax_error_t error = neurax_validate_tensor(input);
     if (error != NEURAX_SUCCESS) return error;
     
-    error = neurax_validate_tensor(output);
+    error = neurax_validate_layout(input, true);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_layout(output, true);
     if (error != NEURAX_SUCCESS) return error;
     
     // Check tensor compatibility
@@ -53,29 +62,56 @@ neurax_error_t neurax_hw_activation(neurax_device_t* device,
                                    neurax_activation_t activation,
                                    neurax_tensor_t* output) {
     
-    NEURAX_LOG_DEBUG("Using hardware acceleration for activation");
+    if (!neurax_hw_supports_tensor(input, input->data_type) ||
+        !neurax_hw_supports_tensor(output, input->data_type) || activation > 0x3 ||
+        (size_t)input->height * input->batch_size > 0xFFFF) {
+        NEURAX_LOG_DEBUG("Activation not supported by the accelerator, using CPU");
+        return neurax_cpu_activation(input, activation, output);
+    }
     
-    // Configure activation function
-    uint32_t act_config = activation & 0x3;
-    NEURAX_WRITE_REG(device, NEURAX_REG_ACT_CONFIG, act_config);
+    NEURAX_LOG_DEBUG("Using hardware acceleration for activation");
     
-    // Enable only activation function
-    uint32_t control = CTRL_ACT_EN;
-    if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
-        control |= CTRL_DATA_WIDTH;
+    neurax_hw_buffer_t in_buf = {0}, out_buf = {0};
+    neurax_error_t error = neurax_hw_buffer_acquire(device, input, true, &in_buf);
+    if (error == NEURAX_SUCCESS) {
+        error = neurax_hw_buffer_acquire(device, output, false, &out_buf);
     }
     
-    NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, control | CTRL_START);
-    
-    // Wait for completion
-    neurax_error_t error = neurax_wait_for_completion(device, NEURAX_DEFAULT_TIMEOUT_MS);
-    if (error != NEURAX_SUCCESS) {
-        NEURAX_LOG_ERROR("Hardware activation timeout or error");
-        return error;
+    if (error == NEURAX_SUCCESS) {
+        pthread_mutex_lock(&device->hw_lock);
+        
+        // Configure activation function
+        uint32_t act_config = activation & 0x3;
+        NEURAX_WRITE_REG(device, NEURAX_REG_ACT_CONFIG, act_config);
+        
+        // Elementwise: the whole batch streams as one image
+        uint32_t dim_config = (input->width & 0xFFFF) | (((input->height * input->batch_size) & 0xFFFF) << 16);
+        uint32_t chan_config = (input->channels & 0xFFFF) | ((output->channels & 0xFFFF) << 16);
+        NEURAX_WRITE_REG(device, NEURAX_REG_DIM_CONFIG, dim_config);
+        NEURAX_WRITE_REG(device, NEURAX_REG_CHAN_CONFIG, chan_config);
+        NEURAX_WRITE_REG(device, NEURAX_REG_INPUT_ADDR, (uint32_t)in_buf.bus_address);
+        NEURAX_WRITE_REG(device, NEURAX_REG_OUTPUT_ADDR, (uint32_t)out_buf.bus_address);
+        
+        // Enable only activation function
+        uint32_t control = CTRL_ACT_EN;
+        if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
+            control |= CTRL_DATA_WIDTH;
+        }
+        if (input->data_type == NEURAX_DATA_INT8 || input->data_type == NEURAX_DATA_INT16) {
+            control |= CTRL_SIGNED;
+        }
+        
+        error = neurax_hw_run(device, control);
+        pthread_mutex_unlock(&device->hw_lock);
+        if (error != NEURAX_SUCCESS) {
+            NEURAX_LOG_ERROR("Hardware activation timeout or error");
+        }
     }
     
-    // For now, fall back to CPU implementation until DMA is implemented
-    return neurax_cpu_activation(input, activation, output);
+    neurax_hw_buffer_release(device, &in_buf, NULL);
+    neurax_hw_buffer_release(device, &out_buf, error == NEURAX_SUCCESS ? output : NULL);
+    
+    return error;
 }
 
 // CPU activation implementation
@@ -86,11 +122,59 @@ neurax_error_t neurax_cpu_activation(const neurax_tensor_t* input,
     NEURAX_LOG_DEBUG("Using CPU implementation for activation");
     
     size_t total_elements = neurax_tensor_total_elements(input);
+    size_t input_element_size = neurax_get_element_size(input->data_type);
+    size_t output_element_size = neurax_get_element_size(output->data_type);
+    float block[NEURAX_ACTIVATION_BLOCK];
+    
+    // Blocked layouts are dense including the padding lanes, so both sides must match
+    if (neurax_layout_block_size(input->layout) != 0 ||
+        neurax_layout_block_size(output->layout) != 0) {
+        if (input->layout != output->layout) {
+            NEURAX_LOG_ERROR("Activation input and output must share a blocked layout");
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        total_elements = input->data_size / input_element_size;
+    } else if (!neurax_tensor_is_contiguous(input) || !neurax_tensor_is_contiguous(output)) {
+        // Strided views: process each pixel's channel run separately
+        size_t pixels = neurax_tensor_pixel_count(input);
+        size_t strides[2][4];
+        neurax_tensor_get_strides(input, strides[0]);
+        neurax_tensor_get_strides(output, strides[1]);
+        
+        for (size_t p = 0; p < pixels; p++) {
+            size_t input_offset = neurax_tensor_pixel_offset(input, p);
+            size_t output_offset = neurax_tensor_pixel_offset(output, p);
+            
+            for (uint32_t c0 = 0; c0 < input->channels; c0 += NEURAX_ACTIVATION_BLOCK) {
+                uint32_t count = input->channels - c0;
+                if (count > NEURAX_ACTIVATION_BLOCK) {
+                    count = NEURAX_ACTIVATION_BLOCK;
+                }
+                
+                neurax_load_channels(input, input_offset + c0 * strides[0][NEURAX_DIM_CHANNEL],
+                                     count, block);
+                neurax_apply_activation_block(block, count, activation);
+                neurax_store_channels(output, output_offset + c0 * strides[1][NEURAX_DIM_CHANNEL],
+                                      count, block);
+            }
+        }
+        
+        return NEURAX_SUCCESS;
+    }
     
-    for (size_t i = 0; i < total_elements; i++) {
-        float input_val = neurax_get_tensor_element(input, i);
-        float output_val = neurax_apply_activation(input_val, activation);
-        neurax_set_tensor_element(output, i, output_val);
+    // Widen each block to fp32, apply the activation and narrow to the output type
+    for (size_t start = 0; start < total_elements; start += NEURAX_ACTIVATION_BLOCK) {
+        size_t count = total_elements - start;
+        if (count > NEURAX_ACTIVATION_BLOCK) {
+            count = NEURAX_ACTIVATION_BLOCK;
+        }
+        
+        neurax_convert_data_type((const uint8_t*)input->data + start * input_element_size,
+                                 input->data_type, block, NEURAX_DATA_FLOAT32, count);
+        neurax_apply_activation_block(block, count, activation);
+        neurax_convert_data_type(block, NEURAX_DATA_FLOAT32,
+                                 (uint8_t*)output->data + start * output_element_size,
+                                 output->data_type, count);
     }
     
     return NEURAX_SUCCESS;
@@ -114,7 +198,13 @@ neurax_error_t neurax_pooling(neurax_device_t* device,
     neurax_error_t error = neurax_validate_tensor(input);
     if (error != NEURAX_SUCCESS) return error;
     
-    error = neurax_validate_tensor(output);
+    error = neurax_validate_layout(input, true);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    error = neurax_validate_layout(output, true);
     if (error != NEURAX_SUCCESS) return error;
     
     error = neurax_validate_pool_config(config);
@@ -137,37 +227,78 @@ neurax_error_t neurax_hw_pooling(neurax_device_t* device,
                                 const neurax_pool_config_t* config,
                                 neurax_tensor_t* output) {
     
-    NEURAX_LOG_DEBUG("Using hardware acceleration for pooling");
-    
-    // Configure pooling operation
-    uint32_t pool_config = 0;
-    pool_config |= (config->pool_type & 0x1);                          // Bit 0: pool type
-    pool_config |= ((config->pool_width - 2) & 0x7) << 1;              // Bits 3:1: pool size
-    pool_config |= ((config->stride_x - 1) & 0x7) << 4;                // Bits 6:4: stride
+    // Square windows of 2 to 9 with a symmetric stride
+    if (!neurax_hw_supports_tensor(input, input->data_type) ||
+        !neurax_hw_supports_tensor(output, input->data_type) ||
+        config->pool_width != config->pool_height || config->pool_width < 2 ||
+        config->pool_width > 9 || config->stride_x != config->stride_y || config->stride_x > 8 ||
+        input->channels != output->channels || input->batch_size != output->batch_size) {
+        NEURAX_LOG_DEBUG("Pooling not supported by the accelerator, using CPU");
+        return neurax_cpu_pooling(input, config, output);
+    }
     
-    NEURAX_WRITE_REG(device, NEURAX_REG_POOL_CONFIG, pool_config);
+    uint32_t out_height = (input->height - config->pool_height) / config->stride_y + 1;
+    uint32_t out_width = (input->width - config->pool_width) / config->stride_x + 1;
+    if (input->height < config->pool_height || input->width < config->pool_width ||
+        output->height != out_height || output->width != out_width) {
+        NEURAX_LOG_ERROR("Output tensor dimensions don't match calculated dimensions");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
     
-    // Set dimension configuration
-    uint32_t dim_config = (input->width & 0xFFFF) | ((input->height & 0xFFFF) << 16);
-    NEURAX_WRITE_REG(device, NEURAX_REG_DIM_CONFIG, dim_config);
+    NEURAX_LOG_DEBUG("Using hardware acceleration for pooling");
     
-    // Enable pooling
-    uint32_t control = CTRL_POOL_EN;
-    if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
-        control |= CTRL_DATA_WIDTH;
+    neurax_hw_buffer_t in_buf = {0}, out_buf = {0};
+    neurax_error_t error = neurax_hw_buffer_acquire(device, input, true, &in_buf);
+    if (error == NEURAX_SUCCESS) {
+        error = neurax_hw_buffer_acquire(device, output, false, &out_buf);
     }
     
-    NEURAX_WRITE_REG(device, NEURAX_REG_CONTROL, control | CTRL_START);
-    
-    // Wait for completion
-    neurax_error_t error = neurax_wait_for_completion(device, NEURAX_DEFAULT_TIMEOUT_MS);
-    if (error != NEURAX_SUCCESS) {
-        NEURAX_LOG_ERROR("Hardware pooling timeout or error");
-        return error;
+    if (error == NEURAX_SUCCESS) {
+        pthread_mutex_lock(&device->hw_lock);
+        
+        // Configure pooling operation
+        uint32_t pool_config = 0;
+        pool_config |= (config->pool_type & 0x1);                          // Bit 0: pool type
+        pool_config |= ((config->pool_width - 2) & 0x7) << 1;              // Bits 3:1: pool size
+        pool_config |= ((config->stride_x - 1) & 0x7) << 4;                // Bits 6:4: stride
+        
+        NEURAX_WRITE_REG(device, NEURAX_REG_POOL_CONFIG, pool_config);
+        
+        // Set dimension configuration
+        uint32_t dim_config = (input->width & 0xFFFF) | ((input->height & 0xFFFF) << 16);
+        uint32_t chan_config = (input->channels & 0xFFFF) | ((output->channels & 0xFFFF) << 16);
+        NEURAX_WRITE_REG(device, NEURAX_REG_DIM_CONFIG, dim_config);
+        NEURAX_WRITE_REG(device, NEURAX_REG_CHAN_CONFIG, chan_config);
+        
+        // Enable pooling
+        uint32_t control = CTRL_POOL_EN;
+        if (input->data_type == NEURAX_DATA_UINT16 || input->data_type == NEURAX_DATA_INT16) {
+            control |= CTRL_DATA_WIDTH;
+        }
+        if (input->data_type == NEURAX_DATA_INT8 || input->data_type == NEURAX_DATA_INT16) {
+            control |= CTRL_SIGNED;
+        }
+        
+        // One image per run
+        size_t in_stride = in_buf.size / input->batch_size;
+        size_t out_stride = out_buf.size / output->batch_size;
+        for (uint32_t n = 0; n < input->batch_size && error == NEURAX_SUCCESS; n++) {
+            NEURAX_WRITE_REG(device, NEURAX_REG_INPUT_ADDR, (uint32_t)(in_buf.bus_address + n * in_stride));
+            NEURAX_WRITE_REG(device, NEURAX_REG_OUTPUT_ADDR, (uint32_t)(out_buf.bus_address + n * out_stride));
+            error = neurax_hw_run(device, control);
+        }
+        
+        pthread_mutex_unlock(&device->hw_lock);
+        
+        if (error != NEURAX_SUCCESS) {
+            NEURAX_LOG_ERROR("Hardware pooling timeout or error");
+        }
     }
     
-    // For now, fall back to CPU implementation
-    return neurax_cpu_pooling(input, config, output);
+    neurax_hw_buffer_release(device, &in_buf, NULL);
+    neurax_hw_buffer_release(device, &out_buf, error == NEURAX_SUCCESS ? output : NULL);
+    
+    return error;
 }
 
 // CPU pooling implementation
@@ -186,8 +317,11 @@ neurax_error_t neurax_cpu_pooling(const neurax_tensor_t* input,
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    // Clear output tensor
-    memset(output->data, 0, output->data_size);
+    // Every output element is written below, so outputs need no clearing
+    if (output->channels != input->channels || output->batch_size != input->batch_size) {
+        NEURAX_LOG_ERROR("Pooling output must have the input's channels and batch size");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
     
     // Perform pooling for each batch
     for (uint32_t batch = 0; batch < input->batch_size; batch++) {
@@ -243,59 +377,10 @@ neurax_error_t neurax_cpu_pooling(const neurax_tensor_t* input,
 
 // Helper function to get tensor element by linear index
 float neurax_get_tensor_element(const neurax_tensor_t* tensor, size_t index) {
-    switch (tensor->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)tensor->data;
-            return (float)data[index];
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)tensor->data;
-            return data[index];
-        }
-        default:
-            return 0.0f;
-    }
+    return neurax_load_element(tensor->data, tensor->data_type, index);
 }
 
 // Helper function to set tensor element by linear index
 void neurax_set_tensor_element(neurax_tensor_t* tensor, size_t index, float value) {
-    switch (tensor->data_type) {
-        case NEURAX_DATA_UINT8: {
-            uint8_t* data = (uint8_t*)tensor->data;
-            data[index] = (uint8_t)fmax(0, fmin(255, value));
-            break;
-        }
-        case NEURAX_DATA_INT8: {
-            int8_t* data = (int8_t*)tensor->data;
-            data[index] = (int8_t)fmax(-128, fmin(127, value));
-            break;
-        }
-        case NEURAX_DATA_UINT16: {
-            uint16_t* data = (uint16_t*)tensor->data;
-            data[index] = (uint16_t)fmax(0, fmin(65535, value));
-            break;
-        }
-        case NEURAX_DATA_INT16: {
-            int16_t* data = (int16_t*)tensor->data;
-            data[index] = (int16_t)fmax(-32768, fmin(32767, value));
-            break;
-        }
-        case NEURAX_DATA_FLOAT32: {
-            float* data = (float*)tensor->data;
-            data[index] = value;
-            break;
-        }
-    }
+    neurax_store_element(tensor->data, tensor->data_type, index, value);
 }
@@ -0,0 +1,206 @@
+/*
+ * NEURAX Memory Layout Transforms
+ * Cache-blocked conversion between NHWC, NCHW, NCHWc and OIHW, and layout preferences
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <string.h>
+
+// Elements per side of a transpose tile. Small tiles keep the scattered side to a few
+// cache lines, so planes whose size is a multiple of 4 KiB don't evict each other.
+#define NEURAX_LAYOUT_TILE 8
+
+// Elements copied per thread before the transform is split
+#define NEURAX_LAYOUT_PARALLEL_MIN (1 << 16)
+
+// Shared state for transform worker threads
+typedef struct {
+    const neurax_tensor_t* src;
+    neurax_tensor_t* dst;
+    uint32_t chunk;                 // Channels per copy; never crosses a block of either side
+} neurax_layout_job_t;
+
+// Byte strides of a row of pixels (x) and of the channels within a chunk (c)
+static void neurax_layout_row_strides(const neurax_tensor_t* tensor, size_t* x_stride, size_t* c_stride) {
+    size_t element_size = neurax_get_element_size(tensor->data_type);
+    uint32_t block = neurax_layout_block_size(tensor->layout);
+
+    if (block != 0) {
+        *x_stride = block * element_size;
+        *c_stride = element_size;
+    } else if (tensor->layout == NEURAX_LAYOUT_OIHW) {
+        // Weights carry no strides; their storage is planar like NCHW
+        *x_stride = element_size;
+        *c_stride = element_size * tensor->width * tensor->height;
+    } else {
+        size_t strides[4];
+        neurax_tensor_get_strides(tensor, strides);
+        *x_stride = strides[NEURAX_DIM_WIDTH];
+        *c_stride = strides[NEURAX_DIM_CHANNEL];
+    }
+}
+
+// Byte offset of element (n, y, x, c), treating OIHW as NCHW
+static size_t neurax_layout_offset(const neurax_tensor_t* tensor, uint32_t n, uint32_t y,
+                                   uint32_t x, uint32_t c) {
+    if (tensor->layout == NEURAX_LAYOUT_OIHW) {
+        size_t element_size = neurax_get_element_size(tensor->data_type);
+        return ((((size_t)n * tensor->channels + c) * tensor->height + y) * tensor->width + x) *
+               element_size;
+    }
+
+    return neurax_tensor_byte_offset(tensor, n, y, x, c);
+}
+
+#define NX_LAYOUT_TILE_LOOP(type)                                                   \
+    for (size_t r = r0; r < r_end; r++) {                                           \
+        for (size_t c = c0; c < c_end; c++) {                                       \
+            *(type*)(dst + r * dst_row + c * dst_col) =                             \
+                *(const type*)(src + r * src_row + c * src_col);                    \
+        }                                                                           \
+    }
+
+// Copy a rows x cols grid of elements between arbitrary byte strides, tile by tile so
+// both the reads and the writes of a tile stay in cache
+static void neurax_layout_copy_tiles(const uint8_t* src, size_t src_row, size_t src_col,
+                                     uint8_t* dst, size_t dst_row, size_t dst_col,
+                                     size_t rows, size_t cols, size_t element_size) {
+    // Both sides have the columns adjacent: plain row copies
+    if (src_col == element_size && dst_col == element_size) {
+        for (size_t r = 0; r < rows; r++) {
+            memcpy(dst + r * dst_row, src + r * src_row, cols * element_size);
+        }
+        return;
+    }
+
+    for (size_t r0 = 0; r0 < rows; r0 += NEURAX_LAYOUT_TILE) {
+        size_t r_end = r0 + NEURAX_LAYOUT_TILE < rows ? r0 + NEURAX_LAYOUT_TILE : rows;
+
+        for (size_t c0 = 0; c0 < cols; c0 += NEURAX_LAYOUT_TILE) {
+            size_t c_end = c0 + NEURAX_LAYOUT_TILE < cols ? c0 + NEURAX_LAYOUT_TILE : cols;
+
+            switch (element_size) {
+                case 1: NX_LAYOUT_TILE_LOOP(uint8_t) break;
+                case 2: NX_LAYOUT_TILE_LOOP(uint16_t) break;
+                default: NX_LAYOUT_TILE_LOOP(uint32_t) break;
+            }
+        }
+    }
+}
+
+// Convert rows (n, y): one tiled (x, channel) copy per channel chunk
+static void neurax_layout_rows(void* ctx, size_t begin, size_t end) {
+    const neurax_layout_job_t* job = (const neurax_layout_job_t*)ctx;
+    const neurax_tensor_t* src = job->src;
+    neurax_tensor_t* dst = job->dst;
+    const size_t element_size = neurax_get_element_size(src->data_type);
+    const uint32_t C = src->channels;
+    const uint32_t dst_block = neurax_layout_block_size(dst->layout);
+    size_t src_x, src_c, dst_x, dst_c;
+
+    neurax_layout_row_strides(src, &src_x, &src_c);
+    neurax_layout_row_strides(dst, &dst_x, &dst_c);
+
+    for (size_t row = begin; row < end; row++) {
+        uint32_t n = (uint32_t)(row / src->height);
+        uint32_t y = (uint32_t)(row % src->height);
+
+        for (uint32_t c0 = 0; c0 < C; c0 += job->chunk) {
+            uint32_t count = C - c0 < job->chunk ? C - c0 : job->chunk;
+            neurax_layout_copy_tiles((const uint8_t*)src->data + neurax_layout_offset(src, n, y, 0, c0),
+                                     src_x, src_c,
+                                     (uint8_t*)dst->data + neurax_layout_offset(dst, n, y, 0, c0),
+                                     dst_x, dst_c, src->width, count, element_size);
+        }
+
+        // Zero the padding lanes of a partial last block
+        if (dst_block != 0 && C % dst_block != 0) {
+            size_t pad = (dst_block - C % dst_block) * element_size;
+            for (uint32_t x = 0; x < dst->width; x++) {
+                memset((uint8_t*)dst->data + neurax_tensor_byte_offset(dst, n, y, x, C), 0, pad);
+            }
+        }
+    }
+}
+
+// Convert between layouts
+neurax_error_t neurax_tensor_convert_layout(const neurax_tensor_t* src, neurax_tensor_t* dst) {
+    neurax_error_t error = neurax_validate_tensor(src);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(dst);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (src->width != dst->width || src->height != dst->height ||
+        src->channels != dst->channels || src->batch_size != dst->batch_size ||
+        src->data_type != dst->data_type) {
+        NEURAX_LOG_ERROR("Layout conversion needs tensors of the same shape and type");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (src->data == dst->data) {
+        NEURAX_LOG_ERROR("Layout conversion cannot run in place");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_DEBUG("Converting layout %d -> %d", src->layout, dst->layout);
+
+    // Identical dense storage: one copy
+    if (src->layout == dst->layout && !neurax_tensor_is_view(src) && !neurax_tensor_is_view(dst)) {
+        memcpy(dst->data, src->data, src->data_size);
+        return NEURAX_SUCCESS;
+    }
+
+    // Chunks stop at block boundaries of both sides; 8 divides 16 so the smaller block works
+    uint32_t src_block = neurax_layout_block_size(src->layout);
+    uint32_t dst_block = neurax_layout_block_size(dst->layout);
+    neurax_layout_job_t job;
+    job.src = src;
+    job.dst = dst;
+    job.chunk = src->channels;
+    if (src_block != 0 && src_block < job.chunk) {
+        job.chunk = src_block;
+    }
+    if (dst_block != 0 && dst_block < job.chunk) {
+        job.chunk = dst_block;
+    }
+
+    size_t row_elements = (size_t)src->width * src->channels;
+    neurax_parallel_for((size_t)src->batch_size * src->height, 1,
+                        NEURAX_LAYOUT_PARALLEL_MIN / row_elements + 1, neurax_layout_rows, &job);
+
+    return NEURAX_SUCCESS;
+}
+
+// Preferred activation layout per layer type
+neurax_error_t neurax_get_preferred_layout(neurax_device_t* device,
+                                          neurax_layer_type_t layer,
+                                          neurax_layout_t* layout) {
+    if (!device || !layout || layer > NEURAX_LAYER_SOFTMAX) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // The accelerator streams interleaved pixels
+    if (device->hardware_available && device->config.use_hardware) {
+        *layout = NEURAX_LAYOUT_NHWC;
+        return NEURAX_SUCCESS;
+    }
+
+    switch (layer) {
+        case NEURAX_LAYER_CONV2D:
+        case NEURAX_LAYER_POOLING:
+        case NEURAX_LAYER_ACTIVATION:
+            // Conv vectorizes across a channel block; pooling and activation accept the
+            // same layout so conv/act/pool chains need no conversion in between
+            *layout = NEURAX_CONV_PREFERRED_LAYOUT;
+            break;
+        default:
+            *layout = NEURAX_LAYOUT_NHWC;
+            break;
+    }
+
+    return NEURAX_SUCCESS;
+}
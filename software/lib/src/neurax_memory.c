@@ -0,0 +1,242 @@
+/*
+ * NEURAX Memory Accounting
+ * Per-device live and peak bytes by category, with an optional budget
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Open devices' accounting, newest first; the head is charged for tensors
+// created without a device
+static pthread_mutex_t neurax_memory_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static neurax_memory_t* neurax_memory_list = NULL;
+
+neurax_memory_t* neurax_memory_create(size_t budget) {
+    neurax_memory_t* memory = calloc(1, sizeof(*memory));
+    if (!memory) {
+        return NULL;
+    }
+    memory->budget = budget;
+    memory->refs = 1;
+    if (pthread_mutex_init(&memory->lock, NULL) != 0) {
+        free(memory);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&neurax_memory_list_lock);
+    memory->next = neurax_memory_list;
+    neurax_memory_list = memory;
+    pthread_mutex_unlock(&neurax_memory_list_lock);
+    return memory;
+}
+
+// Stop charging new default tensors to `memory` and drop the device's reference
+void neurax_memory_retire(neurax_memory_t* memory) {
+    if (!memory) {
+        return;
+    }
+
+    pthread_mutex_lock(&neurax_memory_list_lock);
+    for (neurax_memory_t** link = &neurax_memory_list; *link; link = &(*link)->next) {
+        if (*link == memory) {
+            *link = memory->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&neurax_memory_list_lock);
+
+    if (memory->total_live != 0) {
+        NEURAX_LOG_DEBUG("Device released with %zu tracked bytes still live", memory->total_live);
+    }
+    neurax_memory_release(memory);
+}
+
+neurax_memory_t* neurax_memory_retain(neurax_memory_t* memory) {
+    if (memory) {
+        __atomic_add_fetch(&memory->refs, 1, __ATOMIC_RELAXED);
+    }
+    return memory;
+}
+
+void neurax_memory_release(neurax_memory_t* memory) {
+    if (memory && __atomic_sub_fetch(&memory->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_destroy(&memory->lock);
+        free(memory);
+    }
+}
+
+// The newest open device's accounting, referenced (NULL when no device is open)
+neurax_memory_t* neurax_memory_default(void) {
+    pthread_mutex_lock(&neurax_memory_list_lock);
+    neurax_memory_t* memory = neurax_memory_retain(neurax_memory_list);
+    pthread_mutex_unlock(&neurax_memory_list_lock);
+    return memory;
+}
+
+// Account for `size` bytes about to be allocated, refusing them past the budget
+neurax_error_t neurax_memory_charge_to(neurax_memory_t* memory, neurax_memory_category_t category,
+                                       size_t size) {
+    if (!memory) {
+        return NEURAX_SUCCESS;
+    }
+
+    pthread_mutex_lock(&memory->lock);
+    if (memory->budget != 0 &&
+        (size > memory->budget || memory->total_live > memory->budget - size)) {
+        size_t live = memory->total_live;
+        size_t budget = memory->budget;
+        memory->failed_allocs++;
+        pthread_mutex_unlock(&memory->lock);
+        NEURAX_LOG_ERROR("Memory budget exceeded: %zu bytes requested, %zu of %zu in use",
+                         size, live, budget);
+        (void)live;
+        (void)budget;
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    memory->live[category] += size;
+    memory->allocations[category]++;
+    if (memory->live[category] > memory->peak[category]) {
+        memory->peak[category] = memory->live[category];
+    }
+    memory->total_live += size;
+    if (memory->total_live > memory->total_peak) {
+        memory->total_peak = memory->total_live;
+    }
+    pthread_mutex_unlock(&memory->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+void neurax_memory_uncharge_from(neurax_memory_t* memory, neurax_memory_category_t category,
+                                 size_t size) {
+    if (!memory) {
+        return;
+    }
+
+    pthread_mutex_lock(&memory->lock);
+    memory->live[category] -= size;
+    memory->frees[category]++;
+    memory->total_live -= size;
+    pthread_mutex_unlock(&memory->lock);
+}
+
+neurax_error_t neurax_memory_charge(neurax_device_t* device, neurax_memory_category_t category,
+                                    size_t size) {
+    return neurax_memory_charge_to(device ? device->memory : NULL, category, size);
+}
+
+void neurax_memory_uncharge(neurax_device_t* device, neurax_memory_category_t category,
+                            size_t size) {
+    neurax_memory_uncharge_from(device ? device->memory : NULL, category, size);
+}
+
+// Public API
+
+neurax_error_t neurax_tensor_create_tracked(neurax_device_t* device,
+                                           neurax_memory_category_t category,
+                                           uint32_t width, uint32_t height,
+                                           uint32_t channels, uint32_t batch_size,
+                                           neurax_data_type_t data_type,
+                                           neurax_layout_t layout,
+                                           uint32_t flags,
+                                           neurax_tensor_t** tensor) {
+    if (!tensor || category >= NEURAX_MEMORY_CATEGORY_COUNT) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    return neurax_tensor_create_charged(width, height, channels, batch_size, data_type, layout,
+                                        flags, 0, device->memory, category, tensor);
+}
+
+neurax_error_t neurax_tensor_track(neurax_device_t* device, neurax_tensor_t* tensor,
+                                  neurax_memory_category_t category) {
+    if (!tensor || category >= NEURAX_MEMORY_CATEGORY_COUNT) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    // The charge is recorded in the tensor's state, which caller-built headers lack
+    if (!tensor->state || tensor->state->is_view || tensor->state->in_workspace) {
+        NEURAX_LOG_ERROR("Only library-created tensors that are not views or workspace "
+                         "tensors can be tracked");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Charge the new owner first so a refusal leaves the existing charge in place
+    struct neurax_tensor_state* state = tensor->state;
+    neurax_error_t error = neurax_memory_charge_to(device->memory, category, tensor->data_size);
+    if (error != NEURAX_SUCCESS) return error;
+
+    neurax_memory_uncharge_from(state->memory, state->memory_category, tensor->data_size);
+    neurax_memory_release(state->memory);
+    state->memory = neurax_memory_retain(device->memory);
+    state->memory_category = category;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_set_budget(neurax_device_t* device, size_t budget) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_lock(&device->memory->lock);
+    device->memory->budget = budget;
+    pthread_mutex_unlock(&device->memory->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_get_stats(neurax_device_t* device, neurax_memory_stats_t* stats) {
+    if (!stats) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_memory_t* memory = device->memory;
+    memset(stats, 0, sizeof(*stats));
+
+    pthread_mutex_lock(&memory->lock);
+    for (int c = 0; c < NEURAX_MEMORY_CATEGORY_COUNT; c++) {
+        neurax_memory_usage_t* usage = &stats->categories[c];
+        usage->live_bytes = memory->live[c];
+        usage->peak_bytes = memory->peak[c];
+        usage->allocations = memory->allocations[c];
+        usage->frees = memory->frees[c];
+        stats->total.allocations += usage->allocations;
+        stats->total.frees += usage->frees;
+    }
+    stats->total.live_bytes = memory->total_live;
+    stats->total.peak_bytes = memory->total_peak;
+    stats->budget = memory->budget;
+    stats->failed_allocs = memory->failed_allocs;
+    pthread_mutex_unlock(&memory->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_reset_peak(neurax_device_t* device) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_memory_t* memory = device->memory;
+    pthread_mutex_lock(&memory->lock);
+    for (int c = 0; c < NEURAX_MEMORY_CATEGORY_COUNT; c++) {
+        memory->peak[c] = memory->live[c];
+    }
+    memory->total_peak = memory->total_live;
+    pthread_mutex_unlock(&memory->lock);
+
+    return NEURAX_SUCCESS;
+}
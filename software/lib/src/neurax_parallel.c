@@ -0,0 +1,180 @@
+/*
+ * NEURAX Parallel Execution Helpers
+ * Splits large workloads across a persistent pool of CPU worker threads
+ *
+ * Author: NEURAX Team
+ */
+
+#define _GNU_SOURCE
+#include "neurax_private.h"
+#include <pthread.h>
+#include <unistd.h>
+
+// Process-wide worker pool. One parallel_for runs on it at a time; the caller
+// claims ranges alongside the workers and returns once every range finished.
+typedef struct {
+    pthread_mutex_t dispatch;   // Held by the parallel_for using the pool
+    pthread_mutex_t lock;       // Protects the fields below
+    pthread_cond_t start;       // Signalled when a new loop is published
+    pthread_cond_t done;        // Signalled when the last range finishes
+    uint32_t workers;           // Threads started, excluding callers
+    uint64_t generation;        // Bumped for every published loop
+    neurax_parallel_fn fn;
+    void* ctx;
+    void* scratch;              // Caller's scratch context, lent to the workers
+    size_t count;
+    size_t chunk;
+    size_t num_ranges;
+    size_t next_range;          // Next range to claim
+    size_t finished_ranges;
+} neurax_parallel_pool_t;
+
+static neurax_parallel_pool_t neurax_pool = {
+    .dispatch = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static pthread_once_t neurax_threads_once = PTHREAD_ONCE_INIT;
+static pthread_once_t neurax_pool_once = PTHREAD_ONCE_INIT;
+static uint32_t neurax_num_threads = 1;
+
+static void neurax_init_num_threads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        cpus = 1;
+    }
+    if (cpus > NEURAX_MAX_THREADS) {
+        cpus = NEURAX_MAX_THREADS;
+    }
+    neurax_num_threads = (uint32_t)cpus;
+}
+
+// Number of threads usable for CPU kernels
+uint32_t neurax_get_num_threads(void) {
+    pthread_once(&neurax_threads_once, neurax_init_num_threads);
+    return neurax_num_threads;
+}
+
+// Run ranges of the current loop until none are left. Called with the pool lock held.
+static void neurax_parallel_claim(neurax_parallel_pool_t* pool) {
+    while (pool->next_range < pool->num_ranges) {
+        size_t range = pool->next_range++;
+        neurax_parallel_fn fn = pool->fn;
+        void* ctx = pool->ctx;
+        void* scratch = pool->scratch;
+        size_t begin = range * pool->chunk;
+        size_t end = begin + pool->chunk < pool->count ? begin + pool->chunk : pool->count;
+
+        pthread_mutex_unlock(&pool->lock);
+        void* own_scratch = neurax_scratch_context();
+        neurax_scratch_set_context(scratch);
+        fn(ctx, begin, end);
+        neurax_scratch_set_context(own_scratch);
+        pthread_mutex_lock(&pool->lock);
+
+        if (++pool->finished_ranges == pool->num_ranges) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+}
+
+static void* neurax_parallel_worker(void* arg) {
+    neurax_parallel_pool_t* pool = (neurax_parallel_pool_t*)arg;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        seen = pool->generation;
+        neurax_parallel_claim(pool);
+    }
+
+    return NULL;
+}
+
+// Workers live for the rest of the process; if some fail to start the caller
+// simply runs more of the ranges itself
+static void neurax_init_pool(void) {
+    pthread_attr_t attr;
+    uint32_t wanted = neurax_get_num_threads() - 1;
+
+    if (pthread_attr_init(&attr) != 0) {
+        return;
+    }
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    for (uint32_t i = 0; i < wanted; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, neurax_parallel_worker, &neurax_pool) != 0) {
+            NEURAX_LOG_INFO("Started %u of %u CPU worker threads", i, wanted);
+            break;
+        }
+        pthread_mutex_lock(&neurax_pool.lock);
+        neurax_pool.workers++;
+        pthread_mutex_unlock(&neurax_pool.lock);
+    }
+
+    pthread_attr_destroy(&attr);
+}
+
+// Run fn over [0, count) split into contiguous ranges, at most one per thread.
+// Range boundaries fall on multiples of `grain` items; at least `min_per_thread`
+// items go to each thread. Calls made while the pool is busy (from another
+// thread, or nested inside fn) run on the calling thread.
+void neurax_parallel_for(size_t count, size_t grain, size_t min_per_thread,
+                         neurax_parallel_fn fn, void* ctx) {
+    if (count == 0) {
+        return;
+    }
+
+    size_t num_threads = neurax_get_num_threads();
+    if (min_per_thread > 0 && count / min_per_thread < num_threads) {
+        num_threads = count / min_per_thread;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    if (num_threads <= 1) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    size_t chunk = (count + num_threads - 1) / num_threads;
+    chunk = (chunk + grain - 1) / grain * grain;
+    if (chunk >= count) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    pthread_once(&neurax_pool_once, neurax_init_pool);
+    if (pthread_mutex_trylock(&neurax_pool.dispatch) != 0) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    neurax_parallel_pool_t* pool = &neurax_pool;
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->scratch = neurax_scratch_context();
+    pool->count = count;
+    pool->chunk = chunk;
+    pool->num_ranges = (count + chunk - 1) / chunk;
+    pool->next_range = 0;
+    pool->finished_ranges = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+
+    neurax_parallel_claim(pool);
+    while (pool->finished_ranges < pool->num_ranges) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&neurax_pool.dispatch);
+}
@@ -0,0 +1,254 @@
+/*
+ * NEURAX Performance Model
+ * Cycle-approximate cost of accelerator runs from the configured multipliers,
+ * clock and DMA bandwidth
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <string.h>
+
+// Defaults for unset configuration fields
+#define NEURAX_PERF_DEFAULT_MULTIPLIERS 64
+#define NEURAX_PERF_DEFAULT_CLOCK_MHZ 100
+#define NEURAX_PERF_DEFAULT_BANDWIDTH_MBPS 800   // 64-bit FPGA-to-HPS bridge at 100 MHz
+
+// Register programming, start and completion handshake of one run
+#define NEURAX_PERF_RUN_OVERHEAD_CYCLES 64
+
+static uint32_t neurax_perf_clock_mhz(const neurax_config_t* config) {
+    return config->clock_mhz ? config->clock_mhz : NEURAX_PERF_DEFAULT_CLOCK_MHZ;
+}
+
+// Length of one accelerator cycle at the configured clock
+double neurax_perf_cycle_ns(const neurax_config_t* config) {
+    return 1000.0 / neurax_perf_clock_mhz(config);
+}
+
+static uint64_t neurax_perf_div_ceil(uint64_t a, uint64_t b) {
+    return (a + b - 1) / b;
+}
+
+neurax_error_t neurax_perf_model_run(const neurax_config_t* config,
+                                     const neurax_hw_program_t* program,
+                                     neurax_perf_estimate_t* estimate) {
+    neurax_dim_config_reg_t dim = {.raw = program->dim_config};
+    neurax_chan_config_reg_t chan = {.raw = program->chan_config};
+    uint64_t element_size = (program->control & CTRL_DATA_WIDTH) ? 2 : 1;
+    uint64_t width = dim.bits.width;
+    uint64_t height = dim.bits.height;
+    uint64_t in_channels = chan.bits.input_channels;
+    uint64_t out_channels = chan.bits.output_channels;
+    uint64_t operations, elements;
+
+    memset(estimate, 0, sizeof(*estimate));
+
+    if (program->control & CTRL_CONV_EN) {
+        neurax_conv_config_reg_t conv = {.raw = program->conv_config};
+        uint64_t kernel = conv.bits.kernel_size + 1;
+        uint64_t stride = conv.bits.stride + 1;
+        uint64_t padding = conv.bits.padding;
+        uint64_t conv_channels = conv.bits.input_channels + 1;
+
+        if (width + 2 * padding < kernel || height + 2 * padding < kernel) {
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        uint64_t outputs = ((width + 2 * padding - kernel) / stride + 1) *
+                           ((height + 2 * padding - kernel) / stride + 1) * out_channels;
+        uint64_t weights = out_channels * conv_channels * kernel * kernel;
+
+        operations = outputs * conv_channels * kernel * kernel;
+        elements = width * height * in_channels + weights + outputs +
+                   (conv.bits.use_bias ? out_channels : 0);
+    } else if (program->control & CTRL_POOL_EN) {
+        uint64_t size = ((program->pool_config >> 1) & 0x7) + 2;
+        uint64_t stride = ((program->pool_config >> 4) & 0x7) + 1;
+
+        if (width < size || height < size) {
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        uint64_t outputs = ((width - size) / stride + 1) * ((height - size) / stride + 1) *
+                           in_channels;
+
+        operations = outputs * size * size;
+        elements = width * height * in_channels + outputs;
+    } else if (program->control & CTRL_ACT_EN) {
+        operations = width * height * in_channels;
+        elements = 2 * operations;
+    } else {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Operands stream in while results stream out, so compute and transfer overlap
+    uint32_t multipliers = config->num_multipliers ? config->num_multipliers
+                                                   : NEURAX_PERF_DEFAULT_MULTIPLIERS;
+    uint32_t bandwidth = config->dma_bandwidth_mbps ? config->dma_bandwidth_mbps
+                                                    : NEURAX_PERF_DEFAULT_BANDWIDTH_MBPS;
+
+    estimate->operations = operations;
+    estimate->dma_bytes = elements * element_size;
+    estimate->compute_cycles = neurax_perf_div_ceil(operations, multipliers);
+    estimate->transfer_cycles = neurax_perf_div_ceil(estimate->dma_bytes * neurax_perf_clock_mhz(config),
+                                                     bandwidth);
+    estimate->cycles = (estimate->compute_cycles > estimate->transfer_cycles ?
+                        estimate->compute_cycles : estimate->transfer_cycles) +
+                       NEURAX_PERF_RUN_OVERHEAD_CYCLES;
+    estimate->runs = 1;
+    estimate->time_ms = (double)estimate->cycles / (neurax_perf_clock_mhz(config) * 1000.0);
+    estimate->bottleneck = estimate->compute_cycles >= estimate->transfer_cycles ?
+                           NEURAX_BOUND_COMPUTE : NEURAX_BOUND_TRANSFER;
+
+    return NEURAX_SUCCESS;
+}
+
+// Add `count` copies of an estimate to a running total
+void neurax_perf_accumulate(const neurax_config_t* config, neurax_perf_estimate_t* total,
+                            const neurax_perf_estimate_t* estimate, uint32_t count) {
+    total->cycles += estimate->cycles * count;
+    total->compute_cycles += estimate->compute_cycles * count;
+    total->transfer_cycles += estimate->transfer_cycles * count;
+    total->dma_bytes += estimate->dma_bytes * count;
+    total->operations += estimate->operations * count;
+    total->runs += estimate->runs * count;
+    total->time_ms = (double)total->cycles / (neurax_perf_clock_mhz(config) * 1000.0);
+
+    if (total->runs == 0) {
+        total->bottleneck = NEURAX_BOUND_NONE;
+    } else {
+        total->bottleneck = total->compute_cycles >= total->transfer_cycles ?
+                            NEURAX_BOUND_COMPUTE : NEURAX_BOUND_TRANSFER;
+    }
+}
+
+// Encode a layer the way the hardware path programs it. Returns false for layers the
+// accelerator doesn't take; those fall back to the CPU.
+bool neurax_hw_encode_layer(const neurax_config_t* config, const neurax_perf_layer_t* layer,
+                            neurax_hw_program_t* program, uint32_t* runs) {
+    neurax_data_type_t type = layer->data_type;
+    uint32_t height = layer->height;
+    uint32_t out_channels = layer->channels;
+
+    if (type != NEURAX_DATA_INT8 && type != NEURAX_DATA_UINT8 &&
+        type != NEURAX_DATA_INT16 && type != NEURAX_DATA_UINT16) {
+        return false;
+    }
+
+    memset(program, 0, sizeof(*program));
+    *runs = layer->batch_size;
+
+    if (layer->type == NEURAX_LAYER_CONV2D) {
+        const neurax_conv_config_t* conv = &layer->conv;
+        uint32_t max_kernel = config->max_kernel_size ? config->max_kernel_size : 16;
+        if (conv->kernel_width != conv->kernel_height || conv->kernel_width == 0 ||
+            conv->kernel_width > max_kernel || conv->kernel_width > 16 ||
+            conv->stride_x != conv->stride_y || conv->stride_x == 0 || conv->stride_x > 8 ||
+            conv->padding_x != conv->padding_y || conv->padding_x > 3 ||
+            conv->input_channels != layer->channels || conv->input_channels == 0 ||
+            conv->input_channels > 8 || conv->output_channels > 0xFFFF) {
+            return false;
+        }
+
+        neurax_conv_config_reg_t conv_config = {.raw = 0};
+        conv_config.bits.kernel_size = conv->kernel_width - 1;
+        conv_config.bits.stride = conv->stride_x - 1;
+        conv_config.bits.padding = conv->padding_x;
+        conv_config.bits.use_bias = conv->use_bias ? 1 : 0;
+        conv_config.bits.input_channels = conv->input_channels - 1;
+        program->conv_config = conv_config.raw;
+        program->act_config = conv->activation & 0x3;
+        program->control = CTRL_CONV_EN;
+        if (conv->activation != NEURAX_ACTIVATION_LINEAR) {
+            program->control |= CTRL_ACT_EN;
+        }
+        out_channels = conv->output_channels;
+    } else if (layer->type == NEURAX_LAYER_POOLING) {
+        const neurax_pool_config_t* pool = &layer->pool;
+        if (pool->pool_width != pool->pool_height || pool->pool_width < 2 ||
+            pool->pool_width > 9 || pool->stride_x != pool->stride_y ||
+            pool->stride_x == 0 || pool->stride_x > 8) {
+            return false;
+        }
+
+        program->pool_config = (pool->pool_type & 0x1) | ((pool->pool_width - 2) & 0x7) << 1 |
+                               ((pool->stride_x - 1) & 0x7) << 4;
+        program->control = CTRL_POOL_EN;
+    } else if (layer->type == NEURAX_LAYER_ACTIVATION) {
+        // The whole batch streams as one image
+        if ((uint64_t)layer->height * layer->batch_size > 0xFFFF || layer->activation > 0x3) {
+            return false;
+        }
+
+        program->act_config = layer->activation & 0x3;
+        program->control = CTRL_ACT_EN;
+        height = layer->height * layer->batch_size;
+        *runs = 1;
+    } else {
+        return false;
+    }
+
+    if (layer->width > 0xFFFF || height > 0xFFFF || layer->channels > 0xFFFF) {
+        return false;
+    }
+
+    if (type == NEURAX_DATA_INT16 || type == NEURAX_DATA_UINT16) {
+        program->control |= CTRL_DATA_WIDTH;
+    }
+    if (type == NEURAX_DATA_INT8 || type == NEURAX_DATA_INT16) {
+        program->control |= CTRL_SIGNED;
+    }
+    program->dim_config = (layer->width & 0xFFFF) | (height & 0xFFFF) << 16;
+    program->chan_config = (layer->channels & 0xFFFF) | (out_channels & 0xFFFF) << 16;
+
+    return true;
+}
+
+// Public API
+
+neurax_error_t neurax_perf_estimate(neurax_device_t* device, const neurax_perf_layer_t* layers,
+                                   uint32_t num_layers, neurax_perf_estimate_t* estimates,
+                                   neurax_perf_estimate_t* total) {
+    if (!layers || num_layers == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_perf_estimate_t sum;
+    memset(&sum, 0, sizeof(sum));
+
+    for (uint32_t i = 0; i < num_layers; i++) {
+        const neurax_perf_layer_t* layer = &layers[i];
+        neurax_perf_estimate_t layer_estimate, run;
+        neurax_hw_program_t program;
+        uint32_t runs;
+
+        if (layer->width == 0 || layer->height == 0 || layer->channels == 0 ||
+            layer->batch_size == 0) {
+            NEURAX_LOG_ERROR("Layer %u has an empty shape", i);
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+
+        memset(&layer_estimate, 0, sizeof(layer_estimate));
+        if (neurax_hw_encode_layer(&device->config, layer, &program, &runs)) {
+            neurax_error_t error = neurax_perf_model_run(&device->config, &program, &run);
+            if (error != NEURAX_SUCCESS) {
+                NEURAX_LOG_ERROR("Layer %u: kernel or window larger than its input", i);
+                return error;
+            }
+            neurax_perf_accumulate(&device->config, &layer_estimate, &run, runs);
+            neurax_perf_accumulate(&device->config, &sum, &run, runs);
+        }
+
+        if (estimates) {
+            estimates[i] = layer_estimate;
+        }
+    }
+
+    if (total) {
+        *total = sum;
+    }
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,295 @@
+/*
+ * NEURAX Static Memory Planner
+ * Packs activation tensors into one block by reusing storage of tensors that are no longer live
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Offset granularity inside the planned block
+#define NEURAX_PLAN_ALIGNMENT NEURAX_TENSOR_ALIGNMENT
+
+// Tensor with no layer touching it
+#define NEURAX_PLAN_UNUSED UINT32_MAX
+
+// Storage shared by a tensor and the tensors computed in place on top of it
+typedef struct {
+    size_t size;
+    uint32_t first;                 // First layer that needs the storage
+    uint32_t last;                  // Last layer that needs the storage
+    size_t offset;
+} neurax_plan_buffer_t;
+
+struct neurax_memory_plan {
+    uint32_t num_tensors;
+    size_t* sizes;                  // Requested size of each tensor
+    uint32_t* buffer_of;            // Buffer index of each tensor (NEURAX_PLAN_UNUSED = unused)
+    neurax_plan_buffer_t* buffers;
+    uint32_t num_buffers;
+    neurax_memory_plan_stats_t stats;
+};
+
+static inline size_t neurax_plan_align(size_t size) {
+    return (size + NEURAX_PLAN_ALIGNMENT - 1) & ~((size_t)NEURAX_PLAN_ALIGNMENT - 1);
+}
+
+static inline bool neurax_plan_overlap(const neurax_plan_buffer_t* a, const neurax_plan_buffer_t* b) {
+    return a->first <= b->last && b->first <= a->last;
+}
+
+// Placement order: largest first, earlier first among equals
+static int neurax_plan_compare(const void* pa, const void* pb, const neurax_plan_buffer_t* buffers) {
+    const neurax_plan_buffer_t* a = &buffers[*(const uint32_t*)pa];
+    const neurax_plan_buffer_t* b = &buffers[*(const uint32_t*)pb];
+    if (a->size != b->size) return a->size > b->size ? -1 : 1;
+    if (a->first != b->first) return a->first < b->first ? -1 : 1;
+    return 0;
+}
+
+// Insertion sort with the buffers as context (qsort has no context argument in C99)
+static void neurax_plan_sort(uint32_t* order, uint32_t count, const neurax_plan_buffer_t* buffers) {
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t key = order[i];
+        uint32_t j = i;
+        while (j > 0 && neurax_plan_compare(&key, &order[j - 1], buffers) < 0) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = key;
+    }
+}
+
+// Greedy by size with best fit: each buffer takes the smallest gap between already placed
+// buffers whose lifetimes overlap its own, or goes above all of them
+static size_t neurax_plan_place(neurax_plan_buffer_t* buffers, const uint32_t* order, uint32_t count,
+                                uint32_t* live) {
+    size_t peak = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        neurax_plan_buffer_t* buffer = &buffers[order[i]];
+
+        // Placed buffers that overlap in time, sorted by offset
+        uint32_t num_live = 0;
+        for (uint32_t j = 0; j < i; j++) {
+            const neurax_plan_buffer_t* other = &buffers[order[j]];
+            if (!neurax_plan_overlap(buffer, other)) continue;
+
+            uint32_t k = num_live++;
+            while (k > 0 && buffers[live[k - 1]].offset > other->offset) {
+                live[k] = live[k - 1];
+                k--;
+            }
+            live[k] = order[j];
+        }
+
+        size_t best_offset = 0;
+        size_t best_gap = SIZE_MAX;
+        size_t cursor = 0;
+        for (uint32_t j = 0; j < num_live; j++) {
+            const neurax_plan_buffer_t* other = &buffers[live[j]];
+            if (other->offset > cursor) {
+                size_t gap = other->offset - cursor;
+                if (gap >= buffer->size && gap < best_gap) {
+                    best_gap = gap;
+                    best_offset = cursor;
+                }
+            }
+            size_t end = other->offset + other->size;
+            if (end > cursor) {
+                cursor = end;
+            }
+        }
+
+        buffer->offset = best_gap != SIZE_MAX ? best_offset : cursor;
+        if (buffer->offset + buffer->size > peak) {
+            peak = buffer->offset + buffer->size;
+        }
+    }
+
+    return peak;
+}
+
+// Create a memory plan for a layer sequence
+neurax_error_t neurax_memory_plan_create(const size_t* tensor_sizes, uint32_t num_tensors,
+                                        const neurax_plan_layer_t* layers, uint32_t num_layers,
+                                        neurax_memory_plan_t** plan) {
+    if (!tensor_sizes || num_tensors == 0 || !layers || num_layers == 0 || !plan) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Lifetimes: produced tensors start at their layer, graph inputs at the first layer.
+    // Tensors nobody reads are graph outputs and stay live to the end.
+    uint32_t* producer = malloc(sizeof(uint32_t) * num_tensors);
+    uint32_t* last_read = malloc(sizeof(uint32_t) * num_tensors);
+    neurax_memory_plan_t* p = calloc(1, sizeof(neurax_memory_plan_t));
+    if (p) {
+        p->sizes = malloc(sizeof(size_t) * num_tensors);
+        p->buffer_of = malloc(sizeof(uint32_t) * num_tensors);
+        p->buffers = malloc(sizeof(neurax_plan_buffer_t) * num_tensors);
+    }
+    uint32_t* order = malloc(sizeof(uint32_t) * num_tensors * 2);
+    if (!producer || !last_read || !p || !p->sizes || !p->buffer_of || !p->buffers || !order) {
+        free(producer);
+        free(last_read);
+        free(order);
+        neurax_memory_plan_destroy(p);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    neurax_error_t error = NEURAX_SUCCESS;
+    memcpy(p->sizes, tensor_sizes, sizeof(size_t) * num_tensors);
+    p->num_tensors = num_tensors;
+    for (uint32_t t = 0; t < num_tensors; t++) {
+        producer[t] = NEURAX_PLAN_UNUSED;
+        last_read[t] = NEURAX_PLAN_UNUSED;
+        p->buffer_of[t] = NEURAX_PLAN_UNUSED;
+    }
+
+    for (uint32_t l = 0; l < num_layers && error == NEURAX_SUCCESS; l++) {
+        const neurax_plan_layer_t* layer = &layers[l];
+        // Each tensor is produced once, before any layer reads it
+        if (layer->output >= num_tensors || producer[layer->output] != NEURAX_PLAN_UNUSED ||
+            last_read[layer->output] != NEURAX_PLAN_UNUSED ||
+            (layer->num_inputs > 0 && !layer->inputs) || (layer->in_place && layer->num_inputs == 0)) {
+            error = NEURAX_ERROR_INVALID_PARAM;
+            break;
+        }
+        for (uint32_t i = 0; i < layer->num_inputs; i++) {
+            uint32_t t = layer->inputs[i];
+            if (t >= num_tensors || t == layer->output) {
+                error = NEURAX_ERROR_INVALID_PARAM;
+                break;
+            }
+            last_read[t] = l;
+        }
+        producer[layer->output] = l;
+    }
+
+    if (error != NEURAX_SUCCESS) {
+        NEURAX_LOG_ERROR("Memory plan: invalid layer sequence");
+        free(producer);
+        free(last_read);
+        free(order);
+        neurax_memory_plan_destroy(p);
+        return error;
+    }
+
+    // Graph inputs are live from the first layer up to their last reader
+    size_t naive = 0;
+    for (uint32_t t = 0; t < num_tensors; t++) {
+        if (producer[t] != NEURAX_PLAN_UNUSED || last_read[t] == NEURAX_PLAN_UNUSED) continue;
+
+        neurax_plan_buffer_t* buffer = &p->buffers[p->num_buffers];
+        buffer->size = neurax_plan_align(tensor_sizes[t]);
+        buffer->first = 0;
+        buffer->last = last_read[t];
+        buffer->offset = 0;
+        p->buffer_of[t] = p->num_buffers++;
+        naive += buffer->size;
+    }
+
+    // Layer outputs in execution order. An in-place output takes over its input's buffer
+    // when nothing reads that buffer after the layer.
+    for (uint32_t l = 0; l < num_layers; l++) {
+        const neurax_plan_layer_t* layer = &layers[l];
+        uint32_t t = layer->output;
+        uint32_t last = last_read[t] != NEURAX_PLAN_UNUSED ? last_read[t] : num_layers;
+        size_t size = neurax_plan_align(tensor_sizes[t]);
+        naive += size;
+
+        uint32_t source = layer->in_place ? p->buffer_of[layer->inputs[0]] : NEURAX_PLAN_UNUSED;
+        if (source != NEURAX_PLAN_UNUSED && p->buffers[source].last == l) {
+            neurax_plan_buffer_t* buffer = &p->buffers[source];
+            buffer->last = last;
+            if (size > buffer->size) {
+                buffer->size = size;
+            }
+            p->buffer_of[t] = source;
+            p->stats.in_place_tensors++;
+            continue;
+        }
+
+        neurax_plan_buffer_t* buffer = &p->buffers[p->num_buffers];
+        buffer->size = size;
+        buffer->first = l;
+        buffer->last = last;
+        buffer->offset = 0;
+        p->buffer_of[t] = p->num_buffers++;
+    }
+
+    for (uint32_t b = 0; b < p->num_buffers; b++) {
+        order[b] = b;
+    }
+    neurax_plan_sort(order, p->num_buffers, p->buffers);
+
+    p->stats.peak_bytes = neurax_plan_place(p->buffers, order, p->num_buffers, order + num_tensors);
+    p->stats.naive_bytes = naive;
+    p->stats.num_tensors = num_tensors;
+    p->stats.num_buffers = p->num_buffers;
+
+    NEURAX_LOG_INFO("Memory plan: %u tensors in %u buffers, %zu bytes (naive %zu)",
+                    num_tensors, p->num_buffers, p->stats.peak_bytes, naive);
+
+    free(producer);
+    free(last_read);
+    free(order);
+    *plan = p;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_plan_destroy(neurax_memory_plan_t* plan) {
+    if (!plan) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    free(plan->sizes);
+    free(plan->buffer_of);
+    free(plan->buffers);
+    free(plan);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_plan_get_stats(const neurax_memory_plan_t* plan,
+                                           neurax_memory_plan_stats_t* stats) {
+    if (!plan || !stats) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *stats = plan->stats;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_memory_plan_get_offset(const neurax_memory_plan_t* plan, uint32_t tensor,
+                                            size_t* offset) {
+    if (!plan || !offset || tensor >= plan->num_tensors ||
+        plan->buffer_of[tensor] == NEURAX_PLAN_UNUSED) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *offset = plan->buffers[plan->buffer_of[tensor]].offset;
+    return NEURAX_SUCCESS;
+}
+
+// Create a tensor over a planned tensor's storage inside the caller's block
+neurax_error_t neurax_memory_plan_bind(const neurax_memory_plan_t* plan, void* block,
+                                      uint32_t tensor,
+                                      uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_tensor_t** output) {
+    size_t offset;
+    if (!block) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_memory_plan_get_offset(plan, tensor, &offset);
+    if (error != NEURAX_SUCCESS) return error;
+
+    return neurax_tensor_wrap((uint8_t*)block + offset, plan->sizes[tensor],
+                              width, height, channels, batch_size, data_type,
+                              NEURAX_LAYOUT_NHWC, NEURAX_WRAP_BORROW, NULL, NULL, output);
+}
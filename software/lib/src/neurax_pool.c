@@ -0,0 +1,329 @@
+/*
+ * NEURAX Tensor Pool
+ * Size-class recycling of tensor buffers with per-thread caches
+ *
+ * Author: NEURAX Team
+ */
+
+#define _GNU_SOURCE
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Smallest class and largest pooled buffer; bigger tensors bypass the pool
+#define NEURAX_POOL_MIN_SHIFT 8
+#define NEURAX_POOL_MAX_SHIFT 28
+// Four classes per power of two keep the rounding waste under 25%
+#define NEURAX_POOL_CLASSES (1 + (NEURAX_POOL_MAX_SHIFT - NEURAX_POOL_MIN_SHIFT) * 4)
+
+// Buffers each thread keeps per class, and the largest buffer a thread cache holds
+#define NEURAX_POOL_CACHE_DEPTH 4
+#define NEURAX_POOL_CACHE_MAX_SIZE (1u << 20)
+
+// Idle bytes retained when neurax_config_t does not set a limit
+#define NEURAX_POOL_DEFAULT_LIMIT ((size_t)256 << 20)
+
+// Per-thread cache, served without taking the pool lock. Its own lock is only
+// contended when trim or the last detach drains it from another thread.
+typedef struct neurax_pool_cache {
+    pthread_mutex_t lock;
+    void* slots[NEURAX_POOL_CLASSES][NEURAX_POOL_CACHE_DEPTH];
+    uint8_t count[NEURAX_POOL_CLASSES];
+    struct neurax_pool_cache* prev;
+    struct neurax_pool_cache* next;
+} neurax_pool_cache_t;
+
+// Process-wide pool shared by all devices that enable it. Lock order: pool, then cache.
+static struct {
+    pthread_mutex_t lock;
+    void* free_lists[NEURAX_POOL_CLASSES];  // Idle buffers, linked through their first word
+    neurax_pool_cache_t* caches;            // Every live thread cache
+    uint32_t users;                         // Devices with the pool enabled
+    size_t limit;                           // Largest number of idle bytes retained (atomic)
+    // Statistics, updated with relaxed atomics so thread caches stay lock-free
+    uint64_t hits;
+    uint64_t misses;
+    size_t bytes_retained;
+    size_t bytes_in_use;
+} neurax_pool = {PTHREAD_MUTEX_INITIALIZER, {NULL}, NULL, 0, 0, 0, 0, 0, 0};
+
+static pthread_key_t neurax_pool_key;
+static pthread_once_t neurax_pool_key_once = PTHREAD_ONCE_INIT;
+
+#define NX_POOL_ADD(field, value) __atomic_fetch_add(&neurax_pool.field, (value), __ATOMIC_RELAXED)
+#define NX_POOL_SUB(field, value) __atomic_fetch_sub(&neurax_pool.field, (value), __ATOMIC_RELAXED)
+#define NX_POOL_LOAD(field) __atomic_load_n(&neurax_pool.field, __ATOMIC_RELAXED)
+
+// Size class of a request: index and rounded size, or false when it is not pooled
+static bool neurax_pool_class(size_t size, uint32_t* index, size_t* class_size) {
+    if (size <= ((size_t)1 << NEURAX_POOL_MIN_SHIFT)) {
+        *index = 0;
+        *class_size = (size_t)1 << NEURAX_POOL_MIN_SHIFT;
+        return true;
+    }
+    if (size > ((size_t)1 << NEURAX_POOL_MAX_SHIFT)) {
+        return false;
+    }
+
+    // 2^k < size <= 2^(k+1), split into four steps of 2^(k-2)
+    uint32_t k = 0;
+    while (((size_t)2 << k) < size) {
+        k++;
+    }
+    size_t step = (size_t)1 << (k - 2);
+    size_t steps = (size - ((size_t)1 << k) + step - 1) / step;
+
+    *index = 1 + (k - NEURAX_POOL_MIN_SHIFT) * 4 + (uint32_t)(steps - 1);
+    *class_size = ((size_t)1 << k) + steps * step;
+    return true;
+}
+
+static size_t neurax_pool_class_size(uint32_t index) {
+    if (index == 0) {
+        return (size_t)1 << NEURAX_POOL_MIN_SHIFT;
+    }
+    uint32_t k = NEURAX_POOL_MIN_SHIFT + (index - 1) / 4;
+    return ((size_t)1 << k) + ((index - 1) % 4 + 1) * ((size_t)1 << (k - 2));
+}
+
+// Push a buffer onto the shared free lists, or free it past the retention limit.
+// Caller holds the pool lock.
+static void neurax_pool_push_locked(void* ptr, uint32_t index) {
+    size_t size = neurax_pool_class_size(index);
+
+    if (neurax_pool.users == 0 || NX_POOL_LOAD(bytes_retained) + size > NX_POOL_LOAD(limit)) {
+        neurax_free_aligned(ptr);
+        return;
+    }
+    *(void**)ptr = neurax_pool.free_lists[index];
+    neurax_pool.free_lists[index] = ptr;
+    NX_POOL_ADD(bytes_retained, size);
+}
+
+static void neurax_pool_push(void* ptr, uint32_t index) {
+    pthread_mutex_lock(&neurax_pool.lock);
+    neurax_pool_push_locked(ptr, index);
+    pthread_mutex_unlock(&neurax_pool.lock);
+}
+
+// Return everything in a thread cache to the shared lists. Caller holds the pool lock.
+static void neurax_pool_drain_locked(neurax_pool_cache_t* cache) {
+    pthread_mutex_lock(&cache->lock);
+    for (uint32_t i = 0; i < NEURAX_POOL_CLASSES; i++) {
+        while (cache->count[i] > 0) {
+            void* ptr = cache->slots[i][--cache->count[i]];
+            NX_POOL_SUB(bytes_retained, neurax_pool_class_size(i));
+            neurax_pool_push_locked(ptr, i);
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+static void neurax_pool_drain_all_locked(void) {
+    for (neurax_pool_cache_t* cache = neurax_pool.caches; cache; cache = cache->next) {
+        neurax_pool_drain_locked(cache);
+    }
+}
+
+static void neurax_pool_cache_destructor(void* arg) {
+    neurax_pool_cache_t* cache = (neurax_pool_cache_t*)arg;
+
+    pthread_mutex_lock(&neurax_pool.lock);
+    if (cache->prev) {
+        cache->prev->next = cache->next;
+    } else {
+        neurax_pool.caches = cache->next;
+    }
+    if (cache->next) {
+        cache->next->prev = cache->prev;
+    }
+    neurax_pool_drain_locked(cache);
+    pthread_mutex_unlock(&neurax_pool.lock);
+
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+static void neurax_pool_make_key(void) {
+    pthread_key_create(&neurax_pool_key, neurax_pool_cache_destructor);
+}
+
+// Calling thread's cache, created and registered on first use; NULL if it cannot be created
+static neurax_pool_cache_t* neurax_pool_get_cache(bool create) {
+    pthread_once(&neurax_pool_key_once, neurax_pool_make_key);
+
+    neurax_pool_cache_t* cache = (neurax_pool_cache_t*)pthread_getspecific(neurax_pool_key);
+    if (!cache && create) {
+        cache = calloc(1, sizeof(neurax_pool_cache_t));
+        if (!cache) {
+            return NULL;
+        }
+        if (pthread_mutex_init(&cache->lock, NULL) != 0) {
+            free(cache);
+            return NULL;
+        }
+        if (pthread_setspecific(neurax_pool_key, cache) != 0) {
+            pthread_mutex_destroy(&cache->lock);
+            free(cache);
+            return NULL;
+        }
+
+        pthread_mutex_lock(&neurax_pool.lock);
+        cache->next = neurax_pool.caches;
+        if (cache->next) {
+            cache->next->prev = cache;
+        }
+        neurax_pool.caches = cache;
+        pthread_mutex_unlock(&neurax_pool.lock);
+    }
+    return cache;
+}
+
+static inline bool neurax_pool_active(void) {
+    return __atomic_load_n(&neurax_pool.users, __ATOMIC_ACQUIRE) != 0;
+}
+
+// Buffer of at least `size` bytes from the pool (uninitialized, 64-byte aligned).
+// Returns NULL when the pool is disabled or does not serve that size.
+void* neurax_pool_alloc(size_t size, uint32_t* pool_class) {
+    uint32_t index;
+    size_t class_size;
+
+    *pool_class = 0;
+    if (!neurax_pool_active() || !neurax_pool_class(size, &index, &class_size)) {
+        return NULL;
+    }
+
+    void* ptr = NULL;
+    neurax_pool_cache_t* cache = class_size <= NEURAX_POOL_CACHE_MAX_SIZE ? neurax_pool_get_cache(false) : NULL;
+    if (cache) {
+        pthread_mutex_lock(&cache->lock);
+        if (cache->count[index] > 0) {
+            ptr = cache->slots[index][--cache->count[index]];
+        }
+        pthread_mutex_unlock(&cache->lock);
+    }
+    if (!ptr) {
+        pthread_mutex_lock(&neurax_pool.lock);
+        ptr = neurax_pool.free_lists[index];
+        if (ptr) {
+            neurax_pool.free_lists[index] = *(void**)ptr;
+        }
+        pthread_mutex_unlock(&neurax_pool.lock);
+    }
+
+    if (ptr) {
+        NX_POOL_ADD(hits, 1);
+        NX_POOL_SUB(bytes_retained, class_size);
+    } else {
+        if (neurax_alloc_aligned(class_size, NEURAX_TENSOR_ALIGNMENT, &ptr) != NEURAX_SUCCESS) {
+            return NULL;
+        }
+        NX_POOL_ADD(misses, 1);
+    }
+
+    NX_POOL_ADD(bytes_in_use, class_size);
+    *pool_class = index + 1;
+    return ptr;
+}
+
+// Give a pooled buffer back: to the thread cache when there is room, else to the shared lists
+void neurax_pool_release(void* ptr, uint32_t pool_class) {
+    if (!ptr || pool_class == 0) {
+        return;
+    }
+
+    uint32_t index = pool_class - 1;
+    size_t class_size = neurax_pool_class_size(index);
+    NX_POOL_SUB(bytes_in_use, class_size);
+
+    if (!neurax_pool_active()) {
+        neurax_free_aligned(ptr);
+        return;
+    }
+
+    if (class_size <= NEURAX_POOL_CACHE_MAX_SIZE &&
+        NX_POOL_LOAD(bytes_retained) + class_size <= NX_POOL_LOAD(limit)) {
+        neurax_pool_cache_t* cache = neurax_pool_get_cache(true);
+        bool cached = false;
+        if (cache) {
+            pthread_mutex_lock(&cache->lock);
+            if (cache->count[index] < NEURAX_POOL_CACHE_DEPTH) {
+                cache->slots[index][cache->count[index]++] = ptr;
+                NX_POOL_ADD(bytes_retained, class_size);
+                cached = true;
+            }
+            pthread_mutex_unlock(&cache->lock);
+        }
+        if (cached) {
+            return;
+        }
+    }
+
+    neurax_pool_push(ptr, index);
+}
+
+// Free idle shared buffers until at most `max_retained` bytes remain. Caller holds the lock.
+static void neurax_pool_trim_locked(size_t max_retained) {
+    for (int32_t i = NEURAX_POOL_CLASSES - 1; i >= 0 && NX_POOL_LOAD(bytes_retained) > max_retained; i--) {
+        while (neurax_pool.free_lists[i] && NX_POOL_LOAD(bytes_retained) > max_retained) {
+            void* ptr = neurax_pool.free_lists[i];
+            neurax_pool.free_lists[i] = *(void**)ptr;
+            NX_POOL_SUB(bytes_retained, neurax_pool_class_size((uint32_t)i));
+            neurax_free_aligned(ptr);
+        }
+    }
+}
+
+// Enable the pool for a device; the largest limit requested wins
+void neurax_pool_attach(const neurax_config_t* config) {
+    pthread_mutex_lock(&neurax_pool.lock);
+    size_t limit = config->tensor_pool_limit ? config->tensor_pool_limit : NEURAX_POOL_DEFAULT_LIMIT;
+    if (limit > NX_POOL_LOAD(limit)) {
+        __atomic_store_n(&neurax_pool.limit, limit, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&neurax_pool.users, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&neurax_pool.lock);
+}
+
+// Drop a device's use of the pool; the last one releases the idle buffers of every thread
+void neurax_pool_detach(void) {
+    pthread_mutex_lock(&neurax_pool.lock);
+    if (__atomic_sub_fetch(&neurax_pool.users, 1, __ATOMIC_RELEASE) == 0) {
+        neurax_pool_drain_all_locked();
+        neurax_pool_trim_locked(0);
+        __atomic_store_n(&neurax_pool.limit, 0, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&neurax_pool.lock);
+}
+
+// Public API
+
+neurax_error_t neurax_tensor_pool_trim(size_t max_retained) {
+    pthread_mutex_lock(&neurax_pool.lock);
+    neurax_pool_drain_all_locked();
+    neurax_pool_trim_locked(max_retained);
+    pthread_mutex_unlock(&neurax_pool.lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_pool_get_stats(neurax_tensor_pool_stats_t* stats) {
+    if (!stats) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->enabled = neurax_pool_active();
+    stats->hits = NX_POOL_LOAD(hits);
+    stats->misses = NX_POOL_LOAD(misses);
+    stats->bytes_retained = NX_POOL_LOAD(bytes_retained);
+    stats->bytes_in_use = NX_POOL_LOAD(bytes_in_use);
+    stats->bytes_limit = NX_POOL_LOAD(limit);
+
+    uint64_t requests = stats->hits + stats->misses;
+    stats->hit_rate = requests ? (float)stats->hits / (float)requests : 0.0f;
+
+    return NEURAX_SUCCESS;
+}
@@ -0,0 +1,552 @@
+/*
+ * NEURAX Quantization and Calibration
+ * Post-training calibration of activation ranges and INT8 weight quantization
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+// Histogram resolution and quantized bin count used for KL calibration
+#define NEURAX_CALIB_HIST_BINS 2048
+#define NEURAX_CALIB_QUANT_BINS 128
+#define NEURAX_CALIB_BLOCK 1024
+#define NEURAX_CALIB_DEFAULT_PERCENTILE 99.99f
+
+// Streaming statistics for one tracked tensor
+typedef struct {
+    float min_value;
+    float max_value;
+    float hist_range;           // Histogram covers |x| in [0, hist_range)
+    uint64_t hist[NEURAX_CALIB_HIST_BINS];
+    uint64_t count;
+} neurax_calib_stats_t;
+
+struct neurax_calibrator {
+    neurax_calib_method_t method;
+    float percentile;
+    uint32_t num_tensors;
+    neurax_calib_stats_t* stats;
+};
+
+neurax_error_t neurax_calibrator_create(uint32_t num_tensors,
+                                       neurax_calib_method_t method,
+                                       neurax_calibrator_t** calibrator) {
+    if (!calibrator || num_tensors == 0 || method > NEURAX_CALIB_KL_DIVERGENCE) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_calibrator_t* cal = calloc(1, sizeof(neurax_calibrator_t));
+    if (!cal) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    cal->stats = calloc(num_tensors, sizeof(neurax_calib_stats_t));
+    if (!cal->stats) {
+        free(cal);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    for (uint32_t i = 0; i < num_tensors; i++) {
+        cal->stats[i].min_value = FLT_MAX;
+        cal->stats[i].max_value = -FLT_MAX;
+    }
+
+    cal->method = method;
+    cal->percentile = NEURAX_CALIB_DEFAULT_PERCENTILE;
+    cal->num_tensors = num_tensors;
+
+    *calibrator = cal;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_calibrator_destroy(neurax_calibrator_t* calibrator) {
+    if (!calibrator) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    free(calibrator->stats);
+    free(calibrator);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_calibrator_set_percentile(neurax_calibrator_t* calibrator, float percentile) {
+    if (!calibrator || !(percentile > 0.0f && percentile <= 100.0f)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    calibrator->percentile = percentile;
+    return NEURAX_SUCCESS;
+}
+
+// Double the histogram range, merging bin pairs (exact, no resampling error)
+static void neurax_calib_grow_range(neurax_calib_stats_t* stats) {
+    for (uint32_t i = 0; i < NEURAX_CALIB_HIST_BINS / 2; i++) {
+        stats->hist[i] = stats->hist[2 * i] + stats->hist[2 * i + 1];
+    }
+    memset(&stats->hist[NEURAX_CALIB_HIST_BINS / 2], 0,
+           sizeof(uint64_t) * (NEURAX_CALIB_HIST_BINS / 2));
+    stats->hist_range *= 2.0f;
+}
+
+neurax_error_t neurax_calibrator_observe(neurax_calibrator_t* calibrator,
+                                        uint32_t tensor_index,
+                                        const neurax_tensor_t* tensor) {
+    if (!calibrator || tensor_index >= calibrator->num_tensors) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_validate_tensor(tensor);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(tensor);
+    if (error != NEURAX_SUCCESS) return error;
+
+    neurax_calib_stats_t* stats = &calibrator->stats[tensor_index];
+    size_t total_elements = neurax_tensor_total_elements(tensor);
+    size_t element_size = neurax_get_element_size(tensor->data_type);
+    const uint8_t* data = (const uint8_t*)tensor->data;
+    float block[NEURAX_CALIB_BLOCK];
+
+    // Pass 1: range of this batch
+    float batch_min = FLT_MAX;
+    float batch_max = -FLT_MAX;
+    for (size_t start = 0; start < total_elements; start += NEURAX_CALIB_BLOCK) {
+        size_t count = total_elements - start;
+        if (count > NEURAX_CALIB_BLOCK) count = NEURAX_CALIB_BLOCK;
+
+        neurax_convert_data_type(data + start * element_size, tensor->data_type,
+                                 block, NEURAX_DATA_FLOAT32, count);
+        for (size_t i = 0; i < count; i++) {
+            batch_min = block[i] < batch_min ? block[i] : batch_min;
+            batch_max = block[i] > batch_max ? block[i] : batch_max;
+        }
+    }
+
+    if (batch_min < stats->min_value) stats->min_value = batch_min;
+    if (batch_max > stats->max_value) stats->max_value = batch_max;
+
+    // Size the histogram on first use, then grow it to cover new extremes
+    float batch_abs_max = fmaxf(fabsf(batch_min), fabsf(batch_max));
+    if (stats->hist_range == 0.0f) {
+        stats->hist_range = batch_abs_max > 0.0f ? batch_abs_max * 1.0001f : 1.0f;
+    }
+    while (batch_abs_max >= stats->hist_range) {
+        neurax_calib_grow_range(stats);
+    }
+
+    if (calibrator->method == NEURAX_CALIB_MINMAX) {
+        stats->count += total_elements;
+        return NEURAX_SUCCESS;
+    }
+
+    // Pass 2: histogram of absolute values
+    const float bins_per_unit = NEURAX_CALIB_HIST_BINS / stats->hist_range;
+    for (size_t start = 0; start < total_elements; start += NEURAX_CALIB_BLOCK) {
+        size_t count = total_elements - start;
+        if (count > NEURAX_CALIB_BLOCK) count = NEURAX_CALIB_BLOCK;
+
+        neurax_convert_data_type(data + start * element_size, tensor->data_type,
+                                 block, NEURAX_DATA_FLOAT32, count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t bin = (uint32_t)(fabsf(block[i]) * bins_per_unit);
+            if (bin >= NEURAX_CALIB_HIST_BINS) bin = NEURAX_CALIB_HIST_BINS - 1;
+            stats->hist[bin]++;
+        }
+    }
+
+    stats->count += total_elements;
+    return NEURAX_SUCCESS;
+}
+
+// Smallest |x| threshold covering the requested percentile of samples
+static float neurax_calib_percentile_threshold(const neurax_calib_stats_t* stats, float percentile) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < NEURAX_CALIB_HIST_BINS; i++) {
+        total += stats->hist[i];
+    }
+
+    const double target = (double)total * percentile / 100.0;
+    const float bin_width = stats->hist_range / NEURAX_CALIB_HIST_BINS;
+    uint64_t cumulative = 0;
+    for (uint32_t i = 0; i < NEURAX_CALIB_HIST_BINS; i++) {
+        cumulative += stats->hist[i];
+        if ((double)cumulative >= target) {
+            return (i + 1) * bin_width;
+        }
+    }
+    return stats->hist_range;
+}
+
+// Threshold minimizing KL(P || Q) between the clipped reference distribution P
+// and its NEURAX_CALIB_QUANT_BINS-level quantization Q
+static float neurax_calib_kl_threshold(const neurax_calib_stats_t* stats) {
+    const float bin_width = stats->hist_range / NEURAX_CALIB_HIST_BINS;
+    double reference[NEURAX_CALIB_HIST_BINS];
+    double expanded[NEURAX_CALIB_HIST_BINS];
+    double best_divergence = DBL_MAX;
+    uint32_t best_bins = NEURAX_CALIB_HIST_BINS;
+
+    uint64_t outliers = 0;
+    for (uint32_t i = NEURAX_CALIB_QUANT_BINS; i < NEURAX_CALIB_HIST_BINS; i++) {
+        outliers += stats->hist[i];
+    }
+
+    for (uint32_t num_bins = NEURAX_CALIB_QUANT_BINS; num_bins <= NEURAX_CALIB_HIST_BINS; num_bins++) {
+        // Reference distribution: first num_bins bins, outliers folded into the last one
+        double reference_total = 0.0;
+        for (uint32_t i = 0; i < num_bins; i++) {
+            reference[i] = (double)stats->hist[i];
+        }
+        reference[num_bins - 1] += (double)outliers;
+        for (uint32_t i = 0; i < num_bins; i++) {
+            reference_total += reference[i];
+        }
+        if (num_bins < NEURAX_CALIB_HIST_BINS) {
+            outliers -= stats->hist[num_bins];
+        }
+        if (reference_total == 0.0) {
+            continue;
+        }
+
+        // Quantize the unclipped bins into NEURAX_CALIB_QUANT_BINS levels and expand back,
+        // spreading each level uniformly over its non-empty source bins
+        double expanded_total = 0.0;
+        const double bins_per_level = (double)num_bins / NEURAX_CALIB_QUANT_BINS;
+        for (uint32_t level = 0; level < NEURAX_CALIB_QUANT_BINS; level++) {
+            uint32_t begin = (uint32_t)(level * bins_per_level);
+            uint32_t end = (uint32_t)((level + 1) * bins_per_level);
+            if (level == NEURAX_CALIB_QUANT_BINS - 1 || end > num_bins) {
+                end = num_bins;
+            }
+
+            double level_sum = 0.0;
+            uint32_t nonzero = 0;
+            for (uint32_t i = begin; i < end; i++) {
+                level_sum += (double)stats->hist[i];
+                nonzero += stats->hist[i] != 0;
+            }
+
+            for (uint32_t i = begin; i < end; i++) {
+                expanded[i] = (stats->hist[i] != 0 && nonzero > 0) ? level_sum / nonzero : 0.0;
+                expanded_total += expanded[i];
+            }
+        }
+        if (expanded_total == 0.0) {
+            continue;
+        }
+
+        double divergence = 0.0;
+        for (uint32_t i = 0; i < num_bins; i++) {
+            if (reference[i] == 0.0) {
+                continue;
+            }
+            double p = reference[i] / reference_total;
+            double q = expanded[i] / expanded_total;
+            if (q == 0.0) {
+                // Mass the quantized distribution cannot represent
+                q = 1e-12;
+            }
+            divergence += p * log(p / q);
+        }
+
+        if (divergence < best_divergence) {
+            best_divergence = divergence;
+            best_bins = num_bins;
+        }
+    }
+
+    return (best_bins + 0.5f) * bin_width;
+}
+
+neurax_error_t neurax_calibrator_compute(const neurax_calibrator_t* calibrator,
+                                        uint32_t tensor_index,
+                                        neurax_data_type_t quant_type,
+                                        neurax_quant_params_t* params) {
+    if (!calibrator || !params || tensor_index >= calibrator->num_tensors) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (quant_type != NEURAX_DATA_INT8 && quant_type != NEURAX_DATA_UINT8) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    const neurax_calib_stats_t* stats = &calibrator->stats[tensor_index];
+    if (stats->count == 0) {
+        NEURAX_LOG_ERROR("No calibration data observed for tensor %u", tensor_index);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // Observed range always includes zero so it is exactly representable
+    float range_min = fminf(stats->min_value, 0.0f);
+    float range_max = fmaxf(stats->max_value, 0.0f);
+
+    if (calibrator->method != NEURAX_CALIB_MINMAX) {
+        float threshold = (calibrator->method == NEURAX_CALIB_PERCENTILE)
+                        ? neurax_calib_percentile_threshold(stats, calibrator->percentile)
+                        : neurax_calib_kl_threshold(stats);
+        range_min = fmaxf(range_min, -threshold);
+        range_max = fminf(range_max, threshold);
+    }
+
+    memset(params, 0, sizeof(*params));
+
+    if (quant_type == NEURAX_DATA_INT8) {
+        float abs_max = fmaxf(-range_min, range_max);
+        params->scale = abs_max > 0.0f ? abs_max / 127.0f : 1.0f;
+        params->zero_point = 0;
+    } else {
+        float span = range_max - range_min;
+        params->scale = span > 0.0f ? span / 255.0f : 1.0f;
+        int32_t zero_point = (int32_t)roundf(-range_min / params->scale);
+        params->zero_point = zero_point < 0 ? 0 : (zero_point > 255 ? 255 : zero_point);
+    }
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_set_quant_params(neurax_tensor_t* tensor, float scale,
+                                             int32_t zero_point,
+                                             const float* channel_scales,
+                                             uint32_t num_channels) {
+    if (!tensor || !(scale >= 0.0f)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (channel_scales && num_channels != tensor->batch_size) {
+        NEURAX_LOG_ERROR("Per-channel scale count %u does not match %u output channels",
+                        num_channels, tensor->batch_size);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    float* scales_copy = NULL;
+    if (channel_scales) {
+        scales_copy = malloc(sizeof(float) * num_channels);
+        if (!scales_copy) {
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        memcpy(scales_copy, channel_scales, sizeof(float) * num_channels);
+    }
+
+    free(tensor->quant.channel_scales);
+    tensor->quant.scale = scale;
+    tensor->quant.zero_point = zero_point;
+    tensor->quant.channel_scales = scales_copy;
+    tensor->quant.num_channels = scales_copy ? num_channels : 0;
+
+    return NEURAX_SUCCESS;
+}
+
+// Quantize count floats: q = saturate(round(x / scale) + zero_point)
+static void neurax_quantize_block(const float* src, neurax_data_type_t dst_type, void* dst,
+                                  size_t count, float inv_scale, int32_t zero_point) {
+    const float q_min = dst_type == NEURAX_DATA_INT8 ? -128.0f : 0.0f;
+    const float q_max = dst_type == NEURAX_DATA_INT8 ? 127.0f : 255.0f;
+
+    if (dst_type == NEURAX_DATA_INT8) {
+        int8_t* d = (int8_t*)dst;
+        for (size_t i = 0; i < count; i++) {
+            float v = neurax_quantize_value(src[i], inv_scale, zero_point);
+            v = v > q_min ? v : q_min;
+            v = v < q_max ? v : q_max;
+            d[i] = (int8_t)(int32_t)v;
+        }
+    } else {
+        uint8_t* d = (uint8_t*)dst;
+        for (size_t i = 0; i < count; i++) {
+            float v = neurax_quantize_value(src[i], inv_scale, zero_point);
+            v = v > q_min ? v : q_min;
+            v = v < q_max ? v : q_max;
+            d[i] = (uint8_t)(int32_t)v;
+        }
+    }
+}
+
+// Quantize a contiguous range of a tensor, converting the source to fp32 in blocks
+static void neurax_quantize_range(const neurax_tensor_t* input, size_t first, size_t count,
+                                  neurax_tensor_t* output, float scale, int32_t zero_point) {
+    size_t in_element_size = neurax_get_element_size(input->data_type);
+    const uint8_t* src = (const uint8_t*)input->data + first * in_element_size;
+    uint8_t* dst = (uint8_t*)output->data + first;
+    float inv_scale = 1.0f / scale;
+    float block[NEURAX_CALIB_BLOCK];
+
+    for (size_t start = 0; start < count; start += NEURAX_CALIB_BLOCK) {
+        size_t n = count - start;
+        if (n > NEURAX_CALIB_BLOCK) n = NEURAX_CALIB_BLOCK;
+
+        if (input->data_type == NEURAX_DATA_FLOAT32) {
+            neurax_quantize_block((const float*)src + start, output->data_type, dst + start,
+                                  n, inv_scale, zero_point);
+        } else {
+            neurax_convert_data_type(src + start * in_element_size, input->data_type,
+                                     block, NEURAX_DATA_FLOAT32, n);
+            neurax_quantize_block(block, output->data_type, dst + start, n, inv_scale, zero_point);
+        }
+    }
+}
+
+neurax_error_t neurax_quantize_weights(const neurax_tensor_t* weights, bool per_channel,
+                                      neurax_tensor_t** quantized) {
+    if (!quantized) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_validate_tensor(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(weights);
+    if (error != NEURAX_SUCCESS) return error;
+
+    uint32_t out_channels = weights->batch_size;
+    size_t channel_elements = neurax_tensor_total_elements(weights) / out_channels;
+    size_t element_size = neurax_get_element_size(weights->data_type);
+
+    float* scales = malloc(sizeof(float) * out_channels);
+    if (!scales) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    // Symmetric range per output channel
+    float tensor_abs_max = 0.0f;
+    float block[NEURAX_CALIB_BLOCK];
+    for (uint32_t oc = 0; oc < out_channels; oc++) {
+        const uint8_t* src = (const uint8_t*)weights->data + oc * channel_elements * element_size;
+        float abs_max = 0.0f;
+
+        for (size_t start = 0; start < channel_elements; start += NEURAX_CALIB_BLOCK) {
+            size_t n = channel_elements - start;
+            if (n > NEURAX_CALIB_BLOCK) n = NEURAX_CALIB_BLOCK;
+
+            neurax_convert_data_type(src + start * element_size, weights->data_type,
+                                     block, NEURAX_DATA_FLOAT32, n);
+            for (size_t i = 0; i < n; i++) {
+                float v = fabsf(block[i]);
+                abs_max = v > abs_max ? v : abs_max;
+            }
+        }
+
+        scales[oc] = abs_max > 0.0f ? abs_max / 127.0f : 1.0f;
+        tensor_abs_max = abs_max > tensor_abs_max ? abs_max : tensor_abs_max;
+    }
+
+    float tensor_scale = tensor_abs_max > 0.0f ? tensor_abs_max / 127.0f : 1.0f;
+
+    neurax_tensor_t* q = NULL;
+    error = neurax_tensor_create_weights(weights->width, weights->height, weights->channels,
+                                         weights->batch_size, NEURAX_DATA_INT8,
+                                         NEURAX_LAYOUT_NHWC, &q);
+    if (error != NEURAX_SUCCESS) {
+        free(scales);
+        return error;
+    }
+
+    for (uint32_t oc = 0; oc < out_channels; oc++) {
+        neurax_quantize_range(weights, oc * channel_elements, channel_elements, q,
+                              per_channel ? scales[oc] : tensor_scale, 0);
+    }
+
+    error = neurax_tensor_set_quant_params(q, tensor_scale, 0,
+                                           per_channel ? scales : NULL, out_channels);
+    free(scales);
+    if (error != NEURAX_SUCCESS) {
+        neurax_tensor_destroy(q);
+        return error;
+    }
+
+    *quantized = q;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_quantize_tensor(const neurax_tensor_t* input,
+                                     const neurax_quant_params_t* params,
+                                     neurax_tensor_t* output) {
+    if (!params || !(params->scale > 0.0f)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (output->data_type != NEURAX_DATA_INT8 && output->data_type != NEURAX_DATA_UINT8) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (neurax_tensor_total_elements(input) != neurax_tensor_total_elements(output)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (params->channel_scales && params->num_channels != input->batch_size) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (params->channel_scales) {
+        size_t channel_elements = neurax_tensor_total_elements(input) / input->batch_size;
+        for (uint32_t oc = 0; oc < input->batch_size; oc++) {
+            neurax_quantize_range(input, oc * channel_elements, channel_elements, output,
+                                  params->channel_scales[oc], params->zero_point);
+        }
+    } else {
+        neurax_quantize_range(input, 0, neurax_tensor_total_elements(input), output,
+                              params->scale, params->zero_point);
+    }
+
+    return neurax_tensor_set_quant_params(output, params->scale, params->zero_point,
+                                          params->channel_scales, params->num_channels);
+}
+
+neurax_error_t neurax_dequantize_tensor(const neurax_tensor_t* input, neurax_tensor_t* output) {
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_contiguous(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (!(input->quant.scale > 0.0f) ||
+        neurax_tensor_total_elements(input) != neurax_tensor_total_elements(output)) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    // real = scale * (q - zero_point) is a plain scaled conversion
+    size_t total_elements = neurax_tensor_total_elements(input);
+    if (!input->quant.channel_scales) {
+        float scale = input->quant.scale;
+        return neurax_convert_data_type_scaled(input->data, input->data_type,
+                                               output->data, output->data_type, total_elements,
+                                               scale, -scale * input->quant.zero_point);
+    }
+
+    size_t channel_elements = total_elements / input->batch_size;
+    size_t in_element_size = neurax_get_element_size(input->data_type);
+    size_t out_element_size = neurax_get_element_size(output->data_type);
+    for (uint32_t oc = 0; oc < input->batch_size; oc++) {
+        float scale = input->quant.channel_scales[oc];
+        error = neurax_convert_data_type_scaled(
+            (const uint8_t*)input->data + oc * channel_elements * in_element_size, input->data_type,
+            (uint8_t*)output->data + oc * channel_elements * out_element_size, output->data_type,
+            channel_elements, scale, -scale * input->quant.zero_point);
+        if (error != NEURAX_SUCCESS) return error;
+    }
+
+    return NEURAX_SUCCESS;
+}
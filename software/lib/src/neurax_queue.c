@@ -0,0 +1,400 @@
+/*
+ * NEURAX Submission Queue
+ * Asynchronous layer execution on a per-device worker thread, with fences
+ * and completion callbacks
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct neurax_fence {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool signaled;
+    neurax_error_t result;
+    uint32_t refs;              // Caller's handle plus the queued job
+    pthread_t worker;           // Queue thread that signals the fence
+};
+
+typedef enum {
+    NEURAX_JOB_CONV2D,
+    NEURAX_JOB_POOLING,
+    NEURAX_JOB_ACTIVATION
+} neurax_job_type_t;
+
+// Queued operation: tensors are borrowed, configurations copied at submission
+typedef struct neurax_job {
+    neurax_job_type_t type;
+    const neurax_tensor_t* input;
+    const neurax_tensor_t* weights;
+    const neurax_tensor_t* bias;
+    neurax_tensor_t* output;
+    union {
+        neurax_conv_config_t conv;
+        neurax_pool_config_t pool;
+        neurax_activation_t activation;
+    } params;
+    neurax_completion_fn callback;
+    void* user_data;
+    neurax_fence_t* fence;
+    struct neurax_job* next;
+} neurax_job_t;
+
+struct neurax_queue {
+    neurax_device_t* device;
+    neurax_job_t* head;         // Next job to run
+    neurax_job_t* tail;
+    uint32_t pending;           // Jobs queued or running
+    bool started;               // Worker thread exists
+    bool stopping;              // Worker exits once the queue is empty
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t work;        // Signalled when a job is queued or on shutdown
+    pthread_cond_t idle;        // Signalled when pending drops to zero
+};
+
+static void neurax_fence_release(neurax_fence_t* fence) {
+    pthread_mutex_lock(&fence->lock);
+    bool last = --fence->refs == 0;
+    pthread_mutex_unlock(&fence->lock);
+
+    if (last) {
+        pthread_cond_destroy(&fence->cond);
+        pthread_mutex_destroy(&fence->lock);
+        free(fence);
+    }
+}
+
+static neurax_error_t neurax_job_run(neurax_device_t* device, const neurax_job_t* job) {
+    switch (job->type) {
+        case NEURAX_JOB_CONV2D:
+            return neurax_conv2d(device, job->input, job->weights, job->bias,
+                                 &job->params.conv, job->output);
+        case NEURAX_JOB_POOLING:
+            return neurax_pooling(device, job->input, &job->params.pool, job->output);
+        case NEURAX_JOB_ACTIVATION:
+            return neurax_activation(device, job->input, job->params.activation, job->output);
+        default:
+            return NEURAX_ERROR_INVALID_PARAM;
+    }
+}
+
+// Run jobs in submission order; the callback runs before the fence is signalled
+static void* neurax_queue_worker(void* arg) {
+    neurax_queue_t* queue = (neurax_queue_t*)arg;
+
+    pthread_mutex_lock(&queue->lock);
+    for (;;) {
+        while (!queue->head && !queue->stopping) {
+            pthread_cond_wait(&queue->work, &queue->lock);
+        }
+        if (!queue->head) {
+            break;
+        }
+
+        neurax_job_t* job = queue->head;
+        queue->head = job->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+        pthread_mutex_unlock(&queue->lock);
+
+        neurax_error_t result = neurax_job_run(queue->device, job);
+        if (job->callback) {
+            job->callback(result, job->user_data);
+        }
+        if (job->fence) {
+            pthread_mutex_lock(&job->fence->lock);
+            job->fence->result = result;
+            job->fence->signaled = true;
+            pthread_cond_broadcast(&job->fence->cond);
+            pthread_mutex_unlock(&job->fence->lock);
+            neurax_fence_release(job->fence);
+        }
+        free(job);
+
+        pthread_mutex_lock(&queue->lock);
+        if (--queue->pending == 0) {
+            pthread_cond_broadcast(&queue->idle);
+        }
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return NULL;
+}
+
+neurax_queue_t* neurax_queue_create(neurax_device_t* device) {
+    neurax_queue_t* queue = calloc(1, sizeof(neurax_queue_t));
+    if (!queue) {
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&queue->lock, NULL) != 0) {
+        free(queue);
+        return NULL;
+    }
+    if (pthread_cond_init(&queue->work, NULL) != 0) {
+        pthread_mutex_destroy(&queue->lock);
+        free(queue);
+        return NULL;
+    }
+    if (pthread_cond_init(&queue->idle, NULL) != 0) {
+        pthread_cond_destroy(&queue->work);
+        pthread_mutex_destroy(&queue->lock);
+        free(queue);
+        return NULL;
+    }
+
+    queue->device = device;
+    return queue;
+}
+
+// Finish the queued work, then stop the worker
+void neurax_queue_destroy(neurax_queue_t* queue) {
+    if (!queue) {
+        return;
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    queue->stopping = true;
+    pthread_cond_signal(&queue->work);
+    pthread_mutex_unlock(&queue->lock);
+
+    if (queue->started) {
+        pthread_join(queue->thread, NULL);
+    }
+
+    pthread_cond_destroy(&queue->idle);
+    pthread_cond_destroy(&queue->work);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+// True on the queue's worker thread, i.e. inside a completion callback
+bool neurax_queue_on_worker(neurax_queue_t* queue) {
+    pthread_mutex_lock(&queue->lock);
+    bool on_worker = queue->started && pthread_equal(queue->thread, pthread_self());
+    pthread_mutex_unlock(&queue->lock);
+    return on_worker;
+}
+
+// Queue a job, starting the worker on first use, and hand out its fence
+static neurax_error_t neurax_queue_submit(neurax_device_t* device, neurax_job_t* job,
+                                          neurax_fence_t** fence) {
+    neurax_queue_t* queue = device->queue;
+
+    if (fence) {
+        neurax_fence_t* f = calloc(1, sizeof(neurax_fence_t));
+        if (!f) {
+            free(job);
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        if (pthread_mutex_init(&f->lock, NULL) != 0) {
+            free(f);
+            free(job);
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        if (pthread_cond_init(&f->cond, NULL) != 0) {
+            pthread_mutex_destroy(&f->lock);
+            free(f);
+            free(job);
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        f->refs = 2;
+        job->fence = f;
+    }
+
+    // The worker may free the job as soon as the lock is dropped
+    neurax_fence_t* job_fence = job->fence;
+
+    pthread_mutex_lock(&queue->lock);
+    if (!queue->started) {
+        if (pthread_create(&queue->thread, NULL, neurax_queue_worker, queue) != 0) {
+            pthread_mutex_unlock(&queue->lock);
+            NEURAX_LOG_ERROR("Failed to start the submission queue worker");
+            if (job->fence) {
+                job->fence->refs = 1;
+                neurax_fence_release(job->fence);
+            }
+            free(job);
+            return NEURAX_ERROR_MEMORY_ALLOCATION;
+        }
+        queue->started = true;
+    }
+    if (job_fence) {
+        job_fence->worker = queue->thread;
+    }
+
+    if (queue->tail) {
+        queue->tail->next = job;
+    } else {
+        queue->head = job;
+    }
+    queue->tail = job;
+    queue->pending++;
+    pthread_cond_signal(&queue->work);
+    pthread_mutex_unlock(&queue->lock);
+
+    if (fence) {
+        *fence = job_fence;
+    }
+    return NEURAX_SUCCESS;
+}
+
+static neurax_job_t* neurax_job_alloc(neurax_job_type_t type, neurax_completion_fn callback,
+                                      void* user_data) {
+    neurax_job_t* job = calloc(1, sizeof(neurax_job_t));
+    if (job) {
+        job->type = type;
+        job->callback = callback;
+        job->user_data = user_data;
+    }
+    return job;
+}
+
+// Public API
+
+neurax_error_t neurax_conv2d_async(neurax_device_t* device,
+                                  const neurax_tensor_t* input,
+                                  const neurax_tensor_t* weights,
+                                  const neurax_tensor_t* bias,
+                                  const neurax_conv_config_t* config,
+                                  neurax_tensor_t* output,
+                                  neurax_completion_fn callback,
+                                  void* user_data,
+                                  neurax_fence_t** fence) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!input || !weights || !config || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_job_t* job = neurax_job_alloc(NEURAX_JOB_CONV2D, callback, user_data);
+    if (!job) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    job->input = input;
+    job->weights = weights;
+    job->bias = bias;
+    job->output = output;
+    job->params.conv = *config;
+
+    return neurax_queue_submit(device, job, fence);
+}
+
+neurax_error_t neurax_pooling_async(neurax_device_t* device,
+                                   const neurax_tensor_t* input,
+                                   const neurax_pool_config_t* config,
+                                   neurax_tensor_t* output,
+                                   neurax_completion_fn callback,
+                                   void* user_data,
+                                   neurax_fence_t** fence) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!input || !config || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_job_t* job = neurax_job_alloc(NEURAX_JOB_POOLING, callback, user_data);
+    if (!job) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    job->input = input;
+    job->output = output;
+    job->params.pool = *config;
+
+    return neurax_queue_submit(device, job, fence);
+}
+
+neurax_error_t neurax_activation_async(neurax_device_t* device,
+                                      const neurax_tensor_t* input,
+                                      neurax_activation_t activation,
+                                      neurax_tensor_t* output,
+                                      neurax_completion_fn callback,
+                                      void* user_data,
+                                      neurax_fence_t** fence) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!input || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_job_t* job = neurax_job_alloc(NEURAX_JOB_ACTIVATION, callback, user_data);
+    if (!job) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    job->input = input;
+    job->output = output;
+    job->params.activation = activation;
+
+    return neurax_queue_submit(device, job, fence);
+}
+
+neurax_error_t neurax_fence_wait(neurax_fence_t* fence) {
+    if (!fence) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&fence->lock);
+    if (!fence->signaled && pthread_equal(fence->worker, pthread_self())) {
+        // A callback waiting on its own queue would wait for itself
+        pthread_mutex_unlock(&fence->lock);
+        NEURAX_LOG_ERROR("Cannot wait for an operation queued on the calling callback's device");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    while (!fence->signaled) {
+        pthread_cond_wait(&fence->cond, &fence->lock);
+    }
+    neurax_error_t result = fence->result;
+    pthread_mutex_unlock(&fence->lock);
+
+    return result;
+}
+
+neurax_error_t neurax_fence_poll(neurax_fence_t* fence, bool* signaled) {
+    if (!fence || !signaled) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&fence->lock);
+    *signaled = fence->signaled;
+    pthread_mutex_unlock(&fence->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_fence_destroy(neurax_fence_t* fence) {
+    if (!fence) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_fence_release(fence);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_finish(neurax_device_t* device) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_queue_t* queue = device->queue;
+    if (neurax_queue_on_worker(queue)) {
+        NEURAX_LOG_ERROR("neurax_finish called from a completion callback of the same device");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->pending > 0) {
+        pthread_cond_wait(&queue->idle, &queue->lock);
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return NEURAX_SUCCESS;
+}
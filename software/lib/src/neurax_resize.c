@@ -0,0 +1,558 @@
+/*
+ * NEURAX Resize Implementation
+ * Nearest and separable bilinear resampling with precomputed coefficient tables
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Fixed-point precision of uint8 bilinear weights
+#define NEURAX_RESIZE_FRAC_BITS 11
+#define NEURAX_RESIZE_ONE (1 << NEURAX_RESIZE_FRAC_BITS)
+
+// Output elements per thread before the resize is split across threads
+#define NEURAX_RESIZE_PARALLEL_MIN (64 * 1024)
+
+// Source index and weight for one output row or column
+typedef struct {
+    uint32_t* i0;                   // First source index (nearest: the only one)
+    uint32_t* i1;                   // Second source index
+    float* f;                       // Weight of i1
+    int32_t* w;                     // Weight of i1 in NEURAX_RESIZE_FRAC_BITS fixed point
+} neurax_resize_axis_t;
+
+// Shared state for resize worker threads
+typedef struct {
+    neurax_device_t* device;        // Scratch memory source
+    const neurax_tensor_t* input;
+    neurax_tensor_t* output;
+    neurax_resize_axis_t x;
+    neurax_resize_axis_t y;
+    bool up2_x;                     // Output width is exactly twice the input width
+    neurax_error_t error;           // Set by workers that couldn't allocate scratch (atomic)
+} neurax_resize_job_t;
+
+// Record a worker failure; workers of one call may fail concurrently
+static void neurax_resize_fail(neurax_resize_job_t* job, neurax_error_t error) {
+    __atomic_store_n(&job->error, error, __ATOMIC_RELAXED);
+}
+
+// Half-pixel centers: output pixel d samples source position (d + 0.5) * in / out - 0.5
+static void neurax_resize_fill_axis(neurax_resize_axis_t* axis, uint32_t in_size,
+                                    uint32_t out_size, neurax_resize_mode_t mode) {
+    double scale = (double)in_size / out_size;
+
+    for (uint32_t d = 0; d < out_size; d++) {
+        if (mode == NEURAX_RESIZE_NEAREST) {
+            uint32_t s = (uint32_t)floor((d + 0.5) * scale);
+            axis->i0[d] = s < in_size ? s : in_size - 1;
+            continue;
+        }
+
+        double s = (d + 0.5) * scale - 0.5;
+        if (s < 0.0) {
+            s = 0.0;
+        }
+
+        uint32_t i0 = (uint32_t)s;
+        float f = (float)(s - i0);
+        if (i0 >= in_size - 1) {
+            i0 = in_size - 1;
+            f = 0.0f;
+        }
+
+        axis->i0[d] = i0;
+        axis->i1[d] = i0 + 1 < in_size ? i0 + 1 : i0;
+        axis->f[d] = f;
+        axis->w[d] = (int32_t)lrintf(f * NEURAX_RESIZE_ONE);
+    }
+}
+
+static neurax_error_t neurax_resize_alloc_axis(neurax_device_t* device, neurax_resize_axis_t* axis,
+                                               uint32_t size) {
+    axis->i0 = neurax_scratch_alloc(device, sizeof(uint32_t) * size);
+    axis->i1 = neurax_scratch_alloc(device, sizeof(uint32_t) * size);
+    axis->f = neurax_scratch_alloc(device, sizeof(float) * size);
+    axis->w = neurax_scratch_alloc(device, sizeof(int32_t) * size);
+
+    if (!axis->i0 || !axis->i1 || !axis->f || !axis->w) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    return NEURAX_SUCCESS;
+}
+
+static void neurax_resize_free_axis(neurax_device_t* device, neurax_resize_axis_t* axis) {
+    neurax_scratch_free(device, axis->i0);
+    neurax_scratch_free(device, axis->i1);
+    neurax_scratch_free(device, axis->f);
+    neurax_scratch_free(device, axis->w);
+}
+
+// Byte offset of pixel (n, y, 0)
+static inline size_t neurax_resize_row_offset(const neurax_tensor_t* tensor, uint32_t n, uint32_t y) {
+    return neurax_tensor_byte_offset(tensor, n, y, 0, 0);
+}
+
+// Byte distance between horizontally adjacent pixels
+static inline size_t neurax_resize_x_stride(const neurax_tensor_t* tensor) {
+    size_t strides[4];
+    neurax_tensor_get_strides(tensor, strides);
+    return strides[NEURAX_DIM_WIDTH];
+}
+
+// A row's pixels and channels are adjacent, so it can be converted in one call
+static inline bool neurax_resize_row_packed(const neurax_tensor_t* tensor) {
+    return neurax_tensor_channels_packed(tensor) &&
+           (tensor->width == 1 || neurax_resize_x_stride(tensor) ==
+            tensor->channels * neurax_get_element_size(tensor->data_type));
+}
+
+// Widen one tensor row to packed fp32 [width][channels]
+static void neurax_resize_load_row(const neurax_tensor_t* tensor, uint32_t n, uint32_t y, float* dst) {
+    size_t offset = neurax_resize_row_offset(tensor, n, y);
+
+    if (neurax_resize_row_packed(tensor)) {
+        neurax_convert_data_type((const uint8_t*)tensor->data + offset, tensor->data_type,
+                                 dst, NEURAX_DATA_FLOAT32, (size_t)tensor->width * tensor->channels);
+        return;
+    }
+
+    size_t x_stride = neurax_resize_x_stride(tensor);
+    for (uint32_t x = 0; x < tensor->width; x++) {
+        neurax_load_channels(tensor, offset + x * x_stride, tensor->channels,
+                             dst + (size_t)x * tensor->channels);
+    }
+}
+
+// Narrow one packed fp32 row into the tensor
+static void neurax_resize_store_row(neurax_tensor_t* tensor, uint32_t n, uint32_t y, const float* src) {
+    size_t offset = neurax_resize_row_offset(tensor, n, y);
+
+    if (neurax_resize_row_packed(tensor)) {
+        neurax_convert_data_type(src, NEURAX_DATA_FLOAT32, (uint8_t*)tensor->data + offset,
+                                 tensor->data_type, (size_t)tensor->width * tensor->channels);
+        return;
+    }
+
+    size_t x_stride = neurax_resize_x_stride(tensor);
+    for (uint32_t x = 0; x < tensor->width; x++) {
+        neurax_store_channels(tensor, offset + x * x_stride, tensor->channels,
+                              src + (size_t)x * tensor->channels);
+    }
+}
+
+// Horizontal pass, fp32: table-driven gather and lerp
+static void neurax_resize_hpass_f32(const neurax_resize_job_t* job, const float* in, float* out) {
+    const uint32_t C = job->input->channels;
+
+    if (job->up2_x) {
+        // Exact 2x: fixed 0.25 / 0.75 weights, no table lookups
+        const uint32_t W = job->input->width;
+        for (uint32_t i = 0; i < W; i++) {
+            const float* p = in + (size_t)i * C;
+            const float* prev = in + (size_t)(i > 0 ? i - 1 : 0) * C;
+            const float* next = in + (size_t)(i + 1 < W ? i + 1 : i) * C;
+            float* o0 = out + (size_t)2 * i * C;
+            float* o1 = o0 + C;
+            for (uint32_t c = 0; c < C; c++) {
+                o0[c] = 0.75f * p[c] + 0.25f * prev[c];
+                o1[c] = 0.75f * p[c] + 0.25f * next[c];
+            }
+        }
+        return;
+    }
+
+    for (uint32_t x = 0; x < job->output->width; x++) {
+        const float* p0 = in + (size_t)job->x.i0[x] * C;
+        const float* p1 = in + (size_t)job->x.i1[x] * C;
+        const float f = job->x.f[x];
+        float* o = out + (size_t)x * C;
+        for (uint32_t c = 0; c < C; c++) {
+            o[c] = p0[c] + (p1[c] - p0[c]) * f;
+        }
+    }
+}
+
+// Horizontal pass, uint8: fixed-point weights into int32 rows (channels must be packed)
+static void neurax_resize_hpass_u8(const neurax_resize_job_t* job, const uint8_t* in, int32_t* out) {
+    const uint32_t C = job->input->channels;
+    const size_t stride = neurax_resize_x_stride(job->input);
+
+    if (job->up2_x) {
+        const uint32_t W = job->input->width;
+        for (uint32_t i = 0; i < W; i++) {
+            const uint8_t* p = in + i * stride;
+            const uint8_t* prev = in + (i > 0 ? i - 1 : 0) * stride;
+            const uint8_t* next = in + (i + 1 < W ? i + 1 : i) * stride;
+            int32_t* o0 = out + (size_t)2 * i * C;
+            int32_t* o1 = o0 + C;
+            for (uint32_t c = 0; c < C; c++) {
+                o0[c] = p[c] * (3 * NEURAX_RESIZE_ONE / 4) + prev[c] * (NEURAX_RESIZE_ONE / 4);
+                o1[c] = p[c] * (3 * NEURAX_RESIZE_ONE / 4) + next[c] * (NEURAX_RESIZE_ONE / 4);
+            }
+        }
+        return;
+    }
+
+    for (uint32_t x = 0; x < job->output->width; x++) {
+        const uint8_t* p0 = in + job->x.i0[x] * stride;
+        const uint8_t* p1 = in + job->x.i1[x] * stride;
+        const int32_t w1 = job->x.w[x];
+        const int32_t w0 = NEURAX_RESIZE_ONE - w1;
+        int32_t* o = out + (size_t)x * C;
+        for (uint32_t c = 0; c < C; c++) {
+            o[c] = p0[c] * w0 + p1[c] * w1;
+        }
+    }
+}
+
+// Two-row cache of horizontally resampled source rows, keyed by (n, y)
+typedef struct {
+    void* rows[2];
+    size_t keys[2];
+} neurax_resize_cache_t;
+
+static inline void neurax_resize_cache_swap(neurax_resize_cache_t* cache) {
+    void* row = cache->rows[0];
+    size_t key = cache->keys[0];
+    cache->rows[0] = cache->rows[1];
+    cache->keys[0] = cache->keys[1];
+    cache->rows[1] = row;
+    cache->keys[1] = key;
+}
+
+// Arrange the cache so slot 0 holds k0 and slot 1 holds k1; returns which slots need filling
+static unsigned neurax_resize_cache_lookup(neurax_resize_cache_t* cache, size_t k0, size_t k1) {
+    unsigned fill = 0;
+
+    if (cache->keys[0] != k0) {
+        if (cache->keys[1] == k0 || cache->keys[0] == k1) {
+            neurax_resize_cache_swap(cache);
+        }
+        if (cache->keys[0] != k0) {
+            cache->keys[0] = k0;
+            fill |= 1;
+        }
+    }
+
+    if (k1 != k0 && cache->keys[1] != k1) {
+        cache->keys[1] = k1;
+        fill |= 2;
+    }
+
+    return fill;
+}
+
+// Separable bilinear, fp32 math for any type pair
+static void neurax_resize_bilinear_f32(void* ctx, size_t begin, size_t end) {
+    neurax_resize_job_t* job = (neurax_resize_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const size_t out_row = (size_t)output->width * output->channels;
+    const size_t in_row = (size_t)input->width * input->channels;
+
+    float* scratch = neurax_scratch_alloc(job->device, sizeof(float) * (2 * out_row + in_row + out_row));
+    if (!scratch) {
+        neurax_resize_fail(job, NEURAX_ERROR_MEMORY_ALLOCATION);
+        return;
+    }
+
+    neurax_resize_cache_t cache = {{scratch, scratch + out_row}, {SIZE_MAX, SIZE_MAX}};
+    float* source = scratch + 2 * out_row;
+    float* result = source + in_row;
+
+    for (size_t r = begin; r < end; r++) {
+        uint32_t n = (uint32_t)(r / output->height);
+        uint32_t y = (uint32_t)(r % output->height);
+        size_t k0 = (size_t)n * input->height + job->y.i0[y];
+        size_t k1 = (size_t)n * input->height + job->y.i1[y];
+
+        unsigned fill = neurax_resize_cache_lookup(&cache, k0, k1);
+        for (unsigned slot = 0; slot < 2; slot++) {
+            if (fill & (1u << slot)) {
+                uint32_t sy = slot == 0 ? job->y.i0[y] : job->y.i1[y];
+                neurax_resize_load_row(input, n, sy, source);
+                neurax_resize_hpass_f32(job, source, (float*)cache.rows[slot]);
+            }
+        }
+
+        const float* h0 = (const float*)cache.rows[0];
+        const float* h1 = k1 != k0 ? (const float*)cache.rows[1] : h0;
+        const float f = job->y.f[y];
+        for (size_t i = 0; i < out_row; i++) {
+            result[i] = h0[i] + (h1[i] - h0[i]) * f;
+        }
+
+        neurax_resize_store_row(output, n, y, result);
+    }
+
+    neurax_scratch_free(job->device, scratch);
+}
+
+// Separable bilinear, uint8 to uint8 in fixed point
+static void neurax_resize_bilinear_u8(void* ctx, size_t begin, size_t end) {
+    neurax_resize_job_t* job = (neurax_resize_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = output->channels;
+    const size_t out_row = (size_t)output->width * C;
+    const size_t out_stride = neurax_resize_x_stride(output);
+
+    int32_t* scratch = neurax_scratch_alloc(job->device, sizeof(int32_t) * 2 * out_row);
+    if (!scratch) {
+        neurax_resize_fail(job, NEURAX_ERROR_MEMORY_ALLOCATION);
+        return;
+    }
+
+    neurax_resize_cache_t cache = {{scratch, scratch + out_row}, {SIZE_MAX, SIZE_MAX}};
+    const int32_t half = 1 << (2 * NEURAX_RESIZE_FRAC_BITS - 1);
+
+    for (size_t r = begin; r < end; r++) {
+        uint32_t n = (uint32_t)(r / output->height);
+        uint32_t y = (uint32_t)(r % output->height);
+        size_t k0 = (size_t)n * input->height + job->y.i0[y];
+        size_t k1 = (size_t)n * input->height + job->y.i1[y];
+
+        unsigned fill = neurax_resize_cache_lookup(&cache, k0, k1);
+        for (unsigned slot = 0; slot < 2; slot++) {
+            if (fill & (1u << slot)) {
+                uint32_t sy = slot == 0 ? job->y.i0[y] : job->y.i1[y];
+                const uint8_t* src = (const uint8_t*)input->data +
+                                     neurax_resize_row_offset(input, n, sy);
+                neurax_resize_hpass_u8(job, src, (int32_t*)cache.rows[slot]);
+            }
+        }
+
+        const int32_t* h0 = (const int32_t*)cache.rows[0];
+        const int32_t* h1 = k1 != k0 ? (const int32_t*)cache.rows[1] : h0;
+        const int32_t w1 = job->y.w[y];
+        const int32_t w0 = NEURAX_RESIZE_ONE - w1;
+        uint8_t* dst = (uint8_t*)output->data + neurax_resize_row_offset(output, n, y);
+
+        for (uint32_t x = 0; x < output->width; x++) {
+            const int32_t* a = h0 + (size_t)x * C;
+            const int32_t* b = h1 + (size_t)x * C;
+            uint8_t* o = dst + x * out_stride;
+            for (uint32_t c = 0; c < C; c++) {
+                o[c] = (uint8_t)((a[c] * w0 + b[c] * w1 + half) >> (2 * NEURAX_RESIZE_FRAC_BITS));
+            }
+        }
+    }
+
+    neurax_scratch_free(job->device, scratch);
+}
+
+// Exact 0.5x bilinear: with half-pixel centers every output is a 2x2 box average
+static void neurax_resize_down2(void* ctx, size_t begin, size_t end) {
+    neurax_resize_job_t* job = (neurax_resize_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = output->channels;
+
+    if (input->data_type == NEURAX_DATA_UINT8 && output->data_type == NEURAX_DATA_UINT8 &&
+        neurax_tensor_channels_packed(input) && neurax_tensor_channels_packed(output)) {
+        const size_t in_stride = neurax_resize_x_stride(input);
+        const size_t out_stride = neurax_resize_x_stride(output);
+
+        for (size_t r = begin; r < end; r++) {
+            uint32_t n = (uint32_t)(r / output->height);
+            uint32_t y = (uint32_t)(r % output->height);
+            const uint8_t* r0 = (const uint8_t*)input->data + neurax_resize_row_offset(input, n, 2 * y);
+            const uint8_t* r1 = (const uint8_t*)input->data + neurax_resize_row_offset(input, n, 2 * y + 1);
+            uint8_t* dst = (uint8_t*)output->data + neurax_resize_row_offset(output, n, y);
+
+            for (uint32_t x = 0; x < output->width; x++) {
+                const uint8_t* a = r0 + 2 * x * in_stride;
+                const uint8_t* b = r1 + 2 * x * in_stride;
+                uint8_t* o = dst + x * out_stride;
+                for (uint32_t c = 0; c < C; c++) {
+                    o[c] = (uint8_t)((a[c] + a[c + in_stride] + b[c] + b[c + in_stride] + 2) >> 2);
+                }
+            }
+        }
+        return;
+    }
+
+    const size_t in_row = (size_t)input->width * C;
+    float* scratch = neurax_scratch_alloc(job->device,
+                                          sizeof(float) * (2 * in_row + (size_t)output->width * C));
+    if (!scratch) {
+        neurax_resize_fail(job, NEURAX_ERROR_MEMORY_ALLOCATION);
+        return;
+    }
+    float* r0 = scratch;
+    float* r1 = scratch + in_row;
+    float* result = scratch + 2 * in_row;
+
+    for (size_t r = begin; r < end; r++) {
+        uint32_t n = (uint32_t)(r / output->height);
+        uint32_t y = (uint32_t)(r % output->height);
+        neurax_resize_load_row(input, n, 2 * y, r0);
+        neurax_resize_load_row(input, n, 2 * y + 1, r1);
+
+        for (uint32_t x = 0; x < output->width; x++) {
+            const float* a = r0 + (size_t)2 * x * C;
+            const float* b = r1 + (size_t)2 * x * C;
+            float* o = result + (size_t)x * C;
+            for (uint32_t c = 0; c < C; c++) {
+                o[c] = (a[c] + a[c + C] + b[c] + b[c + C]) * 0.25f;
+            }
+        }
+
+        neurax_resize_store_row(output, n, y, result);
+    }
+
+    neurax_scratch_free(job->device, scratch);
+}
+
+// Nearest neighbour: pixel copies, whole-row copies when consecutive rows share a source
+static void neurax_resize_nearest(void* ctx, size_t begin, size_t end) {
+    neurax_resize_job_t* job = (neurax_resize_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = output->channels;
+    const size_t in_size = neurax_get_element_size(input->data_type);
+    const size_t out_size = neurax_get_element_size(output->data_type);
+    size_t in_strides[4], out_strides[4];
+    neurax_tensor_get_strides(input, in_strides);
+    neurax_tensor_get_strides(output, out_strides);
+    const bool packed = neurax_tensor_channels_packed(input) && neurax_tensor_channels_packed(output);
+    const bool same_type = input->data_type == output->data_type;
+    const bool out_row_packed = neurax_resize_row_packed(output);
+
+    for (size_t r = begin; r < end; r++) {
+        uint32_t n = (uint32_t)(r / output->height);
+        uint32_t y = (uint32_t)(r % output->height);
+        uint8_t* dst = (uint8_t*)output->data + neurax_resize_row_offset(output, n, y);
+
+        if (out_row_packed && r > begin && y > 0 && job->y.i0[y] == job->y.i0[y - 1]) {
+            memcpy(dst, dst - out_strides[NEURAX_DIM_HEIGHT], (size_t)output->width * C * out_size);
+            continue;
+        }
+
+        const uint8_t* src = (const uint8_t*)input->data +
+                             neurax_resize_row_offset(input, n, job->y.i0[y]);
+        for (uint32_t x = 0; x < output->width; x++) {
+            const uint8_t* s = src + job->x.i0[x] * in_strides[NEURAX_DIM_WIDTH];
+            uint8_t* d = dst + x * out_strides[NEURAX_DIM_WIDTH];
+            if (packed && same_type) {
+                memcpy(d, s, C * in_size);
+            } else if (packed) {
+                neurax_convert_data_type(s, input->data_type, d, output->data_type, C);
+            } else {
+                for (uint32_t c = 0; c < C; c++) {
+                    float value = neurax_load_element(s + c * in_strides[NEURAX_DIM_CHANNEL],
+                                                      input->data_type, 0);
+                    neurax_store_element(d + c * out_strides[NEURAX_DIM_CHANNEL],
+                                         output->data_type, 0, value);
+                }
+            }
+        }
+    }
+}
+
+// Execute resize
+neurax_error_t neurax_resize(neurax_device_t* device,
+                            const neurax_tensor_t* input,
+                            neurax_resize_mode_t mode,
+                            neurax_tensor_t* output) {
+
+    if (!device || !input || !output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Validate inputs
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(input, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (mode > NEURAX_RESIZE_BILINEAR) {
+        NEURAX_LOG_ERROR("Invalid resize mode");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (input->channels != output->channels || input->batch_size != output->batch_size) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing resize: %ux%u -> %ux%u, mode=%d",
+                    input->width, input->height, output->width, output->height, mode);
+
+    // The accelerator has no resampling block, so resize always runs on the CPU
+    return neurax_cpu_resize(device, input, mode, output);
+}
+
+// CPU implementation
+neurax_error_t neurax_cpu_resize(neurax_device_t* device,
+                                const neurax_tensor_t* input,
+                                neurax_resize_mode_t mode,
+                                neurax_tensor_t* output) {
+
+    NEURAX_LOG_DEBUG("Using CPU implementation for resize");
+
+    neurax_resize_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.device = device;
+    job.input = input;
+    job.output = output;
+    job.up2_x = output->width == 2 * input->width;
+    job.error = NEURAX_SUCCESS;
+
+    bool down2 = mode == NEURAX_RESIZE_BILINEAR &&
+                 input->width == 2 * output->width && input->height == 2 * output->height;
+
+    neurax_parallel_fn kernel;
+    if (mode == NEURAX_RESIZE_NEAREST) {
+        kernel = neurax_resize_nearest;
+    } else if (down2) {
+        kernel = neurax_resize_down2;
+    } else if (input->data_type == NEURAX_DATA_UINT8 && output->data_type == NEURAX_DATA_UINT8 &&
+               neurax_tensor_channels_packed(input) && neurax_tensor_channels_packed(output)) {
+        kernel = neurax_resize_bilinear_u8;
+    } else {
+        kernel = neurax_resize_bilinear_f32;
+    }
+
+    // Coefficient tables are computed once per call and shared by all rows
+    size_t mark = neurax_scratch_mark(device);
+    neurax_error_t error = NEURAX_SUCCESS;
+    if (!down2) {
+        error = neurax_resize_alloc_axis(device, &job.x, output->width);
+        if (error == NEURAX_SUCCESS) {
+            error = neurax_resize_alloc_axis(device, &job.y, output->height);
+        }
+        if (error == NEURAX_SUCCESS) {
+            neurax_resize_fill_axis(&job.x, input->width, output->width, mode);
+            neurax_resize_fill_axis(&job.y, input->height, output->height, mode);
+        }
+    }
+
+    if (error == NEURAX_SUCCESS) {
+        size_t rows = (size_t)output->batch_size * output->height;
+        size_t row_elements = (size_t)output->width * output->channels;
+        neurax_parallel_for(rows, 1, NEURAX_RESIZE_PARALLEL_MIN / row_elements + 1, kernel, &job);
+        error = __atomic_load_n(&job.error, __ATOMIC_RELAXED);
+    }
+
+    neurax_resize_free_axis(device, &job.x);
+    neurax_resize_free_axis(device, &job.y);
+    neurax_scratch_release(device, mark);
+    return error;
+}
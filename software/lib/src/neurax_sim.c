@@ -0,0 +1,430 @@
+/*
+ * NEURAX Accelerator Simulator
+ * Register-level model of the FPGA: register file, CTRL/STAT handshake,
+ * convolution, activation and pooling units reading and writing DMA memory
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct neurax_sim {
+    neurax_device_t* device;    // Owner, for DMA address translation
+    uint32_t regs[NEURAX_NUM_REGS];
+    neurax_sim_fault_t fault;   // Applied to the next started operation
+    uint64_t operations;        // Operations started since creation
+    neurax_perf_estimate_t stats; // Modelled cost of the completed operations
+    pthread_mutex_t lock;
+};
+
+// Environment switch that selects the simulator without touching the configuration
+#define NEURAX_SIM_ENV "NEURAX_SIMULATOR"
+
+bool neurax_sim_requested(const neurax_config_t* config) {
+    if (config->use_simulator) {
+        return true;
+    }
+
+    const char* env = getenv(NEURAX_SIM_ENV);
+    return env && env[0] != '\0' && strcmp(env, "0") != 0;
+}
+
+neurax_sim_t* neurax_sim_create(neurax_device_t* device) {
+    neurax_sim_t* sim = calloc(1, sizeof(neurax_sim_t));
+    if (!sim) {
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&sim->lock, NULL) != 0) {
+        free(sim);
+        return NULL;
+    }
+    sim->device = device;
+    return sim;
+}
+
+void neurax_sim_destroy(neurax_sim_t* sim) {
+    if (!sim) {
+        return;
+    }
+
+    NEURAX_LOG_DEBUG("Simulator ran %llu operations", (unsigned long long)sim->operations);
+    pthread_mutex_destroy(&sim->lock);
+    free(sim);
+}
+
+// Element type the data path is configured for
+static neurax_data_type_t neurax_sim_data_type(uint32_t control) {
+    if (control & CTRL_DATA_WIDTH) {
+        return (control & CTRL_SIGNED) ? NEURAX_DATA_INT16 : NEURAX_DATA_UINT16;
+    }
+    return (control & CTRL_SIGNED) ? NEURAX_DATA_INT8 : NEURAX_DATA_UINT8;
+}
+
+// Translate an address register into host memory covering `count` elements
+static void* neurax_sim_buffer(neurax_sim_t* sim, uint32_t reg, size_t count,
+                               neurax_data_type_t type) {
+    uint32_t address = sim->regs[reg / 4];
+    void* data = neurax_dma_resolve(sim->device, address, count * neurax_get_element_size(type));
+    if (!data) {
+        NEURAX_LOG_ERROR("Simulator: register 0x%02X points outside DMA memory (0x%08X)",
+                         reg, address);
+    }
+    return data;
+}
+
+// Convolution unit: OIHW weights, zero padding, integer accumulation
+static bool neurax_sim_conv(neurax_sim_t* sim, uint32_t control, neurax_data_type_t type) {
+    neurax_conv_config_reg_t conv = {.raw = sim->regs[NEURAX_REG_CONV_CONFIG / 4]};
+    neurax_dim_config_reg_t dim = {.raw = sim->regs[NEURAX_REG_DIM_CONFIG / 4]};
+    neurax_chan_config_reg_t chan = {.raw = sim->regs[NEURAX_REG_CHAN_CONFIG / 4]};
+    neurax_act_config_reg_t act = {.raw = sim->regs[NEURAX_REG_ACT_CONFIG / 4]};
+
+    uint32_t kernel = conv.bits.kernel_size + 1;
+    uint32_t stride = conv.bits.stride + 1;
+    uint32_t padding = conv.bits.padding;
+    uint32_t in_channels = conv.bits.input_channels + 1;
+    uint32_t width = dim.bits.width;
+    uint32_t height = dim.bits.height;
+    uint32_t pixel_channels = chan.bits.input_channels;
+    uint32_t out_channels = chan.bits.output_channels;
+
+    if (width == 0 || height == 0 || out_channels == 0 || in_channels > pixel_channels ||
+        width + 2 * padding < kernel || height + 2 * padding < kernel) {
+        NEURAX_LOG_ERROR("Simulator: invalid convolution configuration");
+        return false;
+    }
+
+    uint32_t out_width = (width + 2 * padding - kernel) / stride + 1;
+    uint32_t out_height = (height + 2 * padding - kernel) / stride + 1;
+    size_t weight_count = (size_t)out_channels * in_channels * kernel * kernel;
+
+    const void* input = neurax_sim_buffer(sim, NEURAX_REG_INPUT_ADDR,
+                                          (size_t)width * height * pixel_channels, type);
+    const void* weights = neurax_sim_buffer(sim, NEURAX_REG_WEIGHT_ADDR, weight_count, type);
+    const void* bias = conv.bits.use_bias ?
+        neurax_sim_buffer(sim, NEURAX_REG_BIAS_ADDR, out_channels, type) : NULL;
+    void* output = neurax_sim_buffer(sim, NEURAX_REG_OUTPUT_ADDR,
+                                     (size_t)out_width * out_height * out_channels, type);
+    if (!input || !weights || !output || (conv.bits.use_bias && !bias)) {
+        return false;
+    }
+
+    for (uint32_t oy = 0; oy < out_height; oy++) {
+        for (uint32_t ox = 0; ox < out_width; ox++) {
+            for (uint32_t oc = 0; oc < out_channels; oc++) {
+                int64_t acc = 0;
+
+                for (uint32_t ic = 0; ic < in_channels; ic++) {
+                    for (uint32_t ky = 0; ky < kernel; ky++) {
+                        int32_t iy = (int32_t)(oy * stride + ky) - (int32_t)padding;
+                        if (iy < 0 || iy >= (int32_t)height) continue;
+
+                        for (uint32_t kx = 0; kx < kernel; kx++) {
+                            int32_t ix = (int32_t)(ox * stride + kx) - (int32_t)padding;
+                            if (ix < 0 || ix >= (int32_t)width) continue;
+
+                            size_t in_idx = ((size_t)iy * width + ix) * pixel_channels + ic;
+                            size_t w_idx = (((size_t)oc * in_channels + ic) * kernel + ky) * kernel + kx;
+                            acc += (int64_t)neurax_load_element(input, type, in_idx) *
+                                   (int64_t)neurax_load_element(weights, type, w_idx);
+                        }
+                    }
+                }
+                if (bias) {
+                    acc += (int64_t)neurax_load_element(bias, type, oc);
+                }
+
+                float value = (float)acc;
+                if (control & CTRL_ACT_EN) {
+                    value = neurax_apply_activation(value, (neurax_activation_t)act.bits.activation);
+                }
+                neurax_store_element(output, type, ((size_t)oy * out_width + ox) * out_channels + oc,
+                                     value);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Pooling unit: square windows without padding
+static bool neurax_sim_pool(neurax_sim_t* sim, neurax_data_type_t type) {
+    uint32_t pool_config = sim->regs[NEURAX_REG_POOL_CONFIG / 4];
+    neurax_dim_config_reg_t dim = {.raw = sim->regs[NEURAX_REG_DIM_CONFIG / 4]};
+    neurax_chan_config_reg_t chan = {.raw = sim->regs[NEURAX_REG_CHAN_CONFIG / 4]};
+
+    bool average = (pool_config & 0x1) == NEURAX_POOL_AVERAGE;
+    uint32_t size = ((pool_config >> 1) & 0x7) + 2;
+    uint32_t stride = ((pool_config >> 4) & 0x7) + 1;
+    uint32_t width = dim.bits.width;
+    uint32_t height = dim.bits.height;
+    uint32_t channels = chan.bits.input_channels;
+
+    if (channels == 0 || chan.bits.output_channels != channels || width < size || height < size) {
+        NEURAX_LOG_ERROR("Simulator: invalid pooling configuration");
+        return false;
+    }
+
+    uint32_t out_width = (width - size) / stride + 1;
+    uint32_t out_height = (height - size) / stride + 1;
+
+    const void* input = neurax_sim_buffer(sim, NEURAX_REG_INPUT_ADDR,
+                                          (size_t)width * height * channels, type);
+    void* output = neurax_sim_buffer(sim, NEURAX_REG_OUTPUT_ADDR,
+                                     (size_t)out_width * out_height * channels, type);
+    if (!input || !output) {
+        return false;
+    }
+
+    for (uint32_t oy = 0; oy < out_height; oy++) {
+        for (uint32_t ox = 0; ox < out_width; ox++) {
+            for (uint32_t c = 0; c < channels; c++) {
+                float result = 0.0f;
+
+                for (uint32_t py = 0; py < size; py++) {
+                    for (uint32_t px = 0; px < size; px++) {
+                        size_t idx = ((size_t)(oy * stride + py) * width + ox * stride + px) *
+                                     channels + c;
+                        float value = neurax_load_element(input, type, idx);
+
+                        if (average) {
+                            result += value;
+                        } else if (value > result || (py == 0 && px == 0)) {
+                            result = value;
+                        }
+                    }
+                }
+                if (average) {
+                    result /= size * size;
+                }
+
+                neurax_store_element(output, type, ((size_t)oy * out_width + ox) * channels + c,
+                                     result);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Activation unit on its own: elementwise over the configured image
+static bool neurax_sim_act(neurax_sim_t* sim, neurax_data_type_t type) {
+    neurax_dim_config_reg_t dim = {.raw = sim->regs[NEURAX_REG_DIM_CONFIG / 4]};
+    neurax_chan_config_reg_t chan = {.raw = sim->regs[NEURAX_REG_CHAN_CONFIG / 4]};
+    neurax_act_config_reg_t act = {.raw = sim->regs[NEURAX_REG_ACT_CONFIG / 4]};
+
+    if (chan.bits.output_channels != chan.bits.input_channels) {
+        NEURAX_LOG_ERROR("Simulator: activation channel counts differ");
+        return false;
+    }
+
+    size_t count = (size_t)dim.bits.width * dim.bits.height * chan.bits.input_channels;
+    const void* input = neurax_sim_buffer(sim, NEURAX_REG_INPUT_ADDR, count, type);
+    void* output = neurax_sim_buffer(sim, NEURAX_REG_OUTPUT_ADDR, count, type);
+    if (!input || !output) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        float value = neurax_load_element(input, type, i);
+        value = neurax_apply_activation(value, (neurax_activation_t)act.bits.activation);
+        neurax_store_element(output, type, i, value);
+    }
+
+    return true;
+}
+
+// Charge a completed operation with the performance model and latch its cycle count
+static void neurax_sim_account(neurax_sim_t* sim, uint32_t control) {
+    neurax_hw_program_t program = {
+        .control = control,
+        .conv_config = sim->regs[NEURAX_REG_CONV_CONFIG / 4],
+        .pool_config = sim->regs[NEURAX_REG_POOL_CONFIG / 4],
+        .act_config = sim->regs[NEURAX_REG_ACT_CONFIG / 4],
+        .dim_config = sim->regs[NEURAX_REG_DIM_CONFIG / 4],
+        .chan_config = sim->regs[NEURAX_REG_CHAN_CONFIG / 4],
+    };
+    neurax_perf_estimate_t estimate;
+
+    if (neurax_perf_model_run(&sim->device->config, &program, &estimate) != NEURAX_SUCCESS) {
+        return;
+    }
+    neurax_perf_accumulate(&sim->device->config, &sim->stats, &estimate, 1);
+    sim->regs[NEURAX_REG_CYCLE_COUNT / 4] =
+        estimate.cycles < UINT32_MAX ? (uint32_t)estimate.cycles : UINT32_MAX;
+}
+
+// Run the operation selected by the control word; the model completes synchronously
+static uint32_t neurax_sim_execute(neurax_sim_t* sim, uint32_t control) {
+    neurax_data_type_t type = neurax_sim_data_type(control);
+    bool ok;
+
+    if (control & CTRL_CONV_EN) {
+        ok = !(control & CTRL_POOL_EN) && neurax_sim_conv(sim, control, type);
+    } else if (control & CTRL_POOL_EN) {
+        ok = !(control & CTRL_ACT_EN) && neurax_sim_pool(sim, type);
+    } else if (control & CTRL_ACT_EN) {
+        ok = neurax_sim_act(sim, type);
+    } else {
+        NEURAX_LOG_ERROR("Simulator: started with no unit enabled");
+        ok = false;
+    }
+
+    if (!ok) {
+        return STAT_ERROR;
+    }
+    neurax_sim_account(sim, control);
+    return STAT_DONE;
+}
+
+// Descriptor engine: load each descriptor into the registers and run it, stopping at the
+// first failure; DESC_DONE counts the completed descriptors
+static uint32_t neurax_sim_execute_chain(neurax_sim_t* sim) {
+    uint32_t address = sim->regs[NEURAX_REG_DESC_ADDR / 4];
+    uint32_t count = sim->regs[NEURAX_REG_DESC_COUNT / 4];
+    uint64_t cycles = sim->stats.cycles;
+
+    const neurax_hw_descriptor_t* chain =
+        neurax_dma_resolve(sim->device, address, (size_t)count * sizeof(neurax_hw_descriptor_t));
+    if (count == 0 || !chain) {
+        NEURAX_LOG_ERROR("Simulator: invalid descriptor chain (%u at 0x%08X)", count, address);
+        return STAT_ERROR;
+    }
+
+    uint32_t status = STAT_DONE;
+    for (uint32_t i = 0; i < count && status == STAT_DONE; i++) {
+        const neurax_hw_descriptor_t* desc = &chain[i];
+        sim->regs[NEURAX_REG_CONV_CONFIG / 4] = desc->program.conv_config;
+        sim->regs[NEURAX_REG_POOL_CONFIG / 4] = desc->program.pool_config;
+        sim->regs[NEURAX_REG_ACT_CONFIG / 4] = desc->program.act_config;
+        sim->regs[NEURAX_REG_DIM_CONFIG / 4] = desc->program.dim_config;
+        sim->regs[NEURAX_REG_CHAN_CONFIG / 4] = desc->program.chan_config;
+        sim->regs[NEURAX_REG_INPUT_ADDR / 4] = desc->input_addr;
+        sim->regs[NEURAX_REG_OUTPUT_ADDR / 4] = desc->output_addr;
+        sim->regs[NEURAX_REG_WEIGHT_ADDR / 4] = desc->weight_addr;
+        sim->regs[NEURAX_REG_BIAS_ADDR / 4] = desc->bias_addr;
+
+        status = neurax_sim_execute(sim, desc->program.control & ~(CTRL_START | CTRL_DESC_EN));
+        if (status == STAT_DONE) {
+            sim->regs[NEURAX_REG_DESC_DONE / 4] = i + 1;
+        }
+    }
+
+    // The cycle count covers the whole chain
+    cycles = sim->stats.cycles - cycles;
+    sim->regs[NEURAX_REG_CYCLE_COUNT / 4] = cycles < UINT32_MAX ? (uint32_t)cycles : UINT32_MAX;
+    return status;
+}
+
+void neurax_sim_write(neurax_sim_t* sim, uint32_t offset, uint32_t value) {
+    uint32_t index = offset / 4;
+    if (index >= NEURAX_NUM_REGS || offset == NEURAX_REG_STATUS ||
+        offset == NEURAX_REG_CYCLE_COUNT || offset == NEURAX_REG_DESC_DONE) {
+        return; // Unmapped or read-only
+    }
+
+    pthread_mutex_lock(&sim->lock);
+    uint32_t* status = &sim->regs[NEURAX_REG_STATUS / 4];
+
+    if (offset != NEURAX_REG_CONTROL) {
+        sim->regs[index] = value;
+    } else if (value & CTRL_RESET) {
+        // Reset clears configuration and status, and recovers a hung unit
+        memset(sim->regs, 0, sizeof(sim->regs));
+        sim->regs[index] = value;
+    } else {
+        sim->regs[index] = value;
+
+        // A start edge while idle launches an operation; starting clears DONE and ERROR
+        if ((value & CTRL_START) && !(*status & STAT_BUSY)) {
+            neurax_sim_fault_t fault = sim->fault;
+            sim->fault = NEURAX_SIM_FAULT_NONE;
+            sim->operations++;
+
+            sim->regs[NEURAX_REG_CYCLE_COUNT / 4] = 0;
+            sim->regs[NEURAX_REG_DESC_DONE / 4] = 0;
+            if (fault == NEURAX_SIM_FAULT_HANG) {
+                *status = STAT_BUSY;
+            } else if (fault == NEURAX_SIM_FAULT_ERROR) {
+                *status = STAT_ERROR;
+            } else if (value & CTRL_DESC_EN) {
+                *status = neurax_sim_execute_chain(sim);
+            } else {
+                *status = neurax_sim_execute(sim, value);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&sim->lock);
+}
+
+uint32_t neurax_sim_read(neurax_sim_t* sim, uint32_t offset) {
+    uint32_t index = offset / 4;
+    if (index >= NEURAX_NUM_REGS) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&sim->lock);
+    uint32_t value = sim->regs[index];
+    pthread_mutex_unlock(&sim->lock);
+    return value;
+}
+
+// Public API
+
+neurax_error_t neurax_simulator_inject_fault(neurax_device_t* device, neurax_sim_fault_t fault) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!device->sim) {
+        NEURAX_LOG_ERROR("Faults can only be injected into a simulated device");
+        return NEURAX_ERROR_DEVICE_NOT_FOUND;
+    }
+    if (fault > NEURAX_SIM_FAULT_HANG) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&device->sim->lock);
+    device->sim->fault = fault;
+    pthread_mutex_unlock(&device->sim->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_simulator_get_stats(neurax_device_t* device, neurax_perf_estimate_t* stats) {
+    if (!stats) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!device->sim) {
+        return NEURAX_ERROR_DEVICE_NOT_FOUND;
+    }
+
+    pthread_mutex_lock(&device->sim->lock);
+    *stats = device->sim->stats;
+    pthread_mutex_unlock(&device->sim->lock);
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_simulator_reset_stats(neurax_device_t* device) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+    if (!device->sim) {
+        return NEURAX_ERROR_DEVICE_NOT_FOUND;
+    }
+
+    pthread_mutex_lock(&device->sim->lock);
+    memset(&device->sim->stats, 0, sizeof(device->sim->stats));
+    pthread_mutex_unlock(&device->sim->lock);
+
+    return NEURAX_SUCCESS;
+}
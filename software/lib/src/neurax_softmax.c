@@ -0,0 +1,430 @@
+/*
+ * NEURAX Softmax, Argmax and Top-K Implementation
+ * Output operators over the channel (class) dimension of each pixel
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+// Scores converted per fp32 block by argmax and top-k
+#define NEURAX_SCORES_BLOCK 1024
+
+// Scores per thread before the pixels are split across threads
+#define NEURAX_SCORES_PARALLEL_MIN (64 * 1024)
+
+// Shared state for output operator worker threads
+typedef struct {
+    neurax_device_t* device;        // Scratch memory source
+    const neurax_tensor_t* input;
+    neurax_tensor_t* output;        // Softmax only
+    uint32_t k;                     // Top-k only (1 for argmax)
+    uint32_t* indices;
+    float* values;
+    neurax_error_t error;           // Set atomically by workers that couldn't allocate scratch
+} neurax_scores_job_t;
+
+// Candidate kept by the top-k heap
+typedef struct {
+    float value;
+    uint32_t index;
+} neurax_topk_entry_t;
+
+// Load scores [c0, c0 + count) of one pixel as real (dequantized) fp32 values
+static void neurax_load_scores(const neurax_tensor_t* tensor, size_t pixel,
+                               uint32_t c0, uint32_t count, float* dst) {
+    size_t strides[4];
+    neurax_tensor_get_strides(tensor, strides);
+    size_t offset = neurax_tensor_pixel_offset(tensor, pixel) + c0 * strides[NEURAX_DIM_CHANNEL];
+    float scale = tensor->quant.scale > 0.0f ? tensor->quant.scale : 1.0f;
+    float shift = -scale * (float)tensor->quant.zero_point;
+
+    if (!neurax_tensor_channels_packed(tensor)) {
+        neurax_load_channels(tensor, offset, count, dst);
+        for (uint32_t c = 0; c < count; c++) {
+            dst[c] = dst[c] * scale + shift;
+        }
+        return;
+    }
+
+    neurax_convert_data_type_scaled((const uint8_t*)tensor->data + offset, tensor->data_type,
+                                    dst, NEURAX_DATA_FLOAT32, count, scale, shift);
+}
+
+// Scores [c0, c0 + count) of one pixel, read in place when they are plain fp32
+static const float* neurax_get_scores(const neurax_tensor_t* tensor, size_t pixel,
+                                      uint32_t c0, uint32_t count, float* block) {
+    if (tensor->data_type == NEURAX_DATA_FLOAT32 && !(tensor->quant.scale > 0.0f) &&
+        neurax_tensor_channels_packed(tensor)) {
+        return (const float*)((const uint8_t*)tensor->data +
+                              neurax_tensor_pixel_offset(tensor, pixel)) + c0;
+    }
+
+    neurax_load_scores(tensor, pixel, c0, count, block);
+    return block;
+}
+
+// Lower bound for softmax exponents; keeps 2^n of the range reduction a normal float
+#define NEURAX_SOFTMAX_MIN_EXPONENT -87.0f
+
+// exp(x) for x in [-87, 0]: Cephes polynomial with branch-free range reduction so loops
+// vectorize. Callers clamp in a separate loop; a clamp here would keep the loop scalar.
+static inline float neurax_exp_nonpositive(float x) {
+    // n = round(x / ln2); x <= 0 so truncating t - 0.5 rounds to nearest
+    int32_t n = (int32_t)(x * 1.44269504088896341f - 0.5f);
+    float fn = (float)n;
+    float r = x - fn * 0.693359375f + fn * 2.12194440e-4f;
+
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.0f;
+
+    neurax_fp32_bits_t scale;
+    scale.u = (uint32_t)(n + 127) << 23;
+    return p * scale.f;
+}
+
+// Normalize one row of finite scores in place given its maximum
+static void neurax_softmax_row(float* row, uint32_t C, float max) {
+    // Subtracting the max keeps every exponent <= 0, so nothing overflows
+    uint32_t i;
+    for (i = 0; i < C; i++) {
+        float x = row[i] - max;
+        row[i] = x > NEURAX_SOFTMAX_MIN_EXPONENT ? x : NEURAX_SOFTMAX_MIN_EXPONENT;
+    }
+    for (i = 0; i < C; i++) {
+        row[i] = neurax_exp_nonpositive(row[i]);
+    }
+
+    float sums[8] = {0.0f};
+    for (i = 0; i + 8 <= C; i += 8) {
+        for (uint32_t j = 0; j < 8; j++) {
+            sums[j] += row[i + j];
+        }
+    }
+    float sum = ((sums[0] + sums[4]) + (sums[1] + sums[5])) +
+                ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+    for (; i < C; i++) {
+        sum += row[i];
+    }
+
+    const float inv_sum = 1.0f / sum;
+    for (i = 0; i < C; i++) {
+        row[i] *= inv_sum;
+    }
+}
+
+// Rows the exponentials can't handle: a NaN makes every probability NaN, and
+// +inf scores share the whole probability equally
+static void neurax_softmax_row_nonfinite(float* row, uint32_t C, bool has_nan) {
+    uint32_t infinities = 0;
+    for (uint32_t i = 0; i < C; i++) {
+        infinities += row[i] == INFINITY;
+    }
+    for (uint32_t i = 0; i < C; i++) {
+        row[i] = has_nan ? NAN : (row[i] == INFINITY ? 1.0f / (float)infinities : 0.0f);
+    }
+}
+
+static void neurax_softmax_pixels(void* ctx, size_t begin, size_t end) {
+    neurax_scores_job_t* job = (neurax_scores_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    neurax_tensor_t* output = job->output;
+    const uint32_t C = input->channels;
+    const bool quantize_output = output->quant.scale > 0.0f &&
+                                 (output->data_type == NEURAX_DATA_INT8 ||
+                                  output->data_type == NEURAX_DATA_UINT8);
+    const bool float_output = output->data_type == NEURAX_DATA_FLOAT32 ||
+                              output->data_type == NEURAX_DATA_FLOAT16 ||
+                              output->data_type == NEURAX_DATA_BFLOAT16;
+
+    float* row = neurax_scratch_alloc(job->device, sizeof(float) * C);
+    if (!row) {
+        __atomic_store_n(&job->error, NEURAX_ERROR_MEMORY_ALLOCATION, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (size_t p = begin; p < end; p++) {
+        neurax_load_scores(input, p, 0, C, row);
+
+        // Max with independent partials so the reduction vectorizes; NaN
+        // fails every comparison, so it is counted on the side
+        float partial[8] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX,
+                            -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+        uint32_t nans = 0;
+        uint32_t i = 0;
+        for (; i + 8 <= C; i += 8) {
+            for (uint32_t j = 0; j < 8; j++) {
+                partial[j] = row[i + j] > partial[j] ? row[i + j] : partial[j];
+                nans += row[i + j] != row[i + j];
+            }
+        }
+        float max = partial[0];
+        for (uint32_t j = 1; j < 8; j++) {
+            max = partial[j] > max ? partial[j] : max;
+        }
+        for (; i < C; i++) {
+            max = row[i] > max ? row[i] : max;
+            nans += row[i] != row[i];
+        }
+
+        if (nans > 0 || max == INFINITY) {
+            neurax_softmax_row_nonfinite(row, C, nans > 0);
+            if (nans > 0 && !float_output) {
+                // Integer outputs can't hold NaN: report it rather than store a distribution
+                __atomic_store_n(&job->error, NEURAX_ERROR_INVALID_PARAM, __ATOMIC_RELAXED);
+                memset(row, 0, sizeof(float) * C);
+            }
+        } else {
+            neurax_softmax_row(row, C, max);
+        }
+
+        if (quantize_output) {
+            const float inv_scale = 1.0f / output->quant.scale;
+            for (i = 0; i < C; i++) {
+                row[i] = neurax_quantize_value(row[i], inv_scale, output->quant.zero_point);
+            }
+        }
+
+        neurax_store_channels(output, neurax_tensor_pixel_offset(output, p), C, row);
+    }
+
+    neurax_scratch_free(job->device, row);
+}
+
+static void neurax_argmax_pixels(void* ctx, size_t begin, size_t end) {
+    neurax_scores_job_t* job = (neurax_scores_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    const uint32_t C = input->channels;
+    float block[NEURAX_SCORES_BLOCK];
+
+    for (size_t p = begin; p < end; p++) {
+        float best = 0.0f;
+        uint32_t best_index = 0;
+
+        for (uint32_t c0 = 0; c0 < C; c0 += NEURAX_SCORES_BLOCK) {
+            uint32_t count = C - c0 < NEURAX_SCORES_BLOCK ? C - c0 : NEURAX_SCORES_BLOCK;
+            const float* scores = neurax_get_scores(input, p, c0, count, block);
+
+            if (c0 == 0) {
+                best = scores[0];
+            }
+            // Strictly greater keeps the lowest index on ties
+            for (uint32_t i = 0; i < count; i++) {
+                if (scores[i] > best) {
+                    best = scores[i];
+                    best_index = c0 + i;
+                }
+            }
+        }
+
+        job->indices[p] = best_index;
+        if (job->values) {
+            job->values[p] = best;
+        }
+    }
+}
+
+// Heap order: a ranks below b (smaller value, or same value and higher index)
+static inline bool neurax_topk_below(const neurax_topk_entry_t* a, const neurax_topk_entry_t* b) {
+    return a->value < b->value || (a->value == b->value && a->index > b->index);
+}
+
+static void neurax_topk_sift_down(neurax_topk_entry_t* heap, uint32_t size, uint32_t i) {
+    for (;;) {
+        uint32_t lowest = i;
+        uint32_t left = 2 * i + 1;
+        uint32_t right = left + 1;
+
+        if (left < size && neurax_topk_below(&heap[left], &heap[lowest])) lowest = left;
+        if (right < size && neurax_topk_below(&heap[right], &heap[lowest])) lowest = right;
+        if (lowest == i) return;
+
+        neurax_topk_entry_t tmp = heap[i];
+        heap[i] = heap[lowest];
+        heap[lowest] = tmp;
+        i = lowest;
+    }
+}
+
+static void neurax_topk_sift_up(neurax_topk_entry_t* heap, uint32_t i) {
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!neurax_topk_below(&heap[i], &heap[parent])) return;
+
+        neurax_topk_entry_t tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+// Partial selection: a size-k min-heap holds the best candidates seen so far
+static void neurax_topk_pixels(void* ctx, size_t begin, size_t end) {
+    neurax_scores_job_t* job = (neurax_scores_job_t*)ctx;
+    const neurax_tensor_t* input = job->input;
+    const uint32_t C = input->channels;
+    const uint32_t k = job->k;
+    float block[NEURAX_SCORES_BLOCK];
+
+    neurax_topk_entry_t* heap = neurax_scratch_alloc(job->device, sizeof(neurax_topk_entry_t) * k);
+    if (!heap) {
+        __atomic_store_n(&job->error, NEURAX_ERROR_MEMORY_ALLOCATION, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (size_t p = begin; p < end; p++) {
+        uint32_t size = 0;
+
+        for (uint32_t c0 = 0; c0 < C; c0 += NEURAX_SCORES_BLOCK) {
+            uint32_t count = C - c0 < NEURAX_SCORES_BLOCK ? C - c0 : NEURAX_SCORES_BLOCK;
+            const float* scores = neurax_get_scores(input, p, c0, count, block);
+
+            for (uint32_t i = 0; i < count; i++) {
+                neurax_topk_entry_t entry = {scores[i], c0 + i};
+
+                if (size < k) {
+                    heap[size] = entry;
+                    neurax_topk_sift_up(heap, size++);
+                } else if (neurax_topk_below(&heap[0], &entry)) {
+                    heap[0] = entry;
+                    neurax_topk_sift_down(heap, k, 0);
+                }
+            }
+        }
+
+        // Pop the heap from the back so results come out best first
+        uint32_t* indices = job->indices + p * k;
+        float* values = job->values ? job->values + p * k : NULL;
+        while (size > 0) {
+            size--;
+            indices[size] = heap[0].index;
+            if (values) {
+                values[size] = heap[0].value;
+            }
+            heap[0] = heap[size];
+            neurax_topk_sift_down(heap, size, 0);
+        }
+    }
+
+    neurax_scratch_free(job->device, heap);
+}
+
+// Common checks for the output operators
+static neurax_error_t neurax_validate_scores(neurax_device_t* device, const neurax_tensor_t* input) {
+    if (!device || !input) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_error_t error = neurax_validate_tensor(input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    return neurax_validate_layout(input, false);
+}
+
+static neurax_error_t neurax_run_scores(neurax_device_t* device, neurax_scores_job_t* job,
+                                       neurax_parallel_fn fn) {
+    const neurax_tensor_t* input = job->input;
+    size_t min_pixels = NEURAX_SCORES_PARALLEL_MIN / input->channels + 1;
+    size_t mark = neurax_scratch_mark(device);
+
+    job->device = device;
+    job->error = NEURAX_SUCCESS;
+    neurax_parallel_for(neurax_tensor_pixel_count(input), 1, min_pixels, fn, job);
+    neurax_scratch_release(device, mark);
+    return job->error;
+}
+
+// Execute softmax
+neurax_error_t neurax_softmax(neurax_device_t* device,
+                             const neurax_tensor_t* input,
+                             neurax_tensor_t* output) {
+
+    neurax_error_t error = neurax_validate_scores(device, input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (!output) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    error = neurax_validate_output(output);
+    if (error != NEURAX_SUCCESS) return error;
+
+    error = neurax_validate_layout(output, false);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (input->width != output->width || input->height != output->height ||
+        input->channels != output->channels || input->batch_size != output->batch_size) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing softmax: %u classes", input->channels);
+
+    neurax_scores_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.input = input;
+    job.output = output;
+    return neurax_run_scores(device, &job, neurax_softmax_pixels);
+}
+
+// Execute argmax
+neurax_error_t neurax_argmax(neurax_device_t* device,
+                            const neurax_tensor_t* input,
+                            uint32_t* indices,
+                            float* values) {
+
+    neurax_error_t error = neurax_validate_scores(device, input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (!indices) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing argmax: %u classes", input->channels);
+
+    neurax_scores_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.input = input;
+    job.k = 1;
+    job.indices = indices;
+    job.values = values;
+    return neurax_run_scores(device, &job, neurax_argmax_pixels);
+}
+
+// Execute top-k
+neurax_error_t neurax_topk(neurax_device_t* device,
+                          const neurax_tensor_t* input,
+                          uint32_t k,
+                          uint32_t* indices,
+                          float* values) {
+
+    neurax_error_t error = neurax_validate_scores(device, input);
+    if (error != NEURAX_SUCCESS) return error;
+
+    if (!indices || k == 0 || k > input->channels) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    NEURAX_LOG_INFO("Executing top-%u: %u classes", k, input->channels);
+
+    neurax_scores_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.input = input;
+    job.k = k;
+    job.indices = indices;
+    job.values = values;
+    return neurax_run_scores(device, &job, neurax_topk_pixels);
+}
@@ -0,0 +1,492 @@
+/*
+ * NEURAX Tensor Files
+ * .nxt container: a table of tensor headers followed by page-aligned payloads,
+ * loaded through a read-only mapping without copying
+ *
+ * Author: NEURAX Team
+ */
+
+#define _GNU_SOURCE
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// File layout, every field little-endian:
+//   header (NEURAX_NXT_HEADER_SIZE bytes, fields as in neurax_nxt_header_t)
+//   entries (NEURAX_NXT_ENTRY_SIZE bytes each, fields as in neurax_nxt_entry_t)
+//   per-channel quantization scales (float32, 4-byte aligned)
+//   payloads, each aligned to NEURAX_NXT_ALIGNMENT
+// Payloads are mapped in place rather than decoded, so big-endian hosts cannot
+// use the format and are refused.
+#define NEURAX_NXT_MAGIC "NXT1"
+#define NEURAX_NXT_VERSION 1
+#define NEURAX_NXT_ALIGNMENT 4096
+#define NEURAX_NXT_HEADER_SIZE 64
+#define NEURAX_NXT_ENTRY_SIZE 128
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t num_tensors;
+    uint32_t alignment;             // Payload alignment used by the writer
+    uint64_t file_size;
+    uint8_t reserved[40];
+} neurax_nxt_header_t;
+
+typedef struct {
+    char name[NEURAX_TENSOR_NAME_MAX];
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t batch_size;
+    uint32_t data_type;
+    uint32_t layout;
+    float scale;
+    int32_t zero_point;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint64_t scales_offset;         // Per-channel scales (0 = none)
+    uint32_t num_channel_scales;
+    uint32_t reserved;
+} neurax_nxt_entry_t;
+
+// Open file: the mapping stays alive while the handle or any tensor loaded from it exists
+struct neurax_tensor_file {
+    const uint8_t* base;
+    size_t size;
+    neurax_nxt_entry_t* entries;    // Decoded table
+    uint32_t num_tensors;
+    uint32_t refs;
+};
+
+static void neurax_tensor_file_unref(neurax_tensor_file_t* file) {
+    if (__atomic_sub_fetch(&file->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        munmap((void*)file->base, file->size);
+        free(file->entries);
+        free(file);
+    }
+}
+
+static bool neurax_nxt_host_little_endian(void) {
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+// Little-endian field encoding, independent of the host byte order
+static void neurax_nxt_put_u32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void neurax_nxt_put_u64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t neurax_nxt_get_u32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t neurax_nxt_get_u64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+static void neurax_nxt_encode_header(const neurax_nxt_header_t* h, uint8_t* p) {
+    memset(p, 0, NEURAX_NXT_HEADER_SIZE);
+    memcpy(p, h->magic, sizeof(h->magic));
+    neurax_nxt_put_u32(p + 4, h->version);
+    neurax_nxt_put_u32(p + 8, h->num_tensors);
+    neurax_nxt_put_u32(p + 12, h->alignment);
+    neurax_nxt_put_u64(p + 16, h->file_size);
+}
+
+static void neurax_nxt_decode_header(const uint8_t* p, neurax_nxt_header_t* h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, p, sizeof(h->magic));
+    h->version = neurax_nxt_get_u32(p + 4);
+    h->num_tensors = neurax_nxt_get_u32(p + 8);
+    h->alignment = neurax_nxt_get_u32(p + 12);
+    h->file_size = neurax_nxt_get_u64(p + 16);
+}
+
+static void neurax_nxt_encode_entry(const neurax_nxt_entry_t* e, uint8_t* p) {
+    uint32_t scale_bits;
+    memcpy(&scale_bits, &e->scale, sizeof(scale_bits));
+
+    memset(p, 0, NEURAX_NXT_ENTRY_SIZE);
+    memcpy(p, e->name, sizeof(e->name));
+    neurax_nxt_put_u32(p + 64, e->width);
+    neurax_nxt_put_u32(p + 68, e->height);
+    neurax_nxt_put_u32(p + 72, e->channels);
+    neurax_nxt_put_u32(p + 76, e->batch_size);
+    neurax_nxt_put_u32(p + 80, e->data_type);
+    neurax_nxt_put_u32(p + 84, e->layout);
+    neurax_nxt_put_u32(p + 88, scale_bits);
+    neurax_nxt_put_u32(p + 92, (uint32_t)e->zero_point);
+    neurax_nxt_put_u64(p + 96, e->data_offset);
+    neurax_nxt_put_u64(p + 104, e->data_size);
+    neurax_nxt_put_u64(p + 112, e->scales_offset);
+    neurax_nxt_put_u32(p + 120, e->num_channel_scales);
+}
+
+static void neurax_nxt_decode_entry(const uint8_t* p, neurax_nxt_entry_t* e) {
+    memset(e, 0, sizeof(*e));
+    memcpy(e->name, p, sizeof(e->name));
+    e->width = neurax_nxt_get_u32(p + 64);
+    e->height = neurax_nxt_get_u32(p + 68);
+    e->channels = neurax_nxt_get_u32(p + 72);
+    e->batch_size = neurax_nxt_get_u32(p + 76);
+    e->data_type = neurax_nxt_get_u32(p + 80);
+    e->layout = neurax_nxt_get_u32(p + 84);
+    uint32_t scale_bits = neurax_nxt_get_u32(p + 88);
+    memcpy(&e->scale, &scale_bits, sizeof(e->scale));
+    e->zero_point = (int32_t)neurax_nxt_get_u32(p + 92);
+    e->data_offset = neurax_nxt_get_u64(p + 96);
+    e->data_size = neurax_nxt_get_u64(p + 104);
+    e->scales_offset = neurax_nxt_get_u64(p + 112);
+    e->num_channel_scales = neurax_nxt_get_u32(p + 120);
+}
+
+// Deleter of loaded tensors: the data belongs to the mapping
+static void neurax_tensor_file_deleter(void* data, void* user_data) {
+    (void)data;
+    neurax_tensor_file_unref((neurax_tensor_file_t*)user_data);
+}
+
+static inline uint64_t neurax_nxt_align(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Write zero bytes up to `offset`
+static bool neurax_nxt_pad(FILE* fp, uint64_t* position, uint64_t offset) {
+    static const uint8_t zeros[256] = {0};
+    while (*position < offset) {
+        size_t chunk = offset - *position < sizeof(zeros) ? (size_t)(offset - *position) : sizeof(zeros);
+        if (fwrite(zeros, 1, chunk, fp) != chunk) {
+            return false;
+        }
+        *position += chunk;
+    }
+    return true;
+}
+
+// Save tensors to a .nxt file
+neurax_error_t neurax_tensor_file_save(const char* filename,
+                                      const neurax_tensor_t* const* tensors,
+                                      const char* const* names,
+                                      uint32_t count) {
+    if (!filename || !tensors || count == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!neurax_nxt_host_little_endian()) {
+        NEURAX_LOG_ERROR("Tensor files need a little-endian host");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        neurax_error_t error = neurax_validate_tensor(tensors[i]);
+        if (error != NEURAX_SUCCESS) return error;
+
+        // Strided views would need a gather; their parent or a copy can be saved instead
+        if (neurax_tensor_is_view(tensors[i]) && !neurax_tensor_is_contiguous(tensors[i])) {
+            NEURAX_LOG_ERROR("Cannot save strided view %u", i);
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        if (names && names[i] && strlen(names[i]) >= NEURAX_TENSOR_NAME_MAX) {
+            NEURAX_LOG_ERROR("Tensor name '%s' is too long", names[i]);
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+    }
+
+    neurax_nxt_entry_t* entries = calloc(count, sizeof(neurax_nxt_entry_t));
+    if (!entries) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    // Lay out scales after the table, then the payloads
+    uint64_t offset = NEURAX_NXT_HEADER_SIZE + (uint64_t)count * NEURAX_NXT_ENTRY_SIZE;
+    for (uint32_t i = 0; i < count; i++) {
+        const neurax_tensor_t* t = tensors[i];
+        neurax_nxt_entry_t* e = &entries[i];
+
+        if (names && names[i]) {
+            strncpy(e->name, names[i], sizeof(e->name) - 1);
+        }
+        e->width = t->width;
+        e->height = t->height;
+        e->channels = t->channels;
+        e->batch_size = t->batch_size;
+        e->data_type = (uint32_t)t->data_type;
+        e->layout = (uint32_t)t->layout;
+        e->scale = t->quant.scale;
+        e->zero_point = t->quant.zero_point;
+        e->data_size = t->data_size;
+
+        if (t->quant.channel_scales && t->quant.num_channels > 0) {
+            e->scales_offset = offset;
+            e->num_channel_scales = t->quant.num_channels;
+            offset += (uint64_t)t->quant.num_channels * sizeof(float);
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        offset = neurax_nxt_align(offset, NEURAX_NXT_ALIGNMENT);
+        entries[i].data_offset = offset;
+        offset += entries[i].data_size;
+    }
+
+    neurax_nxt_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, NEURAX_NXT_MAGIC, sizeof(header.magic));
+    header.version = NEURAX_NXT_VERSION;
+    header.num_tensors = count;
+    header.alignment = NEURAX_NXT_ALIGNMENT;
+    header.file_size = offset;
+
+    // Header and table are encoded in one block
+    size_t table_size = NEURAX_NXT_HEADER_SIZE + (size_t)count * NEURAX_NXT_ENTRY_SIZE;
+    uint8_t* table = malloc(table_size);
+    if (!table) {
+        free(entries);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    neurax_nxt_encode_header(&header, table);
+    for (uint32_t i = 0; i < count; i++) {
+        neurax_nxt_encode_entry(&entries[i],
+                                table + NEURAX_NXT_HEADER_SIZE + (size_t)i * NEURAX_NXT_ENTRY_SIZE);
+    }
+
+    FILE* fp = fopen(filename, "wb");
+    if (!fp) {
+        NEURAX_LOG_ERROR("Cannot create tensor file %s", filename);
+        free(table);
+        free(entries);
+        return NEURAX_ERROR_IO;
+    }
+
+    // Only regular files are removed again on failure, never device nodes
+    struct stat st;
+    bool regular = fstat(fileno(fp), &st) == 0 && S_ISREG(st.st_mode);
+
+    uint64_t position = table_size;
+    bool ok = fwrite(table, 1, table_size, fp) == table_size;
+    free(table);
+
+    for (uint32_t i = 0; i < count && ok; i++) {
+        if (entries[i].num_channel_scales == 0) continue;
+        ok = fwrite(tensors[i]->quant.channel_scales, sizeof(float),
+                    entries[i].num_channel_scales, fp) == entries[i].num_channel_scales;
+        position += (uint64_t)entries[i].num_channel_scales * sizeof(float);
+    }
+    for (uint32_t i = 0; i < count && ok; i++) {
+        ok = neurax_nxt_pad(fp, &position, entries[i].data_offset) &&
+             fwrite(tensors[i]->data, 1, tensors[i]->data_size, fp) == tensors[i]->data_size;
+        position += tensors[i]->data_size;
+    }
+
+    ok = fclose(fp) == 0 && ok;
+    free(entries);
+
+    // Leave no truncated file behind to be mistaken for a complete one
+    if (!ok) {
+        NEURAX_LOG_ERROR("Failed to write tensor file %s", filename);
+        if (regular) {
+            unlink(filename);
+        }
+        return NEURAX_ERROR_IO;
+    }
+    return NEURAX_SUCCESS;
+}
+
+// Check a table entry against the mapped file
+static bool neurax_nxt_entry_valid(const neurax_nxt_entry_t* e, size_t file_size) {
+    if (e->data_type > NEURAX_DATA_BFLOAT16 || e->layout > NEURAX_LAYOUT_OIHW ||
+        e->width == 0 || e->height == 0 || e->channels == 0 || e->batch_size == 0 ||
+        memchr(e->name, '\0', sizeof(e->name)) == NULL) {
+        return false;
+    }
+    if (e->data_offset % NEURAX_NXT_ALIGNMENT != 0 || e->data_offset > file_size ||
+        e->data_size > file_size - e->data_offset) {
+        return false;
+    }
+    if (e->num_channel_scales != 0) {
+        uint64_t scales_size = (uint64_t)e->num_channel_scales * sizeof(float);
+        if (e->scales_offset % sizeof(float) != 0 || e->scales_offset > file_size ||
+            scales_size > file_size - e->scales_offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Map a .nxt file read-only
+neurax_error_t neurax_tensor_file_open(const char* filename, neurax_tensor_file_t** file) {
+    if (!filename || !file) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    if (!neurax_nxt_host_little_endian()) {
+        NEURAX_LOG_ERROR("Tensor files need a little-endian host");
+        return NEURAX_ERROR_INVALID_MODEL;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        NEURAX_LOG_ERROR("Cannot open tensor file %s", filename);
+        return NEURAX_ERROR_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NEURAX_ERROR_IO;
+    }
+    if ((size_t)st.st_size < NEURAX_NXT_HEADER_SIZE) {
+        close(fd);
+        NEURAX_LOG_ERROR("Tensor file %s is truncated", filename);
+        return NEURAX_ERROR_INVALID_MODEL;
+    }
+
+    // Pages come from the page cache, shared with other processes loading the file
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    neurax_nxt_header_t header;
+    neurax_nxt_decode_header((const uint8_t*)base, &header);
+    bool valid = memcmp(header.magic, NEURAX_NXT_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.version == NEURAX_NXT_VERSION &&
+                 header.file_size <= size &&
+                 header.num_tensors <= (size - NEURAX_NXT_HEADER_SIZE) / NEURAX_NXT_ENTRY_SIZE;
+
+    neurax_tensor_file_t* f = NULL;
+    neurax_nxt_entry_t* entries = NULL;
+    if (valid) {
+        f = calloc(1, sizeof(neurax_tensor_file_t));
+        entries = calloc(header.num_tensors ? header.num_tensors : 1, sizeof(neurax_nxt_entry_t));
+    }
+
+    const uint8_t* table = (const uint8_t*)base + NEURAX_NXT_HEADER_SIZE;
+    for (uint32_t i = 0; valid && entries && i < header.num_tensors; i++) {
+        neurax_nxt_decode_entry(table + (size_t)i * NEURAX_NXT_ENTRY_SIZE, &entries[i]);
+        valid = neurax_nxt_entry_valid(&entries[i], size);
+    }
+
+    if (!valid || !f || !entries) {
+        free(entries);
+        free(f);
+        munmap(base, size);
+        if (!valid) {
+            NEURAX_LOG_ERROR("%s is not a valid tensor file", filename);
+            return NEURAX_ERROR_INVALID_MODEL;
+        }
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    f->base = (const uint8_t*)base;
+    f->size = size;
+    f->entries = entries;
+    f->num_tensors = header.num_tensors;
+    f->refs = 1;
+
+    *file = f;
+    return NEURAX_SUCCESS;
+}
+
+// Release the handle; tensors already loaded keep the mapping alive
+neurax_error_t neurax_tensor_file_close(neurax_tensor_file_t* file) {
+    if (!file) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    neurax_tensor_file_unref(file);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_file_get_count(const neurax_tensor_file_t* file, uint32_t* count) {
+    if (!file || !count) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *count = file->num_tensors;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_file_get_name(const neurax_tensor_file_t* file, uint32_t index,
+                                          const char** name) {
+    if (!file || !name || index >= file->num_tensors) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    *name = file->entries[index].name;
+    return NEURAX_SUCCESS;
+}
+
+// Create a tensor over a payload in the mapping
+neurax_error_t neurax_tensor_file_load(neurax_tensor_file_t* file, uint32_t index,
+                                      neurax_tensor_t** tensor) {
+    if (!file || !tensor || index >= file->num_tensors) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    const neurax_nxt_entry_t* e = &file->entries[index];
+    neurax_tensor_t* t = NULL;
+    neurax_error_t error = neurax_tensor_wrap((void*)(file->base + e->data_offset), e->data_size,
+                                              e->width, e->height, e->channels, e->batch_size,
+                                              (neurax_data_type_t)e->data_type,
+                                              (neurax_layout_t)e->layout,
+                                              NEURAX_WRAP_TAKE_OWNERSHIP,
+                                              neurax_tensor_file_deleter, file, &t);
+    if (error != NEURAX_SUCCESS) return error;
+    __atomic_add_fetch(&file->refs, 1, __ATOMIC_RELAXED);
+    t->state->read_only = true;
+
+    const float* scales = e->num_channel_scales ?
+                          (const float*)(file->base + e->scales_offset) : NULL;
+    if (e->scale != 0.0f || scales) {
+        error = neurax_tensor_set_quant_params(t, e->scale, e->zero_point, scales,
+                                               e->num_channel_scales);
+        if (error != NEURAX_SUCCESS) {
+            neurax_tensor_destroy(t);
+            return error;
+        }
+    }
+
+    *tensor = t;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_tensor_file_find(neurax_tensor_file_t* file, const char* name,
+                                      neurax_tensor_t** tensor) {
+    if (!file || !name || !tensor) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < file->num_tensors; i++) {
+        if (strcmp(file->entries[i].name, name) == 0) {
+            return neurax_tensor_file_load(file, i, tensor);
+        }
+    }
+
+    NEURAX_LOG_ERROR("Tensor '%s' not found", name);
+    return NEURAX_ERROR_INVALID_PARAM;
+}
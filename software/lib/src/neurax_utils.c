@@ -4,10 +4,13 @@
  * Author: NEURAX Team
  */
 
+#define _GNU_SOURCE
 #include "neurax.h"
 #include "neurax_private.h"
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 // Tensor validation
 neurax_error_t neurax_validate_tensor(const neurax_tensor_t* tensor) {
@@ -27,9 +30,37 @@ neurax_error_t neurax_validate_tensor(const neurax_tensor_t* tensor) {
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    size_t expected_size = tensor->width * tensor->height * 
-                          tensor->channels * tensor->batch_size * 
-                          neurax_get_element_size(tensor->data_type);
+    if (tensor->layout > NEURAX_LAYOUT_OIHW) {
+        NEURAX_LOG_ERROR("Invalid tensor layout %d", tensor->layout);
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    size_t element_size = neurax_get_element_size(tensor->data_type);
+    size_t expected_size = element_size;
+    uint32_t block = neurax_layout_block_size(tensor->layout);
+    
+    if (block != 0) {
+        // Blocked tensors are always dense, with channels padded to whole blocks
+        if (tensor->strides[NEURAX_DIM_CHANNEL] != 0) {
+            NEURAX_LOG_ERROR("Blocked tensors cannot have strides");
+            return NEURAX_ERROR_INVALID_PARAM;
+        }
+        expected_size = neurax_tensor_pixel_count(tensor) *
+                        ((tensor->channels + block - 1) / block * block) * element_size;
+    } else {
+        // Views span from their first to their last element
+        size_t strides[4];
+        neurax_tensor_get_strides(tensor, strides);
+        
+        const uint32_t dims[4] = {tensor->channels, tensor->width, tensor->height, tensor->batch_size};
+        for (int d = 0; d < 4; d++) {
+            if (dims[d] > 1 && (strides[d] == 0 || strides[d] % element_size != 0)) {
+                NEURAX_LOG_ERROR("Invalid stride %zu for dimension %d", strides[d], d);
+                return NEURAX_ERROR_INVALID_PARAM;
+            }
+            expected_size += (size_t)(dims[d] - 1) * strides[d];
+        }
+    }
     
     if (tensor->data_size != expected_size) {
         NEURAX_LOG_ERROR("Tensor data size mismatch: expected %zu, got %zu", 
@@ -41,6 +72,19 @@ neurax_error_t neurax_validate_tensor(const neurax_tensor_t* tensor) {
 }
 
 // Convolution configuration validation
+// Validate a tensor an operation writes to
+neurax_error_t neurax_validate_output(const neurax_tensor_t* tensor) {
+    neurax_error_t error = neurax_validate_tensor(tensor);
+    if (error != NEURAX_SUCCESS) return error;
+    
+    if (tensor->state && tensor->state->read_only) {
+        NEURAX_LOG_ERROR("Tensor is read-only; write to a copy instead");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
 neurax_error_t neurax_validate_conv_config(const neurax_conv_config_t* config) {
     if (!config) {
         NEURAX_LOG_ERROR("Convolution config pointer is NULL");
@@ -110,6 +154,83 @@ neurax_error_t neurax_validate_pool_config(const neurax_pool_config_t* config) {
     return NEURAX_SUCCESS;
 }
 
+// Dense configuration validation
+neurax_error_t neurax_validate_dense_config(const neurax_dense_config_t* config) {
+    if (!config) {
+        NEURAX_LOG_ERROR("Dense config pointer is NULL");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->input_features == 0 || config->output_features == 0) {
+        NEURAX_LOG_ERROR("Feature count cannot be zero");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    if (config->activation > NEURAX_ACTIVATION_LINEAR) {
+        NEURAX_LOG_ERROR("Invalid activation function");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+// Layout check for operations that address tensors as flat arrays
+neurax_error_t neurax_validate_contiguous(const neurax_tensor_t* tensor) {
+    if (!neurax_tensor_is_contiguous(tensor)) {
+        NEURAX_LOG_ERROR("Operation requires a contiguous NHWC tensor");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+// Layout check for activation tensors; blocked layouts only where the kernel handles them
+neurax_error_t neurax_validate_layout(const neurax_tensor_t* tensor, bool allow_blocked) {
+    if (tensor->layout == NEURAX_LAYOUT_OIHW) {
+        NEURAX_LOG_ERROR("OIHW is a weight layout, not valid for activations");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    if (!allow_blocked && neurax_layout_block_size(tensor->layout) != 0) {
+        NEURAX_LOG_ERROR("Operation does not support blocked layouts; convert to NHWC first");
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+// Convert the channel run of one pixel to fp32, gathering when channels aren't adjacent
+void neurax_load_channels(const neurax_tensor_t* tensor, size_t byte_offset,
+                          uint32_t count, float* dst) {
+    const uint8_t* src = (const uint8_t*)tensor->data + byte_offset;
+    
+    if (neurax_tensor_channels_packed(tensor)) {
+        neurax_convert_data_type(src, tensor->data_type, dst, NEURAX_DATA_FLOAT32, count);
+        return;
+    }
+    
+    size_t stride = tensor->strides[NEURAX_DIM_CHANNEL];
+    for (uint32_t c = 0; c < count; c++) {
+        dst[c] = neurax_load_element(src + c * stride, tensor->data_type, 0);
+    }
+}
+
+// Convert fp32 values into the channel run of one pixel, scattering when needed
+void neurax_store_channels(neurax_tensor_t* tensor, size_t byte_offset,
+                           uint32_t count, const float* src) {
+    uint8_t* dst = (uint8_t*)tensor->data + byte_offset;
+    
+    if (neurax_tensor_channels_packed(tensor)) {
+        neurax_convert_data_type(src, NEURAX_DATA_FLOAT32, dst, tensor->data_type, count);
+        return;
+    }
+    
+    size_t stride = tensor->strides[NEURAX_DIM_CHANNEL];
+    for (uint32_t c = 0; c < count; c++) {
+        neurax_store_element(dst + c * stride, tensor->data_type, 0, src[c]);
+    }
+}
+
 // Optimal configuration
 neurax_error_t neurax_get_optimal_config(neurax_device_t* device, neurax_config_t* config) {
     if (!device || !config) {
@@ -258,95 +379,73 @@ cleanup:
 
 // Memory allocation with alignment
 neurax_error_t neurax_alloc_aligned(size_t size, size_t alignment, void** ptr) {
-    if (!ptr || size == 0 || alignment == 0) {
+    if (!ptr || size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0) {
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    // Use posix_memalign if available, otherwise use regular malloc
-    #ifdef _POSIX_C_SOURCE
-    if (posix_memalign(ptr, alignment, size) != 0) {
-        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    // posix_memalign needs at least pointer alignment
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
     }
-    #else
-    *ptr = malloc(size);
-    if (!*ptr) {
+    
+    if (posix_memalign(ptr, alignment, size) != 0) {
+        *ptr = NULL;
         return NEURAX_ERROR_MEMORY_ALLOCATION;
     }
-    #endif
     
     return NEURAX_SUCCESS;
 }
 
-// Free aligned memory
-neurax_error_t neurax_free_aligned(void* ptr) {
-    if (ptr) {
-        free(ptr);
+// Tensor storage: aligned, zeroed unless NO_INIT, optionally huge-page backed.
+// Released with neurax_free_aligned.
+neurax_error_t neurax_alloc_tensor_data(size_t size, size_t alignment, uint32_t flags, void** ptr) {
+    if (!ptr || size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
     }
-    return NEURAX_SUCCESS;
-}
-
-// Data type conversion
-neurax_error_t neurax_convert_data_type(const void* src, neurax_data_type_t src_type,
-                                       void* dst, neurax_data_type_t dst_type,
-                                       size_t num_elements) {
-    if (!src || !dst || num_elements == 0) {
+    
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (alignment == 0) {
+        alignment = NEURAX_TENSOR_ALIGNMENT;
+    } else if ((alignment & (alignment - 1)) != 0 || (page_size > 0 && alignment > (size_t)page_size)) {
+        NEURAX_LOG_ERROR("Tensor alignment %zu must be a power of two up to the page size", alignment);
         return NEURAX_ERROR_INVALID_PARAM;
     }
     
-    // If types are the same, just copy
-    if (src_type == dst_type) {
-        size_t element_size = neurax_get_element_size(src_type);
-        memcpy(dst, src, num_elements * element_size);
-        return NEURAX_SUCCESS;
+    // Huge pages only pay off once the buffer spans one; the size is rounded up so the
+    // tail does not share a huge page with unrelated allocations
+    bool hugepage = (flags & NEURAX_TENSOR_HUGEPAGE) && size >= NEURAX_HUGEPAGE_SIZE &&
+                    size <= SIZE_MAX - NEURAX_HUGEPAGE_SIZE;
+    if (hugepage) {
+        alignment = NEURAX_HUGEPAGE_SIZE;
+        size = (size + NEURAX_HUGEPAGE_SIZE - 1) & ~((size_t)NEURAX_HUGEPAGE_SIZE - 1);
     }
     
-    // Convert each element
-    for (size_t i = 0; i < num_elements; i++) {
-        float temp_value = 0.0f;
-        
-        // Read source value
-        switch (src_type) {
-            case NEURAX_DATA_UINT8:
-                temp_value = ((uint8_t*)src)[i];
-                break;
-            case NEURAX_DATA_INT8:
-                temp_value = ((int8_t*)src)[i];
-                break;
-            case NEURAX_DATA_UINT16:
-                temp_value = ((uint16_t*)src)[i];
-                break;
-            case NEURAX_DATA_INT16:
-                temp_value = ((int16_t*)src)[i];
-                break;
-            case NEURAX_DATA_FLOAT32:
-                temp_value = ((float*)src)[i];
-                break;
-        }
-        
-        // Write destination value
-        switch (dst_type) {
-            case NEURAX_DATA_UINT8:
-                ((uint8_t*)dst)[i] = (uint8_t)fmax(0, fmin(255, temp_value));
-                break;
-            case NEURAX_DATA_INT8:
-                ((int8_t*)dst)[i] = (int8_t)fmax(-128, fmin(127, temp_value));
-                break;
-            case NEURAX_DATA_UINT16:
-                ((uint16_t*)dst)[i] = (uint16_t)fmax(0, fmin(65535, temp_value));
-                break;
-            case NEURAX_DATA_INT16:
-                ((int16_t*)dst)[i] = (int16_t)fmax(-32768, fmin(32767, temp_value));
-                break;
-            case NEURAX_DATA_FLOAT32:
-                ((float*)dst)[i] = temp_value;
-                break;
-        }
+    neurax_error_t error = neurax_alloc_aligned(size, alignment, ptr);
+    if (error != NEURAX_SUCCESS) return error;
+    
+#ifdef MADV_HUGEPAGE
+    // Advisory only: kernels without THP support reject it and the buffer keeps normal pages
+    if (hugepage && madvise(*ptr, size, MADV_HUGEPAGE) != 0) {
+        NEURAX_LOG_DEBUG("madvise(MADV_HUGEPAGE) failed; using regular pages");
     }
+#endif
     
+    if (!(flags & NEURAX_TENSOR_NO_INIT)) {
+        memset(*ptr, 0, size);
+    }
+    
+    return NEURAX_SUCCESS;
+}
+
+// Free aligned memory
+neurax_error_t neurax_free_aligned(void* ptr) {
+    if (ptr) {
+        free(ptr);
+    }
     return NEURAX_SUCCESS;
 }
 
 size_t neurax_tensor_total_elements(const neurax_tensor_t* tensor) {
     if (!tensor) return 0;
-    return tensor->width * tensor->height * tensor->channels * tensor->batch_size;
+    return (size_t)tensor->width * tensor->height * tensor->channels * tensor->batch_size;
 }
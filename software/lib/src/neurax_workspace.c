@@ -0,0 +1,408 @@
+/*
+ * NEURAX Device Workspace
+ * Per-device bump arena for user workspace memory, and per-operation arenas
+ * for kernel scratch buffers
+ *
+ * Author: NEURAX Team
+ */
+
+#define _GNU_SOURCE
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Heap fallbacks of a device carry their size in front so the charge can be released
+#define NEURAX_SCRATCH_HEADER NEURAX_TENSOR_ALIGNMENT
+
+// Innermost scratch arena the calling thread allocates from (NULL = none)
+static pthread_key_t neurax_scratch_key;
+static pthread_once_t neurax_scratch_key_once = PTHREAD_ONCE_INIT;
+
+static void neurax_scratch_make_key(void) {
+    pthread_key_create(&neurax_scratch_key, NULL);
+}
+
+// Round up to the arena alignment
+static inline size_t neurax_workspace_align(size_t size) {
+    return (size + NEURAX_TENSOR_ALIGNMENT - 1) & ~((size_t)NEURAX_TENSOR_ALIGNMENT - 1);
+}
+
+// Replace an empty arena's storage with at least `size` bytes, charged to the device
+// as scratch memory. Caller holds the workspace lock.
+static neurax_error_t neurax_workspace_grow(neurax_device_t* device, uint8_t** base,
+                                            size_t* capacity, size_t size) {
+    size = neurax_workspace_align(size);
+
+    // Charge the growth only, since the old storage is released right after
+    neurax_error_t error = neurax_memory_charge(device, NEURAX_MEMORY_SCRATCH, size - *capacity);
+    if (error != NEURAX_SUCCESS) return error;
+
+    void* storage = NULL;
+    error = neurax_alloc_aligned(size, NEURAX_TENSOR_ALIGNMENT, &storage);
+    if (error != NEURAX_SUCCESS) {
+        neurax_memory_uncharge(device, NEURAX_MEMORY_SCRATCH, size - *capacity);
+        return error;
+    }
+
+    neurax_free_aligned(*base);
+    *base = (uint8_t*)storage;
+    *capacity = size;
+    return NEURAX_SUCCESS;
+}
+
+// Record the bytes held right now in the peak. Caller holds the workspace lock.
+static void neurax_workspace_sample_peak(neurax_workspace_t* ws) {
+    size_t total = ws->used;
+    for (const neurax_scratch_arena_t* a = ws->arenas; a; a = a->next) {
+        total += __atomic_load_n(&a->used, __ATOMIC_RELAXED);
+    }
+    if (total > ws->peak) {
+        ws->peak = total;
+    }
+}
+
+// Arena of `device` the calling thread allocates from: its innermost one for that device
+static neurax_scratch_arena_t* neurax_scratch_find(neurax_device_t* device) {
+    pthread_once(&neurax_scratch_key_once, neurax_scratch_make_key);
+
+    neurax_scratch_arena_t* arena = (neurax_scratch_arena_t*)pthread_getspecific(neurax_scratch_key);
+    while (arena && arena->device != device) {
+        arena = arena->outer;
+    }
+    return arena;
+}
+
+// Bump-allocate from an arena without a lock, or return NULL when it is full
+static void* neurax_scratch_bump(neurax_scratch_arena_t* arena, size_t size) {
+    size = neurax_workspace_align(size);
+    __atomic_add_fetch(&arena->demand, size, __ATOMIC_RELAXED);
+
+    size_t used = __atomic_load_n(&arena->used, __ATOMIC_RELAXED);
+    do {
+        if (size > arena->size - used) {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&arena->used, &used, used + size, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    return arena->base + used;
+}
+
+// Take an idle arena for an operation, sized to the largest scratch demand seen
+static neurax_scratch_arena_t* neurax_scratch_take(neurax_device_t* device) {
+    neurax_workspace_t* ws = &device->workspace;
+
+    pthread_mutex_lock(&ws->lock);
+    neurax_scratch_arena_t* arena = ws->arenas;
+    while (arena && arena->busy) {
+        arena = arena->next;
+    }
+    if (!arena) {
+        arena = calloc(1, sizeof(neurax_scratch_arena_t));
+        if (!arena) {
+            pthread_mutex_unlock(&ws->lock);
+            return NULL;
+        }
+        arena->device = device;
+        arena->next = ws->arenas;
+        ws->arenas = arena;
+    }
+    if (ws->scratch_high_water > arena->size &&
+        neurax_workspace_grow(device, &arena->base, &arena->size,
+                              ws->scratch_high_water) != NEURAX_SUCCESS) {
+        NEURAX_LOG_DEBUG("Scratch arena growth to %zu bytes failed", ws->scratch_high_water);
+    }
+    arena->busy = true;
+    __atomic_store_n(&arena->used, 0, __ATOMIC_RELAXED);
+    arena->demand = 0;
+    pthread_mutex_unlock(&ws->lock);
+
+    return arena;
+}
+
+neurax_error_t neurax_workspace_init(neurax_workspace_t* ws) {
+    memset(ws, 0, sizeof(*ws));
+    if (pthread_mutex_init(&ws->lock, NULL) != 0) {
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+    return NEURAX_SUCCESS;
+}
+
+// Release the user arena and every scratch arena, with their charges
+void neurax_workspace_destroy(neurax_device_t* device) {
+    neurax_workspace_t* ws = &device->workspace;
+
+    neurax_memory_uncharge(device, NEURAX_MEMORY_SCRATCH, ws->size);
+    neurax_free_aligned(ws->base);
+    while (ws->arenas) {
+        neurax_scratch_arena_t* arena = ws->arenas;
+        ws->arenas = arena->next;
+        neurax_memory_uncharge(device, NEURAX_MEMORY_SCRATCH, arena->size);
+        neurax_free_aligned(arena->base);
+        free(arena);
+    }
+    pthread_mutex_destroy(&ws->lock);
+    memset(ws, 0, sizeof(*ws));
+}
+
+// Scratch memory for a kernel: the operation's arena when it fits, the heap otherwise.
+// Safe to call from worker threads; `device` may be NULL for device-less callers.
+// Returns NULL when the heap fallback fails or would exceed the memory budget.
+void* neurax_scratch_alloc(neurax_device_t* device, size_t size) {
+    if (!device) {
+        return malloc(size);
+    }
+
+    neurax_scratch_arena_t* arena = neurax_scratch_find(device);
+    void* ptr = arena ? neurax_scratch_bump(arena, size) : NULL;
+    if (ptr) {
+        return ptr;
+    }
+    __atomic_add_fetch(&device->workspace.fallback_allocs, 1, __ATOMIC_RELAXED);
+
+    if (size > SIZE_MAX - NEURAX_SCRATCH_HEADER ||
+        neurax_memory_charge(device, NEURAX_MEMORY_SCRATCH, size) != NEURAX_SUCCESS) {
+        return NULL;
+    }
+    void* block = NULL;
+    if (neurax_alloc_aligned(NEURAX_SCRATCH_HEADER + size, NEURAX_TENSOR_ALIGNMENT, &block) != NEURAX_SUCCESS) {
+        neurax_memory_uncharge(device, NEURAX_MEMORY_SCRATCH, size);
+        return NULL;
+    }
+    *(size_t*)block = size;
+    return (uint8_t*)block + NEURAX_SCRATCH_HEADER;
+}
+
+// Release scratch memory; arena memory is reclaimed by neurax_scratch_release instead
+void neurax_scratch_free(neurax_device_t* device, void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    if (!device) {
+        free(ptr);
+        return;
+    }
+
+    neurax_scratch_arena_t* arena = neurax_scratch_find(device);
+    const uint8_t* p = (const uint8_t*)ptr;
+    if (arena && arena->base && p >= arena->base && p < arena->base + arena->size) {
+        return;
+    }
+    uint8_t* block = (uint8_t*)ptr - NEURAX_SCRATCH_HEADER;
+    neurax_memory_uncharge(device, NEURAX_MEMORY_SCRATCH, *(size_t*)block);
+    neurax_free_aligned(block);
+}
+
+// Start an operation's scratch use and return the position to release back to.
+// A thread's outermost mark takes an arena of its own, so other threads' operations
+// on the same device run alongside it.
+size_t neurax_scratch_mark(neurax_device_t* device) {
+    if (!device) {
+        return 0;
+    }
+
+    neurax_scratch_arena_t* arena = neurax_scratch_find(device);
+    if (arena && pthread_equal(arena->owner, pthread_self())) {
+        arena->depth++;
+        return __atomic_load_n(&arena->used, __ATOMIC_RELAXED);
+    }
+
+    // Without an arena the operation's scratch comes from the heap
+    arena = neurax_scratch_take(device);
+    if (!arena) {
+        return 0;
+    }
+    arena->owner = pthread_self();
+    arena->depth = 1;
+    arena->outer = (neurax_scratch_arena_t*)pthread_getspecific(neurax_scratch_key);
+    pthread_setspecific(neurax_scratch_key, arena);
+    return 0;
+}
+
+// Drop everything allocated since `mark`. The outermost release hands the arena back
+// and records the operation's demand, so the next one of the same shape stays off
+// the heap. The operation's parallel work has finished by now.
+void neurax_scratch_release(neurax_device_t* device, size_t mark) {
+    if (!device) {
+        return;
+    }
+
+    neurax_scratch_arena_t* arena = neurax_scratch_find(device);
+    if (!arena || !pthread_equal(arena->owner, pthread_self())) {
+        return;
+    }
+
+    neurax_workspace_t* ws = &device->workspace;
+    pthread_mutex_lock(&ws->lock);
+    neurax_workspace_sample_peak(ws);
+    if (arena->demand > ws->scratch_high_water) {
+        ws->scratch_high_water = arena->demand;
+    }
+    __atomic_store_n(&arena->used, mark, __ATOMIC_RELAXED);
+    arena->demand = mark;
+    if (--arena->depth == 0) {
+        arena->busy = false;
+        pthread_setspecific(neurax_scratch_key, arena->outer);
+        arena->outer = NULL;
+    }
+    pthread_mutex_unlock(&ws->lock);
+}
+
+void* neurax_scratch_context(void) {
+    pthread_once(&neurax_scratch_key_once, neurax_scratch_make_key);
+    return pthread_getspecific(neurax_scratch_key);
+}
+
+// Let a worker thread allocate from the scratch arenas of the thread it works for
+void neurax_scratch_set_context(void* context) {
+    pthread_once(&neurax_scratch_key_once, neurax_scratch_make_key);
+    pthread_setspecific(neurax_scratch_key, context);
+}
+
+// Public API
+
+neurax_error_t neurax_workspace_reserve(neurax_device_t* device, size_t size) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_workspace_t* ws = &device->workspace;
+    neurax_error_t error = NEURAX_SUCCESS;
+
+    // Scratch arenas pick the size up the next time an operation takes one
+    pthread_mutex_lock(&ws->lock);
+    if (size > ws->scratch_high_water) {
+        ws->scratch_high_water = size;
+    }
+    if (size > ws->size) {
+        if (ws->used != 0) {
+            NEURAX_LOG_ERROR("Cannot grow the workspace while it holds allocations");
+            error = NEURAX_ERROR_INVALID_PARAM;
+        } else {
+            error = neurax_workspace_grow(device, &ws->base, &ws->size, size);
+        }
+    }
+    pthread_mutex_unlock(&ws->lock);
+
+    return error;
+}
+
+neurax_error_t neurax_workspace_alloc(neurax_device_t* device, size_t size, void** ptr) {
+    if (!ptr || size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    neurax_workspace_t* ws = &device->workspace;
+    size_t aligned = neurax_workspace_align(size);
+
+    pthread_mutex_lock(&ws->lock);
+    ws->demand += aligned;
+    if (ws->demand > ws->high_water) {
+        ws->high_water = ws->demand;
+    }
+    size_t used = ws->used;
+    size_t capacity = ws->size;
+    *ptr = NULL;
+    if (aligned <= capacity - used) {
+        *ptr = ws->base + used;
+        ws->used += aligned;
+        neurax_workspace_sample_peak(ws);
+    }
+    pthread_mutex_unlock(&ws->lock);
+
+    if (!*ptr) {
+        NEURAX_LOG_ERROR("Workspace exhausted: %zu of %zu bytes used, %zu requested",
+                         used, capacity, size);
+        return NEURAX_ERROR_MEMORY_ALLOCATION;
+    }
+
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_workspace_tensor(neurax_device_t* device,
+                                      uint32_t width, uint32_t height,
+                                      uint32_t channels, uint32_t batch_size,
+                                      neurax_data_type_t data_type,
+                                      neurax_tensor_t** tensor) {
+    if (!tensor || width == 0 || height == 0 || channels == 0 || batch_size == 0) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+
+    size_t data_size;
+    neurax_error_t error = neurax_tensor_compute_size(width, height, channels, batch_size,
+                                                      data_type, NEURAX_LAYOUT_NHWC, &data_size);
+    if (error != NEURAX_SUCCESS) return error;
+    size_t header_size = neurax_workspace_align(sizeof(neurax_tensor_block_t));
+    if (data_size > SIZE_MAX - header_size) {
+        return NEURAX_ERROR_BUFFER_OVERFLOW;
+    }
+
+    void* block = NULL;
+    error = neurax_workspace_alloc(device, header_size + data_size, &block);
+    if (error != NEURAX_SUCCESS) return error;
+
+    // Header and data share one block; neither is freed until the workspace is reset
+    neurax_tensor_block_t* header = (neurax_tensor_block_t*)block;
+    memset(header, 0, sizeof(*header));
+    neurax_tensor_t* t = &header->tensor;
+    t->state = &header->state;
+    t->data = (uint8_t*)block + header_size;
+    t->width = width;
+    t->height = height;
+    t->channels = channels;
+    t->batch_size = batch_size;
+    t->data_type = data_type;
+    t->data_size = data_size;
+    t->layout = NEURAX_LAYOUT_NHWC;
+    t->state->in_workspace = true;
+
+    *tensor = t;
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_workspace_reset(neurax_device_t* device) {
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Once empty, the user arena is regrown to the largest demand seen
+    neurax_workspace_t* ws = &device->workspace;
+    pthread_mutex_lock(&ws->lock);
+    ws->used = 0;
+    ws->demand = 0;
+    if (ws->high_water > ws->size &&
+        neurax_workspace_grow(device, &ws->base, &ws->size, ws->high_water) != NEURAX_SUCCESS) {
+        NEURAX_LOG_DEBUG("Workspace growth to %zu bytes failed", ws->high_water);
+    }
+    pthread_mutex_unlock(&ws->lock);
+    return NEURAX_SUCCESS;
+}
+
+neurax_error_t neurax_workspace_get_stats(neurax_device_t* device, neurax_workspace_stats_t* stats) {
+    if (!stats) {
+        return NEURAX_ERROR_INVALID_PARAM;
+    }
+    if (!device || !device->initialized) {
+        return NEURAX_ERROR_NOT_INITIALIZED;
+    }
+
+    // Scratch arenas count with the user arena; the high water is what one
+    // operation's scratch needs on top of the user allocations
+    neurax_workspace_t* ws = &device->workspace;
+    pthread_mutex_lock(&ws->lock);
+    stats->size = ws->size;
+    stats->used = ws->used;
+    for (const neurax_scratch_arena_t* a = ws->arenas; a; a = a->next) {
+        stats->size += a->size;
+        stats->used += __atomic_load_n(&a->used, __ATOMIC_RELAXED);
+    }
+    stats->peak = ws->peak;
+    stats->high_water = ws->high_water + ws->scratch_high_water;
+    stats->fallback_allocs = __atomic_load_n(&ws->fallback_allocs, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ws->lock);
+
+    return NEURAX_SUCCESS;
+}
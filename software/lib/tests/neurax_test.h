@@ -0,0 +1,111 @@
+/*
+ * NEURAX Library Tests
+ * Check macros and tensor helpers shared by the test programs
+ *
+ * Author: NEURAX Team
+ */
+
+#ifndef NEURAX_TEST_H
+#define NEURAX_TEST_H
+
+#include "neurax.h"
+#include "neurax_private.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int neurax_test_failures = 0;
+
+// Record a failed condition and keep going, so one run reports every failure
+#define NEURAX_CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        neurax_test_failures++; \
+    } \
+} while (0)
+
+#define NEURAX_CHECK_OK(expr) do { \
+    neurax_error_t neurax_check_error = (expr); \
+    if (neurax_check_error != NEURAX_SUCCESS) { \
+        fprintf(stderr, "%s:%d: %s returned %d (%s)\n", __FILE__, __LINE__, #expr, \
+                (int)neurax_check_error, neurax_get_error_string(neurax_check_error)); \
+        neurax_test_failures++; \
+    } \
+} while (0)
+
+// Exit status of a test program
+static inline int neurax_test_result(const char* name) {
+    if (neurax_test_failures != 0) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, neurax_test_failures);
+        return 1;
+    }
+    printf("%s: passed\n", name);
+    return 0;
+}
+
+static inline size_t neurax_test_element_size(neurax_data_type_t type) {
+    switch (type) {
+        case NEURAX_DATA_INT8:
+        case NEURAX_DATA_UINT8:
+            return 1;
+        case NEURAX_DATA_INT16:
+        case NEURAX_DATA_UINT16:
+        case NEURAX_DATA_FLOAT16:
+        case NEURAX_DATA_BFLOAT16:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+// Deterministic contents for the whole data buffer of a tensor, blocked padding included
+static inline void neurax_test_fill(neurax_tensor_t* tensor, uint32_t seed) {
+    uint32_t state = seed * 2654435761u + 1;
+    size_t element_size = neurax_test_element_size(tensor->data_type);
+    size_t count = tensor->data_size / element_size;
+
+    for (size_t i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        int32_t value = (int32_t)(state >> 24) - 128;
+        switch (tensor->data_type) {
+            case NEURAX_DATA_FLOAT32:
+                ((float*)tensor->data)[i] = (float)value / 64.0f;
+                break;
+            case NEURAX_DATA_INT8:
+                ((int8_t*)tensor->data)[i] = (int8_t)value;
+                break;
+            case NEURAX_DATA_UINT8:
+                ((uint8_t*)tensor->data)[i] = (uint8_t)(value + 128);
+                break;
+            case NEURAX_DATA_INT16:
+                ((int16_t*)tensor->data)[i] = (int16_t)(value * 37);
+                break;
+            case NEURAX_DATA_UINT16:
+                ((uint16_t*)tensor->data)[i] = (uint16_t)((value + 128) * 37);
+                break;
+            default:
+                memset(tensor->data, 0, tensor->data_size);
+                return;
+        }
+    }
+}
+
+static inline bool neurax_test_same(const neurax_tensor_t* a, const neurax_tensor_t* b) {
+    return a->data_size == b->data_size && memcmp(a->data, b->data, a->data_size) == 0;
+}
+
+// Element (n, y, x, c) as float, whatever the layout and strides
+static inline float neurax_test_get(const neurax_tensor_t* tensor, uint32_t n, uint32_t y,
+                                    uint32_t x, uint32_t c) {
+    return neurax_load_element((const uint8_t*)tensor->data +
+                               neurax_tensor_byte_offset(tensor, n, y, x, c),
+                               tensor->data_type, 0);
+}
+
+static inline void neurax_test_set(neurax_tensor_t* tensor, uint32_t n, uint32_t y,
+                                   uint32_t x, uint32_t c, float value) {
+    neurax_store_element((uint8_t*)tensor->data + neurax_tensor_byte_offset(tensor, n, y, x, c),
+                         tensor->data_type, 0, value);
+}
+
+#endif // NEURAX_TEST_H
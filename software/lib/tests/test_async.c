@@ -0,0 +1,142 @@
+/*
+ * NEURAX Library Tests
+ * Asynchronous submission: ordering, callbacks, fences and error results
+ *
+ * Author: NEURAX Team
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "neurax_test.h"
+#include <unistd.h>
+
+#define JOBS 8
+
+static int completions[JOBS + 8];
+static int completed = 0;
+
+// Callbacks run on the queue worker; store the job tag, negated on failure
+static void on_complete(neurax_error_t result, void* user_data) {
+    int tag = (int)(intptr_t)user_data;
+    int slot = __atomic_fetch_add(&completed, 1, __ATOMIC_SEQ_CST);
+    completions[slot] = result == NEURAX_SUCCESS ? tag : -tag;
+}
+
+// A callback that tries to wait for its own device, then queues follow-up work
+typedef struct {
+    neurax_device_t* device;
+    const neurax_tensor_t* input;
+    neurax_tensor_t* output;
+    neurax_error_t finish;
+    neurax_error_t wait;
+    neurax_error_t cleanup;
+    neurax_error_t submit;
+} reentrant_t;
+
+static void on_complete_reentrant(neurax_error_t result, void* user_data) {
+    reentrant_t* r = (reentrant_t*)user_data;
+    neurax_fence_t* fence = NULL;
+    (void)result;
+    r->finish = neurax_finish(r->device);
+    r->submit = neurax_activation_async(r->device, r->input, NEURAX_ACTIVATION_RELU, r->output,
+                                        on_complete, (void*)(intptr_t)(JOBS + 3), &fence);
+    if (r->submit == NEURAX_SUCCESS) {
+        r->wait = neurax_fence_wait(fence);
+        neurax_fence_destroy(fence);
+    }
+    r->cleanup = neurax_cleanup(r->device);
+}
+
+int main(void) {
+    neurax_config_t config;
+    neurax_device_t* device = NULL;
+    neurax_tensor_t *input, *weights, *reference, *outputs[JOBS], *activated;
+    neurax_fence_t* fences[JOBS];
+    neurax_conv_config_t conv = {3, 3, 1, 1, 1, 1, 3, 8, false, NEURAX_ACTIVATION_RELU};
+
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    NEURAX_CHECK_OK(neurax_tensor_create(40, 30, 3, 1, NEURAX_DATA_INT8, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 3, 8, NEURAX_DATA_INT8,
+                                                NEURAX_LAYOUT_OIHW, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create(40, 30, 8, 1, NEURAX_DATA_INT8, &reference));
+    NEURAX_CHECK_OK(neurax_tensor_create(40, 30, 3, 1, NEURAX_DATA_INT8, &activated));
+    neurax_test_fill(input, 1);
+    neurax_test_fill(weights, 2);
+    NEURAX_CHECK_OK(neurax_conv2d(device, input, weights, NULL, &conv, reference));
+
+    // Jobs complete in submission order with the synchronous result
+    for (int j = 0; j < JOBS; j++) {
+        NEURAX_CHECK_OK(neurax_tensor_create(40, 30, 8, 1, NEURAX_DATA_INT8, &outputs[j]));
+        NEURAX_CHECK_OK(neurax_conv2d_async(device, input, weights, NULL, &conv, outputs[j],
+                                            on_complete, (void*)(intptr_t)(j + 1), &fences[j]));
+    }
+    for (int j = 0; j < JOBS; j++) {
+        bool signaled = false;
+        NEURAX_CHECK_OK(neurax_fence_wait(fences[j]));
+        NEURAX_CHECK_OK(neurax_fence_poll(fences[j], &signaled));
+        NEURAX_CHECK(signaled);
+        NEURAX_CHECK(neurax_test_same(outputs[j], reference));
+        NEURAX_CHECK_OK(neurax_fence_destroy(fences[j]));
+    }
+    NEURAX_CHECK(completed == JOBS);
+    for (int j = 0; j < completed && j < JOBS; j++) {
+        NEURAX_CHECK(completions[j] == j + 1);
+    }
+
+    // A failing job reports its error through both the callback and the fence
+    neurax_fence_t* fence = NULL;
+    neurax_conv_config_t mismatched = conv;
+    mismatched.output_channels = 4;
+    NEURAX_CHECK_OK(neurax_conv2d_async(device, input, weights, NULL, &mismatched, outputs[0],
+                                        on_complete, (void*)(intptr_t)(JOBS + 1), &fence));
+    NEURAX_CHECK(neurax_fence_wait(fence) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_fence_destroy(fence));
+    NEURAX_CHECK(completions[JOBS] == -(JOBS + 1));
+
+    // Fences released before their job runs, and jobs without a fence, still complete
+    for (int j = 0; j < 4; j++) {
+        NEURAX_CHECK_OK(neurax_activation_async(device, input, NEURAX_ACTIVATION_RELU, activated,
+                                                NULL, NULL, &fence));
+        NEURAX_CHECK_OK(neurax_fence_destroy(fence));
+    }
+    NEURAX_CHECK_OK(neurax_activation_async(device, input, NEURAX_ACTIVATION_RELU, activated,
+                                            on_complete, (void*)(intptr_t)(JOBS + 2), NULL));
+    NEURAX_CHECK_OK(neurax_finish(device));
+    NEURAX_CHECK(completed == JOBS + 2);
+    NEURAX_CHECK(completions[JOBS + 1] == JOBS + 2);
+
+    // Waiting on the own device from a callback fails instead of deadlocking;
+    // work queued there still runs. alarm() turns a deadlock into a failure.
+    reentrant_t reentrant = {device, input, activated, NEURAX_SUCCESS, NEURAX_SUCCESS,
+                             NEURAX_SUCCESS, NEURAX_ERROR_INVALID_PARAM};
+    alarm(10);
+    NEURAX_CHECK_OK(neurax_activation_async(device, input, NEURAX_ACTIVATION_RELU, activated,
+                                            on_complete_reentrant, &reentrant, &fence));
+    NEURAX_CHECK_OK(neurax_fence_wait(fence));
+    NEURAX_CHECK_OK(neurax_fence_destroy(fence));
+    NEURAX_CHECK_OK(neurax_finish(device));
+    alarm(0);
+    NEURAX_CHECK(reentrant.finish == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(reentrant.submit);
+    NEURAX_CHECK(reentrant.wait == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(reentrant.cleanup == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(completed == JOBS + 3);
+    NEURAX_CHECK(completions[JOBS + 2] == JOBS + 3);
+
+    // Cleanup runs the work still queued
+    NEURAX_CHECK_OK(neurax_activation_async(device, input, NEURAX_ACTIVATION_RELU, activated,
+                                            on_complete, (void*)(intptr_t)(JOBS + 4), NULL));
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+    NEURAX_CHECK(completed == JOBS + 4);
+
+    for (int j = 0; j < JOBS; j++) {
+        neurax_tensor_destroy(outputs[j]);
+    }
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(reference);
+    neurax_tensor_destroy(activated);
+
+    return neurax_test_result("test_async");
+}
@@ -0,0 +1,146 @@
+/*
+ * NEURAX Library Tests
+ * Batch normalization against its formula, and folding into convolution
+ * weights giving the same result as convolution followed by batch norm
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+
+#define C 6
+
+static neurax_tensor_t* channel_vector(const float* values) {
+    neurax_tensor_t* tensor = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create(C, 1, 1, 1, NEURAX_DATA_FLOAT32, &tensor));
+    memcpy(tensor->data, values, sizeof(float) * C);
+    return tensor;
+}
+
+static float max_difference(const neurax_tensor_t* a, const neurax_tensor_t* b) {
+    float worst = 0.0f;
+    size_t count = a->data_size / sizeof(float);
+    for (size_t i = 0; i < count; i++) {
+        float d = fabsf(((const float*)a->data)[i] - ((const float*)b->data)[i]);
+        worst = d > worst ? d : worst;
+    }
+    return worst;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    const float gamma_v[C] = {1.0f, 0.5f, 2.0f, -1.0f, 0.25f, 3.0f};
+    const float beta_v[C] = {0.0f, 1.0f, -2.0f, 0.5f, 0.0f, -0.25f};
+    const float mean_v[C] = {0.0f, -1.0f, 0.5f, 2.0f, 0.125f, -0.75f};
+    const float variance_v[C] = {1.0f, 4.0f, 0.25f, 0.0f, 9.0f, 2.0f};
+    neurax_tensor_t* gamma = channel_vector(gamma_v);
+    neurax_tensor_t* beta = channel_vector(beta_v);
+    neurax_tensor_t* mean = channel_vector(mean_v);
+    neurax_tensor_t* variance = channel_vector(variance_v);
+
+    // Inference batch norm, with and without the optional gamma and beta
+    neurax_tensor_t *input, *output;
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, C, 2, NEURAX_DATA_FLOAT32, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, C, 2, NEURAX_DATA_FLOAT32, &output));
+    neurax_test_fill(input, 1);
+    neurax_batch_norm_params_t variants[2] = {
+        {gamma, beta, mean, variance, 1e-3f},
+        {NULL, NULL, mean, variance, 1e-3f},
+    };
+    for (int v = 0; v < 2; v++) {
+        NEURAX_CHECK_OK(neurax_batch_norm(device, input, &variants[v], output));
+        bool close = true;
+        for (size_t i = 0; i < input->data_size / sizeof(float); i++) {
+            uint32_t c = (uint32_t)(i % C);
+            double g = v == 0 ? gamma_v[c] : 1.0, b = v == 0 ? beta_v[c] : 0.0;
+            double x = ((float*)input->data)[i];
+            double expected = g * (x - mean_v[c]) / sqrt(variance_v[c] + 1e-3) + b;
+            close = close && fabs(((float*)output->data)[i] - expected) <= 1e-4 * (1 + fabs(expected));
+        }
+        NEURAX_CHECK(close);
+    }
+
+    // In place gives the same result
+    neurax_tensor_t* in_place;
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, C, 2, NEURAX_DATA_FLOAT32, &in_place));
+    memcpy(in_place->data, input->data, input->data_size);
+    NEURAX_CHECK_OK(neurax_batch_norm(device, in_place, &variants[1], in_place));
+    NEURAX_CHECK(neurax_test_same(in_place, output));
+
+    // Parameters with too few channels, or a negative epsilon, are refused
+    neurax_tensor_t* short_mean;
+    NEURAX_CHECK_OK(neurax_tensor_create(C - 1, 1, 1, 1, NEURAX_DATA_FLOAT32, &short_mean));
+    neurax_batch_norm_params_t bad = {NULL, NULL, short_mean, variance, 1e-3f};
+    NEURAX_CHECK(neurax_batch_norm(device, input, &bad, output) == NEURAX_ERROR_INVALID_PARAM);
+    bad.mean = mean;
+    bad.epsilon = -1.0f;
+    NEURAX_CHECK(neurax_batch_norm(device, input, &bad, output) == NEURAX_ERROR_INVALID_PARAM);
+
+    // Folding: conv with folded weights and bias matches conv then batch norm,
+    // whether the fold creates the bias or rewrites an existing one
+    neurax_conv_config_t conv = {3, 3, 1, 1, 1, 1, 4, C, true, NEURAX_ACTIVATION_LINEAR};
+    neurax_tensor_t *image, *weights, *folded, *bias, *conv_out, *expected, *actual;
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 4, 1, NEURAX_DATA_FLOAT32, &image));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 4, C, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 4, C, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &folded));
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, C, 1, NEURAX_DATA_FLOAT32, &conv_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, C, 1, NEURAX_DATA_FLOAT32, &expected));
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, C, 1, NEURAX_DATA_FLOAT32, &actual));
+    neurax_test_fill(image, 2);
+    neurax_test_fill(weights, 3);
+
+    for (int with_bias = 0; with_bias < 2; with_bias++) {
+        const float bias_v[C] = {0.5f, -0.5f, 1.0f, 0.0f, 2.0f, -1.5f};
+        neurax_tensor_t* original_bias = with_bias ? channel_vector(bias_v) : NULL;
+        conv.use_bias = with_bias;
+        NEURAX_CHECK_OK(neurax_conv2d(device, image, weights, original_bias, &conv, conv_out));
+        NEURAX_CHECK_OK(neurax_batch_norm(device, conv_out, &variants[0], expected));
+        NEURAX_CHECK(max_difference(conv_out, expected) > 0.1f);
+
+        memcpy(folded->data, weights->data, weights->data_size);
+        bias = with_bias ? channel_vector(bias_v) : NULL;
+        NEURAX_CHECK_OK(neurax_fold_batch_norm(folded, &bias, &variants[0]));
+        NEURAX_CHECK(bias != NULL);
+        conv.use_bias = true;
+        NEURAX_CHECK_OK(neurax_conv2d(device, image, folded, bias, &conv, actual));
+        NEURAX_CHECK(max_difference(actual, expected) < 1e-4f);
+
+        neurax_tensor_destroy(bias);
+        neurax_tensor_destroy(original_bias);
+    }
+
+    // Quantized weights can't be folded
+    neurax_tensor_t* int8_weights;
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 4, C, NEURAX_DATA_INT8,
+                                                NEURAX_LAYOUT_OIHW, &int8_weights));
+    bias = NULL;
+    NEURAX_CHECK(neurax_fold_batch_norm(int8_weights, &bias, &variants[0]) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(bias == NULL);
+
+    neurax_tensor_destroy(int8_weights);
+    neurax_tensor_destroy(image);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(folded);
+    neurax_tensor_destroy(conv_out);
+    neurax_tensor_destroy(expected);
+    neurax_tensor_destroy(actual);
+    neurax_tensor_destroy(short_mean);
+    neurax_tensor_destroy(in_place);
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(output);
+    neurax_tensor_destroy(gamma);
+    neurax_tensor_destroy(beta);
+    neurax_tensor_destroy(mean);
+    neurax_tensor_destroy(variance);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_batch_norm");
+}
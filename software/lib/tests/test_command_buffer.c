@@ -0,0 +1,148 @@
+/*
+ * NEURAX Library Tests
+ * Command buffers: recorded chains match the same operations run one by one
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+
+typedef struct {
+    neurax_tensor_t* input;
+    neurax_tensor_t* weights;
+    neurax_tensor_t* bias;
+    neurax_tensor_t* conv_out;
+    neurax_tensor_t* pooled;
+    neurax_tensor_t* activated;
+} network_t;
+
+static const neurax_conv_config_t conv = {3, 3, 1, 1, 1, 1, 3, 6, true, NEURAX_ACTIVATION_LINEAR};
+static const neurax_pool_config_t pool = {2, 2, 2, 2, NEURAX_POOL_MAX};
+
+static void create_network(neurax_device_t* device, network_t* net) {
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 20, 16, 3, 2, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_NHWC, &net->input));
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 3, 3, 3, 6, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_OIHW, &net->weights));
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 6, 1, 1, 1, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_NHWC, &net->bias));
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 20, 16, 6, 2, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_NHWC, &net->conv_out));
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 10, 8, 6, 2, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_NHWC, &net->pooled));
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 10, 8, 6, 2, NEURAX_DATA_INT8,
+                                             NEURAX_LAYOUT_NHWC, &net->activated));
+    neurax_test_fill(net->input, 1);
+    neurax_test_fill(net->weights, 2);
+    neurax_test_fill(net->bias, 3);
+}
+
+static void destroy_network(network_t* net) {
+    neurax_tensor_destroy(net->input);
+    neurax_tensor_destroy(net->weights);
+    neurax_tensor_destroy(net->bias);
+    neurax_tensor_destroy(net->conv_out);
+    neurax_tensor_destroy(net->pooled);
+    neurax_tensor_destroy(net->activated);
+}
+
+static void record_network(neurax_command_buffer_t* cmd, const network_t* net) {
+    NEURAX_CHECK_OK(neurax_command_buffer_conv2d(cmd, net->input, net->weights, net->bias,
+                                                 &conv, net->conv_out));
+    NEURAX_CHECK_OK(neurax_command_buffer_pooling(cmd, net->conv_out, &pool, net->pooled));
+    NEURAX_CHECK_OK(neurax_command_buffer_activation(cmd, net->pooled, NEURAX_ACTIVATION_RELU,
+                                                     net->activated));
+}
+
+static bool same_results(const network_t* a, const network_t* b) {
+    return neurax_test_same(a->conv_out, b->conv_out) && neurax_test_same(a->pooled, b->pooled) &&
+           neurax_test_same(a->activated, b->activated);
+}
+
+int main(void) {
+    neurax_config_t sim_config, cpu_config;
+    neurax_device_t *sim, *cpu;
+    network_t reference, chained, fallback;
+    neurax_command_buffer_t *cmd, *small, *cpu_cmd;
+
+    memset(&sim_config, 0, sizeof(sim_config));
+    sim_config.use_hardware = true;
+    sim_config.use_simulator = true;
+    memset(&cpu_config, 0, sizeof(cpu_config));
+    NEURAX_CHECK_OK(neurax_init(&sim_config, &sim));
+    NEURAX_CHECK_OK(neurax_init(&cpu_config, &cpu));
+
+    // Operations one by one on the CPU
+    create_network(cpu, &reference);
+    NEURAX_CHECK_OK(neurax_conv2d(cpu, reference.input, reference.weights, reference.bias,
+                                  &conv, reference.conv_out));
+    NEURAX_CHECK_OK(neurax_pooling(cpu, reference.conv_out, &pool, reference.pooled));
+    NEURAX_CHECK_OK(neurax_activation(cpu, reference.pooled, NEURAX_ACTIVATION_RELU,
+                                      reference.activated));
+
+    // One descriptor chain on the simulator: one run per image for conv and pooling,
+    // one for the activation
+    create_network(sim, &chained);
+    NEURAX_CHECK_OK(neurax_command_buffer_create(sim, 16, &cmd));
+    record_network(cmd, &chained);
+    NEURAX_CHECK_OK(neurax_simulator_reset_stats(sim));
+    NEURAX_CHECK_OK(neurax_command_buffer_submit(cmd));
+    NEURAX_CHECK(same_results(&chained, &reference));
+
+    neurax_perf_estimate_t stats;
+    NEURAX_CHECK_OK(neurax_simulator_get_stats(sim, &stats));
+    NEURAX_CHECK(stats.runs == 5);
+
+    // A recorded chain can be submitted again
+    memset(chained.activated->data, 0, chained.activated->data_size);
+    NEURAX_CHECK_OK(neurax_command_buffer_submit(cmd));
+    NEURAX_CHECK(neurax_test_same(chained.activated, reference.activated));
+
+    // A failing descriptor stops the chain with the hardware error
+    NEURAX_CHECK_OK(neurax_simulator_inject_fault(sim, NEURAX_SIM_FAULT_ERROR));
+    NEURAX_CHECK(neurax_command_buffer_submit(cmd) == NEURAX_ERROR_HARDWARE_FAILURE);
+
+    // Recording errors: full buffer, tensors outside DMA memory, unsupported windows
+    neurax_tensor_t* heap_tensor;
+    neurax_pool_config_t large_pool = {10, 10, 1, 1, NEURAX_POOL_MAX};
+    NEURAX_CHECK_OK(neurax_tensor_create(10, 8, 6, 2, NEURAX_DATA_INT8, &heap_tensor));
+    NEURAX_CHECK_OK(neurax_command_buffer_create(sim, 1, &small));
+    NEURAX_CHECK(neurax_command_buffer_conv2d(small, chained.input, chained.weights, chained.bias,
+                                              &conv, chained.conv_out) ==
+                 NEURAX_ERROR_BUFFER_OVERFLOW);
+    NEURAX_CHECK(neurax_command_buffer_activation(small, chained.pooled, NEURAX_ACTIVATION_RELU,
+                                                  heap_tensor) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_command_buffer_pooling(small, chained.input, &large_pool,
+                                               chained.pooled) == NEURAX_ERROR_INVALID_PARAM);
+
+    // Without an accelerator the commands run on the CPU in order
+    create_network(cpu, &fallback);
+    NEURAX_CHECK_OK(neurax_command_buffer_create(cpu, 16, &cpu_cmd));
+    record_network(cpu_cmd, &fallback);
+    NEURAX_CHECK_OK(neurax_command_buffer_submit(cpu_cmd));
+    NEURAX_CHECK(same_results(&fallback, &reference));
+
+    // An empty buffer submits nothing
+    NEURAX_CHECK_OK(neurax_command_buffer_reset(cmd));
+    NEURAX_CHECK_OK(neurax_simulator_reset_stats(sim));
+    NEURAX_CHECK_OK(neurax_command_buffer_submit(cmd));
+    NEURAX_CHECK_OK(neurax_simulator_get_stats(sim, &stats));
+    NEURAX_CHECK(stats.runs == 0);
+
+    NEURAX_CHECK_OK(neurax_command_buffer_destroy(cmd));
+    NEURAX_CHECK_OK(neurax_command_buffer_destroy(small));
+    NEURAX_CHECK_OK(neurax_command_buffer_destroy(cpu_cmd));
+    neurax_tensor_destroy(heap_tensor);
+    destroy_network(&reference);
+    destroy_network(&chained);
+    destroy_network(&fallback);
+
+    neurax_dma_info_t dma;
+    NEURAX_CHECK_OK(neurax_dma_get_info(sim, &dma));
+    NEURAX_CHECK(dma.num_buffers == 0);
+
+    NEURAX_CHECK_OK(neurax_cleanup(sim));
+    NEURAX_CHECK_OK(neurax_cleanup(cpu));
+
+    return neurax_test_result("test_command_buffer");
+}
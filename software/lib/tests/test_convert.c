@@ -0,0 +1,89 @@
+/*
+ * NEURAX Library Tests
+ * BF16 conversion: the vector path and the software path agree on
+ * denormals, NaN, infinities, rounding ties and overflow
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include "neurax_private.h"
+
+#define COUNT 45    // Two 16-wide vector blocks plus a scalar tail
+
+typedef struct {
+    uint32_t fp32;
+    uint16_t bf16;
+} bf16_case_t;
+
+// Expected results follow VCVTNEPS2BF16: round to nearest even, denormal
+// inputs read as signed zero, NaN kept and made quiet
+static const bf16_case_t cases[] = {
+    {0x3F800000u, 0x3F80u},     // 1.0
+    {0x3F808000u, 0x3F80u},     // Tie rounds to even (down)
+    {0x3F818000u, 0x3F82u},     // Tie rounds to even (up)
+    {0x3F808001u, 0x3F81u},     // Above the tie
+    {0x00000001u, 0x0000u},     // Smallest denormal
+    {0x007FFFFFu, 0x0000u},     // Largest denormal, would round to 0x0080 unflushed
+    {0x80400000u, 0x8000u},     // Negative denormal keeps its sign
+    {0x00800000u, 0x0080u},     // Smallest normal
+    {0x80000000u, 0x8000u},     // -0
+    {0x7F800000u, 0x7F80u},     // +inf
+    {0xFF800000u, 0xFF80u},     // -inf
+    {0x7F7FFFFFu, 0x7F80u},     // FLT_MAX overflows to inf
+    {0x7F7F7FFFu, 0x7F7Fu},     // Largest value that stays finite
+    {0x7FC00000u, 0x7FC0u},     // Quiet NaN
+    {0x7F800001u, 0x7FC0u},     // Signalling NaN with low payload is quietened
+    {0xFFA12345u, 0xFFE1u},     // Negative signalling NaN keeps sign and payload
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+static float from_bits(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+int main(void) {
+    float src[COUNT];
+    uint16_t dst[COUNT];
+    float back[COUNT];
+
+    for (size_t i = 0; i < COUNT; i++) {
+        src[i] = from_bits(cases[i % NUM_CASES].fp32);
+    }
+
+    // The dispatched conversion (AVX-512 BF16 where the CPU has it) against
+    // the scalar conversion used by every other path
+    NEURAX_CHECK_OK(neurax_convert_data_type(src, NEURAX_DATA_FLOAT32, dst,
+                                             NEURAX_DATA_BFLOAT16, COUNT));
+    for (size_t i = 0; i < COUNT; i++) {
+        const bf16_case_t* c = &cases[i % NUM_CASES];
+        if (dst[i] != c->bf16 || neurax_fp32_to_bf16(src[i]) != c->bf16) {
+            fprintf(stderr, "bf16(0x%08x): vector 0x%04x, scalar 0x%04x, expected 0x%04x\n",
+                    c->fp32, dst[i], neurax_fp32_to_bf16(src[i]), c->bf16);
+            NEURAX_CHECK(false);
+        }
+    }
+
+    // Widening is exact, BF16 denormals included
+    uint16_t wide[3] = {0x0001u, 0x807Fu, 0x7FC0u};
+    NEURAX_CHECK_OK(neurax_convert_data_type(wide, NEURAX_DATA_BFLOAT16, back,
+                                             NEURAX_DATA_FLOAT32, 3));
+    for (size_t i = 0; i < 3; i++) {
+        uint32_t bits;
+        memcpy(&bits, &back[i], sizeof(bits));
+        NEURAX_CHECK(bits == (uint32_t)wide[i] << 16);
+        NEURAX_CHECK(neurax_bf16_to_fp32(wide[i]) == back[i] || back[i] != back[i]);
+    }
+
+    // Element stores used by the reference kernels round the same way
+    uint16_t stored[NUM_CASES];
+    for (size_t i = 0; i < NUM_CASES; i++) {
+        neurax_store_element(stored, NEURAX_DATA_BFLOAT16, i, from_bits(cases[i].fp32));
+        NEURAX_CHECK(stored[i] == cases[i].bf16);
+    }
+
+    return neurax_test_result("test_convert");
+}
@@ -0,0 +1,133 @@
+/*
+ * NEURAX Library Tests
+ * Dense layers against a double-precision reference: the GEMV path for a
+ * single input, the blocked GEMM path for batches, and each weight type
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define K 300       // Past one 256-wide K block
+#define N 37        // Not a multiple of the 8-wide weight panels
+
+// Largest relative error of neurax_dense against the reference, computed
+// from the weights as the layer sees them (dequantized or widened)
+static double dense_error(neurax_device_t* device, uint32_t batch,
+                          const neurax_tensor_t* weights, const neurax_tensor_t* bias,
+                          neurax_activation_t activation) {
+    neurax_tensor_t *input, *output, *wide;
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, 15, batch, NEURAX_DATA_FLOAT32, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(N, 1, 1, batch, NEURAX_DATA_FLOAT32, &output));
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, N, NEURAX_DATA_FLOAT32, &wide));
+    neurax_test_fill(input, batch);
+    if (weights->quant.scale > 0.0f) {
+        NEURAX_CHECK_OK(neurax_dequantize_tensor(weights, wide));
+    } else {
+        NEURAX_CHECK_OK(neurax_convert_data_type(weights->data, weights->data_type, wide->data,
+                                                 NEURAX_DATA_FLOAT32, (size_t)N * K));
+    }
+
+    neurax_dense_config_t config = {K, N, bias != NULL, activation};
+    NEURAX_CHECK_OK(neurax_dense(device, input, weights, bias, &config, output));
+
+    double worst = 0.0;
+    const float* x = (const float*)input->data;
+    const float* w = (const float*)wide->data;
+    for (uint32_t b = 0; b < batch; b++) {
+        for (uint32_t o = 0; o < N; o++) {
+            double sum = bias ? ((const float*)bias->data)[o] : 0.0;
+            double magnitude = fabs(sum);
+            for (uint32_t k = 0; k < K; k++) {
+                sum += (double)x[b * K + k] * w[o * K + k];
+                magnitude += fabs((double)x[b * K + k] * w[o * K + k]);
+            }
+            if (activation == NEURAX_ACTIVATION_RELU && sum < 0.0) {
+                sum = 0.0;
+            }
+            double error = fabs(((float*)output->data)[b * N + o] - sum) / (magnitude + 1e-6);
+            worst = error > worst ? error : worst;
+        }
+    }
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(output);
+    neurax_tensor_destroy(wide);
+    return worst;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    neurax_tensor_t *weights, *half, *bf16, *int8, *bias;
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, N, NEURAX_DATA_FLOAT32, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, N, NEURAX_DATA_FLOAT16, &half));
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, N, NEURAX_DATA_BFLOAT16, &bf16));
+    NEURAX_CHECK_OK(neurax_tensor_create(N, 1, 1, 1, NEURAX_DATA_FLOAT32, &bias));
+    neurax_test_fill(weights, 1);
+    neurax_test_fill(bias, 2);
+    NEURAX_CHECK_OK(neurax_convert_data_type(weights->data, NEURAX_DATA_FLOAT32, half->data,
+                                             NEURAX_DATA_FLOAT16, (size_t)N * K));
+    NEURAX_CHECK_OK(neurax_convert_data_type(weights->data, NEURAX_DATA_FLOAT32, bf16->data,
+                                             NEURAX_DATA_BFLOAT16, (size_t)N * K));
+    NEURAX_CHECK_OK(neurax_quantize_weights(weights, true, &int8));
+
+    // Batch 1 takes GEMV; 4 is one full micro-tile of rows, 5 and 9 leave remainders
+    const uint32_t batches[4] = {1, 4, 5, 9};
+    const neurax_tensor_t* types[4] = {weights, half, bf16, int8};
+    for (int b = 0; b < 4; b++) {
+        for (int t = 0; t < 4; t++) {
+            NEURAX_CHECK(dense_error(device, batches[b], types[t], bias,
+                                     NEURAX_ACTIVATION_LINEAR) < 1e-5);
+        }
+        NEURAX_CHECK(dense_error(device, batches[b], weights, NULL, NEURAX_ACTIVATION_RELU) < 1e-5);
+    }
+
+    // GEMV and GEMM agree row for row
+    neurax_tensor_t *batch_in, *single_in, *batch_out, *single_out;
+    neurax_dense_config_t dense = {K, N, true, NEURAX_ACTIVATION_LINEAR};
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, 3, NEURAX_DATA_FLOAT32, &batch_in));
+    NEURAX_CHECK_OK(neurax_tensor_create(K, 1, 1, 1, NEURAX_DATA_FLOAT32, &single_in));
+    NEURAX_CHECK_OK(neurax_tensor_create(N, 1, 1, 3, NEURAX_DATA_FLOAT32, &batch_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(N, 1, 1, 1, NEURAX_DATA_FLOAT32, &single_out));
+    neurax_test_fill(batch_in, 3);
+    NEURAX_CHECK_OK(neurax_dense(device, batch_in, weights, bias, &dense, batch_out));
+    for (uint32_t b = 0; b < 3; b++) {
+        memcpy(single_in->data, (float*)batch_in->data + b * K, sizeof(float) * K);
+        NEURAX_CHECK_OK(neurax_dense(device, single_in, weights, bias, &dense, single_out));
+        bool close = true;
+        for (uint32_t o = 0; o < N; o++) {
+            float g = ((float*)batch_out->data)[b * N + o];
+            float v = ((float*)single_out->data)[o];
+            close = close && fabsf(g - v) <= 1e-5f * (1.0f + fabsf(v));
+        }
+        NEURAX_CHECK(close);
+    }
+
+    // Shapes that don't match the configuration are refused
+    dense.input_features = K - 1;
+    NEURAX_CHECK(neurax_dense(device, batch_in, weights, bias, &dense, batch_out) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    dense.input_features = K;
+    dense.output_features = N + 1;
+    NEURAX_CHECK(neurax_dense(device, batch_in, weights, bias, &dense, batch_out) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(batch_in);
+    neurax_tensor_destroy(single_in);
+    neurax_tensor_destroy(batch_out);
+    neurax_tensor_destroy(single_out);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(half);
+    neurax_tensor_destroy(bf16);
+    neurax_tensor_destroy(int8);
+    neurax_tensor_destroy(bias);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_dense");
+}
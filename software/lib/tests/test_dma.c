@@ -0,0 +1,146 @@
+/*
+ * NEURAX Library Tests
+ * DMA buffers from the anonymous stand-in region: page granularity, first-fit
+ * reuse, bus addresses, exhaustion, DMA tensors and concurrent allocation
+ *
+ * Author: NEURAX Team
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "neurax_test.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define PAGES 16
+#define THREADS 4
+#define ROUNDS 200
+
+typedef struct {
+    neurax_device_t* device;
+    size_t page;
+    uint32_t seed;
+    bool ok;
+} worker_t;
+
+// Each buffer carries its owner's seed in every byte; a buffer handed out twice
+// would see another thread's pattern
+static void* alloc_free_loop(void* arg) {
+    worker_t* w = (worker_t*)arg;
+    w->ok = true;
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        size_t size = w->page * (1 + (r + w->seed) % 2);
+        uint8_t* p = NULL;
+        if (neurax_dma_alloc(w->device, size, (void**)&p, NULL) != NEURAX_SUCCESS) {
+            w->ok = false;
+            break;
+        }
+        memset(p, (int)w->seed, size);
+        for (size_t i = 0; i < size; i += 512) {
+            w->ok = w->ok && p[i] == (uint8_t)w->seed;
+        }
+        w->ok = w->ok && neurax_dma_free(w->device, p) == NEURAX_SUCCESS;
+    }
+    return NULL;
+}
+
+int main(void) {
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.dma_device = "/nonexistent/udmabuf0";
+    config.dma_region_size = PAGES * page - 100;    // Rounded up to whole pages
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // The region is set up by the first allocation
+    neurax_dma_info_t info;
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.backend == NEURAX_DMA_NONE && info.size == 0);
+
+    // Buffers are whole, zero-filled pages at matching bus addresses
+    uint8_t *a, *b, *c, *d;
+    uint64_t bus_a, bus_b, bus;
+    NEURAX_CHECK_OK(neurax_dma_alloc(device, 1, (void**)&a, &bus_a));
+    NEURAX_CHECK_OK(neurax_dma_alloc(device, page + 1, (void**)&b, &bus_b));
+    NEURAX_CHECK_OK(neurax_dma_alloc(device, page, (void**)&c, NULL));
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.backend == NEURAX_DMA_ANONYMOUS && info.size == PAGES * page);
+    NEURAX_CHECK(info.used == 4 * page && info.num_buffers == 3);
+    NEURAX_CHECK((uintptr_t)a % page == 0 && bus_a % page == 0);
+    NEURAX_CHECK(b == a + page && c == b + 2 * page);
+    NEURAX_CHECK(bus_a == info.bus_address && bus_b == bus_a + page);
+    bool zero = true;
+    for (size_t i = 0; i < 2 * page; i++) {
+        zero = zero && b[i] == 0;
+    }
+    NEURAX_CHECK(zero);
+
+    // Any address inside the region translates; anything else is refused
+    NEURAX_CHECK_OK(neurax_dma_get_address(device, b + 100, &bus));
+    NEURAX_CHECK(bus == bus_b + 100);
+    NEURAX_CHECK(neurax_dma_get_address(device, &info, &bus) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_dma_free(device, &info) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_dma_free(device, b + page) == NEURAX_ERROR_INVALID_PARAM);
+
+    // First fit reuses a freed gap that is large enough, zeroed again
+    memset(b, 0x5A, 2 * page);
+    NEURAX_CHECK_OK(neurax_dma_free(device, b));
+    NEURAX_CHECK(neurax_dma_free(device, b) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_dma_alloc(device, 3 * page, (void**)&d, NULL));
+    NEURAX_CHECK(d == c + page);
+    NEURAX_CHECK_OK(neurax_dma_alloc(device, page, (void**)&b, NULL));
+    NEURAX_CHECK(b == a + page && b[0] == 0 && b[page - 1] == 0);
+
+    // Exhaustion fails cleanly and leaves the accounting as it was
+    void* big = NULL;
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    size_t used = info.used;
+    NEURAX_CHECK(neurax_dma_alloc(device, PAGES * page, &big, NULL) ==
+                 NEURAX_ERROR_MEMORY_ALLOCATION);
+    NEURAX_CHECK(neurax_dma_alloc(device, SIZE_MAX, &big, NULL) == NEURAX_ERROR_BUFFER_OVERFLOW);
+    NEURAX_CHECK(neurax_dma_alloc(device, 0, &big, NULL) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.used == used && info.num_buffers == 4 && info.peak == 6 * page);
+
+    neurax_memory_stats_t stats;
+    NEURAX_CHECK_OK(neurax_memory_get_stats(device, &stats));
+    NEURAX_CHECK(stats.categories[NEURAX_MEMORY_DMA].live_bytes == used);
+
+    // DMA tensors live in the region, sized for their layout, and free on destroy
+    neurax_tensor_t* tensor;
+    NEURAX_CHECK_OK(neurax_tensor_create_dma(device, 10, 10, 13, 1, NEURAX_DATA_FLOAT32,
+                                             NEURAX_LAYOUT_NCHW8C, &tensor));
+    NEURAX_CHECK(tensor->data_size == sizeof(float) * 10 * 10 * 16);
+    NEURAX_CHECK_OK(neurax_dma_get_address(device, tensor->data, &bus));
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.num_buffers == 5);
+    neurax_tensor_destroy(tensor);
+
+    NEURAX_CHECK_OK(neurax_dma_free(device, a));
+    NEURAX_CHECK_OK(neurax_dma_free(device, b));
+    NEURAX_CHECK_OK(neurax_dma_free(device, c));
+    NEURAX_CHECK_OK(neurax_dma_free(device, d));
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.used == 0 && info.num_buffers == 0);
+
+    // Threads allocating and freeing at once never receive the same pages
+    pthread_t threads[THREADS];
+    worker_t workers[THREADS];
+    for (uint32_t t = 0; t < THREADS; t++) {
+        workers[t] = (worker_t){device, page, t + 1, false};
+        pthread_create(&threads[t], NULL, alloc_free_loop, &workers[t]);
+    }
+    for (uint32_t t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        NEURAX_CHECK(workers[t].ok);
+    }
+    NEURAX_CHECK_OK(neurax_dma_get_info(device, &info));
+    NEURAX_CHECK(info.used == 0 && info.num_buffers == 0);
+    NEURAX_CHECK_OK(neurax_memory_get_stats(device, &stats));
+    NEURAX_CHECK(stats.categories[NEURAX_MEMORY_DMA].live_bytes == 0);
+
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_dma");
+}
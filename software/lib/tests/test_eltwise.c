@@ -0,0 +1,185 @@
+/*
+ * NEURAX Library Tests
+ * Elementwise add/mul/add+ReLU with broadcasting, per-channel scale and
+ * bias, and channel concatenation through output slices
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+
+// Broadcast dimension: size-1 operands repeat their only entry
+static uint32_t bc(uint32_t i, uint32_t size) {
+    return size == 1 ? 0 : i;
+}
+
+static float reference_op(neurax_eltwise_op_t op, float a, float b) {
+    switch (op) {
+        case NEURAX_ELTWISE_ADD: return a + b;
+        case NEURAX_ELTWISE_MUL: return a * b;
+        default: return a + b > 0.0f ? a + b : 0.0f;
+    }
+}
+
+// out = a op b over the output shape, compared element by element
+static bool matches_reference(const neurax_tensor_t* a, const neurax_tensor_t* b,
+                              neurax_eltwise_op_t op, const neurax_tensor_t* out) {
+    for (uint32_t n = 0; n < out->batch_size; n++)
+    for (uint32_t y = 0; y < out->height; y++)
+    for (uint32_t x = 0; x < out->width; x++)
+    for (uint32_t c = 0; c < out->channels; c++) {
+        float va = neurax_test_get(a, bc(n, a->batch_size), bc(y, a->height),
+                                   bc(x, a->width), bc(c, a->channels));
+        float vb = neurax_test_get(b, bc(n, b->batch_size), bc(y, b->height),
+                                   bc(x, b->width), bc(c, b->channels));
+        if (neurax_test_get(out, n, y, x, c) != reference_op(op, va, vb)) {
+            fprintf(stderr, "op %d mismatch at (%u, %u, %u, %u)\n", op, n, y, x, c);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // Full-shape operands and each broadcast shape, for every op
+    neurax_tensor_t *a, *out;
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 6, 2, NEURAX_DATA_FLOAT32, &a));
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 6, 2, NEURAX_DATA_FLOAT32, &out));
+    neurax_test_fill(a, 1);
+    const uint32_t shapes[][4] = {
+        {7, 5, 6, 2},   // Same shape: flat path
+        {1, 1, 6, 1},   // Per-channel vector
+        {7, 1, 1, 1},   // Per-column
+        {1, 5, 6, 1},   // Rows of channels shared across width and batch
+        {1, 1, 1, 1},   // Scalar
+    };
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        neurax_tensor_t* b;
+        NEURAX_CHECK_OK(neurax_tensor_create(shapes[s][0], shapes[s][1], shapes[s][2],
+                                             shapes[s][3], NEURAX_DATA_FLOAT32, &b));
+        neurax_test_fill(b, 10 + (uint32_t)s);
+        for (int op = NEURAX_ELTWISE_ADD; op <= NEURAX_ELTWISE_ADD_RELU; op++) {
+            NEURAX_CHECK_OK(neurax_eltwise(device, a, b, (neurax_eltwise_op_t)op, out));
+            NEURAX_CHECK(matches_reference(a, b, (neurax_eltwise_op_t)op, out));
+            // Either operand may broadcast
+            NEURAX_CHECK_OK(neurax_eltwise(device, b, a, (neurax_eltwise_op_t)op, out));
+            NEURAX_CHECK(matches_reference(b, a, (neurax_eltwise_op_t)op, out));
+        }
+        neurax_tensor_destroy(b);
+    }
+
+    // Shapes that neither match nor are 1 are refused
+    neurax_tensor_t* bad;
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 3, 1, NEURAX_DATA_FLOAT32, &bad));
+    NEURAX_CHECK(neurax_eltwise(device, a, bad, NEURAX_ELTWISE_ADD, out) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    neurax_tensor_destroy(bad);
+
+    // In place on a residual: out aliases the first operand
+    neurax_tensor_t *residual, *copy;
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 6, 2, NEURAX_DATA_FLOAT32, &residual));
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 6, 2, NEURAX_DATA_FLOAT32, &copy));
+    neurax_test_fill(residual, 3);
+    memcpy(copy->data, residual->data, residual->data_size);
+    NEURAX_CHECK_OK(neurax_eltwise(device, residual, a, NEURAX_ELTWISE_ADD_RELU, residual));
+    NEURAX_CHECK(matches_reference(copy, a, NEURAX_ELTWISE_ADD_RELU, residual));
+
+    // Integer outputs saturate
+    neurax_tensor_t *u8a, *u8b, *u8out;
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 1, 1, NEURAX_DATA_UINT8, &u8a));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 1, 1, NEURAX_DATA_UINT8, &u8b));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 1, 1, NEURAX_DATA_UINT8, &u8out));
+    const uint8_t u8_a[4] = {200, 10, 0, 128};
+    const uint8_t u8_b[4] = {100, 20, 0, 127};
+    const uint8_t u8_sum[4] = {255, 30, 0, 255};
+    memcpy(u8a->data, u8_a, 4);
+    memcpy(u8b->data, u8_b, 4);
+    NEURAX_CHECK_OK(neurax_eltwise(device, u8a, u8b, NEURAX_ELTWISE_ADD, u8out));
+    NEURAX_CHECK(memcmp(u8out->data, u8_sum, 4) == 0);
+
+    // Scale and bias: per channel, a single value, or absent
+    neurax_tensor_t *scale, *bias, *single;
+    NEURAX_CHECK_OK(neurax_tensor_create(6, 1, 1, 1, NEURAX_DATA_FLOAT32, &scale));
+    NEURAX_CHECK_OK(neurax_tensor_create(6, 1, 1, 1, NEURAX_DATA_FLOAT32, &bias));
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 1, 1, NEURAX_DATA_FLOAT32, &single));
+    for (uint32_t c = 0; c < 6; c++) {
+        ((float*)scale->data)[c] = 0.5f * (float)c - 1.0f;
+        ((float*)bias->data)[c] = (float)c * 0.25f;
+    }
+    ((float*)single->data)[0] = 2.0f;
+    const neurax_tensor_t* scales[3] = {scale, single, NULL};
+    const neurax_tensor_t* biases[3] = {bias, NULL, single};
+    for (int v = 0; v < 3; v++) {
+        NEURAX_CHECK_OK(neurax_scale_bias(device, a, scales[v], biases[v], out));
+        bool same = true;
+        for (uint32_t i = 0; i < 7 * 5 * 2; i++) {
+            for (uint32_t c = 0; c < 6; c++) {
+                float k = scales[v] ? ((float*)scales[v]->data)[scales[v] == scale ? c : 0] : 1.0f;
+                float d = biases[v] ? ((float*)biases[v]->data)[biases[v] == bias ? c : 0] : 0.0f;
+                float expected = ((float*)a->data)[i * 6 + c] * k + d;
+                same = same && fabsf(((float*)out->data)[i * 6 + c] - expected) <= 1e-6f;
+            }
+        }
+        NEURAX_CHECK(same);
+    }
+    NEURAX_CHECK(neurax_scale_bias(device, a, u8a, NULL, out) == NEURAX_ERROR_INVALID_PARAM);
+
+    // Concat: producers that wrote into channel slices of the output are
+    // left alone, other inputs are copied in (and converted) at their offset
+    neurax_tensor_t *concat, *slice0, *slice2, *middle, *ref0, *ref2, *gain;
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 10, 2, NEURAX_DATA_FLOAT32, &concat));
+    NEURAX_CHECK_OK(neurax_tensor_channel_slice(concat, 0, 6, &slice0));
+    NEURAX_CHECK_OK(neurax_tensor_channel_slice(concat, 8, 2, &slice2));
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 2, 2, NEURAX_DATA_INT8, &middle));
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 6, 2, NEURAX_DATA_FLOAT32, &ref0));
+    NEURAX_CHECK_OK(neurax_tensor_create(7, 5, 2, 2, NEURAX_DATA_FLOAT32, &ref2));
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 6, 1, NEURAX_DATA_FLOAT32, &gain));
+    neurax_test_fill(middle, 5);
+    neurax_test_fill(ref2, 6);
+    neurax_test_fill(gain, 7);
+    NEURAX_CHECK_OK(neurax_eltwise(device, a, gain, NEURAX_ELTWISE_MUL, slice0));
+    NEURAX_CHECK_OK(neurax_eltwise(device, a, gain, NEURAX_ELTWISE_MUL, ref0));
+    NEURAX_CHECK_OK(neurax_tensor_convert_layout(ref2, slice2));
+
+    const neurax_tensor_t* parts[3] = {slice0, middle, slice2};
+    NEURAX_CHECK_OK(neurax_concat(device, parts, 3, concat));
+    bool joined = true;
+    for (uint32_t n = 0; n < 2; n++)
+    for (uint32_t y = 0; y < 5; y++)
+    for (uint32_t x = 0; x < 7; x++)
+    for (uint32_t c = 0; c < 10; c++) {
+        float expected = c < 6 ? neurax_test_get(ref0, n, y, x, c) :
+                         c < 8 ? neurax_test_get(middle, n, y, x, c - 6) :
+                                 neurax_test_get(ref2, n, y, x, c - 8);
+        joined = joined && neurax_test_get(concat, n, y, x, c) == expected;
+    }
+    NEURAX_CHECK(joined);
+    const neurax_tensor_t* short_parts[2] = {slice0, middle};
+    NEURAX_CHECK(neurax_concat(device, short_parts, 2, concat) == NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(slice0);
+    neurax_tensor_destroy(slice2);
+    neurax_tensor_destroy(concat);
+    neurax_tensor_destroy(middle);
+    neurax_tensor_destroy(ref0);
+    neurax_tensor_destroy(ref2);
+    neurax_tensor_destroy(gain);
+    neurax_tensor_destroy(scale);
+    neurax_tensor_destroy(bias);
+    neurax_tensor_destroy(single);
+    neurax_tensor_destroy(u8a);
+    neurax_tensor_destroy(u8b);
+    neurax_tensor_destroy(u8out);
+    neurax_tensor_destroy(residual);
+    neurax_tensor_destroy(copy);
+    neurax_tensor_destroy(a);
+    neurax_tensor_destroy(out);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_eltwise");
+}
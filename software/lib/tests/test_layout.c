@@ -0,0 +1,174 @@
+/*
+ * NEURAX Library Tests
+ * Layout transforms between NHWC, NCHW and blocked NCHWc, and the blocked
+ * convolution kernel against a direct reference
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+
+static bool same_elements(const neurax_tensor_t* a, const neurax_tensor_t* b) {
+    for (uint32_t n = 0; n < a->batch_size; n++)
+    for (uint32_t y = 0; y < a->height; y++)
+    for (uint32_t x = 0; x < a->width; x++)
+    for (uint32_t c = 0; c < a->channels; c++) {
+        if (neurax_test_get(a, n, y, x, c) != neurax_test_get(b, n, y, x, c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Direct convolution in double precision over flat OIHW weights
+static double conv_error(const neurax_tensor_t* input, const neurax_tensor_t* weights,
+                         const neurax_tensor_t* bias, const neurax_conv_config_t* conv,
+                         const neurax_tensor_t* output) {
+    const float* w = (const float*)weights->data;
+    const uint32_t KH = conv->kernel_height, KW = conv->kernel_width;
+    double worst = 0.0;
+    for (uint32_t n = 0; n < output->batch_size; n++)
+    for (uint32_t oy = 0; oy < output->height; oy++)
+    for (uint32_t ox = 0; ox < output->width; ox++)
+    for (uint32_t o = 0; o < output->channels; o++) {
+        double sum = bias ? ((const float*)bias->data)[o] : 0.0;
+        for (uint32_t ky = 0; ky < KH; ky++)
+        for (uint32_t kx = 0; kx < KW; kx++) {
+            int32_t iy = (int32_t)(oy * conv->stride_y + ky) - (int32_t)conv->padding_y;
+            int32_t ix = (int32_t)(ox * conv->stride_x + kx) - (int32_t)conv->padding_x;
+            if (iy < 0 || ix < 0 || iy >= (int32_t)input->height || ix >= (int32_t)input->width) {
+                continue;
+            }
+            for (uint32_t i = 0; i < conv->input_channels; i++) {
+                sum += (double)neurax_test_get(input, n, (uint32_t)iy, (uint32_t)ix, i) *
+                       w[((o * conv->input_channels + i) * KH + ky) * KW + kx];
+            }
+        }
+        if (conv->activation == NEURAX_ACTIVATION_RELU && sum < 0.0) {
+            sum = 0.0;
+        }
+        double error = fabs(neurax_test_get(output, n, oy, ox, o) - sum);
+        worst = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // Every transform preserves every element; 13 channels leave a partial block
+    const neurax_layout_t layouts[4] = {NEURAX_LAYOUT_NHWC, NEURAX_LAYOUT_NCHW,
+                                        NEURAX_LAYOUT_NCHW8C, NEURAX_LAYOUT_NCHW16C};
+    neurax_tensor_t* tensors[4];
+    for (int l = 0; l < 4; l++) {
+        NEURAX_CHECK_OK(neurax_tensor_create_layout(9, 5, 13, 2, NEURAX_DATA_FLOAT32,
+                                                    layouts[l], &tensors[l]));
+    }
+    neurax_test_fill(tensors[0], 1);
+    for (int from = 0; from < 4; from++) {
+        for (int to = 0; to < 4; to++) {
+            if (from != to) {
+                NEURAX_CHECK_OK(neurax_tensor_convert_layout(tensors[from], tensors[to]));
+                NEURAX_CHECK(same_elements(tensors[from], tensors[to]));
+            }
+        }
+    }
+
+    // Planar and blocked storage put elements where their layouts say
+    const float* planar = (const float*)tensors[1]->data;
+    const float* blocked = (const float*)tensors[2]->data;
+    const uint32_t W = 9, H = 5, C = 13;
+    NEURAX_CHECK(planar[((1 * C + 12) * H + 3) * W + 7] == neurax_test_get(tensors[0], 1, 3, 7, 12));
+    NEURAX_CHECK(blocked[(((1 * 2 + 1) * H + 3) * W + 7) * 8 + 4] ==
+                 neurax_test_get(tensors[0], 1, 3, 7, 12));
+
+    // Strided NHWC views convert too: a channel slice into planar storage
+    neurax_tensor_t *slice, *planar_slice;
+    NEURAX_CHECK_OK(neurax_tensor_channel_slice(tensors[0], 3, 6, &slice));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(9, 5, 6, 2, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_NCHW, &planar_slice));
+    NEURAX_CHECK_OK(neurax_tensor_convert_layout(slice, planar_slice));
+    NEURAX_CHECK(same_elements(slice, planar_slice));
+
+    // Weights transpose from OHWI (NHWC with batch = output channels) into OIHW
+    neurax_tensor_t *ohwi, *oihw;
+    NEURAX_CHECK_OK(neurax_tensor_create(3, 2, 5, 4, NEURAX_DATA_FLOAT32, &ohwi));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 2, 5, 4, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &oihw));
+    neurax_test_fill(ohwi, 2);
+    NEURAX_CHECK_OK(neurax_tensor_convert_layout(ohwi, oihw));
+    bool transposed = true;
+    for (uint32_t o = 0; o < 4; o++)
+    for (uint32_t i = 0; i < 5; i++)
+    for (uint32_t ky = 0; ky < 2; ky++)
+    for (uint32_t kx = 0; kx < 3; kx++) {
+        transposed = transposed && ((const float*)oihw->data)[((o * 5 + i) * 2 + ky) * 3 + kx] ==
+                                   neurax_test_get(ohwi, o, ky, kx, i);
+    }
+    NEURAX_CHECK(transposed);
+
+    // Shapes and types must match
+    neurax_tensor_t* other;
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(9, 5, 12, 2, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_NCHW, &other));
+    NEURAX_CHECK(neurax_tensor_convert_layout(tensors[0], other) == NEURAX_ERROR_INVALID_PARAM);
+
+    // Convolution in blocked layouts matches the direct reference and the NHWC path
+    neurax_layout_t preferred;
+    NEURAX_CHECK_OK(neurax_get_preferred_layout(device, NEURAX_LAYER_CONV2D, &preferred));
+    NEURAX_CHECK(neurax_layout_block_size(preferred) != 0);
+
+    const neurax_conv_config_t convs[3] = {
+        {3, 3, 1, 1, 1, 1, 13, 20, true, NEURAX_ACTIVATION_RELU},
+        {3, 3, 2, 2, 1, 1, 13, 20, false, NEURAX_ACTIVATION_LINEAR},
+        {1, 1, 1, 1, 0, 0, 13, 7, true, NEURAX_ACTIVATION_LINEAR},
+    };
+    for (int k = 0; k < 3; k++) {
+        const neurax_conv_config_t* conv = &convs[k];
+        uint32_t out_w = (W + 2 * conv->padding_x - conv->kernel_width) / conv->stride_x + 1;
+        uint32_t out_h = (H + 2 * conv->padding_y - conv->kernel_height) / conv->stride_y + 1;
+        neurax_tensor_t *weights, *bias, *nhwc_out;
+        NEURAX_CHECK_OK(neurax_tensor_create_layout(conv->kernel_width, conv->kernel_height, C,
+                                                    conv->output_channels, NEURAX_DATA_FLOAT32,
+                                                    NEURAX_LAYOUT_OIHW, &weights));
+        NEURAX_CHECK_OK(neurax_tensor_create(conv->output_channels, 1, 1, 1,
+                                             NEURAX_DATA_FLOAT32, &bias));
+        NEURAX_CHECK_OK(neurax_tensor_create(out_w, out_h, conv->output_channels, 2,
+                                             NEURAX_DATA_FLOAT32, &nhwc_out));
+        neurax_test_fill(weights, 10 + k);
+        neurax_test_fill(bias, 20 + k);
+        const neurax_tensor_t* b = conv->use_bias ? bias : NULL;
+
+        NEURAX_CHECK_OK(neurax_conv2d(device, tensors[0], weights, b, conv, nhwc_out));
+        NEURAX_CHECK(conv_error(tensors[0], weights, b, conv, nhwc_out) < 1e-3);
+
+        for (int l = 2; l < 4; l++) {
+            neurax_tensor_t* out;
+            NEURAX_CHECK_OK(neurax_tensor_create_layout(out_w, out_h, conv->output_channels, 2,
+                                                        NEURAX_DATA_FLOAT32, layouts[l], &out));
+            NEURAX_CHECK_OK(neurax_conv2d(device, tensors[l], weights, b, conv, out));
+            NEURAX_CHECK(conv_error(tensors[l], weights, b, conv, out) < 1e-3);
+            neurax_tensor_destroy(out);
+        }
+
+        neurax_tensor_destroy(weights);
+        neurax_tensor_destroy(bias);
+        neurax_tensor_destroy(nhwc_out);
+    }
+
+    neurax_tensor_destroy(other);
+    neurax_tensor_destroy(ohwi);
+    neurax_tensor_destroy(oihw);
+    neurax_tensor_destroy(slice);
+    neurax_tensor_destroy(planar_slice);
+    for (int l = 0; l < 4; l++) {
+        neurax_tensor_destroy(tensors[l]);
+    }
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_layout");
+}
@@ -0,0 +1,108 @@
+/*
+ * NEURAX Library Tests
+ * Memory accounting: live, peak and allocation counts per category, the
+ * budget, the untracked opt-out and tensors that outlive their device
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+
+static neurax_memory_stats_t stats_of(neurax_device_t* device) {
+    neurax_memory_stats_t stats;
+    NEURAX_CHECK_OK(neurax_memory_get_stats(device, &stats));
+    return stats;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    neurax_tensor_t *a, *b, *weights, *untracked, *refused;
+
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+    neurax_memory_stats_t base = stats_of(device);
+    neurax_memory_usage_t base_act = base.categories[NEURAX_MEMORY_ACTIVATIONS];
+    neurax_memory_usage_t base_wt = base.categories[NEURAX_MEMORY_WEIGHTS];
+
+    // Plain creates are charged as activations, OIHW tensors as weights
+    NEURAX_CHECK_OK(neurax_tensor_create(16, 16, 4, 1, NEURAX_DATA_FLOAT32, &a));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 8, 4, 1, NEURAX_DATA_FLOAT32, &b));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 4, 8, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &weights));
+    neurax_memory_stats_t s = stats_of(device);
+    neurax_memory_usage_t act = s.categories[NEURAX_MEMORY_ACTIVATIONS];
+    neurax_memory_usage_t wt = s.categories[NEURAX_MEMORY_WEIGHTS];
+    NEURAX_CHECK(act.live_bytes - base_act.live_bytes == a->data_size + b->data_size);
+    NEURAX_CHECK(act.allocations - base_act.allocations == 2);
+    NEURAX_CHECK(wt.live_bytes - base_wt.live_bytes == weights->data_size);
+    NEURAX_CHECK(wt.allocations - base_wt.allocations == 1);
+    NEURAX_CHECK(s.total.live_bytes - base.total.live_bytes ==
+                 a->data_size + b->data_size + weights->data_size);
+
+    // Peak holds the high-water mark after a free; reset_peak restarts it
+    size_t b_size = b->data_size;
+    NEURAX_CHECK_OK(neurax_tensor_destroy(b));
+    s = stats_of(device);
+    act = s.categories[NEURAX_MEMORY_ACTIVATIONS];
+    NEURAX_CHECK(act.live_bytes - base_act.live_bytes == a->data_size);
+    NEURAX_CHECK(act.peak_bytes >= base_act.live_bytes + a->data_size + b_size);
+    NEURAX_CHECK(act.frees - base_act.frees == 1);
+    NEURAX_CHECK_OK(neurax_memory_reset_peak(device));
+    s = stats_of(device);
+    NEURAX_CHECK(s.categories[NEURAX_MEMORY_ACTIVATIONS].peak_bytes ==
+                 s.categories[NEURAX_MEMORY_ACTIVATIONS].live_bytes);
+    NEURAX_CHECK(s.total.peak_bytes == s.total.live_bytes);
+
+    // The opt-out leaves the counters alone
+    NEURAX_CHECK_OK(neurax_tensor_create_ex(64, 64, 1, 1, NEURAX_DATA_FLOAT32, NEURAX_LAYOUT_NHWC,
+                                            NEURAX_TENSOR_UNTRACKED, 0, &untracked));
+    neurax_memory_stats_t after = stats_of(device);
+    NEURAX_CHECK(after.total.live_bytes == s.total.live_bytes);
+    NEURAX_CHECK(after.total.allocations == s.total.allocations);
+
+    // Tracking moves the charge to the requested category
+    NEURAX_CHECK_OK(neurax_tensor_track(device, untracked, NEURAX_MEMORY_WEIGHTS));
+    NEURAX_CHECK_OK(neurax_tensor_track(device, a, NEURAX_MEMORY_WEIGHTS));
+    s = stats_of(device);
+    NEURAX_CHECK(s.categories[NEURAX_MEMORY_ACTIVATIONS].live_bytes == base_act.live_bytes);
+    NEURAX_CHECK(s.categories[NEURAX_MEMORY_WEIGHTS].live_bytes - base_wt.live_bytes ==
+                 a->data_size + weights->data_size + untracked->data_size);
+    NEURAX_CHECK(s.total.live_bytes == after.total.live_bytes + untracked->data_size);
+
+    // A budget refuses the allocation that would exceed it, before allocating
+    NEURAX_CHECK_OK(neurax_memory_set_budget(device, s.total.live_bytes + 1024));
+    NEURAX_CHECK(neurax_tensor_create(64, 64, 1, 1, NEURAX_DATA_FLOAT32, &refused) ==
+                 NEURAX_ERROR_MEMORY_ALLOCATION);
+    NEURAX_CHECK(neurax_tensor_create_tracked(device, NEURAX_MEMORY_WEIGHTS, 64, 64, 1, 1,
+                                              NEURAX_DATA_FLOAT32, NEURAX_LAYOUT_NHWC,
+                                              NEURAX_TENSOR_DEFAULT, &refused) ==
+                 NEURAX_ERROR_MEMORY_ALLOCATION);
+    s = stats_of(device);
+    NEURAX_CHECK(s.failed_allocs == base.failed_allocs + 2);
+    NEURAX_CHECK(s.budget == after.total.live_bytes + untracked->data_size + 1024);
+    NEURAX_CHECK(s.total.live_bytes == after.total.live_bytes + untracked->data_size);
+
+    // What fits is still allocated, and the untracked opt-out bypasses the budget
+    NEURAX_CHECK_OK(neurax_tensor_create(256, 1, 1, 1, NEURAX_DATA_FLOAT32, &refused));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(refused));
+    NEURAX_CHECK_OK(neurax_tensor_create_ex(64, 64, 1, 1, NEURAX_DATA_FLOAT32, NEURAX_LAYOUT_NHWC,
+                                            NEURAX_TENSOR_UNTRACKED, 0, &refused));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(refused));
+    NEURAX_CHECK_OK(neurax_memory_set_budget(device, 0));
+
+    NEURAX_CHECK_OK(neurax_tensor_destroy(untracked));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(weights));
+    s = stats_of(device);
+    NEURAX_CHECK(s.categories[NEURAX_MEMORY_WEIGHTS].live_bytes - base_wt.live_bytes ==
+                 a->data_size);
+
+    // Tensors may outlive their device; with no device open nothing is charged
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(a));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 8, 1, 1, NEURAX_DATA_FLOAT32, &a));
+    NEURAX_CHECK(a->state != NULL);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(a));
+
+    return neurax_test_result("test_memory");
+}
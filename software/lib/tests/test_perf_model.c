@@ -0,0 +1,114 @@
+/*
+ * NEURAX Library Tests
+ * Performance model estimates, checked by hand and against the simulator
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+
+// Setup cost the model adds to every accelerator run
+#define RUN_OVERHEAD 64
+
+int main(void) {
+    neurax_config_t config;
+    neurax_device_t* device = NULL;
+    neurax_perf_layer_t layers[4];
+    neurax_perf_estimate_t estimates[4], total, stats;
+    const neurax_conv_config_t conv = {3, 3, 1, 1, 1, 1, 3, 8, true, NEURAX_ACTIVATION_RELU};
+    const neurax_pool_config_t pool = {2, 2, 2, 2, NEURAX_POOL_MAX};
+
+    memset(&config, 0, sizeof(config));
+    config.use_hardware = true;
+    config.use_simulator = true;
+    config.num_multipliers = 16;
+    config.clock_mhz = 150;
+    config.dma_bandwidth_mbps = 400;
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    memset(layers, 0, sizeof(layers));
+    for (int i = 0; i < 4; i++) {
+        layers[i].batch_size = 2;
+        layers[i].data_type = NEURAX_DATA_INT8;
+    }
+    layers[0].type = NEURAX_LAYER_CONV2D;
+    layers[0].width = 32;
+    layers[0].height = 24;
+    layers[0].channels = 3;
+    layers[0].conv = conv;
+    layers[1].type = NEURAX_LAYER_POOLING;
+    layers[1].width = 32;
+    layers[1].height = 24;
+    layers[1].channels = 8;
+    layers[1].pool = pool;
+    layers[2].type = NEURAX_LAYER_ACTIVATION;
+    layers[2].width = 16;
+    layers[2].height = 12;
+    layers[2].channels = 8;
+    layers[2].activation = NEURAX_ACTIVATION_SIGMOID;
+    layers[3] = layers[2];
+    layers[3].type = NEURAX_LAYER_SOFTMAX;
+
+    NEURAX_CHECK_OK(neurax_perf_estimate(device, layers, 4, estimates, &total));
+
+    // Conv: 32x24x8 outputs of 27 MACs; input, weights, outputs and bias over DMA
+    NEURAX_CHECK(estimates[0].operations == 2 * 32 * 24 * 8 * 27);
+    NEURAX_CHECK(estimates[0].dma_bytes == 2 * (32 * 24 * 3 + 8 * 27 + 32 * 24 * 8 + 8));
+    NEURAX_CHECK(estimates[0].compute_cycles == 2 * 10368);
+    NEURAX_CHECK(estimates[0].transfer_cycles == 2 * 3252);
+    NEURAX_CHECK(estimates[0].cycles == 2 * (10368 + RUN_OVERHEAD));
+    NEURAX_CHECK(estimates[0].runs == 2);
+    NEURAX_CHECK(estimates[0].bottleneck == NEURAX_BOUND_COMPUTE);
+
+    // Pooling: 16x12x8 windows of 4 elements, transfer bound
+    NEURAX_CHECK(estimates[1].operations == 2 * 16 * 12 * 8 * 4);
+    NEURAX_CHECK(estimates[1].cycles == 2 * (2880 + RUN_OVERHEAD));
+    NEURAX_CHECK(estimates[1].runs == 2);
+    NEURAX_CHECK(estimates[1].bottleneck == NEURAX_BOUND_TRANSFER);
+
+    // Activation streams the whole batch in one run
+    NEURAX_CHECK(estimates[2].operations == 2 * 16 * 12 * 8);
+    NEURAX_CHECK(estimates[2].cycles == 2304 + RUN_OVERHEAD);
+    NEURAX_CHECK(estimates[2].runs == 1);
+
+    // Softmax stays on the CPU
+    NEURAX_CHECK(estimates[3].runs == 0 && estimates[3].cycles == 0);
+    NEURAX_CHECK(estimates[3].bottleneck == NEURAX_BOUND_NONE);
+
+    NEURAX_CHECK(total.cycles == estimates[0].cycles + estimates[1].cycles + estimates[2].cycles);
+    NEURAX_CHECK(total.runs == 5);
+
+    // The simulator charges the same model for the runs it executes
+    neurax_tensor_t *input, *weights, *bias, *conv_out, *pooled, *activated;
+    NEURAX_CHECK_OK(neurax_tensor_create(32, 24, 3, 2, NEURAX_DATA_INT8, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 3, 8, NEURAX_DATA_INT8,
+                                                NEURAX_LAYOUT_OIHW, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 1, 1, 1, NEURAX_DATA_INT8, &bias));
+    NEURAX_CHECK_OK(neurax_tensor_create(32, 24, 8, 2, NEURAX_DATA_INT8, &conv_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(16, 12, 8, 2, NEURAX_DATA_INT8, &pooled));
+    NEURAX_CHECK_OK(neurax_tensor_create(16, 12, 8, 2, NEURAX_DATA_INT8, &activated));
+
+    NEURAX_CHECK_OK(neurax_simulator_reset_stats(device));
+    NEURAX_CHECK_OK(neurax_conv2d(device, input, weights, bias, &conv, conv_out));
+    NEURAX_CHECK_OK(neurax_pooling(device, conv_out, &pool, pooled));
+    NEURAX_CHECK_OK(neurax_activation(device, pooled, NEURAX_ACTIVATION_SIGMOID, activated));
+    NEURAX_CHECK_OK(neurax_simulator_get_stats(device, &stats));
+    NEURAX_CHECK(stats.cycles == total.cycles);
+    NEURAX_CHECK(stats.dma_bytes == total.dma_bytes);
+    NEURAX_CHECK(stats.runs == total.runs);
+
+    // Invalid shapes are rejected
+    layers[0].width = 0;
+    NEURAX_CHECK(neurax_perf_estimate(device, layers, 1, NULL, &total) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(bias);
+    neurax_tensor_destroy(conv_out);
+    neurax_tensor_destroy(pooled);
+    neurax_tensor_destroy(activated);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_perf_model");
+}
@@ -0,0 +1,183 @@
+/*
+ * NEURAX Library Tests
+ * Static memory planner: no two live tensors share bytes, storage is reused
+ * and shared in place where allowed, and a network run through a planned
+ * block matches one run through separate tensors
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <stdlib.h>
+
+#define UNUSED UINT32_MAX
+
+// Checks every pair of tensors against lifetimes worked out here, independently
+// of the planner: tensors live at the same layer must not share a byte, except an
+// in-place output and the input it overwrites at that layer
+static bool plan_is_safe(const neurax_memory_plan_t* plan, const size_t* sizes,
+                         uint32_t num_tensors, const neurax_plan_layer_t* layers,
+                         uint32_t num_layers) {
+    uint32_t first[16], last[16], producer[16];
+    size_t offset[16];
+    for (uint32_t t = 0; t < num_tensors; t++) {
+        first[t] = 0;
+        last[t] = UNUSED;
+        producer[t] = UNUSED;
+    }
+    for (uint32_t l = 0; l < num_layers; l++) {
+        for (uint32_t i = 0; i < layers[l].num_inputs; i++) {
+            last[layers[l].inputs[i]] = l;
+        }
+        first[layers[l].output] = l;
+        producer[layers[l].output] = l;
+    }
+
+    neurax_memory_plan_stats_t stats;
+    NEURAX_CHECK_OK(neurax_memory_plan_get_stats(plan, &stats));
+    for (uint32_t t = 0; t < num_tensors; t++) {
+        if (producer[t] == UNUSED && last[t] == UNUSED) {
+            continue;
+        }
+        if (producer[t] != UNUSED && last[t] == UNUSED) {
+            last[t] = num_layers;
+        }
+        NEURAX_CHECK_OK(neurax_memory_plan_get_offset(plan, t, &offset[t]));
+        if (offset[t] % 64 != 0 || offset[t] + sizes[t] > stats.peak_bytes) {
+            return false;
+        }
+    }
+
+    for (uint32_t a = 0; a < num_tensors; a++) {
+        for (uint32_t b = a + 1; b < num_tensors; b++) {
+            if (last[a] == UNUSED || last[b] == UNUSED) continue;
+            bool live_together = first[a] <= last[b] && first[b] <= last[a];
+            bool share_bytes = offset[a] < offset[b] + sizes[b] && offset[b] < offset[a] + sizes[a];
+            const neurax_plan_layer_t* made_b = producer[b] != UNUSED ? &layers[producer[b]] : NULL;
+            bool in_place = made_b && made_b->in_place && made_b->inputs[0] == a &&
+                            last[a] == producer[b];
+            if (live_together && share_bytes && !in_place) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    neurax_memory_plan_t* plan = NULL;
+    neurax_memory_plan_stats_t stats;
+
+    // A plain chain ping-pongs between two buffers
+    const uint32_t chain_in[4] = {0, 1, 2, 3};
+    const size_t chain_sizes[5] = {1000, 1000, 1000, 1000, 1000};
+    neurax_plan_layer_t chain[4];
+    for (uint32_t l = 0; l < 4; l++) {
+        chain[l] = (neurax_plan_layer_t){&chain_in[l], 1, l + 1, false};
+    }
+    NEURAX_CHECK_OK(neurax_memory_plan_create(chain_sizes, 5, chain, 4, &plan));
+    NEURAX_CHECK_OK(neurax_memory_plan_get_stats(plan, &stats));
+    NEURAX_CHECK(stats.peak_bytes == 2 * 1024 && stats.naive_bytes == 5 * 1024);
+    NEURAX_CHECK(stats.num_buffers == 5 && stats.in_place_tensors == 0);
+    NEURAX_CHECK(plan_is_safe(plan, chain_sizes, 5, chain, 4));
+    NEURAX_CHECK_OK(neurax_memory_plan_destroy(plan));
+
+    // In place along the same chain needs a single buffer
+    for (uint32_t l = 0; l < 4; l++) {
+        chain[l].in_place = true;
+    }
+    NEURAX_CHECK_OK(neurax_memory_plan_create(chain_sizes, 5, chain, 4, &plan));
+    NEURAX_CHECK_OK(neurax_memory_plan_get_stats(plan, &stats));
+    NEURAX_CHECK(stats.peak_bytes == 1024 && stats.num_buffers == 1 && stats.in_place_tensors == 4);
+    NEURAX_CHECK_OK(neurax_memory_plan_destroy(plan));
+
+    // A block of mixed sizes with a skip connection; tensor 7 is never used.
+    //   L0: t1 = tanh(t0)   L1: t2 = relu(t1) in place   L2: t3 = t2 + t0
+    //   L3: t4 = sigmoid(t3) in place   L4: t5 = t4 * t2   L5: t6 = relu(t5)
+    const uint32_t W = 7, H = 5, C = 6;
+    const size_t bytes = sizeof(float) * W * H * C;
+    const size_t sizes[8] = {bytes, bytes, bytes, bytes, bytes, bytes, bytes, 4096};
+    const uint32_t in0[1] = {0}, in1[1] = {1}, in2[2] = {2, 0}, in3[1] = {3},
+                   in4[2] = {4, 2}, in5[1] = {5};
+    const neurax_plan_layer_t net[6] = {
+        {in0, 1, 1, false}, {in1, 1, 2, true}, {in2, 2, 3, false},
+        {in3, 1, 4, true}, {in4, 2, 5, false}, {in5, 1, 6, false},
+    };
+    NEURAX_CHECK_OK(neurax_memory_plan_create(sizes, 8, net, 6, &plan));
+    NEURAX_CHECK_OK(neurax_memory_plan_get_stats(plan, &stats));
+    NEURAX_CHECK(plan_is_safe(plan, sizes, 8, net, 6));
+    NEURAX_CHECK(stats.in_place_tensors == 2 && stats.num_buffers == 5);
+    NEURAX_CHECK(stats.peak_bytes < stats.naive_bytes);
+    size_t offset;
+    NEURAX_CHECK(neurax_memory_plan_get_offset(plan, 7, &offset) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_memory_plan_get_offset(plan, 8, &offset) == NEURAX_ERROR_INVALID_PARAM);
+
+    // Run it through the planned block and through separate tensors
+    void* block = malloc(stats.peak_bytes);
+    NEURAX_CHECK(block != NULL);
+    memset(block, 0xFF, stats.peak_bytes);
+    neurax_tensor_t *planned[7], *separate[7];
+    for (uint32_t t = 0; t < 7; t++) {
+        NEURAX_CHECK_OK(neurax_memory_plan_bind(plan, block, t, W, H, C, 1,
+                                                NEURAX_DATA_FLOAT32, &planned[t]));
+        NEURAX_CHECK_OK(neurax_tensor_create(W, H, C, 1, NEURAX_DATA_FLOAT32, &separate[t]));
+        NEURAX_CHECK_OK(neurax_memory_plan_get_offset(plan, t, &offset));
+        NEURAX_CHECK(planned[t]->data == (uint8_t*)block + offset);
+    }
+    neurax_test_fill(separate[0], 1);
+    memcpy(planned[0]->data, separate[0]->data, bytes);
+    for (int run = 0; run < 2; run++) {
+        neurax_tensor_t** t = run ? planned : separate;
+        NEURAX_CHECK_OK(neurax_activation(device, t[0], NEURAX_ACTIVATION_TANH, t[1]));
+        NEURAX_CHECK_OK(neurax_activation(device, t[1], NEURAX_ACTIVATION_RELU, t[2]));
+        NEURAX_CHECK_OK(neurax_eltwise(device, t[2], t[0], NEURAX_ELTWISE_ADD, t[3]));
+        NEURAX_CHECK_OK(neurax_activation(device, t[3], NEURAX_ACTIVATION_SIGMOID, t[4]));
+        NEURAX_CHECK_OK(neurax_eltwise(device, t[4], t[2], NEURAX_ELTWISE_MUL, t[5]));
+        NEURAX_CHECK_OK(neurax_activation(device, t[5], NEURAX_ACTIVATION_RELU, t[6]));
+    }
+    NEURAX_CHECK(neurax_test_same(planned[6], separate[6]));
+    for (uint32_t t = 0; t < 7; t++) {
+        neurax_tensor_destroy(planned[t]);
+        neurax_tensor_destroy(separate[t]);
+    }
+    free(block);
+    NEURAX_CHECK(neurax_memory_plan_bind(plan, NULL, 1, W, H, C, 1, NEURAX_DATA_FLOAT32,
+                                         &planned[0]) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_memory_plan_destroy(plan));
+
+    // An in-place output can't overwrite an input that is read later
+    const uint32_t skip_in0[1] = {0}, skip_in1[2] = {1, 0};
+    const neurax_plan_layer_t skip[2] = {{skip_in0, 1, 1, true}, {skip_in1, 2, 2, false}};
+    NEURAX_CHECK_OK(neurax_memory_plan_create(chain_sizes, 3, skip, 2, &plan));
+    NEURAX_CHECK_OK(neurax_memory_plan_get_stats(plan, &stats));
+    NEURAX_CHECK(stats.in_place_tensors == 0 && stats.peak_bytes == 3 * 1024);
+    NEURAX_CHECK(plan_is_safe(plan, chain_sizes, 3, skip, 2));
+    NEURAX_CHECK_OK(neurax_memory_plan_destroy(plan));
+
+    // Sequences that don't describe a valid execution order are refused
+    const neurax_plan_layer_t twice[2] = {{skip_in0, 1, 1, false}, {skip_in0, 1, 1, false}};
+    const neurax_plan_layer_t read_early[2] = {{&chain_in[1], 1, 2, false},
+                                               {skip_in0, 1, 1, false}};
+    const neurax_plan_layer_t self[1] = {{&chain_in[1], 1, 1, false}};
+    const neurax_plan_layer_t nothing_in_place[1] = {{NULL, 0, 1, true}};
+    const neurax_plan_layer_t out_of_range[1] = {{skip_in0, 1, 5, false}};
+    NEURAX_CHECK(neurax_memory_plan_create(chain_sizes, 3, twice, 2, &plan) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_memory_plan_create(chain_sizes, 3, read_early, 2, &plan) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_memory_plan_create(chain_sizes, 3, self, 1, &plan) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_memory_plan_create(chain_sizes, 3, nothing_in_place, 1, &plan) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_memory_plan_create(chain_sizes, 3, out_of_range, 1, &plan) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_planner");
+}
@@ -0,0 +1,134 @@
+/*
+ * NEURAX Library Tests
+ * Tensor pool: size-class rounding, buffer reuse, the retention limit and
+ * trimming buffers cached by other threads
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <pthread.h>
+
+static neurax_tensor_pool_stats_t pool_stats(void) {
+    neurax_tensor_pool_stats_t stats;
+    NEURAX_CHECK_OK(neurax_tensor_pool_get_stats(&stats));
+    return stats;
+}
+
+// Pooled bytes a tensor of `size` bytes holds while it lives
+static size_t in_use_for(size_t size) {
+    size_t before = pool_stats().bytes_in_use;
+    neurax_tensor_t* tensor = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create((uint32_t)size, 1, 1, 1, NEURAX_DATA_UINT8, &tensor));
+    size_t held = pool_stats().bytes_in_use - before;
+    NEURAX_CHECK_OK(neurax_tensor_destroy(tensor));
+    return held;
+}
+
+// A thread that leaves buffers in its cache and stays alive until released
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int stage = 0;
+
+static void wait_stage(int value) {
+    pthread_mutex_lock(&lock);
+    while (stage < value) {
+        pthread_cond_wait(&cond, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void set_stage(int value) {
+    pthread_mutex_lock(&lock);
+    stage = value;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&lock);
+}
+
+static void* cache_owner(void* arg) {
+    (void)arg;
+    for (int round = 1; round <= 2; round++) {
+        neurax_tensor_t* tensors[3];
+        for (int i = 0; i < 3; i++) {
+            NEURAX_CHECK_OK(neurax_tensor_create(1024, 1, 1, 1, NEURAX_DATA_UINT8, &tensors[i]));
+        }
+        for (int i = 0; i < 3; i++) {
+            NEURAX_CHECK_OK(neurax_tensor_destroy(tensors[i]));
+        }
+        set_stage(2 * round - 1);
+        wait_stage(2 * round);
+    }
+    return NULL;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.use_tensor_pool = true;
+    config.tensor_pool_limit = 64 << 10;
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+    NEURAX_CHECK(pool_stats().enabled);
+    NEURAX_CHECK(pool_stats().bytes_limit == (64 << 10));
+
+    // Four classes per power of two above the 256-byte minimum
+    NEURAX_CHECK(in_use_for(1) == 256);
+    NEURAX_CHECK(in_use_for(256) == 256);
+    NEURAX_CHECK(in_use_for(257) == 320);
+    NEURAX_CHECK(in_use_for(300) == 320);
+    NEURAX_CHECK(in_use_for(1000) == 1024);
+    NEURAX_CHECK(in_use_for(1025) == 1280);
+    NEURAX_CHECK(in_use_for(30000) == 32768);
+
+    // A freed buffer serves the next request of its class, zeroed again
+    neurax_tensor_t* a = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create(250, 1, 1, 1, NEURAX_DATA_FLOAT32, &a));
+    void* data = a->data;
+    memset(data, 0xff, a->data_size);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(a));
+    neurax_tensor_pool_stats_t before = pool_stats();
+    NEURAX_CHECK_OK(neurax_tensor_create(1000, 1, 1, 1, NEURAX_DATA_UINT8, &a));
+    NEURAX_CHECK(a->data == data);
+    NEURAX_CHECK(((uint8_t*)a->data)[999] == 0);
+    NEURAX_CHECK(pool_stats().hits == before.hits + 1);
+    NEURAX_CHECK(pool_stats().misses == before.misses);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(a));
+
+    // Idle buffers never exceed the retention limit
+    NEURAX_CHECK_OK(neurax_tensor_pool_trim(0));
+    NEURAX_CHECK(pool_stats().bytes_retained == 0);
+    neurax_tensor_t* big[4];
+    for (int i = 0; i < 4; i++) {
+        NEURAX_CHECK_OK(neurax_tensor_create(30000, 1, 1, 1, NEURAX_DATA_UINT8, &big[i]));
+    }
+    for (int i = 0; i < 4; i++) {
+        NEURAX_CHECK_OK(neurax_tensor_destroy(big[i]));
+    }
+    NEURAX_CHECK(pool_stats().bytes_retained == 2 * 32768);
+
+    // Trim keeps what was asked for, then everything goes
+    NEURAX_CHECK_OK(neurax_tensor_pool_trim(32768));
+    NEURAX_CHECK(pool_stats().bytes_retained <= 32768);
+    NEURAX_CHECK_OK(neurax_tensor_pool_trim(0));
+    NEURAX_CHECK(pool_stats().bytes_retained == 0);
+
+    // Trim and the last detach reach buffers cached by a thread that is still running
+    pthread_t thread;
+    NEURAX_CHECK(pthread_create(&thread, NULL, cache_owner, NULL) == 0);
+    wait_stage(1);
+    NEURAX_CHECK(pool_stats().bytes_retained == 3 * 1024);
+    NEURAX_CHECK_OK(neurax_tensor_pool_trim(0));
+    NEURAX_CHECK(pool_stats().bytes_retained == 0);
+    set_stage(2);
+    wait_stage(3);
+    NEURAX_CHECK(pool_stats().bytes_retained == 3 * 1024);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+    NEURAX_CHECK(!pool_stats().enabled);
+    NEURAX_CHECK(pool_stats().bytes_retained == 0);
+    set_stage(4);
+    pthread_join(thread, NULL);
+    NEURAX_CHECK(pool_stats().bytes_retained == 0);
+    NEURAX_CHECK(pool_stats().bytes_in_use == 0);
+
+    return neurax_test_result("test_pool");
+}
@@ -0,0 +1,189 @@
+/*
+ * NEURAX Library Tests
+ * Calibration ranges (min/max, percentile, KL), per-tensor and per-channel
+ * INT8 weight quantization, quantize/dequantize and per-channel convolution
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+
+static neurax_tensor_t* vector_of(const float* values, uint32_t count) {
+    neurax_tensor_t* tensor = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create(count, 1, 1, 1, NEURAX_DATA_FLOAT32, &tensor));
+    memcpy(tensor->data, values, sizeof(float) * count);
+    return tensor;
+}
+
+static bool near(float a, float b, float tolerance) {
+    return fabsf(a - b) <= tolerance;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // Min/max accumulates across batches; the range always includes zero
+    neurax_calibrator_t* cal = NULL;
+    neurax_quant_params_t params;
+    const float batch0[4] = {-1.0f, 0.5f, 2.0f, 1.0f};
+    const float batch1[4] = {-3.0f, 5.0f, 0.0f, 4.0f};
+    const float positive[3] = {1.0f, 2.0f, 3.0f};
+    neurax_tensor_t* b0 = vector_of(batch0, 4);
+    neurax_tensor_t* b1 = vector_of(batch1, 4);
+    neurax_tensor_t* pos = vector_of(positive, 3);
+    NEURAX_CHECK_OK(neurax_calibrator_create(2, NEURAX_CALIB_MINMAX, &cal));
+    NEURAX_CHECK(neurax_calibrator_compute(cal, 0, NEURAX_DATA_INT8, &params) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_calibrator_observe(cal, 0, b0));
+    NEURAX_CHECK_OK(neurax_calibrator_observe(cal, 0, b1));
+    NEURAX_CHECK_OK(neurax_calibrator_observe(cal, 1, pos));
+    NEURAX_CHECK(neurax_calibrator_observe(cal, 2, pos) == NEURAX_ERROR_INVALID_PARAM);
+
+    NEURAX_CHECK_OK(neurax_calibrator_compute(cal, 0, NEURAX_DATA_INT8, &params));
+    NEURAX_CHECK(near(params.scale, 5.0f / 127.0f, 1e-7f) && params.zero_point == 0);
+    NEURAX_CHECK(params.channel_scales == NULL);
+    NEURAX_CHECK_OK(neurax_calibrator_compute(cal, 0, NEURAX_DATA_UINT8, &params));
+    NEURAX_CHECK(near(params.scale, 8.0f / 255.0f, 1e-7f) && params.zero_point == 96);
+    NEURAX_CHECK_OK(neurax_calibrator_compute(cal, 1, NEURAX_DATA_UINT8, &params));
+    NEURAX_CHECK(near(params.scale, 3.0f / 255.0f, 1e-7f) && params.zero_point == 0);
+    NEURAX_CHECK(neurax_calibrator_compute(cal, 0, NEURAX_DATA_INT16, &params) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_calibrator_destroy(cal));
+
+    // Percentile and KL clip a rare outlier that min/max would keep
+    neurax_tensor_t* activations;
+    NEURAX_CHECK_OK(neurax_tensor_create(10000, 1, 1, 1, NEURAX_DATA_FLOAT32, &activations));
+    float* a = (float*)activations->data;
+    for (uint32_t i = 0; i < 10000; i++) {
+        a[i] = (float)((i * 7919u) % 10000u) / 10000.0f * ((i & 1) ? 1.0f : -1.0f);
+    }
+    a[1234] = 100.0f;
+    const neurax_calib_method_t methods[3] = {NEURAX_CALIB_MINMAX, NEURAX_CALIB_PERCENTILE,
+                                              NEURAX_CALIB_KL_DIVERGENCE};
+    float ranges[3];
+    for (int m = 0; m < 3; m++) {
+        NEURAX_CHECK_OK(neurax_calibrator_create(1, methods[m], &cal));
+        if (methods[m] == NEURAX_CALIB_PERCENTILE) {
+            NEURAX_CHECK(neurax_calibrator_set_percentile(cal, 0.0f) == NEURAX_ERROR_INVALID_PARAM);
+            NEURAX_CHECK_OK(neurax_calibrator_set_percentile(cal, 99.9f));
+        }
+        NEURAX_CHECK_OK(neurax_calibrator_observe(cal, 0, activations));
+        NEURAX_CHECK_OK(neurax_calibrator_compute(cal, 0, NEURAX_DATA_INT8, &params));
+        ranges[m] = params.scale * 127.0f;
+        NEURAX_CHECK_OK(neurax_calibrator_destroy(cal));
+    }
+    NEURAX_CHECK(near(ranges[0], 100.0f, 1e-3f));
+    NEURAX_CHECK(ranges[1] > 0.9f && ranges[1] < 1.1f);   // One histogram bin is ~0.05
+    NEURAX_CHECK(ranges[2] > 0.5f && ranges[2] < 10.0f);
+
+    // Weight quantization: channel magnitudes spanning three decades
+    const uint32_t O = 4;
+    neurax_tensor_t *weights, *per_tensor, *per_channel, *dequantized;
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 2, O, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 2, O, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &dequantized));
+    neurax_test_fill(weights, 4);
+    const size_t per_o = 3 * 3 * 2;
+    const float magnitude[4] = {0.01f, 0.1f, 1.0f, 10.0f};
+    for (uint32_t o = 0; o < O; o++) {
+        for (size_t i = 0; i < per_o; i++) {
+            ((float*)weights->data)[o * per_o + i] *= magnitude[o];
+        }
+    }
+    NEURAX_CHECK_OK(neurax_quantize_weights(weights, false, &per_tensor));
+    NEURAX_CHECK_OK(neurax_quantize_weights(weights, true, &per_channel));
+    NEURAX_CHECK(per_tensor->data_type == NEURAX_DATA_INT8 && !per_tensor->quant.channel_scales);
+    NEURAX_CHECK(per_channel->quant.channel_scales && per_channel->quant.num_channels == O);
+
+    float error_tensor[4] = {0}, error_channel[4] = {0};
+    for (int pass = 0; pass < 2; pass++) {
+        const neurax_tensor_t* q = pass ? per_channel : per_tensor;
+        NEURAX_CHECK_OK(neurax_dequantize_tensor(q, dequantized));
+        for (uint32_t o = 0; o < O; o++) {
+            float abs_max = 0.0f, worst = 0.0f;
+            for (size_t i = 0; i < per_o; i++) {
+                float w = ((float*)weights->data)[o * per_o + i];
+                float d = ((float*)dequantized->data)[o * per_o + i];
+                float scale = pass ? q->quant.channel_scales[o] : q->quant.scale;
+                // Round to nearest: q = round(w / scale), within half a step
+                NEURAX_CHECK(((int8_t*)q->data)[o * per_o + i] == (int8_t)lrintf(w / scale));
+                abs_max = fabsf(w) > abs_max ? fabsf(w) : abs_max;
+                worst = fabsf(w - d) > worst ? fabsf(w - d) : worst;
+            }
+            if (pass) {
+                NEURAX_CHECK(near(q->quant.channel_scales[o], abs_max / 127.0f, 1e-7f));
+                error_channel[o] = worst / abs_max;
+            } else {
+                error_tensor[o] = worst / abs_max;
+            }
+        }
+    }
+    // Per-channel keeps every channel within half a step of its own range;
+    // per-tensor scales leave the smallest channel almost unrepresented
+    for (uint32_t o = 0; o < O; o++) {
+        NEURAX_CHECK(error_channel[o] <= 0.5f / 127.0f + 1e-6f);
+    }
+    NEURAX_CHECK(error_tensor[0] > 10.0f * error_channel[0]);
+
+    // A per-channel INT8 convolution matches fp32 with the dequantized weights
+    neurax_conv_config_t conv = {3, 3, 1, 1, 1, 1, 2, O, false, NEURAX_ACTIVATION_LINEAR};
+    neurax_tensor_t *image, *expected, *actual;
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 6, 2, 1, NEURAX_DATA_FLOAT32, &image));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 6, O, 1, NEURAX_DATA_FLOAT32, &expected));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 6, O, 1, NEURAX_DATA_FLOAT32, &actual));
+    neurax_test_fill(image, 5);
+    NEURAX_CHECK_OK(neurax_conv2d(device, image, dequantized, NULL, &conv, expected));
+    NEURAX_CHECK_OK(neurax_conv2d(device, image, per_channel, NULL, &conv, actual));
+    bool close = true;
+    for (size_t i = 0; i < expected->data_size / sizeof(float); i++) {
+        float e = ((float*)expected->data)[i];
+        close = close && near(((float*)actual->data)[i], e, 1e-4f * (1.0f + fabsf(e)));
+    }
+    NEURAX_CHECK(close);
+
+    // Activation quantization saturates, and uint8 honours the zero point
+    const float values[6] = {-1.0f, 0.0f, 0.26f, 1.0f, 10.0f, -10.0f};
+    neurax_tensor_t* real = vector_of(values, 6);
+    neurax_tensor_t *q8, *qu8, *back;
+    NEURAX_CHECK_OK(neurax_tensor_create(6, 1, 1, 1, NEURAX_DATA_INT8, &q8));
+    NEURAX_CHECK_OK(neurax_tensor_create(6, 1, 1, 1, NEURAX_DATA_UINT8, &qu8));
+    NEURAX_CHECK_OK(neurax_tensor_create(6, 1, 1, 1, NEURAX_DATA_FLOAT32, &back));
+    neurax_quant_params_t symmetric = {0.05f, 0, NULL, 0};
+    neurax_quant_params_t asymmetric = {0.05f, 20, NULL, 0};
+    const int8_t q8_expected[6] = {-20, 0, 5, 20, 127, -128};
+    const uint8_t qu8_expected[6] = {0, 20, 25, 40, 220, 0};
+    NEURAX_CHECK_OK(neurax_quantize_tensor(real, &symmetric, q8));
+    NEURAX_CHECK(memcmp(q8->data, q8_expected, 6) == 0);
+    NEURAX_CHECK_OK(neurax_quantize_tensor(real, &asymmetric, qu8));
+    NEURAX_CHECK(memcmp(qu8->data, qu8_expected, 6) == 0);
+    NEURAX_CHECK(qu8->quant.zero_point == 20);
+    NEURAX_CHECK_OK(neurax_dequantize_tensor(qu8, back));
+    NEURAX_CHECK(near(((float*)back->data)[2], 0.25f, 1e-6f));
+    NEURAX_CHECK(near(((float*)back->data)[0], -1.0f, 1e-6f));
+    neurax_quant_params_t unset = {0.0f, 0, NULL, 0};
+    NEURAX_CHECK(neurax_quantize_tensor(real, &unset, q8) == NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(real);
+    neurax_tensor_destroy(q8);
+    neurax_tensor_destroy(qu8);
+    neurax_tensor_destroy(back);
+    neurax_tensor_destroy(image);
+    neurax_tensor_destroy(expected);
+    neurax_tensor_destroy(actual);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(dequantized);
+    neurax_tensor_destroy(per_tensor);
+    neurax_tensor_destroy(per_channel);
+    neurax_tensor_destroy(activations);
+    neurax_tensor_destroy(b0);
+    neurax_tensor_destroy(b1);
+    neurax_tensor_destroy(pos);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_quant");
+}
@@ -0,0 +1,128 @@
+/*
+ * NEURAX Library Tests
+ * Resize against a double-precision reference: nearest, bilinear at
+ * arbitrary scales, the exact 2x and 0.5x paths and uint8 fixed point
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+
+// Half-pixel source position of output index d, clamped like the library
+static double source_position(uint32_t d, uint32_t in_size, uint32_t out_size) {
+    double s = (d + 0.5) * in_size / out_size - 0.5;
+    if (s < 0.0) s = 0.0;
+    if (s > in_size - 1) s = in_size - 1;
+    return s;
+}
+
+static double reference_bilinear(const neurax_tensor_t* in, uint32_t n, uint32_t c,
+                                 double sy, double sx) {
+    uint32_t y0 = (uint32_t)sy, x0 = (uint32_t)sx;
+    uint32_t y1 = y0 + 1 < in->height ? y0 + 1 : y0;
+    uint32_t x1 = x0 + 1 < in->width ? x0 + 1 : x0;
+    double fy = sy - y0, fx = sx - x0;
+    double top = neurax_test_get(in, n, y0, x0, c) * (1 - fx) + neurax_test_get(in, n, y0, x1, c) * fx;
+    double bottom = neurax_test_get(in, n, y1, x0, c) * (1 - fx) + neurax_test_get(in, n, y1, x1, c) * fx;
+    return top * (1 - fy) + bottom * fy;
+}
+
+// Largest deviation of a bilinear resize from the reference
+static double bilinear_error(neurax_device_t* device, neurax_data_type_t type,
+                             uint32_t in_w, uint32_t in_h, uint32_t out_w, uint32_t out_h) {
+    neurax_tensor_t *in, *out;
+    NEURAX_CHECK_OK(neurax_tensor_create(in_w, in_h, 3, 2, type, &in));
+    NEURAX_CHECK_OK(neurax_tensor_create(out_w, out_h, 3, 2, type, &out));
+    neurax_test_fill(in, in_w * 31 + out_w);
+    NEURAX_CHECK_OK(neurax_resize(device, in, NEURAX_RESIZE_BILINEAR, out));
+
+    double worst = 0.0;
+    for (uint32_t n = 0; n < 2; n++)
+    for (uint32_t y = 0; y < out_h; y++)
+    for (uint32_t x = 0; x < out_w; x++)
+    for (uint32_t c = 0; c < 3; c++) {
+        double expected = reference_bilinear(in, n, c, source_position(y, in_h, out_h),
+                                             source_position(x, in_w, out_w));
+        double error = fabs(neurax_test_get(out, n, y, x, c) - expected);
+        worst = error > worst ? error : worst;
+    }
+    neurax_tensor_destroy(in);
+    neurax_tensor_destroy(out);
+    return worst;
+}
+
+// Nearest neighbour is an exact gather of source pixels
+static bool nearest_matches(neurax_device_t* device, neurax_data_type_t in_type,
+                            neurax_data_type_t out_type, uint32_t in_w, uint32_t in_h,
+                            uint32_t out_w, uint32_t out_h) {
+    neurax_tensor_t *in, *out;
+    NEURAX_CHECK_OK(neurax_tensor_create(in_w, in_h, 3, 2, in_type, &in));
+    NEURAX_CHECK_OK(neurax_tensor_create(out_w, out_h, 3, 2, out_type, &out));
+    neurax_test_fill(in, in_w + out_h);
+    NEURAX_CHECK_OK(neurax_resize(device, in, NEURAX_RESIZE_NEAREST, out));
+
+    bool same = true;
+    for (uint32_t n = 0; n < 2; n++)
+    for (uint32_t y = 0; y < out_h; y++)
+    for (uint32_t x = 0; x < out_w; x++)
+    for (uint32_t c = 0; c < 3; c++) {
+        uint32_t sy = (uint32_t)floor((y + 0.5) * in_h / out_h);
+        uint32_t sx = (uint32_t)floor((x + 0.5) * in_w / out_w);
+        same = same && neurax_test_get(out, n, y, x, c) ==
+                       neurax_test_get(in, n, sy < in_h ? sy : in_h - 1, sx < in_w ? sx : in_w - 1, c);
+    }
+    neurax_tensor_destroy(in);
+    neurax_tensor_destroy(out);
+    return same;
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // Nearest: up, down, odd ratios, and a type change on the way
+    NEURAX_CHECK(nearest_matches(device, NEURAX_DATA_FLOAT32, NEURAX_DATA_FLOAT32, 5, 4, 10, 8));
+    NEURAX_CHECK(nearest_matches(device, NEURAX_DATA_FLOAT32, NEURAX_DATA_FLOAT32, 10, 8, 5, 4));
+    NEURAX_CHECK(nearest_matches(device, NEURAX_DATA_UINT8, NEURAX_DATA_UINT8, 7, 5, 11, 3));
+    NEURAX_CHECK(nearest_matches(device, NEURAX_DATA_UINT8, NEURAX_DATA_FLOAT32, 6, 6, 9, 13));
+
+    // fp32 bilinear: table path, exact 2x and exact 0.5x
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_FLOAT32, 7, 5, 11, 9) < 1e-5);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_FLOAT32, 9, 7, 4, 3) < 1e-5);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_FLOAT32, 6, 5, 12, 10) < 1e-5);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_FLOAT32, 12, 10, 6, 5) < 1e-5);
+
+    // uint8 fixed point rounds to the nearest value: 11-bit weights stay well
+    // inside the half step, where truncation would be off by up to one
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_UINT8, 7, 5, 11, 9) <= 0.6);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_UINT8, 13, 9, 5, 7) <= 0.6);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_UINT8, 6, 5, 12, 10) <= 0.6);
+    NEURAX_CHECK(bilinear_error(device, NEURAX_DATA_UINT8, 12, 10, 6, 5) <= 0.5);
+
+    // The 0.5x uint8 box average rounds halves up
+    neurax_tensor_t *in, *out;
+    NEURAX_CHECK_OK(neurax_tensor_create(2, 2, 1, 1, NEURAX_DATA_UINT8, &in));
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 1, 1, NEURAX_DATA_UINT8, &out));
+    const uint8_t box[4] = {1, 2, 2, 1};
+    memcpy(in->data, box, 4);
+    NEURAX_CHECK_OK(neurax_resize(device, in, NEURAX_RESIZE_BILINEAR, out));
+    NEURAX_CHECK(((uint8_t*)out->data)[0] == 2);
+
+    // Channel and batch counts must carry over
+    neurax_tensor_t* wrong;
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 2, 1, NEURAX_DATA_UINT8, &wrong));
+    NEURAX_CHECK(neurax_resize(device, in, NEURAX_RESIZE_BILINEAR, wrong) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_resize(device, in, (neurax_resize_mode_t)2, out) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(wrong);
+    neurax_tensor_destroy(in);
+    neurax_tensor_destroy(out);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_resize");
+}
@@ -0,0 +1,164 @@
+/*
+ * NEURAX Library Tests
+ * Scratch arenas of the submission queue worker and the calling thread
+ *
+ * Author: NEURAX Team
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "neurax_test.h"
+#include "neurax_private.h"
+#include <time.h>
+
+#define ITERATIONS 20
+#define JOBS 4
+#define SYNC_ROUNDS 8
+
+typedef struct {
+    neurax_tensor_t* conv_in;
+    neurax_tensor_t* conv_weights;
+    neurax_tensor_t* conv_out;
+    neurax_tensor_t* scores;
+    neurax_tensor_t* probs;
+    neurax_tensor_t* bn_in;
+    neurax_tensor_t* bn_out;
+    neurax_tensor_t* mean;
+    neurax_tensor_t* variance;
+} operands_t;
+
+static const neurax_conv_config_t conv_config = {3, 3, 1, 1, 1, 1, 16, 16, false,
+                                                 NEURAX_ACTIVATION_RELU};
+
+static void create_operands(operands_t* op) {
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(48, 48, 16, 1, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_NCHW8C, &op->conv_in));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 16, 16, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_OIHW, &op->conv_weights));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(48, 48, 16, 1, NEURAX_DATA_FLOAT32,
+                                                NEURAX_LAYOUT_NCHW8C, &op->conv_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 10, 1, NEURAX_DATA_FLOAT32, &op->scores));
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 10, 1, NEURAX_DATA_FLOAT32, &op->probs));
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 16, 1, NEURAX_DATA_FLOAT32, &op->bn_in));
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 16, 1, NEURAX_DATA_FLOAT32, &op->bn_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(16, 1, 1, 1, NEURAX_DATA_FLOAT32, &op->mean));
+    NEURAX_CHECK_OK(neurax_tensor_create(16, 1, 1, 1, NEURAX_DATA_FLOAT32, &op->variance));
+
+    neurax_test_fill(op->conv_in, 1);
+    neurax_test_fill(op->conv_weights, 2);
+    neurax_test_fill(op->scores, 3);
+    neurax_test_fill(op->bn_in, 4);
+    neurax_test_fill(op->mean, 5);
+    for (uint32_t c = 0; c < 16; c++) {
+        ((float*)op->variance->data)[c] = 0.5f + (float)c;
+    }
+}
+
+static void destroy_operands(operands_t* op) {
+    neurax_tensor_destroy(op->conv_in);
+    neurax_tensor_destroy(op->conv_weights);
+    neurax_tensor_destroy(op->conv_out);
+    neurax_tensor_destroy(op->scores);
+    neurax_tensor_destroy(op->probs);
+    neurax_tensor_destroy(op->bn_in);
+    neurax_tensor_destroy(op->bn_out);
+    neurax_tensor_destroy(op->mean);
+    neurax_tensor_destroy(op->variance);
+}
+
+static neurax_error_t run_batch_norm(neurax_device_t* device, const operands_t* op) {
+    neurax_batch_norm_params_t params = {NULL, NULL, op->mean, op->variance, 1e-3f};
+    return neurax_batch_norm(device, op->bn_in, &params, op->bn_out);
+}
+
+int main(void) {
+    neurax_config_t config;
+    neurax_device_t* device = NULL;
+    operands_t op;
+    neurax_tensor_t* outputs[JOBS];
+
+    memset(&config, 0, sizeof(config));
+    create_operands(&op);
+    for (int j = 0; j < JOBS; j++) {
+        NEURAX_CHECK_OK(neurax_tensor_create_layout(48, 48, 16, 1, NEURAX_DATA_FLOAT32,
+                                                    NEURAX_LAYOUT_NCHW8C, &outputs[j]));
+    }
+
+    // Single-threaded references
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+    NEURAX_CHECK_OK(neurax_conv2d(device, op.conv_in, op.conv_weights, NULL, &conv_config,
+                                  op.conv_out));
+    NEURAX_CHECK_OK(neurax_softmax(device, op.scores, op.probs));
+    NEURAX_CHECK_OK(run_batch_norm(device, &op));
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    neurax_tensor_t *probs_ref = op.probs, *bn_ref = op.bn_out;
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 10, 1, NEURAX_DATA_FLOAT32, &op.probs));
+    NEURAX_CHECK_OK(neurax_tensor_create(64, 64, 16, 1, NEURAX_DATA_FLOAT32, &op.bn_out));
+
+    // A fresh device each iteration starts with an empty arena, so the first releases
+    // regrow it while the other thread may be using scratch
+    for (int it = 0; it < ITERATIONS; it++) {
+        neurax_fence_t* fences[JOBS];
+
+        NEURAX_CHECK_OK(neurax_init(&config, &device));
+        for (int j = 0; j < JOBS; j++) {
+            memset(outputs[j]->data, 0, outputs[j]->data_size);
+            NEURAX_CHECK_OK(neurax_conv2d_async(device, op.conv_in, op.conv_weights, NULL,
+                                                &conv_config, outputs[j], NULL, NULL,
+                                                &fences[j]));
+        }
+
+        for (int round = 0; round < SYNC_ROUNDS; round++) {
+            memset(op.probs->data, 0, op.probs->data_size);
+            memset(op.bn_out->data, 0, op.bn_out->data_size);
+            NEURAX_CHECK_OK(neurax_softmax(device, op.scores, op.probs));
+            NEURAX_CHECK_OK(run_batch_norm(device, &op));
+            NEURAX_CHECK(neurax_test_same(op.probs, probs_ref));
+            NEURAX_CHECK(neurax_test_same(op.bn_out, bn_ref));
+        }
+
+        for (int j = 0; j < JOBS; j++) {
+            NEURAX_CHECK_OK(neurax_fence_wait(fences[j]));
+            NEURAX_CHECK_OK(neurax_fence_destroy(fences[j]));
+            NEURAX_CHECK(neurax_test_same(outputs[j], op.conv_out));
+        }
+
+        neurax_workspace_stats_t stats;
+        NEURAX_CHECK_OK(neurax_workspace_get_stats(device, &stats));
+        NEURAX_CHECK(stats.used == 0);
+        NEURAX_CHECK_OK(neurax_cleanup(device));
+    }
+
+    // An operation in flight on this thread does not hold up the queue worker's
+    neurax_fence_t* fence = NULL;
+    bool signaled = false;
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+    size_t mark = neurax_scratch_mark(device);
+    void* held = neurax_scratch_alloc(device, 4096);
+    NEURAX_CHECK(held != NULL);
+    NEURAX_CHECK_OK(neurax_conv2d_async(device, op.conv_in, op.conv_weights, NULL, &conv_config,
+                                        outputs[0], NULL, NULL, &fence));
+    for (int i = 0; i < 10000 && !signaled; i++) {
+        const struct timespec delay = {0, 1000000};
+        NEURAX_CHECK_OK(neurax_fence_poll(fence, &signaled));
+        if (!signaled) {
+            nanosleep(&delay, NULL);
+        }
+    }
+    NEURAX_CHECK(signaled);
+    neurax_scratch_free(device, held);
+    neurax_scratch_release(device, mark);
+    NEURAX_CHECK_OK(neurax_fence_wait(fence));
+    NEURAX_CHECK_OK(neurax_fence_destroy(fence));
+    NEURAX_CHECK(neurax_test_same(outputs[0], op.conv_out));
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    for (int j = 0; j < JOBS; j++) {
+        neurax_tensor_destroy(outputs[j]);
+    }
+    neurax_tensor_destroy(probs_ref);
+    neurax_tensor_destroy(bn_ref);
+    destroy_operands(&op);
+
+    return neurax_test_result("test_scratch_threads");
+}
@@ -0,0 +1,141 @@
+/*
+ * NEURAX Library Tests
+ * The simulated accelerator matches the CPU kernels bit for bit
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+
+typedef struct {
+    neurax_device_t* sim;
+    neurax_device_t* cpu;
+} devices_t;
+
+static void check_conv(const devices_t* dev, neurax_data_type_t type, neurax_activation_t act) {
+    neurax_tensor_t *input, *weights, *bias, *sim_out, *cpu_out;
+    neurax_conv_config_t conv = {3, 3, 2, 2, 1, 1, 3, 5, true, act};
+
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 3, 2, type, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create_layout(3, 3, 3, 5, type, NEURAX_LAYOUT_OIHW, &weights));
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 1, 1, 1, type, &bias));
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, 5, 2, type, &sim_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(5, 4, 5, 2, type, &cpu_out));
+    neurax_test_fill(input, 1);
+    neurax_test_fill(weights, 2);
+    neurax_test_fill(bias, 3);
+
+    NEURAX_CHECK_OK(neurax_conv2d(dev->sim, input, weights, bias, &conv, sim_out));
+    NEURAX_CHECK_OK(neurax_conv2d(dev->cpu, input, weights, bias, &conv, cpu_out));
+    if (!neurax_test_same(sim_out, cpu_out)) {
+        fprintf(stderr, "conv2d type %d activation %d differs\n", type, act);
+        neurax_test_failures++;
+    }
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(weights);
+    neurax_tensor_destroy(bias);
+    neurax_tensor_destroy(sim_out);
+    neurax_tensor_destroy(cpu_out);
+}
+
+static void check_pooling(const devices_t* dev, neurax_data_type_t type, neurax_pool_type_t pool) {
+    neurax_tensor_t *input, *sim_out, *cpu_out;
+    neurax_pool_config_t config = {3, 3, 2, 2, pool};
+
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 3, 2, type, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 3, 3, 2, type, &sim_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 3, 3, 2, type, &cpu_out));
+    neurax_test_fill(input, 4);
+
+    NEURAX_CHECK_OK(neurax_pooling(dev->sim, input, &config, sim_out));
+    NEURAX_CHECK_OK(neurax_pooling(dev->cpu, input, &config, cpu_out));
+    if (!neurax_test_same(sim_out, cpu_out)) {
+        fprintf(stderr, "pooling type %d pool %d differs\n", type, pool);
+        neurax_test_failures++;
+    }
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(sim_out);
+    neurax_tensor_destroy(cpu_out);
+}
+
+static void check_activation(const devices_t* dev, neurax_data_type_t type,
+                             neurax_activation_t act) {
+    neurax_tensor_t *input, *sim_out, *cpu_out;
+
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 3, 2, type, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 3, 2, type, &sim_out));
+    NEURAX_CHECK_OK(neurax_tensor_create(9, 7, 3, 2, type, &cpu_out));
+    neurax_test_fill(input, 5);
+
+    NEURAX_CHECK_OK(neurax_activation(dev->sim, input, act, sim_out));
+    NEURAX_CHECK_OK(neurax_activation(dev->cpu, input, act, cpu_out));
+    if (!neurax_test_same(sim_out, cpu_out)) {
+        fprintf(stderr, "activation type %d activation %d differs\n", type, act);
+        neurax_test_failures++;
+    }
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(sim_out);
+    neurax_tensor_destroy(cpu_out);
+}
+
+// Injected faults surface as errors and don't stick to the next operation
+static void check_faults(neurax_device_t* sim) {
+    neurax_tensor_t *input, *output;
+
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 4, 2, 1, NEURAX_DATA_INT8, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 4, 2, 1, NEURAX_DATA_INT8, &output));
+
+    NEURAX_CHECK_OK(neurax_simulator_inject_fault(sim, NEURAX_SIM_FAULT_ERROR));
+    NEURAX_CHECK(neurax_activation(sim, input, NEURAX_ACTIVATION_RELU, output) ==
+                 NEURAX_ERROR_HARDWARE_FAILURE);
+    NEURAX_CHECK_OK(neurax_activation(sim, input, NEURAX_ACTIVATION_RELU, output));
+
+    NEURAX_CHECK_OK(neurax_simulator_inject_fault(sim, NEURAX_SIM_FAULT_HANG));
+    NEURAX_CHECK(neurax_activation(sim, input, NEURAX_ACTIVATION_RELU, output) ==
+                 NEURAX_ERROR_TIMEOUT);
+    NEURAX_CHECK_OK(neurax_activation(sim, input, NEURAX_ACTIVATION_RELU, output));
+
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(output);
+}
+
+int main(void) {
+    neurax_config_t sim_config, cpu_config;
+    devices_t dev;
+    const neurax_data_type_t types[] = {NEURAX_DATA_INT8, NEURAX_DATA_UINT8, NEURAX_DATA_INT16};
+    const neurax_activation_t activations[] = {NEURAX_ACTIVATION_RELU, NEURAX_ACTIVATION_SIGMOID,
+                                               NEURAX_ACTIVATION_TANH, NEURAX_ACTIVATION_LINEAR};
+
+    memset(&sim_config, 0, sizeof(sim_config));
+    sim_config.use_hardware = true;
+    sim_config.use_simulator = true;
+    sim_config.timeout_ms = 20;
+    memset(&cpu_config, 0, sizeof(cpu_config));
+    NEURAX_CHECK_OK(neurax_init(&sim_config, &dev.sim));
+    NEURAX_CHECK_OK(neurax_init(&cpu_config, &dev.cpu));
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        for (size_t a = 0; a < sizeof(activations) / sizeof(activations[0]); a++) {
+            check_conv(&dev, types[t], activations[a]);
+            check_activation(&dev, types[t], activations[a]);
+        }
+        check_pooling(&dev, types[t], NEURAX_POOL_MAX);
+        check_pooling(&dev, types[t], NEURAX_POOL_AVERAGE);
+    }
+
+    // Every operation above ran on the simulated unit, not the CPU fallback. Conv and
+    // pooling take one run per image of the batch of 2; activation streams the batch.
+    neurax_perf_estimate_t stats;
+    NEURAX_CHECK_OK(neurax_simulator_get_stats(dev.sim, &stats));
+    NEURAX_CHECK(stats.runs == 3 * (4 * (2 + 1) + 2 * 2));
+
+    check_faults(dev.sim);
+
+    NEURAX_CHECK_OK(neurax_cleanup(dev.sim));
+    NEURAX_CHECK_OK(neurax_cleanup(dev.cpu));
+
+    return neurax_test_result("test_simulator");
+}
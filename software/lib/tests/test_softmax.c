@@ -0,0 +1,176 @@
+/*
+ * NEURAX Library Tests
+ * Softmax, argmax and top-k against scalar references: accuracy, NaN and
+ * infinite scores, tie order and best-first results
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define PIXELS 6
+
+// Softmax of one pixel in double precision
+static void reference_softmax(const float* scores, uint32_t C, double* out) {
+    double max = scores[0];
+    for (uint32_t c = 1; c < C; c++) {
+        max = scores[c] > max ? scores[c] : max;
+    }
+    double sum = 0.0;
+    for (uint32_t c = 0; c < C; c++) {
+        out[c] = exp((double)scores[c] - max);
+        sum += out[c];
+    }
+    for (uint32_t c = 0; c < C; c++) {
+        out[c] /= sum;
+    }
+}
+
+// Softmax over C channels matches the reference to float accuracy
+static void check_softmax(neurax_device_t* device, uint32_t C, uint32_t seed) {
+    neurax_tensor_t *input, *output;
+    NEURAX_CHECK_OK(neurax_tensor_create(PIXELS, 1, C, 1, NEURAX_DATA_FLOAT32, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(PIXELS, 1, C, 1, NEURAX_DATA_FLOAT32, &output));
+    neurax_test_fill(input, seed);
+    NEURAX_CHECK_OK(neurax_softmax(device, input, output));
+
+    double* expected = malloc(sizeof(double) * C);
+    for (uint32_t p = 0; p < PIXELS; p++) {
+        const float* scores = (const float*)input->data + p * C;
+        const float* probs = (const float*)output->data + p * C;
+        reference_softmax(scores, C, expected);
+        double sum = 0.0;
+        for (uint32_t c = 0; c < C; c++) {
+            NEURAX_CHECK(fabs(probs[c] - expected[c]) <= 1e-6 + 1e-5 * expected[c]);
+            sum += probs[c];
+        }
+        NEURAX_CHECK(fabs(sum - 1.0) < 1e-5);
+    }
+    free(expected);
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(output);
+}
+
+int main(void) {
+    neurax_device_t* device = NULL;
+    neurax_config_t config;
+    memset(&config, 0, sizeof(config));
+    NEURAX_CHECK_OK(neurax_init(&config, &device));
+
+    // Channel counts below, at and past the 8-wide partial sums
+    check_softmax(device, 3, 1);
+    check_softmax(device, 8, 2);
+    check_softmax(device, 21, 3);
+    check_softmax(device, 1000, 4);
+
+    // Non-finite scores: NaN poisons its pixel, +inf takes all the probability
+    neurax_tensor_t *input, *output, *quantized;
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 10, 1, NEURAX_DATA_FLOAT32, &input));
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 10, 1, NEURAX_DATA_FLOAT32, &output));
+    float* s = (float*)input->data;
+    for (uint32_t i = 0; i < 40; i++) {
+        s[i] = (float)(i % 7) - 3.0f;
+    }
+    s[3] = NAN;                             // Pixel 0: one NaN
+    s[10 + 2] = INFINITY;                   // Pixel 1: one +inf
+    s[20 + 1] = INFINITY;                   // Pixel 2: two +inf
+    s[20 + 9] = INFINITY;
+    for (uint32_t c = 0; c < 10; c++) {     // Pixel 3: all -inf but one
+        s[30 + c] = c == 6 ? 0.0f : -INFINITY;
+    }
+    NEURAX_CHECK_OK(neurax_softmax(device, input, output));
+    const float* o = (const float*)output->data;
+    for (uint32_t c = 0; c < 10; c++) {
+        NEURAX_CHECK(isnan(o[c]));
+        NEURAX_CHECK(o[10 + c] == (c == 2 ? 1.0f : 0.0f));
+        NEURAX_CHECK(o[20 + c] == (c == 1 || c == 9 ? 0.5f : 0.0f));
+        NEURAX_CHECK(c == 6 ? fabsf(o[30 + c] - 1.0f) < 1e-6f : o[30 + c] < 1e-30f);
+    }
+
+    // An integer output can't carry the NaN, so the call fails
+    NEURAX_CHECK_OK(neurax_tensor_create(4, 1, 10, 1, NEURAX_DATA_UINT8, &quantized));
+    NEURAX_CHECK_OK(neurax_tensor_set_quant_params(quantized, 1.0f / 255.0f, 0, NULL, 0));
+    NEURAX_CHECK(neurax_softmax(device, input, quantized) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(((uint8_t*)quantized->data)[0] == 0 && ((uint8_t*)quantized->data)[3] == 0);
+    NEURAX_CHECK(((uint8_t*)quantized->data)[10 + 2] == 255);
+    s[3] = 0.0f;
+    NEURAX_CHECK_OK(neurax_softmax(device, input, quantized));
+    neurax_tensor_destroy(quantized);
+    neurax_tensor_destroy(input);
+    neurax_tensor_destroy(output);
+
+    // Argmax and top-k: ties go to the lowest channel, top-k is best first.
+    // 1500 channels span two of the 1024-score conversion blocks.
+    const uint32_t C = 1500;
+    const uint32_t K = 5;
+    neurax_tensor_t* scores;
+    NEURAX_CHECK_OK(neurax_tensor_create(3, 1, C, 1, NEURAX_DATA_FLOAT32, &scores));
+    s = (float*)scores->data;
+    for (uint32_t i = 0; i < 3 * C; i++) {
+        s[i] = (float)((i * 7919u) % 997u) / 1000.0f;
+    }
+    s[1200] = 5.0f;                         // Pixel 0: best in the second block
+    s[17] = 4.0f;
+    s[1499] = 4.0f;
+    s[C + 40] = 3.0f;                       // Pixel 1: three-way tie for best
+    s[C + 4] = 3.0f;
+    s[C + 1100] = 3.0f;
+    s[2 * C + 0] = 2.0f;                    // Pixel 2: tie at the first channel
+    s[2 * C + 999] = 2.0f;
+
+    uint32_t argmax[3];
+    float best[3];
+    NEURAX_CHECK_OK(neurax_argmax(device, scores, argmax, best));
+    NEURAX_CHECK(argmax[0] == 1200 && best[0] == 5.0f);
+    NEURAX_CHECK(argmax[1] == 4 && best[1] == 3.0f);
+    NEURAX_CHECK(argmax[2] == 0 && best[2] == 2.0f);
+
+    uint32_t indices[3 * K];
+    float values[3 * K];
+    NEURAX_CHECK_OK(neurax_topk(device, scores, K, indices, values));
+    NEURAX_CHECK(indices[0] == 1200 && indices[1] == 17 && indices[2] == 1499);
+    NEURAX_CHECK(indices[K] == 4 && indices[K + 1] == 40 && indices[K + 2] == 1100);
+    NEURAX_CHECK(indices[2 * K] == 0 && indices[2 * K + 1] == 999);
+
+    // Against a scalar reference: each pick is the best remaining score,
+    // lowest index first among equals
+    for (uint32_t p = 0; p < 3; p++) {
+        const float* row = s + p * C;
+        char* taken = calloc(C, 1);
+        for (uint32_t r = 0; r < K; r++) {
+            uint32_t pick = C;
+            for (uint32_t c = 0; c < C; c++) {
+                if (!taken[c] && (pick == C || row[c] > row[pick])) {
+                    pick = c;
+                }
+            }
+            taken[pick] = 1;
+            NEURAX_CHECK(indices[p * K + r] == pick);
+            NEURAX_CHECK(values[p * K + r] == row[pick]);
+        }
+        free(taken);
+    }
+
+    // k = channels is a full sort
+    uint32_t all[8];
+    float all_values[8];
+    neurax_tensor_t* small;
+    const float small_scores[8] = {0.5f, 2.0f, -1.0f, 2.0f, 0.0f, 7.0f, 0.5f, -3.0f};
+    const uint32_t sorted[8] = {5, 1, 3, 0, 6, 4, 2, 7};
+    NEURAX_CHECK_OK(neurax_tensor_create(1, 1, 8, 1, NEURAX_DATA_FLOAT32, &small));
+    memcpy(small->data, small_scores, sizeof(small_scores));
+    NEURAX_CHECK_OK(neurax_topk(device, small, 8, all, all_values));
+    for (uint32_t i = 0; i < 8; i++) {
+        NEURAX_CHECK(all[i] == sorted[i] && all_values[i] == small_scores[sorted[i]]);
+    }
+    NEURAX_CHECK(neurax_topk(device, small, 9, all, NULL) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_topk(device, small, 0, all, NULL) == NEURAX_ERROR_INVALID_PARAM);
+
+    neurax_tensor_destroy(small);
+    neurax_tensor_destroy(scores);
+    NEURAX_CHECK_OK(neurax_cleanup(device));
+
+    return neurax_test_result("test_softmax");
+}
@@ -0,0 +1,140 @@
+/*
+ * NEURAX Library Tests
+ * .nxt tensor files: little-endian round trip, read-only loaded tensors and
+ * file errors
+ *
+ * Author: NEURAX Team
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "neurax_test.h"
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+static uint32_t le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+int main(void) {
+    char path[] = "/tmp/neurax_test_XXXXXX";
+    int fd = mkstemp(path);
+    NEURAX_CHECK(fd >= 0);
+    if (fd < 0) {
+        return neurax_test_result("test_tensor_file");
+    }
+    close(fd);
+
+    neurax_tensor_t* weights = NULL;
+    neurax_tensor_t* quantized = NULL;
+    float channel_scales[8] = {0.5f, 0.25f, 1.0f, 2.0f, 0.125f, 4.0f, 0.75f, 1.5f};
+    NEURAX_CHECK_OK(neurax_tensor_create(3, 3, 4, 8, NEURAX_DATA_FLOAT32, &weights));
+    neurax_test_fill(weights, 7);
+    NEURAX_CHECK_OK(neurax_tensor_create(3, 3, 4, 8, NEURAX_DATA_INT8, &quantized));
+    neurax_test_fill(quantized, 11);
+    NEURAX_CHECK_OK(neurax_tensor_set_quant_params(quantized, 0.0f, 0, channel_scales, 8));
+
+    const neurax_tensor_t* tensors[2] = {weights, quantized};
+    const char* names[2] = {"conv.weights", "conv.qweights"};
+    NEURAX_CHECK_OK(neurax_tensor_file_save(path, tensors, names, 2));
+
+    // Header and table fields are little-endian whatever the host
+    uint8_t table[64 + 2 * 128];
+    FILE* fp = fopen(path, "rb");
+    NEURAX_CHECK(fp && fread(table, 1, sizeof(table), fp) == sizeof(table));
+    if (fp) fclose(fp);
+    NEURAX_CHECK(memcmp(table, "NXT1", 4) == 0);
+    NEURAX_CHECK(le32(table + 4) == 1 && le32(table + 8) == 2 && le32(table + 12) == 4096);
+    NEURAX_CHECK(strcmp((const char*)table + 64, "conv.weights") == 0);
+    NEURAX_CHECK(le32(table + 64 + 64) == 3 && le32(table + 64 + 76) == 8);
+    NEURAX_CHECK(le32(table + 64 + 80) == NEURAX_DATA_FLOAT32);
+    NEURAX_CHECK(le32(table + 192 + 120) == 8);
+
+    // Round trip, quantization parameters included
+    neurax_tensor_file_t* file = NULL;
+    neurax_tensor_t* loaded = NULL;
+    neurax_tensor_t* loaded_q = NULL;
+    uint32_t count = 0;
+    const char* name = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_file_open(path, &file));
+    NEURAX_CHECK_OK(neurax_tensor_file_get_count(file, &count));
+    NEURAX_CHECK(count == 2);
+    NEURAX_CHECK_OK(neurax_tensor_file_get_name(file, 1, &name));
+    NEURAX_CHECK(name && strcmp(name, "conv.qweights") == 0);
+    NEURAX_CHECK_OK(neurax_tensor_file_find(file, "conv.weights", &loaded));
+    NEURAX_CHECK_OK(neurax_tensor_file_load(file, 1, &loaded_q));
+    NEURAX_CHECK_OK(neurax_tensor_file_close(file));
+    NEURAX_CHECK(neurax_test_same(loaded, weights));
+    NEURAX_CHECK(neurax_test_same(loaded_q, quantized));
+    NEURAX_CHECK(loaded_q->quant.num_channels == 8 &&
+                 memcmp(loaded_q->quant.channel_scales, channel_scales, sizeof(channel_scales)) == 0);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(loaded_q));
+
+    // Loaded tensors and their views refuse writes
+    void* data = NULL;
+    neurax_tensor_t* view = NULL;
+    neurax_tensor_t* bias = NULL;
+    neurax_tensor_t* mean = NULL;
+    neurax_tensor_t* variance = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 1, 1, 1, NEURAX_DATA_FLOAT32, &mean));
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 1, 1, 1, NEURAX_DATA_FLOAT32, &variance));
+    for (uint32_t c = 0; c < 8; c++) {
+        ((float*)variance->data)[c] = 3.0f;
+    }
+    neurax_batch_norm_params_t params = {NULL, NULL, mean, variance, 1.0f};
+
+    NEURAX_CHECK(neurax_tensor_map(loaded, NEURAX_MAP_READ_WRITE, &data, NULL) ==
+                 NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_tensor_map(loaded, NEURAX_MAP_READ, &data, NULL));
+    NEURAX_CHECK_OK(neurax_tensor_unmap(loaded));
+    NEURAX_CHECK(neurax_tensor_set_data(loaded, weights->data, 16) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_fold_batch_norm(loaded, &bias, &params) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(bias == NULL);
+    NEURAX_CHECK_OK(neurax_tensor_channel_slice(loaded, 0, 2, &view));
+    NEURAX_CHECK(neurax_tensor_set_data(view, weights->data, 8) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK(neurax_tensor_convert_layout(weights, loaded) == NEURAX_ERROR_INVALID_PARAM);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(view));
+
+    // A copy is writable: fold into it
+    neurax_tensor_t* copy = NULL;
+    NEURAX_CHECK_OK(neurax_tensor_create(3, 3, 4, 8, NEURAX_DATA_FLOAT32, &copy));
+    NEURAX_CHECK_OK(neurax_tensor_convert_layout(loaded, copy));
+    NEURAX_CHECK_OK(neurax_fold_batch_norm(copy, &bias, &params));
+    NEURAX_CHECK(((float*)copy->data)[1] == ((float*)weights->data)[1] * 0.5f);
+    NEURAX_CHECK(neurax_test_same(loaded, weights));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(loaded));
+
+    // Missing paths are I/O errors, malformed files invalid models
+    NEURAX_CHECK(neurax_tensor_file_open("/nonexistent/neurax.nxt", &file) == NEURAX_ERROR_IO);
+    NEURAX_CHECK(neurax_tensor_file_save("/nonexistent/neurax.nxt", tensors, names, 1) ==
+                 NEURAX_ERROR_IO);
+    fp = fopen(path, "r+b");
+    NEURAX_CHECK(fp != NULL);
+    if (fp) {
+        fputc('X', fp);
+        fclose(fp);
+    }
+    NEURAX_CHECK(neurax_tensor_file_open(path, &file) == NEURAX_ERROR_INVALID_MODEL);
+
+    // A failed write leaves no partial file behind
+    struct rlimit limit, small;
+    signal(SIGXFSZ, SIG_IGN);
+    NEURAX_CHECK(getrlimit(RLIMIT_FSIZE, &limit) == 0);
+    small = limit;
+    small.rlim_cur = 4096;
+    NEURAX_CHECK(setrlimit(RLIMIT_FSIZE, &small) == 0);
+    NEURAX_CHECK(neurax_tensor_file_save(path, tensors, names, 2) == NEURAX_ERROR_IO);
+    NEURAX_CHECK(access(path, F_OK) != 0);
+    setrlimit(RLIMIT_FSIZE, &limit);
+
+    neurax_tensor_destroy(copy);
+    neurax_tensor_destroy(bias);
+    neurax_tensor_destroy(mean);
+    neurax_tensor_destroy(variance);
+    neurax_tensor_destroy(quantized);
+    neurax_tensor_destroy(weights);
+    unlink(path);
+
+    return neurax_test_result("test_tensor_file");
+}
@@ -0,0 +1,78 @@
+/*
+ * NEURAX Library Tests
+ * Who releases tensor data on destroy: library tensors, wrapped buffers,
+ * views and headers built by the caller
+ *
+ * Author: NEURAX Team
+ */
+
+#include "neurax_test.h"
+#include <stdlib.h>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define HAVE_MALLINFO2 1
+#endif
+
+static int deleted = 0;
+
+static void count_delete(void* data, void* user_data) {
+    (void)user_data;
+    deleted++;
+    free(data);
+}
+
+// Header and data malloc'd by the caller, the way code predating the library API does
+static neurax_tensor_t* caller_built(size_t size) {
+    neurax_tensor_t* tensor = calloc(1, sizeof(neurax_tensor_t));
+    tensor->width = (uint32_t)size;
+    tensor->height = 1;
+    tensor->channels = 1;
+    tensor->batch_size = 1;
+    tensor->data_type = NEURAX_DATA_UINT8;
+    tensor->data_size = size;
+    tensor->data = malloc(size);
+    memset(tensor->data, 1, size);
+    return tensor;
+}
+
+int main(void) {
+    neurax_tensor_t *tensor, *view;
+    uint8_t buffer[64];
+
+    // Borrowed buffers stay with the caller, owned ones go to the deleter
+    NEURAX_CHECK_OK(neurax_tensor_wrap(buffer, sizeof(buffer), 8, 8, 1, 1, NEURAX_DATA_UINT8,
+                                       NEURAX_LAYOUT_NHWC, NEURAX_WRAP_BORROW, count_delete,
+                                       NULL, &tensor));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(tensor));
+    NEURAX_CHECK(deleted == 0);
+
+    NEURAX_CHECK_OK(neurax_tensor_wrap(malloc(64), 64, 8, 8, 1, 1, NEURAX_DATA_UINT8,
+                                       NEURAX_LAYOUT_NHWC, NEURAX_WRAP_TAKE_OWNERSHIP,
+                                       count_delete, NULL, &tensor));
+    NEURAX_CHECK_OK(neurax_tensor_destroy(tensor));
+    NEURAX_CHECK(deleted == 1);
+
+    // Destroying a view leaves the parent's data alone
+    NEURAX_CHECK_OK(neurax_tensor_create(8, 8, 4, 1, NEURAX_DATA_FLOAT32, &tensor));
+    neurax_test_fill(tensor, 1);
+    NEURAX_CHECK_OK(neurax_tensor_channel_slice(tensor, 1, 2, &view));
+    float first = ((float*)view->data)[0];
+    NEURAX_CHECK_OK(neurax_tensor_destroy(view));
+    NEURAX_CHECK(((float*)tensor->data)[1] == first);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(tensor));
+
+    // Caller-built headers have no library state; destroy frees header and data
+    tensor = caller_built(16);
+    NEURAX_CHECK(tensor->state == NULL);
+    NEURAX_CHECK_OK(neurax_tensor_destroy(tensor));
+
+#ifdef HAVE_MALLINFO2
+    size_t before = mallinfo2().uordblks;
+    for (int i = 0; i < 64; i++) {
+        NEURAX_CHECK_OK(neurax_tensor_destroy(caller_built(1 << 16)));
+    }
+    NEURAX_CHECK(mallinfo2().uordblks < before + (1 << 16));
+#endif
+
+    return neurax_test_result("test_tensor_lifetime");
+}